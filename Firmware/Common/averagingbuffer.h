@@ -24,6 +24,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <numeric>
 
 // ---------------------------------------------------------------------------------------------- //
@@ -58,7 +59,7 @@ void AveragingBuffer<T,N>::addSample(const T& sample)
 template <typename T, size_t N>
 auto AveragingBuffer<T,N>::getValue() const -> T
 {
-    return std::accumulate(m_data.begin(), m_data.end(), T()) / N;
+    return std::accumulate(m_data.begin(), m_data.end(), T()) / static_cast<T>(N);
 }
 
 // ---------------------------------------------------------------------------------------------- //
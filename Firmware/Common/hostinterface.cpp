@@ -138,12 +138,15 @@ auto HostInterface::sendData(const uint8_t* data, uint32_t size,
 
 void HostInterface::processData(const uint8_t* data, uint32_t size)
 {
-    if (m_rxBufferSize + size > ReceiveBufferSize)
+    // Runs in the USB interrupt, so nothing else changes the size in between
+    const size_t rxBufferSize = m_rxBufferSize;
+
+    if (rxBufferSize + size > ReceiveBufferSize)
         m_rxBufferOverflow = true;
     else
     {
-        std::copy_n(data, size, m_rxBuffer.begin() + m_rxBufferSize);
-        m_rxBufferSize += size;
+        std::copy_n(data, size, m_rxBuffer.begin() + rxBufferSize);
+        m_rxBufferSize = rxBufferSize + size;
     }
 }
 
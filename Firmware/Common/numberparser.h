@@ -0,0 +1,184 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <concepts>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Strict decimal conversions without locale, errno or strto*() overhead. Unlike those, they
+// reject empty strings, whitespace and trailing characters instead of silently returning 0.
+class NumberParser
+{
+public:
+    template <std::integral T>
+    static constexpr auto parse(std::string_view string, T& value) -> bool;
+
+    // Parses e.g. "-1.25" into -1250 for three decimals, additional decimals are truncated
+    template <unsigned int Decimals, std::integral T>
+    static constexpr auto parseFixed(std::string_view string, T& value) -> bool;
+
+private:
+    template <std::integral T>
+    struct Accumulator
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+
+        constexpr Accumulator(bool negative);
+        constexpr auto append(unsigned int digit) -> bool;
+        constexpr auto result() const -> T;
+
+        Unsigned value = 0;
+        Unsigned maximum;
+        unsigned int lastDigit;
+        bool negative;
+    };
+
+    static constexpr auto toDigit(char c) -> unsigned int;
+    static constexpr auto parseSign(std::string_view& string) -> bool;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <std::integral T>
+constexpr NumberParser::Accumulator<T>::Accumulator(bool negative)
+    : negative(negative)
+{
+    // Compared against for every digit, instead of dividing the limit each time
+    const Unsigned limit =
+            static_cast<Unsigned>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+    maximum = limit / 10;
+    lastDigit = limit % 10;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <std::integral T>
+constexpr auto NumberParser::Accumulator<T>::append(unsigned int digit) -> bool
+{
+    if (digit > 9 || value > maximum || (value == maximum && digit > lastDigit))
+        return false;
+
+    value = value * 10 + digit;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <std::integral T>
+constexpr auto NumberParser::Accumulator<T>::result() const -> T
+{
+    return static_cast<T>(negative ? Unsigned(0) - value : value);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <std::integral T>
+constexpr auto NumberParser::parse(std::string_view string, T& value) -> bool
+{
+    const bool negative = parseSign(string);
+
+    if (string.empty())
+        return false;
+
+    Accumulator<T> accumulator(negative);
+
+    for (char c : string)
+    {
+        if (!accumulator.append(toDigit(c)))
+            return false;
+    }
+
+    value = accumulator.result();
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <unsigned int Decimals, std::integral T>
+constexpr auto NumberParser::parseFixed(std::string_view string, T& value) -> bool
+{
+    const bool negative = parseSign(string);
+
+    const size_t point = string.find('.');
+
+    const auto integer = string.substr(0, point);
+    const auto fraction = point != std::string_view::npos ? string.substr(point + 1)
+                                                          : std::string_view();
+
+    if (integer.empty() && fraction.empty())
+        return false;
+
+    Accumulator<T> accumulator(negative);
+
+    for (char c : integer)
+    {
+        if (!accumulator.append(toDigit(c)))
+            return false;
+    }
+
+    for (size_t i = 0; i < fraction.size(); ++i)
+    {
+        const unsigned int digit = toDigit(fraction[i]);
+
+        if (digit > 9 || (i < Decimals && !accumulator.append(digit)))
+            return false;
+    }
+
+    for (size_t i = fraction.size(); i < Decimals; ++i)
+    {
+        if (!accumulator.append(0))
+            return false;
+    }
+
+    value = accumulator.result();
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+constexpr auto NumberParser::toDigit(char c) -> unsigned int
+{
+    // Anything but a digit ends up above 9
+    return static_cast<unsigned int>(static_cast<unsigned char>(c)) - '0';
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+constexpr auto NumberParser::parseSign(std::string_view& string) -> bool
+{
+    if (string.empty() || (string.front() != '-' && string.front() != '+'))
+        return false;
+
+    const bool negative = string.front() == '-';
+    string.remove_prefix(1);
+
+    return negative;
+}
+
+// ---------------------------------------------------------------------------------------------- //
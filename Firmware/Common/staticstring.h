@@ -40,6 +40,7 @@
 #include <cstring>
 #include <iterator>
 #include <span>
+#include <string_view>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -81,6 +82,7 @@ public:
     StaticString(StaticString&& other) noexcept;
     StaticString(const char* string);
     StaticString(const char* string, size_t first, size_t last);
+    explicit StaticString(std::string_view string);
     ~StaticString() noexcept = default;
 
     auto format(const char* format, ...) -> StaticString&;
@@ -144,6 +146,8 @@ public:
     constexpr auto c_str() noexcept -> char* { return m_data.data(); }
     constexpr auto c_str() const noexcept -> const char* { return m_data.data(); }
 
+    constexpr operator std::string_view() const noexcept { return { m_data.data(), m_size }; }
+
     constexpr auto size() const -> size_t { return m_size; }
     constexpr auto capacity() const -> size_t { return N; }
     constexpr auto empty() const -> bool { return m_size == 0; }
@@ -235,6 +239,16 @@ StaticString<N>::StaticString(const char* string, size_t first, size_t last)
 
 // ---------------------------------------------------------------------------------------------- //
 
+template <size_t N>
+StaticString<N>::StaticString(std::string_view string)
+    : m_size(std::min(string.size(), N))
+{
+    std::copy_n(string.begin(), m_size, std::begin(m_data));
+    m_data[m_size] = '\0';
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 template <size_t N>
 auto StaticString<N>::format(const char* format, ...) -> StaticString&
 {
@@ -435,10 +449,8 @@ auto StaticString<N>::trim(size_t count) -> StaticString&
 template <size_t N>
 auto StaticString<N>::trimmed(size_t count) const -> StaticString
 {
-    if (count > m_size)
-        count = m_size;
-
-    return StaticString(m_data, 0, count);
+    StaticString result = *this;
+    return result.trim(count);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,136 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Splits a string in a single pass, yielding views into the original string instead of copies,
+// so the string must outlive the tokens.
+class StringTokenizer
+{
+public:
+    enum class TokenBehavior
+    {
+        KeepEmptyTokens,
+        SkipEmptyTokens
+    };
+
+    static constexpr auto DefaultTokenBehavior = TokenBehavior::KeepEmptyTokens;
+
+public:
+    constexpr StringTokenizer(std::string_view string, char separator,
+                              TokenBehavior behavior = DefaultTokenBehavior);
+
+    // Leaves token untouched and returns false once there are no tokens left
+    constexpr auto next(std::string_view& token) -> bool;
+
+    // Stores as many tokens as fit and returns the total number of tokens
+    static constexpr auto split(std::string_view string, char separator,
+                                std::span<std::string_view> tokens,
+                                TokenBehavior behavior = DefaultTokenBehavior) -> size_t;
+
+private:
+    std::string_view m_string;
+    size_t m_position = 0;
+
+    char m_separator;
+    TokenBehavior m_behavior;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+constexpr StringTokenizer::StringTokenizer(std::string_view string, char separator,
+                                           TokenBehavior behavior)
+    : m_string(string),
+      m_separator(separator),
+      m_behavior(behavior)
+{
+    // Like StaticString::getTokenCount(), an empty string has no tokens at all
+    if (m_string.empty())
+        m_position = 1;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+constexpr auto StringTokenizer::next(std::string_view& token) -> bool
+{
+    if (m_behavior == TokenBehavior::SkipEmptyTokens)
+    {
+        while (m_position < m_string.size() && m_string[m_position] == m_separator)
+            ++m_position;
+
+        if (m_position >= m_string.size())
+        {
+            m_position = m_string.size() + 1;
+            return false;
+        }
+    }
+
+    // One past the end marks that the last token has been consumed
+    if (m_position > m_string.size())
+        return false;
+
+    const size_t end = m_string.find(m_separator, m_position);
+
+    if (end == std::string_view::npos)
+    {
+        token = m_string.substr(m_position);
+        m_position = m_string.size() + 1;
+    }
+    else
+    {
+        token = m_string.substr(m_position, end - m_position);
+        m_position = end + 1;
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+constexpr auto StringTokenizer::split(std::string_view string, char separator,
+                                      std::span<std::string_view> tokens,
+                                      TokenBehavior behavior) -> size_t
+{
+    StringTokenizer tokenizer(string, separator, behavior);
+
+    std::string_view token;
+    size_t count = 0;
+
+    while (tokenizer.next(token))
+    {
+        if (count < tokens.size())
+            tokens[count] = token;
+
+        ++count;
+    }
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,88 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "averagingbuffer.h"
+#include "testing.h"
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testWindow()
+{
+    AveragingBuffer<double, 4> buffer;
+    CHECK(buffer.getValue() == 0.0);
+
+    // The window starts out with zeros
+    buffer.addSample(4.0);
+    CHECK(buffer.getValue() == 1.0);
+
+    buffer.addSample(8.0);
+    buffer.addSample(12.0);
+    buffer.addSample(16.0);
+    CHECK(buffer.getValue() == 10.0);
+
+    // Then the oldest sample is replaced
+    buffer.addSample(20.0);
+    CHECK(buffer.getValue() == 14.0);
+
+    for (int i = 0; i < 3; ++i)
+        buffer.addSample(-2.0);
+
+    CHECK(buffer.getValue() == 3.5);
+
+    buffer.clear();
+    CHECK(buffer.getValue() == 0.0);
+
+    buffer.addSample(8.0);
+    CHECK(buffer.getValue() == 2.0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testInteger()
+{
+    // The mean is rounded toward zero like any integer division
+    AveragingBuffer<int, 3> buffer;
+
+    buffer.addSample(1);
+    buffer.addSample(1);
+    CHECK(buffer.getValue() == 0);
+
+    buffer.addSample(2);
+    CHECK(buffer.getValue() == 1);
+
+    buffer.addSample(-10);
+    buffer.addSample(-10);
+    CHECK(buffer.getValue() == -6);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testWindow();
+    testInteger();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
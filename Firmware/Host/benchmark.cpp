@@ -0,0 +1,352 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "averagingbuffer.h"
+#include "benchmark.h"
+#include "commandparser.h"
+#include "defaultstring.h"
+#include "hostinterface.h"
+#include "numberparser.h"
+#include "potentiostat.h"
+#include "stringtokenizer.h"
+#include "wavegenerator.h"
+
+#include "usbd_cdc_if.h"
+
+#include <cstdio>
+#include <cstring>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace Benchmark;
+
+// ---------------------------------------------------------------------------------------------- //
+
+class HostInterfaceOwner : public HostInterface::Owner
+{
+public:
+    size_t lineCount = 0;
+
+private:
+    void onHostDataReceived(const String& data) override
+    {
+        sink = sink + data.size();
+        ++lineCount;
+    }
+
+    void onHostDataOverflow() override {}
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+class CommandParserOwner : public CommandParser::Owner
+{
+private:
+    void onCommandSetupSignal(Waveform waveform, unsigned int frequency, double amplitude) override
+    {
+        sink = sink + static_cast<int>(waveform) + frequency + amplitude;
+    }
+
+    void onCommandSetGain(Gain gain) override
+    {
+        sink = sink + static_cast<int>(gain);
+    }
+
+    void onCommandReset() override
+    {
+        sink = sink + 1.0;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkHostInterface()
+{
+    static constexpr const char* Line = "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;0\r\n";
+
+    HostInterfaceOwner owner;
+    HostInterface hostInterface(&owner);
+
+    std::array<uint8_t, 64> line = {};
+    const auto lineSize = static_cast<uint32_t>(std::strlen(Line));
+    std::copy_n(Line, lineSize, line.begin());
+
+    measure("HostInterface::update (receive line)", DefaultIterations, [&](size_t) {
+        CDC_Receive(line.data(), lineSize);
+        hostInterface.update();
+    });
+
+    std::array<String, HostInterface::MaximumStringSpanSize> samples;
+
+    for (auto& s : samples)
+        s.format("<S> %d;%d;%d", 2, -1234, 56789);
+
+    measure("HostInterface::sendData (sample block)", DefaultIterations, [&](size_t) {
+        hostInterface.sendData(samples);
+    });
+
+    sink = sink + owner.lineCount + CDC_GetTransmittedSize();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkPotentiostat()
+{
+    Potentiostat potentiostat;
+
+    auto receive = [](const char* line) {
+        CDC_Receive(reinterpret_cast<uint8_t*>(const_cast<char*>(line)), std::strlen(line));
+    };
+
+    measure("Potentiostat SET_CALIBRATION", DefaultIterations, [&](size_t) {
+        receive("<SET_CALIBRATION> 12;-34;5\r\n");
+        potentiostat.update();
+    });
+
+    // A valid setup would start a measurement, which waits for the output to settle and can't be
+    // stopped without the sample timer. The third vertex is out of range, so all values are parsed
+    // and the setup is rejected.
+    measure("Potentiostat START_MEASUREMENT (invalid)", DefaultIterations, [&](size_t) {
+        receive("<START_MEASUREMENT> 1;2;30;100;-500;500;-5000;0\r\n");
+        potentiostat.update();
+    });
+
+    measure("Potentiostat GET_POWER_VALUES", DefaultIterations, [&](size_t) {
+        receive("<GET_POWER_VALUES>\r\n");
+        potentiostat.update();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr char TokenSeparator = ' ';
+    constexpr char ValueSeparator = ';';
+
+    // Potentiostat::onHostDataReceived() and the command handlers before the switch to
+    // StringTokenizer and NumberParser. Returns the sum of the values, or -1 if invalid.
+    template <size_t ValueCount, size_t UnsignedCount>
+    auto parseWithString(const String& data, const char* expectedTag) -> long
+    {
+        const size_t tokenCount = data.getTokenCount(TokenSeparator);
+        const String tag = data.getToken(TokenSeparator, 0);
+
+        if (tokenCount < 2 || tag != expectedTag)
+            return -1;
+
+        const String values = data.getToken(TokenSeparator, 1);
+
+        if (values.getTokenCount(ValueSeparator) != ValueCount)
+            return -1;
+
+        std::array<String, ValueCount> valueTokens;
+        values.getAllTokens(ValueSeparator, valueTokens);
+
+        long sum = 0;
+
+        for (size_t i = 0; i < UnsignedCount; ++i)
+            sum += valueTokens[i].toUInt();
+
+        for (size_t i = UnsignedCount; i < ValueCount; ++i)
+            sum += valueTokens[i].toInt();
+
+        return sum;
+    }
+
+    // The same after the switch
+    template <size_t ValueCount, size_t UnsignedCount>
+    auto parseWithTokenizer(const String& data, const char* expectedTag) -> long
+    {
+        std::array<std::string_view, 2> tokens;
+        const size_t tokenCount = StringTokenizer::split(data, TokenSeparator, tokens);
+
+        if (tokenCount < 2 || tokens[0] != expectedTag)
+            return -1;
+
+        std::array<std::string_view, ValueCount> values;
+
+        if (StringTokenizer::split(tokens[1], ValueSeparator, values) != ValueCount)
+            return -1;
+
+        long sum = 0;
+
+        for (size_t i = 0; i < UnsignedCount; ++i)
+        {
+            unsigned int value = 0;
+
+            if (!NumberParser::parse(values[i], value))
+                return -1;
+
+            sum += value;
+        }
+
+        for (size_t i = UnsignedCount; i < ValueCount; ++i)
+        {
+            int value = 0;
+
+            if (!NumberParser::parse(values[i], value))
+                return -1;
+
+            sum += value;
+        }
+
+        return sum;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkStringParsing()
+{
+    // Type, gain and duration are unsigned, the rest signed
+    const String start = "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;0";
+    const String calibration = "<SET_CALIBRATION> 12;-34;5";
+
+    if (parseWithString<8, 3>(start, "<START_MEASUREMENT>") !=
+                parseWithTokenizer<8, 3>(start, "<START_MEASUREMENT>") ||
+            parseWithString<3, 0>(calibration, "<SET_CALIBRATION>") !=
+                parseWithTokenizer<3, 0>(calibration, "<SET_CALIBRATION>"))
+        std::printf("String and tokenizer parsing differ\n");
+
+    measure("String parse (START_MEASUREMENT)", DefaultIterations, [&](size_t) {
+        sink = sink + parseWithString<8, 3>(start, "<START_MEASUREMENT>");
+    });
+
+    measure("Tokenizer parse (START_MEASUREMENT)", DefaultIterations, [&](size_t) {
+        sink = sink + parseWithTokenizer<8, 3>(start, "<START_MEASUREMENT>");
+    });
+
+    measure("String parse (SET_CALIBRATION)", DefaultIterations, [&](size_t) {
+        sink = sink + parseWithString<3, 0>(calibration, "<SET_CALIBRATION>");
+    });
+
+    measure("Tokenizer parse (SET_CALIBRATION)", DefaultIterations, [&](size_t) {
+        sink = sink + parseWithTokenizer<3, 0>(calibration, "<SET_CALIBRATION>");
+    });
+
+    const String fixed = "-1234.567";
+
+    measure("String::toDouble (fixed-point value)", DefaultIterations, [&](size_t) {
+        sink = sink + fixed.toDouble();
+    });
+
+    measure("NumberParser::parseFixed<3>", DefaultIterations, [&](size_t) {
+        int value = 0;
+        NumberParser::parseFixed<3>(fixed, value);
+        sink = sink + value;
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkStringFormatting()
+{
+    String sample;
+
+    measure("String::format (sample)", DefaultIterations, [&](size_t i) {
+        sample.format("<S> %d;%d;%d", 2, static_cast<int>(i), -static_cast<int>(i));
+        sink = sink + sample.size();
+    });
+
+    measure("String::makeFormat (power values)", DefaultIterations, [&](size_t i) {
+        const String values = String::makeFormat("%f;%f;%f", 5.0 + i * 1e-6, 0.25, 31.5);
+        sink = sink + values.size();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkWaveGenerator()
+{
+    using Generator = WaveGenerator<float>;
+
+    static constexpr float TimeStep = 1e-5f;
+    static constexpr float Frequency = 1000.0f;
+
+    measure("WaveGenerator<float>::sine", DefaultIterations, [](size_t i) {
+        sink = sink + Generator::sine(i * TimeStep, Frequency);
+    });
+
+    measure("WaveGenerator<float>::qsine", DefaultIterations, [](size_t i) {
+        sink = sink + Generator::qsine(i * TimeStep, Frequency);
+    });
+
+    measure("WaveGenerator<float>::square", DefaultIterations, [](size_t i) {
+        sink = sink + Generator::square(i * TimeStep, Frequency);
+    });
+
+    measure("WaveGenerator<float>::triangle", DefaultIterations, [](size_t i) {
+        sink = sink + Generator::triangle(i * TimeStep, Frequency);
+    });
+
+    measure("WaveGenerator<float>::sawtooth", DefaultIterations, [](size_t i) {
+        sink = sink + Generator::sawtooth(i * TimeStep, Frequency);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkCommandParser()
+{
+    // Setup signal: sine, 100 Hz, amplitude 128 and set gain: 10k
+    static constexpr std::array<uint32_t, 2> Commands = {
+        (0x01u << 29) | (0x01u << 26) | (100u << 16) | 128u,
+        (0x02u << 29) | 0x02u
+    };
+
+    CommandParserOwner owner;
+    CommandParser parser(&owner);
+
+    measure("CommandParser::parse", DefaultIterations, [&](size_t i) {
+        parser.parse(Commands[i % Commands.size()]);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkAveragingBuffer()
+{
+    AveragingBuffer<double, 32> buffer;
+
+    measure("AveragingBuffer<double,32>", DefaultIterations, [&](size_t i) {
+        buffer.addSample(i * 0.5);
+        sink = sink + buffer.getValue();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    benchmarkHostInterface();
+    benchmarkPotentiostat();
+    benchmarkStringParsing();
+    benchmarkStringFormatting();
+    benchmarkWaveGenerator();
+    benchmarkCommandParser();
+    benchmarkAveragingBuffer();
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,54 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace Benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t DefaultIterations = 1000000;
+
+// Keeps the compiler from dropping the work being measured
+inline volatile double sink = 0.0;
+
+template <typename Function>
+void measure(const char* name, size_t iterations, Function function)
+{
+    // Warm up caches and branch predictors first
+    for (size_t i = 0; i < iterations / 10; ++i)
+        function(i);
+
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < iterations; ++i)
+        function(i);
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+    std::printf("%-40s %12.1f ns/op\n", name, elapsed.count() / iterations);
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,202 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "commandparser.h"
+#include "testing.h"
+
+#include <optional>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    struct Signal
+    {
+        Waveform waveform;
+        unsigned int frequency;
+        double amplitude;
+    };
+
+    class Owner : public CommandParser::Owner
+    {
+    public:
+        std::optional<Signal> signal;
+        std::optional<Gain> gain;
+        int resetCount = 0;
+
+        auto callCount() const -> int
+        {
+            return (signal ? 1 : 0) + (gain ? 1 : 0) + resetCount;
+        }
+
+    private:
+        void onCommandSetupSignal(Waveform waveform, unsigned int frequency,
+                                  double amplitude) override
+        {
+            signal = Signal{ waveform, frequency, amplitude };
+        }
+
+        void onCommandSetGain(Gain gain) override
+        {
+            this->gain = gain;
+        }
+
+        void onCommandReset() override
+        {
+            ++resetCount;
+        }
+    };
+
+    // The command in the top three bits, then the waveform, the frequency and the amplitude
+    auto setupSignal(uint32_t waveform, uint32_t frequency, uint32_t amplitude) -> uint32_t
+    {
+        return (1u << 29) | (waveform << 26) | (frequency << 16) | amplitude;
+    }
+
+    auto setGain(uint32_t gain) -> uint32_t
+    {
+        return (2u << 29) | gain;
+    }
+
+    constexpr uint32_t Reset = 7u << 29;
+
+    // Returns true if the command was ignored
+    auto isRejected(uint32_t command) -> bool
+    {
+        Owner owner;
+        CommandParser parser(&owner);
+
+        parser.parse(command);
+        return owner.callCount() == 0;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSetupSignal()
+{
+    Owner owner;
+    CommandParser parser(&owner);
+
+    parser.parse(setupSignal(1, 100, 50));
+
+    if (!CHECK(owner.signal.has_value()))
+        return;
+
+    CHECK(owner.signal->waveform == Waveform::Sine);
+    CHECK(owner.signal->frequency == 100);
+    CHECK_NEAR(owner.signal->amplitude, 0.5, 1e-12);
+
+    // The limits are accepted
+    parser.parse(setupSignal(4, 1000, 150));
+    CHECK(owner.signal->waveform == Waveform::Sawtooth);
+    CHECK(owner.signal->frequency == 1000);
+    CHECK_NEAR(owner.signal->amplitude, 1.5, 1e-12);
+
+    parser.parse(setupSignal(0, 1, 0));
+    CHECK(owner.signal->waveform == Waveform::None);
+    CHECK(owner.signal->frequency == 1);
+    CHECK(owner.signal->amplitude == 0.0);
+
+    CHECK(owner.callCount() == 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSetupSignalRejected()
+{
+    // Unknown waveforms
+    CHECK(isRejected(setupSignal(5, 100, 50)));
+    CHECK(isRejected(setupSignal(7, 100, 50)));
+
+    // Frequencies outside of 1 to 1000 Hz
+    CHECK(isRejected(setupSignal(1, 0, 50)));
+    CHECK(isRejected(setupSignal(1, 1001, 50)));
+    CHECK(isRejected(setupSignal(1, 1023, 50)));
+
+    // Amplitudes above 1.5 V
+    CHECK(isRejected(setupSignal(1, 100, 151)));
+    CHECK(isRejected(setupSignal(1, 100, 255)));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSetGain()
+{
+    Owner owner;
+    CommandParser parser(&owner);
+
+    parser.parse(setGain(0));
+    CHECK(owner.gain == Gain::_100);
+
+    parser.parse(setGain(3));
+    CHECK(owner.gain == Gain::_100k);
+
+    // Only the lowest two bits hold the gain
+    parser.parse(setGain(0xfffc | 2));
+    CHECK(owner.gain == Gain::_10k);
+
+    CHECK(!owner.signal.has_value());
+    CHECK(owner.resetCount == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testReset()
+{
+    Owner owner;
+    CommandParser parser(&owner);
+
+    parser.parse(Reset);
+    parser.parse(Reset | 0x1234);
+    CHECK(owner.resetCount == 2);
+    CHECK(owner.callCount() == 2);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUnknownCommands()
+{
+    CHECK(isRejected(0));
+    CHECK(isRejected(0x00ffffff));
+
+    for (uint32_t command = 3; command < 7; ++command)
+    {
+        if (!CHECK(isRejected((command << 29) | 0x1)))
+            return;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testSetupSignal();
+    testSetupSignalRejected();
+    testSetGain();
+    testReset();
+    testUnknownCommands();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
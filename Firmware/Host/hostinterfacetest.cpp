@@ -0,0 +1,157 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "hostinterface.h"
+#include "testing.h"
+
+#include "usbd_cdc_if.h"
+
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    class Owner : public HostInterface::Owner
+    {
+    public:
+        std::vector<std::string> lines;
+        size_t overflowCount = 0;
+
+    private:
+        void onHostDataReceived(const String& data) override
+        {
+            lines.emplace_back(std::string_view(data));
+        }
+
+        void onHostDataOverflow() override
+        {
+            ++overflowCount;
+        }
+    };
+
+    void receive(std::string data)
+    {
+        CDC_Receive(reinterpret_cast<uint8_t*>(data.data()), data.size());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testLines()
+{
+    Owner owner;
+    HostInterface hostInterface(&owner);
+
+    // Nothing is delivered before update()
+    receive("<GET_POWER_VALUES>\r\n");
+    CHECK(owner.lines.empty());
+
+    hostInterface.update();
+    CHECK(owner.lines == std::vector<std::string>{ "<GET_POWER_VALUES>" });
+
+    // Lines may be split across and share transfers, including the terminator
+    receive("<SET_GAIN>");
+    receive(" 2\r");
+    hostInterface.update();
+    CHECK(owner.lines.size() == 1);
+
+    receive("\n<STOP_MEASUREMENT>\r\n<SET_GAIN> 1\r\n");
+    hostInterface.update();
+    CHECK((owner.lines == std::vector<std::string>{
+        "<GET_POWER_VALUES>", "<SET_GAIN> 2", "<STOP_MEASUREMENT>", "<SET_GAIN> 1" }));
+
+    // A lone newline doesn't end a line
+    owner.lines.clear();
+    receive("<A>\n<B>\r\n");
+    hostInterface.update();
+    CHECK(owner.lines == std::vector<std::string>{ "<A>\n<B>" });
+
+    // Empty lines are delivered as well
+    owner.lines.clear();
+    receive("\r\n");
+    hostInterface.update();
+    CHECK(owner.lines == std::vector<std::string>{ "" });
+
+    CHECK(owner.overflowCount == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testOverflow()
+{
+    Owner owner;
+    HostInterface hostInterface(&owner);
+
+    const std::string line = std::string(98, 'x') + "\r\n";
+
+    // Two lines fit, the third is dropped as a whole
+    receive(line);
+    receive(line);
+    receive(line);
+    hostInterface.update();
+
+    CHECK(owner.lines.size() == 2);
+    CHECK(owner.overflowCount == 1);
+
+    // The buffer is empty again after update()
+    receive(line);
+    receive(line);
+    hostInterface.update();
+
+    CHECK(owner.lines.size() == 4);
+    CHECK(owner.overflowCount == 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSendData()
+{
+    Owner owner;
+    HostInterface hostInterface(&owner);
+
+    CDC_SetCaptureEnabled(true);
+
+    CHECK(hostInterface.sendData("<GAIN_SET>"));
+    CHECK(CDC_TakeTransmittedData() == "<GAIN_SET>\r\n");
+
+    const std::array<String, 3> samples = { "<S> 0;1;2", "<S> 0;3;4", "<S> 0;5;6" };
+
+    CHECK(hostInterface.sendData(samples));
+    CHECK(CDC_TakeTransmittedData() == "<S> 0;1;2\r\n<S> 0;3;4\r\n<S> 0;5;6\r\n");
+
+    CDC_SetCaptureEnabled(false);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testLines();
+    testOverflow();
+    testSendData();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,159 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "defaultstring.h"
+#include "numberparser.h"
+#include "testing.h"
+
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    struct Case
+    {
+        const char* text;
+        bool valid;
+        int value;
+    };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testInt()
+{
+    static constexpr std::array<Case, 15> Cases = {{
+        { "0", true, 0 },
+        { "-0", true, 0 },
+        { "+17", true, 17 },
+        { "007", true, 7 },
+        { "010", true, 10 },
+        { "2147483647", true, 2147483647 },
+        { "-2147483648", true, -2147483647 - 1 },
+        { "2147483648", false, 0 },
+        { "-2147483649", false, 0 },
+        { "99999999999", false, 0 },
+        { "", false, 0 },
+        { "-", false, 0 },
+        { " 1", false, 0 },
+        { "12a", false, 0 },
+        { "0x10", false, 0 }
+    }};
+
+    for (const auto& c : Cases)
+    {
+        int value = 0;
+        const bool valid = NumberParser::parse(std::string_view(c.text), value);
+
+        if (!CHECK(valid == c.valid && (!valid || value == c.value)))
+            std::cerr << "  for \"" << c.text << "\"" << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUnsigned()
+{
+    uint8_t byte = 0;
+    CHECK(NumberParser::parse(std::string_view("255"), byte) && byte == 255);
+    CHECK(!NumberParser::parse(std::string_view("256"), byte));
+
+    unsigned int value = 0;
+    CHECK(NumberParser::parse(std::string_view("4294967295"), value) && value == 4294967295u);
+    CHECK(!NumberParser::parse(std::string_view("4294967296"), value));
+    CHECK(!NumberParser::parse(std::string_view("-1"), value));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testFixed()
+{
+    static constexpr std::array<Case, 13> Cases = {{
+        { "-1.25", true, -1250 },
+        { "1.2345", true, 1234 },
+        { "-1.2349", true, -1234 },
+        { ".5", true, 500 },
+        { "7.", true, 7000 },
+        { "42", true, 42000 },
+        { "2147483.647", true, 2147483647 },
+        { "-2147483.648", true, -2147483647 - 1 },
+        { "2147483.648", false, 0 },
+        { ".", false, 0 },
+        { "-", false, 0 },
+        { "1.2.3", false, 0 },
+        { "1.5e3", false, 0 }
+    }};
+
+    for (const auto& c : Cases)
+    {
+        int value = 0;
+        const bool valid = NumberParser::parseFixed<3>(std::string_view(c.text), value);
+
+        if (!CHECK(valid == c.valid && (!valid || value == c.value)))
+            std::cerr << "  for \"" << c.text << "\"" << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Random integers, compared against strtol() and strtoul() where both accept the input. They
+// don't for leading zeros, which strtol() takes as an octal prefix.
+static void testStaticStringEquivalence()
+{
+    static constexpr size_t NumberCount = 100000;
+
+    std::minstd_rand random;
+
+    for (size_t i = 0; i < NumberCount; ++i)
+    {
+        const auto number = static_cast<int32_t>(random() ^ (random() << 16));
+        const String text = String::makeFormat(i % 2 ? "%d" : "%+d", number);
+
+        int value = 0;
+
+        if (!CHECK(NumberParser::parse(std::string_view(text), value) && value == text.toInt()))
+            return;
+
+        const String positive = String::makeFormat("%u", static_cast<uint32_t>(number));
+
+        unsigned int unsignedValue = 0;
+
+        if (!CHECK(NumberParser::parse(std::string_view(positive), unsignedValue) &&
+                   unsignedValue == positive.toUInt()))
+            return;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testInt();
+    testUnsigned();
+    testFixed();
+    testStaticStringEquivalence();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
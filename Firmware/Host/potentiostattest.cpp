@@ -0,0 +1,173 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "potentiostat.h"
+#include "testing.h"
+
+#include "usbd_cdc_if.h"
+
+#include <string>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Sends a line to the board, runs the main loop once and returns what the board sent back
+    auto request(Potentiostat* potentiostat, std::string line) -> std::string
+    {
+        line += "\r\n";
+
+        CDC_Receive(reinterpret_cast<uint8_t*>(line.data()), line.size());
+        potentiostat->update();
+
+        return CDC_TakeTransmittedData();
+    }
+
+    auto error(const std::string& error) -> std::string
+    {
+        return "<ERROR> " + error + "\r\n";
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDispatch(Potentiostat* potentiostat)
+{
+    CHECK(request(potentiostat, "").empty());
+    CHECK(request(potentiostat, "<GET_VALUES>") == error("UNKNOWN_COMMAND"));
+    CHECK(request(potentiostat, "GET_POWER_VALUES") == error("UNKNOWN_COMMAND"));
+
+    CHECK(request(potentiostat, "<GET_POWER_VALUES>").starts_with("<P> "));
+
+    // Arguments beyond the ones a command takes are ignored
+    CHECK(request(potentiostat, "<GET_POWER_VALUES> 1 2").starts_with("<P> "));
+
+    // More data than the receive buffer holds, the transfer that doesn't fit is dropped
+    std::string data(HostInterface::ReceiveBufferSize / 2 + 1, 'x');
+    CDC_Receive(reinterpret_cast<uint8_t*>(data.data()), data.size());
+    CDC_Receive(reinterpret_cast<uint8_t*>(data.data()), data.size());
+
+    CHECK(request(potentiostat, "") == error("UNKNOWN_COMMAND") + error("DATA_OVERFLOW"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSetCalibration(Potentiostat* potentiostat)
+{
+    // There is no response on success
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 12;-34;5").empty());
+    CHECK(request(potentiostat, "<SET_CALIBRATION> -8192;8192;+100").empty());
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;0;0 1").empty());
+
+    CHECK(request(potentiostat, "<SET_CALIBRATION>") == error("MISSING_ARGUMENT"));
+
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 1;2") == error("INVALID_LENGTH"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 1;2;3;4") == error("INVALID_LENGTH"));
+
+    // Out of range
+    CHECK(request(potentiostat, "<SET_CALIBRATION> -8193;0;0") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;0;101") == error("INVALID_ARGUMENT"));
+
+    // Used to be read as zero or as the leading digits
+    CHECK(request(potentiostat, "<SET_CALIBRATION> x;0;0") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;;0") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;0;12a") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;0x10;0") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_CALIBRATION> 0;1.5;0") == error("INVALID_ARGUMENT"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSetGain(Potentiostat* potentiostat)
+{
+    CHECK(request(potentiostat, "<SET_GAIN> 0") == "<GAIN_SET>\r\n");
+    CHECK(request(potentiostat, "<SET_GAIN> 3") == "<GAIN_SET>\r\n");
+    CHECK(request(potentiostat, "<SET_GAIN> 2 1") == "<GAIN_SET>\r\n");
+
+    CHECK(request(potentiostat, "<SET_GAIN>") == error("MISSING_ARGUMENT"));
+
+    CHECK(request(potentiostat, "<SET_GAIN> 4") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_GAIN> -1") == error("INVALID_ARGUMENT"));
+
+    // Used to set the lowest gain
+    CHECK(request(potentiostat, "<SET_GAIN> high") == error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<SET_GAIN> ") == error("INVALID_ARGUMENT"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testStartMeasurement(Potentiostat* potentiostat)
+{
+    CHECK(request(potentiostat, "<START_MEASUREMENT>") == error("MISSING_ARGUMENT"));
+
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-500") ==
+          error("INVALID_LENGTH"));
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;1;0") ==
+          error("INVALID_LENGTH"));
+
+    // Out of range
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;0;100;-500;500;-500;1") ==
+          error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-5000;1") ==
+          error("INVALID_ARGUMENT"));
+
+    // Used to be read as zero or as the leading digits
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;x") ==
+          error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<START_MEASUREMENT> -1;2;30;100;-500;500;-500;1") ==
+          error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30s;100;-500;500;-500;1") ==
+          error("INVALID_ARGUMENT"));
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;;500;-500;1") ==
+          error("INVALID_ARGUMENT"));
+
+    CHECK(HAL_GPIO_ReadPin(OUTPUT_ENABLE_GPIO_Port, OUTPUT_ENABLE_Pin) == GPIO_PIN_SET);
+
+    // Stopping needs the sample timer, so this comes last
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;1 2") ==
+          "<MEASUREMENT_STARTED>\r\n");
+    CHECK(HAL_GPIO_ReadPin(OUTPUT_ENABLE_GPIO_Port, OUTPUT_ENABLE_Pin) == GPIO_PIN_RESET);
+
+    CHECK(request(potentiostat, "<START_MEASUREMENT> 1;2;30;100;-500;500;-500;1") ==
+          error("DEVICE_BUSY"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    CDC_SetCaptureEnabled(true);
+
+    // The board exists only once
+    Potentiostat potentiostat;
+
+    HAL_GPIO_WritePin(OUTPUT_ENABLE_GPIO_Port, OUTPUT_ENABLE_Pin, GPIO_PIN_SET); // Active low
+
+    testDispatch(&potentiostat);
+    testSetCalibration(&potentiostat);
+    testSetGain(&potentiostat);
+    testStartMeasurement(&potentiostat);
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
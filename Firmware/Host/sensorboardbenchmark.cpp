@@ -0,0 +1,130 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "benchmark.h"
+#include "config.h"
+#include "sensorboard.h"
+
+#include "usbd_cdc_if.h"
+
+#include <cstring>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace Benchmark;
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void benchmarkSensorBoard()
+{
+    SensorBoard sensorBoard;
+
+    auto receive = [](const char* line) {
+        CDC_Receive(reinterpret_cast<uint8_t*>(const_cast<char*>(line)), std::strlen(line));
+    };
+
+    measure("SensorBoard GET_SENSOR_VALUE", DefaultIterations, [&](size_t) {
+        receive("<GET_SENSOR_VALUE> 1\r\n");
+        sensorBoard.update();
+    });
+
+    measure("SensorBoard GET_SENSOR_VALUE @id", DefaultIterations, [&](size_t) {
+        receive("<GET_SENSOR_VALUE> 1 @42\r\n");
+        sensorBoard.update();
+    });
+
+    measure("SensorBoard GET_ALL_VALUES @id", DefaultIterations, [&](size_t) {
+        receive("<GET_ALL_VALUES> @42\r\n");
+        sensorBoard.update();
+    });
+
+    measure("SensorBoard SUBSCRIBE", DefaultIterations, [&](size_t) {
+        receive("<SUBSCRIBE> 1000\r\n");
+        sensorBoard.update();
+    });
+
+    sink = sink + CDC_GetTransmittedSize();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Serial traffic per set of values, when the host polls and when the board pushes
+static void measureTraffic()
+{
+    static constexpr size_t UpdateCount = 1000;
+    static constexpr const char* Request = "<GET_ALL_VALUES> @42\r\n";
+
+    SensorBoard sensorBoard;
+
+    auto receive = [](const char* line) {
+        CDC_Receive(reinterpret_cast<uint8_t*>(const_cast<char*>(line)), std::strlen(line));
+    };
+
+    auto elapse = [&] {
+        HAL_TIM_PeriodElapsedCallback(Config::UpdateTimerHandle);
+        sensorBoard.update();
+    };
+
+    uint64_t transmitted = CDC_GetTransmittedSize();
+
+    for (size_t i = 0; i < UpdateCount; ++i)
+    {
+        receive(Request);
+        sensorBoard.update();
+        elapse();
+    }
+
+    const double pollReceived = std::strlen(Request);
+    const double pollSent = double(CDC_GetTransmittedSize() - transmitted) / UpdateCount;
+
+    // One value set per update period
+    receive("<SUBSCRIBE> 100\r\n");
+    sensorBoard.update();
+
+    transmitted = CDC_GetTransmittedSize();
+
+    for (size_t i = 0; i < UpdateCount; ++i)
+        elapse();
+
+    const double pushSent = double(CDC_GetTransmittedSize() - transmitted) / UpdateCount;
+
+    receive("<UNSUBSCRIBE>\r\n");
+    sensorBoard.update();
+
+    std::printf("%-40s %6.1f B to board, %6.1f B to host\n",
+                "Traffic per value set (polling)", pollReceived, pollSent);
+    std::printf("%-40s %6.1f B to board, %6.1f B to host\n",
+                "Traffic per value set (subscription)", 0.0, pushSent);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    benchmarkSensorBoard();
+    measureTraffic();
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,190 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "sensorboard.h"
+#include "testing.h"
+
+#include "config.h"
+#include "usbd_cdc_if.h"
+
+#include <string>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Sends a line to the board, runs the main loop once and returns what the board sent back
+    auto request(SensorBoard* sensorBoard, std::string line) -> std::string
+    {
+        line += "\r\n";
+
+        CDC_Receive(reinterpret_cast<uint8_t*>(line.data()), line.size());
+        sensorBoard->update();
+
+        return CDC_TakeTransmittedData();
+    }
+
+    // Lets one update period pass and returns what the board pushed
+    auto elapse(SensorBoard* sensorBoard) -> std::string
+    {
+        HAL_TIM_PeriodElapsedCallback(Config::UpdateTimerHandle);
+        sensorBoard->update();
+
+        return CDC_TakeTransmittedData();
+    }
+
+    auto error(const std::string& error, const std::string& id = {}) -> std::string
+    {
+        return "<ERROR> " + error + (id.empty() ? "" : " " + id) + "\r\n";
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBoardInfo(SensorBoard* sensorBoard)
+{
+    CHECK(request(sensorBoard, "").empty());
+    CHECK(request(sensorBoard, "<GET_NAME>") == error("UNKNOWN_COMMAND"));
+
+    CHECK(request(sensorBoard, "<GET_BOARD_NAME>") == "<BOARD_NAME> I2CCarrier\r\n");
+    CHECK(request(sensorBoard, "<GET_HARDWARE_VERSION>") == "<HARDWARE_VERSION> 1.0\r\n");
+    CHECK(request(sensorBoard, "<GET_FIRMWARE_VERSION>") == "<FIRMWARE_VERSION> 1.3\r\n");
+    CHECK(request(sensorBoard, "<GET_SERIAL_NUMBER>") == "<SERIAL_NUMBER> TEST\r\n");
+    CHECK(request(sensorBoard, "<GET_BUILD_TIMESTAMP>") == "<BUILD_TIMESTAMP> 1700000000\r\n");
+
+    // Arguments beyond the ones a command takes are ignored
+    CHECK(request(sensorBoard, "<GET_BOARD_NAME> 1 2 3") == "<BOARD_NAME> I2CCarrier\r\n");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSensors(SensorBoard* sensorBoard)
+{
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 0") == "<SENSOR_TYPE> Temperature\r\n");
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 1") == "<SENSOR_TYPE> None\r\n");
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 1 0") == "<SENSOR_TYPE> None\r\n");
+
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE> 1") == "<SENSOR_VALUE> 0.000000\r\n");
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE> 0").starts_with("<SENSOR_VALUE> "));
+
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE>") == error("MISSING_ARGUMENT"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE>") == error("MISSING_ARGUMENT"));
+
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 2") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE> 256") == error("INVALID_ARGUMENT"));
+
+    // Used to select the first sensor
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> x") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> -1") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE> 1a") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_VALUE> ") == error("INVALID_ARGUMENT"));
+
+    CHECK(request(sensorBoard, "<GET_POWER_VALUES>").starts_with("<POWER_VALUES> "));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRequestId(SensorBoard* sensorBoard)
+{
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 1 @7") == "<SENSOR_TYPE> None @7\r\n");
+    CHECK(request(sensorBoard, "<GET_BOARD_NAME> @a") == "<BOARD_NAME> I2CCarrier @a\r\n");
+
+    // The ID is the last token, no matter how many come before it
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 1 2 3 @7") == "<SENSOR_TYPE> None @7\r\n");
+
+    // It doesn't count as an argument
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> @7") == error("MISSING_ARGUMENT", "@7"));
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> x @7") == error("INVALID_ARGUMENT", "@7"));
+
+    // Only on the request it came with
+    CHECK(request(sensorBoard, "<GET_SENSOR_TYPE> 1") == "<SENSOR_TYPE> None\r\n");
+
+    const std::string values = request(sensorBoard, "<GET_ALL_VALUES> @9");
+
+    CHECK(values.starts_with("<SENSOR_DATA> 0;Temperature;"));
+    CHECK(values.find("\r\n<SENSOR_DATA> 1;None;0.000000 @9\r\n<POWER_VALUES> ") !=
+          std::string::npos);
+    CHECK(values.ends_with(" @9\r\n"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSubscription(SensorBoard* sensorBoard)
+{
+    CHECK(elapse(sensorBoard).empty());
+
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 100") == "<SUBSCRIBED> 100\r\n");
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 60000") == "<SUBSCRIBED> 60000\r\n");
+
+    // Rounded to whole update periods
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 249") == "<SUBSCRIBED> 200\r\n");
+
+    // Values are pushed on the next update, then every other one
+    CHECK(elapse(sensorBoard).starts_with("<SENSOR_DATA> 0;Temperature;"));
+    CHECK(elapse(sensorBoard).empty());
+    CHECK(elapse(sensorBoard).starts_with("<SENSOR_DATA> 0;Temperature;"));
+
+    CHECK(request(sensorBoard, "<UNSUBSCRIBE>") == "<UNSUBSCRIBED>\r\n");
+    CHECK(elapse(sensorBoard).empty());
+    CHECK(elapse(sensorBoard).empty());
+
+    // A disconnect ends the subscription
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 100") == "<SUBSCRIBED> 100\r\n");
+    CDC_Disconnect();
+    CHECK(elapse(sensorBoard).empty());
+
+    CHECK(request(sensorBoard, "<SUBSCRIBE>") == error("MISSING_ARGUMENT"));
+
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 99") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 60001") == error("INVALID_ARGUMENT"));
+
+    // Used to be read as zero or as the leading digits
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 1000ms") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<SUBSCRIBE> 1e3") == error("INVALID_ARGUMENT"));
+    CHECK(request(sensorBoard, "<SUBSCRIBE> -1000") == error("INVALID_ARGUMENT"));
+
+    // None of the rejected requests changed the subscription
+    CHECK(elapse(sensorBoard).empty());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    CDC_SetCaptureEnabled(true);
+
+    // The first sensor is a temperature sensor, the second is missing
+    HAL_GPIO_WritePin(ID1_0_GPIO_Port, ID1_0_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(ID1_1_GPIO_Port, ID1_1_Pin, GPIO_PIN_SET);
+
+    // The board exists only once
+    SensorBoard sensorBoard;
+
+    testBoardInfo(&sensorBoard);
+    testSensors(&sensorBoard);
+    testRequestId(&sensorBoard);
+    testSubscription(&sensorBoard);
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,141 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "staticstring.h"
+#include "testing.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    using String8 = StaticString<8>;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCapacity()
+{
+    const String8 empty;
+    CHECK(empty.empty());
+    CHECK(empty.capacity() == 8);
+    CHECK(empty == "");
+
+    String8 string("abc");
+    CHECK(string.size() == 3);
+    CHECK(string == "abc");
+    CHECK(string.c_str()[3] == '\0');
+
+    string += "defg";
+    string += 'h';
+    CHECK(string.size() == String8::Capacity);
+    CHECK(string == "abcdefgh");
+    CHECK(std::string_view(string) == "abcdefgh");
+
+    string.pop_back();
+    string.trim(2);
+    CHECK(string == "abcde");
+    CHECK(string.trimmed(2) == "abc");
+    CHECK(string.trim(10).empty());
+
+    string.push_back('x');
+    CHECK(string == "x");
+    CHECK(string + 'y' == "xy");
+    CHECK("w" + string == "wx");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTruncation()
+{
+    // Everything beyond the capacity is cut off and the string stays terminated
+    const String8 string("0123456789");
+    CHECK(string.size() == 8);
+    CHECK(string == "01234567");
+    CHECK(string.c_str()[8] == '\0');
+
+    const String8 view(std::string_view("abcdefghijkl"));
+    CHECK(view == "abcdefgh");
+
+    const String8 range("0123456789", 2, 20);
+    CHECK(range == "23456789");
+
+    const String8 inner("0123456789", 2, 5);
+    CHECK(inner == "234");
+
+    // Formatting is cut off as well, within the capacity
+    String8 formatted;
+    formatted.format("%d;%d;%d", 1000, 2000, 3000);
+    CHECK(formatted.size() <= String8::Capacity);
+    CHECK(std::string("1000;2000;3000").starts_with(std::string_view(formatted)));
+    CHECK(formatted.c_str()[formatted.size()] == '\0');
+
+    const String8 made = String8::makeFormat("%s", "abcdefghijkl");
+    CHECK(made.size() <= String8::Capacity);
+    CHECK(std::string("abcdefghijkl").starts_with(std::string_view(made)));
+
+    CHECK(String8::makeFormat("%d", 42) == "42");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTokens()
+{
+    using String32 = StaticString<32>;
+    constexpr auto SkipEmptyTokens = String32::TokenBehavior::SkipEmptyTokens;
+
+    const String32 string("<A>;1;;-2.5");
+
+    CHECK(string.getTokenCount(';') == 4);
+    CHECK(string.getTokenCount(';', SkipEmptyTokens) == 3);
+
+    CHECK(string.getToken(';', 0) == "<A>");
+    CHECK(string.getToken(';', 2) == "");
+    CHECK(string.getToken(';', 2, SkipEmptyTokens) == "-2.5");
+    CHECK(string.getTokens(';', 1, 2) == "1;");
+
+    std::array<String32, 4> tokens;
+    CHECK(string.getAllTokens(';', tokens) == 4);
+    CHECK(tokens[1].toInt() == 1);
+    CHECK(tokens[2].empty());
+    CHECK(tokens[3].toDouble() == -2.5);
+
+    CHECK(string.endsWith("2.5"));
+    CHECK(string.endsWith('5'));
+    CHECK(!string.endsWith(""));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testCapacity();
+    testTruncation();
+    testTokens();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
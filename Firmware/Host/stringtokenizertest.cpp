@@ -0,0 +1,133 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "defaultstring.h"
+#include "stringtokenizer.h"
+#include "testing.h"
+
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using TokenBehavior = StringTokenizer::TokenBehavior;
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSplit()
+{
+    std::array<std::string_view, 3> tokens;
+
+    CHECK(StringTokenizer::split("1;-2;3", ';', tokens) == 3);
+    CHECK(tokens[0] == "1" && tokens[1] == "-2" && tokens[2] == "3");
+
+    // Reports all tokens, but stores only the ones that fit
+    tokens = {};
+    CHECK(StringTokenizer::split("a;b;c;d", ';', tokens) == 4);
+    CHECK(tokens[0] == "a" && tokens[1] == "b" && tokens[2] == "c");
+
+    tokens = {};
+    CHECK(StringTokenizer::split(";a;;", ';', tokens) == 4);
+    CHECK(tokens[0].empty() && tokens[1] == "a" && tokens[2].empty());
+
+    tokens = {};
+    CHECK(StringTokenizer::split(";a;;b", ';', tokens, TokenBehavior::SkipEmptyTokens) == 2);
+    CHECK(tokens[0] == "a" && tokens[1] == "b");
+
+    CHECK(StringTokenizer::split("", ';', tokens) == 0);
+    CHECK(StringTokenizer::split(";;", ';', tokens, TokenBehavior::SkipEmptyTokens) == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testNext()
+{
+    StringTokenizer tokenizer("<SET_GAIN> 2", ' ');
+    std::string_view token = "unchanged";
+
+    CHECK(tokenizer.next(token) && token == "<SET_GAIN>");
+    CHECK(tokenizer.next(token) && token == "2");
+
+    // The last token stays available
+    CHECK(!tokenizer.next(token));
+    CHECK(token == "2");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Random lines, compared against the StaticString implementation it replaces
+static void testStaticStringEquivalence()
+{
+    static constexpr size_t LineCount = 100000;
+    static constexpr size_t MaximumTokenCount = String::Capacity + 1;
+
+    static constexpr std::array<char, 6> Alphabet = { 'a', '1', '-', ';', ' ', 'x' };
+
+    std::minstd_rand random;
+
+    for (size_t i = 0; i < LineCount; ++i)
+    {
+        String line;
+        const size_t size = random() % (String::Capacity + 1);
+
+        for (size_t j = 0; j < size; ++j)
+            line += Alphabet[random() % Alphabet.size()];
+
+        for (auto behavior : { TokenBehavior::KeepEmptyTokens, TokenBehavior::SkipEmptyTokens })
+        {
+            const auto stringBehavior = static_cast<String::TokenBehavior>(behavior);
+
+            std::array<std::string_view, MaximumTokenCount> views;
+            std::array<String, MaximumTokenCount> strings;
+
+            const size_t count = StringTokenizer::split(line, ';', views, behavior);
+            const size_t stringCount = line.getAllTokens(';', strings, stringBehavior);
+
+            if (!CHECK(count == line.getTokenCount(';', stringBehavior)))
+                return;
+
+            // getAllTokens() reports a single token for an empty string, unlike getTokenCount()
+            if (!CHECK(count == stringCount || line.empty()))
+                return;
+
+            for (size_t j = 0; j < std::min(count, stringCount); ++j)
+            {
+                if (!CHECK(views[j] == std::string_view(strings[j])) ||
+                    !CHECK(views[j] == std::string_view(line.getToken(';', j, stringBehavior))))
+                    return;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testSplit();
+    testNext();
+    testStaticStringEquivalence();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
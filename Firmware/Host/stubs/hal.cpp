@@ -0,0 +1,336 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "main.h"
+#include "usbd_cdc_if.h"
+#include "usbd_desc.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------- //
+
+GPIO_TypeDef GPIOA_Registers;
+GPIO_TypeDef GPIOB_Registers;
+GPIO_TypeDef GPIOC_Registers;
+
+// The handles of all boards, each of them declares the ones it uses in its config.h
+ADC_HandleTypeDef hadc1;
+ADC_HandleTypeDef hadc2;
+
+DAC_HandleTypeDef hdac1;
+DMA_HandleTypeDef hdma_spi2_rx;
+
+I2C_HandleTypeDef hi2c1;
+I2C_HandleTypeDef hi2c3;
+
+OPAMP_HandleTypeDef hopamp1;
+OPAMP_HandleTypeDef hopamp2;
+
+TIM_HandleTypeDef htim1;
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim6;
+TIM_HandleTypeDef htim15;
+TIM_HandleTypeDef htim16;
+
+namespace {
+    // Receive data is always available, so that reads don't wait
+    SPI_TypeDef SPI1_Registers = { .CR1 = 0, .SR = SPI_FLAG_RXNE, .DR = 0 };
+    SPI_TypeDef SPI2_Registers = { .CR1 = 0, .SR = SPI_FLAG_RXNE, .DR = 0 };
+}
+
+SPI_HandleTypeDef hspi1 = { .Instance = &SPI1_Registers };
+SPI_HandleTypeDef hspi2 = { .Instance = &SPI2_Registers };
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point StartTime = Clock::now();
+
+    CDC_ReceiveCallback receiveCallback = nullptr;
+    CDC_TxCompleteCallback txCompleteCallback = nullptr;
+    CDC_DisconnectCallback disconnectCallback = nullptr;
+
+    uint64_t transmittedSize = 0;
+
+    bool captureEnabled = false;
+    std::string transmittedData;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET)
+        port->ODR |= pin;
+    else
+        port->ODR &= ~pin;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin) -> GPIO_PinState
+{
+    return (port->ODR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void HAL_NVIC_EnableIRQ(IRQn_Type) {}
+void HAL_NVIC_DisableIRQ(IRQn_Type) {}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_TIM_Base_Start(TIM_HandleTypeDef*) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* handle) -> HAL_StatusTypeDef
+{
+    handle->State = HAL_TIM_STATE_BUSY;
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* handle) -> HAL_StatusTypeDef
+{
+    handle->State = HAL_TIM_STATE_READY;
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_TIM_GetCounter(TIM_HandleTypeDef*) -> uint32_t
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                               StartTime);
+    // The delay timer is a 16-bit counter
+    return static_cast<uint32_t>(elapsed.count()) & 0xffff;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_GetTick() -> uint32_t
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                                               StartTime);
+    return static_cast<uint32_t>(elapsed.count());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void HAL_Delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef*, uint32_t) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADC_Start(ADC_HandleTypeDef*) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADC_Start_DMA(ADC_HandleTypeDef*, uint32_t*, uint32_t) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADC_Stop(ADC_HandleTypeDef*) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADC_PollForConversion(ADC_HandleTypeDef*, uint32_t) -> HAL_StatusTypeDef
+{
+    // A completed conversion would make the boards read their factory calibration
+    return HAL_TIMEOUT;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_ADC_GetValue(ADC_HandleTypeDef*) -> uint32_t
+{
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_I2C_Master_Transmit(I2C_HandleTypeDef*, uint16_t, uint8_t*, uint16_t,
+                             uint32_t) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_I2C_Master_Receive(I2C_HandleTypeDef*, uint16_t, uint8_t* data, uint16_t size,
+                            uint32_t) -> HAL_StatusTypeDef
+{
+    std::fill_n(data, size, 0);
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_I2C_Mem_Write(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t*, uint16_t,
+                       uint32_t) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_I2C_Mem_Read(I2C_HandleTypeDef*, uint16_t, uint16_t, uint16_t, uint8_t* data,
+                      uint16_t size, uint32_t) -> HAL_StatusTypeDef
+{
+    std::fill_n(data, size, 0);
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_OPAMP_Start(OPAMP_HandleTypeDef*) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HAL_OPAMP_Stop(OPAMP_HandleTypeDef*) -> HAL_StatusTypeDef
+{
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // UTF-16 with size and type in front, as the USB device library provides it
+    uint8_t serialDescriptor[] = { 10, 3, 'T', 0, 'E', 0, 'S', 0, 'T', 0 };
+
+    auto getSerialStrDescriptor(USBD_SpeedTypeDef, uint16_t* length) -> uint8_t*
+    {
+        *length = sizeof(serialDescriptor);
+        return serialDescriptor;
+    }
+}
+
+USBD_DescriptorsTypeDef FS_Desc = { .GetSerialStrDescriptor = &getSerialStrDescriptor };
+
+// ---------------------------------------------------------------------------------------------- //
+
+uint8_t CDC_Transmit(uint8_t* buffer, uint16_t size)
+{
+    transmittedSize += size;
+
+    if (captureEnabled)
+        transmittedData.append(reinterpret_cast<const char*>(buffer), size);
+
+    // Transfers complete immediately
+    if (txCompleteCallback)
+        txCompleteCallback();
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_RegisterReceiveCallback(CDC_ReceiveCallback callback)
+{
+    receiveCallback = callback;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_RegisterTxCompleteCallback(CDC_TxCompleteCallback callback)
+{
+    txCompleteCallback = callback;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_RegisterDisconnectCallback(CDC_DisconnectCallback callback)
+{
+    disconnectCallback = callback;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_Receive(uint8_t* buffer, uint32_t size)
+{
+    if (receiveCallback)
+        receiveCallback(buffer, size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_Disconnect()
+{
+    if (disconnectCallback)
+        disconnectCallback();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto CDC_GetTransmittedSize() -> uint64_t
+{
+    return transmittedSize;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CDC_SetCaptureEnabled(bool enabled)
+{
+    captureEnabled = enabled;
+    transmittedData.clear();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto CDC_TakeTransmittedData() -> std::string
+{
+    return std::exchange(transmittedData, {});
+}
+
+// ---------------------------------------------------------------------------------------------- //
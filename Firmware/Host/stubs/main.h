@@ -0,0 +1,213 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+// Just enough of the STM32 HAL to build the hardware independent modules and the command
+// handlers of the boards on a host. Peripherals do nothing, except for the following:
+// - Pins read back the state last written, so that tests can set the inputs.
+// - The delay timer counts microseconds and the tick milliseconds, both from steady_clock.
+// - SPI always has data to receive, so that reads don't block.
+// - ADC conversions never complete.
+
+#include <cstdint>
+
+enum IRQn_Type
+{
+    USB_IRQn
+};
+
+enum HAL_StatusTypeDef
+{
+    HAL_OK,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+};
+
+enum FlagStatus
+{
+    RESET,
+    SET
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+enum GPIO_PinState
+{
+    GPIO_PIN_RESET,
+    GPIO_PIN_SET
+};
+
+struct GPIO_TypeDef
+{
+    uint32_t ODR;
+};
+
+extern GPIO_TypeDef GPIOA_Registers;
+extern GPIO_TypeDef GPIOB_Registers;
+extern GPIO_TypeDef GPIOC_Registers;
+
+#define GPIOA (&GPIOA_Registers)
+#define GPIOB (&GPIOB_Registers)
+#define GPIOC (&GPIOC_Registers)
+
+// The pins of all boards, they don't overlap with each other
+#define STATUS_GOOD_Pin 0x0001
+#define STATUS_GOOD_GPIO_Port GPIOA
+#define STATUS_BAD_Pin 0x0002
+#define STATUS_BAD_GPIO_Port GPIOA
+#define PWR_ENABLE_Pin 0x0004
+#define PWR_ENABLE_GPIO_Port GPIOA
+#define OUTPUT_ENABLE_Pin 0x0008
+#define OUTPUT_ENABLE_GPIO_Port GPIOA
+
+#define ADC_CONVST_Pin 0x0001
+#define ADC_CONVST_GPIO_Port GPIOB
+#define ADC_CS1_Pin 0x0002
+#define ADC_CS1_GPIO_Port GPIOB
+#define ADC_CS2_Pin 0x0004
+#define ADC_CS2_GPIO_Port GPIOB
+#define MUX_A0_Pin 0x0008
+#define MUX_A0_GPIO_Port GPIOB
+#define MUX_A1_Pin 0x0010
+#define MUX_A1_GPIO_Port GPIOB
+#define MUX_EN_Pin 0x0020
+#define MUX_EN_GPIO_Port GPIOB
+
+#define ID1_0_Pin 0x0001
+#define ID1_0_GPIO_Port GPIOC
+#define ID1_1_Pin 0x0002
+#define ID1_1_GPIO_Port GPIOC
+#define ID2_0_Pin 0x0004
+#define ID2_0_GPIO_Port GPIOC
+#define ID2_1_Pin 0x0008
+#define ID2_1_GPIO_Port GPIOC
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+auto HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin) -> GPIO_PinState;
+
+// ---------------------------------------------------------------------------------------------- //
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+void HAL_NVIC_DisableIRQ(IRQn_Type irq);
+
+auto HAL_GetTick() -> uint32_t;
+void HAL_Delay(uint32_t ms);
+
+// ---------------------------------------------------------------------------------------------- //
+
+enum HAL_TIM_StateTypeDef
+{
+    HAL_TIM_STATE_READY,
+    HAL_TIM_STATE_BUSY
+};
+
+struct TIM_HandleTypeDef
+{
+    HAL_TIM_StateTypeDef State;
+};
+
+auto HAL_TIM_Base_Start(TIM_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+auto HAL_TIM_Base_Start_IT(TIM_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+auto HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+
+// Called by the boards' timer interrupts, tests may call it instead
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* handle);
+
+// Counts microseconds, like the delay timer on the boards
+auto HAL_TIM_GetCounter(TIM_HandleTypeDef* handle) -> uint32_t;
+
+#define __HAL_TIM_GET_COUNTER(handle) HAL_TIM_GetCounter(handle)
+#define __HAL_TIM_SET_COUNTER(handle, value) ((void)(handle), (void)(value))
+#define __HAL_TIM_SET_AUTORELOAD(handle, value) ((void)(handle), (void)(value))
+#define __HAL_TIM_ENABLE(handle) ((void)(handle))
+#define __HAL_TIM_DISABLE(handle) ((void)(handle))
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct SPI_TypeDef
+{
+    uint32_t CR1;
+    uint32_t SR;
+    volatile uint32_t DR; // Reads have side effects on the board
+};
+
+struct SPI_HandleTypeDef
+{
+    SPI_TypeDef* Instance;
+};
+
+#define SPI_CR1_SPE 0x0040
+#define SPI_CR1_RXONLY 0x0400
+#define SPI_FLAG_RXNE 0x0001
+
+#define __HAL_SPI_ENABLE(handle) ((handle)->Instance->CR1 |= SPI_CR1_SPE)
+#define __HAL_SPI_DISABLE(handle) ((handle)->Instance->CR1 &= ~SPI_CR1_SPE)
+#define __HAL_SPI_GET_FLAG(handle, flag) \
+    ((((handle)->Instance->SR) & (flag)) == (flag) ? SET : RESET)
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct ADC_HandleTypeDef {};
+
+#define ADC_SINGLE_ENDED 0x7f
+
+auto HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef* handle, uint32_t mode) -> HAL_StatusTypeDef;
+auto HAL_ADC_Start(ADC_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+auto HAL_ADC_Start_DMA(ADC_HandleTypeDef* handle, uint32_t* data,
+                       uint32_t length) -> HAL_StatusTypeDef;
+auto HAL_ADC_Stop(ADC_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+auto HAL_ADC_PollForConversion(ADC_HandleTypeDef* handle, uint32_t timeout) -> HAL_StatusTypeDef;
+auto HAL_ADC_GetValue(ADC_HandleTypeDef* handle) -> uint32_t;
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct I2C_HandleTypeDef {};
+
+#define I2C_MEMADD_SIZE_8BIT 0x01
+
+// Reads return zeros
+auto HAL_I2C_Master_Transmit(I2C_HandleTypeDef* handle, uint16_t address, uint8_t* data,
+                             uint16_t size, uint32_t timeout) -> HAL_StatusTypeDef;
+auto HAL_I2C_Master_Receive(I2C_HandleTypeDef* handle, uint16_t address, uint8_t* data,
+                            uint16_t size, uint32_t timeout) -> HAL_StatusTypeDef;
+auto HAL_I2C_Mem_Write(I2C_HandleTypeDef* handle, uint16_t address, uint16_t memoryAddress,
+                       uint16_t memoryAddressSize, uint8_t* data, uint16_t size,
+                       uint32_t timeout) -> HAL_StatusTypeDef;
+auto HAL_I2C_Mem_Read(I2C_HandleTypeDef* handle, uint16_t address, uint16_t memoryAddress,
+                      uint16_t memoryAddressSize, uint8_t* data, uint16_t size,
+                      uint32_t timeout) -> HAL_StatusTypeDef;
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct OPAMP_HandleTypeDef {};
+
+auto HAL_OPAMP_Start(OPAMP_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+auto HAL_OPAMP_Stop(OPAMP_HandleTypeDef* handle) -> HAL_StatusTypeDef;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Only referenced by the boards' config.h
+struct DAC_HandleTypeDef {};
+struct DMA_HandleTypeDef {};
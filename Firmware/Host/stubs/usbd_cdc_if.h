@@ -0,0 +1,54 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+uint8_t CDC_Transmit(uint8_t* buffer, uint16_t size);
+
+typedef void (*CDC_ReceiveCallback)(uint8_t *buffer, uint32_t size);
+void CDC_RegisterReceiveCallback(CDC_ReceiveCallback callback);
+
+typedef void (*CDC_TxCompleteCallback)(void);
+void CDC_RegisterTxCompleteCallback(CDC_TxCompleteCallback callback);
+
+typedef void (*CDC_DisconnectCallback)(void);
+void CDC_RegisterDisconnectCallback(CDC_DisconnectCallback callback);
+
+// Host only, delivers data to the receive callback as the USB interrupt would
+void CDC_Receive(uint8_t* buffer, uint32_t size);
+
+// Host only, reports a disconnect as the USB interrupt would
+void CDC_Disconnect();
+
+// Host only, the number of bytes passed to CDC_Transmit() so far
+auto CDC_GetTransmittedSize() -> uint64_t;
+
+// Host only, keeps the data passed to CDC_Transmit() for CDC_TakeTransmittedData(). Off by default,
+// as it would add to the cost that the benchmarks measure.
+void CDC_SetCaptureEnabled(bool enabled);
+
+// Host only, the data captured since the last call
+auto CDC_TakeTransmittedData() -> std::string;
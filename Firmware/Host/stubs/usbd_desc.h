@@ -0,0 +1,42 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+// Stands in for the descriptors of the USB device library. Only the serial number is provided.
+
+#include <cstdint>
+
+enum USBD_SpeedTypeDef
+{
+    USBD_SPEED_HIGH,
+    USBD_SPEED_FULL,
+    USBD_SPEED_LOW
+};
+
+struct USBD_DescriptorsTypeDef
+{
+    uint8_t* (*GetSerialStrDescriptor)(USBD_SpeedTypeDef speed, uint16_t* length);
+};
+
+extern USBD_DescriptorsTypeDef FS_Desc;
@@ -0,0 +1,139 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "wavegenerator.h"
+#include "testing.h"
+
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr double Frequency = 50.0;
+    constexpr double Period = 1.0 / Frequency;
+
+    // The time at the given fraction of the period, in a later period to include the wrap around
+    auto at(double phase) -> double
+    {
+        return (3.0 + phase) * Period;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSine()
+{
+    using Generator = WaveGenerator<double>;
+
+    CHECK_NEAR(Generator::sine(at(0.0), Frequency), 0.0, 1e-9);
+    CHECK_NEAR(Generator::sine(at(0.25), Frequency), 1.0, 1e-9);
+    CHECK_NEAR(Generator::sine(at(0.5), Frequency), 0.0, 1e-9);
+    CHECK_NEAR(Generator::sine(at(0.75), Frequency), -1.0, 1e-9);
+    CHECK_NEAR(Generator::sine(at(0.25), Frequency, 2.0, 0.5), 2.5, 1e-9);
+
+    // The table has 1000 entries, so it's off by at most one step
+    for (int i = 0; i < 100; ++i)
+    {
+        const double time = at(i / 100.0 + 0.0005);
+
+        if (!CHECK_NEAR(Generator::qsine(time, Frequency), Generator::sine(time, Frequency),
+                        2.0 * Generator::TwoPi / 1000))
+            return;
+    }
+
+    CHECK_NEAR(Generator::qsine(at(0.25), Frequency, 2.0, 0.5), 2.5, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSquare()
+{
+    using Generator = WaveGenerator<double>;
+
+    CHECK(Generator::square(at(0.1), Frequency) == 1.0);
+    CHECK(Generator::square(at(0.4), Frequency) == 1.0);
+    CHECK(Generator::square(at(0.6), Frequency) == -1.0);
+    CHECK(Generator::square(at(0.9), Frequency) == -1.0);
+    CHECK(Generator::square(at(0.6), Frequency, 0.5, 1.0) == 0.5);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTriangle()
+{
+    using Generator = WaveGenerator<double>;
+
+    // Rises through zero at the start of the period like the sine
+    CHECK_NEAR(Generator::triangle(at(0.0), Frequency), 0.0, 1e-9);
+    CHECK_NEAR(Generator::triangle(at(0.125), Frequency), 0.5, 1e-9);
+    CHECK_NEAR(Generator::triangle(at(0.25), Frequency), 1.0, 1e-9);
+    CHECK_NEAR(Generator::triangle(at(0.5), Frequency), 0.0, 1e-9);
+    CHECK_NEAR(Generator::triangle(at(0.75), Frequency), -1.0, 1e-9);
+    CHECK_NEAR(Generator::triangle(at(0.25), Frequency, 2.0, -1.0), 1.0, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSawtooth()
+{
+    using Generator = WaveGenerator<double>;
+
+    CHECK_NEAR(Generator::sawtooth(at(0.0), Frequency), 0.0, 1e-9);
+    CHECK_NEAR(Generator::sawtooth(at(0.25), Frequency), 0.5, 1e-9);
+    CHECK_NEAR(Generator::sawtooth(at(0.499), Frequency), 0.998, 1e-9);
+    CHECK_NEAR(Generator::sawtooth(at(0.501), Frequency), -0.998, 1e-9);
+    CHECK_NEAR(Generator::sawtooth(at(0.75), Frequency), -0.5, 1e-9);
+    CHECK_NEAR(Generator::sawtooth(at(0.25), Frequency, 3.0, 1.0), 2.5, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testFloat()
+{
+    // The board generates the signal in single precision
+    using Generator = WaveGenerator<float>;
+
+    const auto time = static_cast<float>(at(0.25));
+    const auto frequency = static_cast<float>(Frequency);
+
+    CHECK_NEAR(Generator::sine(time, frequency), 1.0f, 1e-4f);
+    CHECK_NEAR(Generator::qsine(time, frequency), 1.0f, 1e-4f);
+    CHECK(Generator::square(time, frequency) == 1.0f);
+    CHECK_NEAR(Generator::triangle(time, frequency), 1.0f, 1e-4f);
+    CHECK_NEAR(Generator::sawtooth(time, frequency), 0.5f, 1e-4f);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testSine();
+    testSquare();
+    testTriangle();
+    testSawtooth();
+    testFloat();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -30,6 +30,8 @@
 #include "signalgenerator.h"
 #include "signalreader.h"
 
+#include <string_view>
+
 class Potentiostat : public HostInterface::Owner,
                      public SignalGenerator::Owner,
                      public SignalReader::Owner
@@ -40,6 +42,9 @@ public:
 
     void exec();
 
+    // One pass of the main loop, which exec() runs forever
+    void update();
+
 private:
     void onHostDataReceived(const String& data) override;
     void onHostDataOverflow() override;
@@ -47,12 +52,12 @@ private:
     void onSamplesAvailable(std::span<const Measurement::Sample> samples) override;
     void onSignalGenerationComplete() override;
 
-    void protocolSetCalibration(const String& data, size_t tokenCount);
+    void protocolSetCalibration(std::span<const std::string_view> tokens);
 
-    void protocolStartMeasurement(const String& data, size_t tokenCount);
+    void protocolStartMeasurement(std::span<const std::string_view> tokens);
     void protocolStopMeasurement();
 
-    void protocolSetGain(const String& data, size_t tokenCount);
+    void protocolSetGain(std::span<const std::string_view> tokens);
 
     void protocolGetPowerValues();
 
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "averagingbuffer.h"
+#include "config.h"
 #include "ltc2945.h"
 #include "main.h"
 
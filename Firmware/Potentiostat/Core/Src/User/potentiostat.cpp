@@ -23,7 +23,9 @@
 
 #include "config.h"
 #include "delay.h"
+#include "numberparser.h"
 #include "potentiostat.h"
+#include "stringtokenizer.h"
 
 #include "usbd_desc.h"
 
@@ -31,6 +33,9 @@
 
 namespace {
     constexpr char TokenSeparator = ' ';
+
+    // A tag and its arguments, anything beyond is ignored
+    constexpr size_t MaximumTokenCount = 2;
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -74,16 +79,21 @@ void Potentiostat::exec()
     HAL_GPIO_WritePin(STATUS_GOOD_GPIO_Port, STATUS_GOOD_Pin, GPIO_PIN_RESET); // Active low
 
     while (true)
+        update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Potentiostat::update()
+{
+    m_hostInterface.update();
+    m_powerMonitor.update();
+
+    if (m_measurementRunning)
     {
-        m_hostInterface.update();
-        m_powerMonitor.update();
-
-        if (m_measurementRunning)
-        {
-            m_signalGenerator.update();
-            m_signalReader.update();
-            m_blinker.update();
-        }
+        m_signalGenerator.update();
+        m_signalReader.update();
+        m_blinker.update();
     }
 }
 
@@ -91,23 +101,27 @@ void Potentiostat::exec()
 
 void Potentiostat::onHostDataReceived(const String& data)
 {
-    const size_t tokenCount = data.getTokenCount(TokenSeparator);
+    std::array<std::string_view, MaximumTokenCount> tokenArray;
+    const size_t tokenCount = StringTokenizer::split(data, TokenSeparator, tokenArray);
 
     if (tokenCount < 1)
         return;
 
-    const String tag = data.getToken(TokenSeparator, 0);
+    const auto tokens = std::span<const std::string_view>(tokenArray).first(
+                std::min(tokenCount, tokenArray.size()));
+
+    const std::string_view tag = tokens[0];
 
     if (tag == "<START_MEASUREMENT>")
-        protocolStartMeasurement(data, tokenCount);
+        protocolStartMeasurement(tokens);
     else if (tag == "<STOP_MEASUREMENT>")
         protocolStopMeasurement();
     else if (tag == "<GET_POWER_VALUES>")
         protocolGetPowerValues();
     else if (tag == "<SET_GAIN>")
-        protocolSetGain(data, tokenCount);
+        protocolSetGain(tokens);
     else if (tag == "<SET_CALIBRATION>")
-        protocolSetCalibration(data, tokenCount);
+        protocolSetCalibration(tokens);
     else
         sendError("UNKNOWN_COMMAND");
 }
@@ -156,30 +170,29 @@ void Potentiostat::protocolGetPowerValues()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void Potentiostat::protocolSetCalibration(const String& data, size_t tokenCount)
+void Potentiostat::protocolSetCalibration(std::span<const std::string_view> tokens)
 {
     static constexpr size_t ExpectedTokenCount = 2;
     static constexpr size_t ExpectedValueCount = 3;
 
     static constexpr char ValueSeparator = ';';
 
-    if (tokenCount < ExpectedTokenCount)
+    if (tokens.size() < ExpectedTokenCount)
         return sendError("MISSING_ARGUMENT");
 
-    const String values = data.getToken(TokenSeparator, 1);
-    const size_t valueCount = values.getTokenCount(ValueSeparator);
+    std::array<std::string_view, ExpectedValueCount> values;
 
-    if (valueCount != ExpectedValueCount)
+    if (StringTokenizer::split(tokens[1], ValueSeparator, values) != ExpectedValueCount)
         return sendError("INVALID_LENGTH");
 
-    std::array<String, ExpectedValueCount> valueTokens;
-    values.getAllTokens(ValueSeparator, valueTokens);
+    int voltage = 0;
+    int current = 0;
+    int signal = 0;
 
-    const auto voltage = valueTokens[0].toInt();
-    const auto current = valueTokens[1].toInt();
-    const auto signal = valueTokens[2].toInt();
-
-    const bool valid = voltage >= SignalReader::MinimumCalibrationOffset &&
+    const bool valid = NumberParser::parse(values[0], voltage) &&
+                       NumberParser::parse(values[1], current) &&
+                       NumberParser::parse(values[2], signal) &&
+                       voltage >= SignalReader::MinimumCalibrationOffset &&
                        voltage <= SignalReader::MaximumCalibrationOffset &&
                        current >= SignalReader::MinimumCalibrationOffset &&
                        current <= SignalReader::MaximumCalibrationOffset &&
@@ -194,7 +207,7 @@ void Potentiostat::protocolSetCalibration(const String& data, size_t tokenCount)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void Potentiostat::protocolStartMeasurement(const String& data, size_t tokenCount)
+void Potentiostat::protocolStartMeasurement(std::span<const std::string_view> tokens)
 {
     static constexpr size_t ExpectedTokenCount = 2;
     static constexpr size_t ExpectedValueCount = 8;
@@ -204,33 +217,42 @@ void Potentiostat::protocolStartMeasurement(const String& data, size_t tokenCoun
     if (m_measurementRunning)
         return sendError("DEVICE_BUSY");
 
-    if (tokenCount < ExpectedTokenCount)
+    if (tokens.size() < ExpectedTokenCount)
         return sendError("MISSING_ARGUMENT");
 
-    const String values = data.getToken(TokenSeparator, 1);
-    const size_t valueCount = values.getTokenCount(ValueSeparator);
+    std::array<std::string_view, ExpectedValueCount> values;
 
-    if (valueCount != ExpectedValueCount)
+    if (StringTokenizer::split(tokens[1], ValueSeparator, values) != ExpectedValueCount)
         return sendError("INVALID_LENGTH");
 
-    std::array<String, ExpectedValueCount> valueTokens;
-    values.getAllTokens(ValueSeparator, valueTokens);
+    unsigned int typeIndex = 0;
+    unsigned int gainIndex = 0;
+    unsigned int seconds = 0;
+    int rate = 0;
+    int vertex0 = 0;
+    int vertex1 = 0;
+    int vertex2 = 0;
+    int cycles = 0;
+
+    const bool parsed = NumberParser::parse(values[0], typeIndex) &&
+                        NumberParser::parse(values[1], gainIndex) &&
+                        NumberParser::parse(values[2], seconds) &&
+                        NumberParser::parse(values[3], rate) &&
+                        NumberParser::parse(values[4], vertex0) &&
+                        NumberParser::parse(values[5], vertex1) &&
+                        NumberParser::parse(values[6], vertex2) &&
+                        NumberParser::parse(values[7], cycles);
+    if (!parsed)
+        return sendError("INVALID_ARGUMENT");
 
-    const auto type = Measurement::toType(valueTokens[0].toUInt());
-    const auto gain = Measurement::toGain(valueTokens[1].toUInt());
-    const auto duration = std::chrono::seconds(valueTokens[2].toUInt());
-    const auto rate = std::clamp(valueTokens[3].toInt(),
-                                 Measurement::MinimumScanRate, Measurement::MaximumScanRate);
-    const auto vertex0 = valueTokens[4].toInt();
-    const auto vertex1 = valueTokens[5].toInt();
-    const auto vertex2 = valueTokens[6].toInt();
-    const auto cycles = valueTokens[7].toInt();
+    const auto type = Measurement::toType(typeIndex);
+    const auto gain = Measurement::toGain(gainIndex);
 
     Measurement::Setup setup = {
             type,
             gain,
-            duration,
-            rate,
+            std::chrono::seconds(seconds),
+            std::clamp(rate, Measurement::MinimumScanRate, Measurement::MaximumScanRate),
             vertex0,
             vertex1,
             vertex2,
@@ -265,16 +287,16 @@ void Potentiostat::protocolStopMeasurement()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void Potentiostat::protocolSetGain(const String& data, size_t tokenCount)
+void Potentiostat::protocolSetGain(std::span<const std::string_view> tokens)
 {
     static constexpr size_t ExpectedTokenCount = 2;
 
-    if (tokenCount < ExpectedTokenCount)
+    if (tokens.size() < ExpectedTokenCount)
         return sendError("MISSING_ARGUMENT");
 
-    const auto gain = data.getToken(TokenSeparator, 1).toUInt();
+    unsigned int gain = 0;
 
-    if (gain >= Measurement::GainCount)
+    if (!NumberParser::parse(tokens[1], gain) || gain >= Measurement::GainCount)
         return sendError("INVALID_ARGUMENT");
 
     setGain(Measurement::toGain(gain));
@@ -38,7 +38,7 @@ extern TIM_HandleTypeDef htim6;
 namespace Config {
     constexpr const char* BoardName = "I2CCarrier";
     constexpr const char* HardwareVersion = "1.0";
-    constexpr const char* FirmwareVersion = "1.0";
+    constexpr const char* FirmwareVersion = "1.3";
 
     constexpr I2C_HandleTypeDef* Sensor1Handle = &hi2c3;
     constexpr I2C_HandleTypeDef* Sensor2Handle = &hi2c1;
@@ -47,6 +47,10 @@ namespace Config {
 
     constexpr ADC_HandleTypeDef* PowerMonitorHandle = &hadc1;
     constexpr TIM_HandleTypeDef* UpdateTimerHandle = &htim1;
+    constexpr uint32_t UpdatePeriodMs = 100; // Must match the configuration of TIM1
+
+    constexpr uint32_t MinimumSubscriptionIntervalMs = UpdatePeriodMs;
+    constexpr uint32_t MaximumSubscriptionIntervalMs = 60000;
 
     constexpr TIM_HandleTypeDef* DelayTimerHandle = &htim6;
 }
@@ -0,0 +1 @@
+../../../../Common/numberparser.h
\ No newline at end of file
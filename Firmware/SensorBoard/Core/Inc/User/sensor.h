@@ -28,6 +28,7 @@
 #include "main.h"
 
 #include <array>
+#include <limits>
 #include <span>
 
 class Sensor
@@ -27,6 +27,8 @@
 #include "powermonitor.h"
 #include "sensormanager.h"
 
+#include <string_view>
+
 class SensorBoard : public HostInterface::Owner
 {
 public:
@@ -35,14 +37,21 @@ public:
 
     void exec();
 
+    // One pass of the main loop, which exec() runs forever
+    void update();
+
 private:
     void onHostDataReceived(const String& data) override;
     void onHostDataOverflow() override;
 
-    void protocolGetSensorType(const String& data, size_t tokenCount);
-    void protocolGetSensorValue(const String& data, size_t tokenCount);
+    void protocolGetSensorType(std::span<const std::string_view> tokens);
+    void protocolGetSensorValue(std::span<const std::string_view> tokens);
 
     void protocolGetPowerValues();
+    void protocolGetAllValues();
+
+    void protocolSubscribe(std::span<const std::string_view> tokens);
+    void protocolUnsubscribe();
 
     void protocolGetBoardName();
     void protocolGetHardwareVersion();
@@ -52,13 +61,23 @@ private:
 
     void checkTokenCount(size_t tokenCount, size_t expectedCount);
 
+    auto makePowerValues() const -> String;
+    void sendAllValues();
+
+    void appendRequestId(String& line) const;
+
     void sendResponse(const String& tag, const String& data = {});
     void sendError(const String& error);
 
-    auto toIndex(const String& s) -> size_t;
+    auto toIndex(std::string_view s) -> size_t;
 
 private:
     HostInterface m_hostInterface;
     PowerMonitor m_powerMonitor;
     SensorManager m_sensorManager;
+
+    String m_requestId;
+
+    uint32_t m_subscriptionTicks = 0;
+    uint32_t m_ticksSinceLastPush = 0;
 };
@@ -0,0 +1 @@
+../../../../Common/stringtokenizer.h
\ No newline at end of file
@@ -22,16 +22,30 @@
 // ============================================================================================== //
 
 #include "config.h"
+#include "numberparser.h"
 #include "sensorboard.h"
+#include "stringtokenizer.h"
 #include "timestamp.h"
 
+#include "usbd_cdc_if.h"
 #include "usbd_desc.h"
 
 // ---------------------------------------------------------------------------------------------- //
 
 namespace {
     constexpr char TokenSeparator = ' ';
+    constexpr char RequestIdPrefix = '@';
+
+    // A tag, its argument and a request ID
+    constexpr size_t MaximumTokenCount = 3;
+
     volatile bool g_updatePeriodElapsed = false;
+    volatile bool g_hostDisconnected = false;
+
+    void onHostDisconnected()
+    {
+        g_hostDisconnected = true;
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -63,12 +77,15 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
 SensorBoard::SensorBoard()
     : m_hostInterface(this)
 {
+    CDC_RegisterDisconnectCallback(&onHostDisconnected);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 SensorBoard::~SensorBoard()
 {
+    CDC_RegisterDisconnectCallback(nullptr);
+
     HAL_TIM_Base_Stop_IT(Config::UpdateTimerHandle);
     HAL_OPAMP_Stop(Config::BusVoltageOpAmpHandle);
 
@@ -85,14 +102,34 @@ void SensorBoard::exec()
     HAL_GPIO_WritePin(STATUS_GOOD_GPIO_Port, STATUS_GOOD_Pin, GPIO_PIN_RESET);
 
     while (true)
+        update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SensorBoard::update()
+{
+    m_hostInterface.update();
+
+    // A host that reconnects doesn't expect values it hasn't subscribed to
+    if (g_hostDisconnected)
+    {
+        g_hostDisconnected = false;
+
+        m_subscriptionTicks = 0;
+        m_ticksSinceLastPush = 0;
+    }
+
+    if (g_updatePeriodElapsed)
     {
-        m_hostInterface.update();
+        g_updatePeriodElapsed = false;
+        m_powerMonitor.update();
+        m_sensorManager.update();
 
-        if (g_updatePeriodElapsed)
+        if (m_subscriptionTicks > 0 && ++m_ticksSinceLastPush >= m_subscriptionTicks)
         {
-            g_updatePeriodElapsed = false;
-            m_powerMonitor.update();
-            m_sensorManager.update();
+            m_ticksSinceLastPush = 0;
+            sendAllValues();
         }
     }
 }
@@ -101,19 +138,51 @@ void SensorBoard::exec()
 
 void SensorBoard::onHostDataReceived(const String& data)
 {
-    const size_t tokenCount = data.getTokenCount(TokenSeparator);
+    StringTokenizer tokenizer(data, TokenSeparator);
+
+    std::array<std::string_view, MaximumTokenCount> tokenArray;
+    std::string_view token;
+    size_t tokenCount = 0;
+
+    // Keeps going past the array, as the last token is needed for the request ID
+    while (tokenizer.next(token))
+    {
+        if (tokenCount < tokenArray.size())
+            tokenArray[tokenCount] = token;
+
+        ++tokenCount;
+    }
 
     if (tokenCount < 1)
         return;
 
-    const String tag = data.getToken(TokenSeparator, 0);
+    const std::string_view tag = tokenArray[0];
+
+    // Requests may end with an ID, which is echoed on every line of the response
+    // so the host can match responses to requests it has in flight.
+    if (tokenCount > 1 && !token.empty() && token[0] == RequestIdPrefix)
+    {
+        m_requestId = String(token);
+        --tokenCount;
+    }
+    else
+        m_requestId.clear();
+
+    const auto tokens = std::span<const std::string_view>(tokenArray).first(
+                std::min(tokenCount, tokenArray.size()));
 
     if (tag == "<GET_SENSOR_TYPE>")
-        protocolGetSensorType(data, tokenCount);
+        protocolGetSensorType(tokens);
     else if (tag == "<GET_SENSOR_VALUE>")
-        protocolGetSensorValue(data, tokenCount);
+        protocolGetSensorValue(tokens);
     else if (tag == "<GET_POWER_VALUES>")
         protocolGetPowerValues();
+    else if (tag == "<GET_ALL_VALUES>")
+        protocolGetAllValues();
+    else if (tag == "<SUBSCRIBE>")
+        protocolSubscribe(tokens);
+    else if (tag == "<UNSUBSCRIBE>")
+        protocolUnsubscribe();
     else if (tag == "<GET_BOARD_NAME>")
         protocolGetBoardName();
     else if (tag == "<GET_HARDWARE_VERSION>")
@@ -126,6 +195,8 @@ void SensorBoard::onHostDataReceived(const String& data)
         protocolGetBuildTimestamp();
     else
         sendError("UNKNOWN_COMMAND");
+
+    m_requestId.clear();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -137,12 +208,12 @@ void SensorBoard::onHostDataOverflow()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void SensorBoard::protocolGetSensorType(const String& data, size_t tokenCount)
+void SensorBoard::protocolGetSensorType(std::span<const std::string_view> tokens)
 {
     try {
-        checkTokenCount(tokenCount, 2);
+        checkTokenCount(tokens.size(), 2);
 
-        const uint8_t index = toIndex(data.getToken(TokenSeparator, 1));
+        const uint8_t index = toIndex(tokens[1]);
         sendResponse("<SENSOR_TYPE>", Sensor::toString(m_sensorManager.sensorType(index)));
     }
     catch (const std::exception& e) {
@@ -152,12 +223,12 @@ void SensorBoard::protocolGetSensorType(const String& data, size_t tokenCount)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void SensorBoard::protocolGetSensorValue(const String& data, size_t tokenCount)
+void SensorBoard::protocolGetSensorValue(std::span<const std::string_view> tokens)
 {
     try {
-        checkTokenCount(tokenCount, 2);
+        checkTokenCount(tokens.size(), 2);
 
-        const uint8_t index = toIndex(data.getToken(TokenSeparator, 1));
+        const uint8_t index = toIndex(tokens[1]);
         sendResponse("<SENSOR_VALUE>", String().format("%f", m_sensorManager.sensorValue(index)));
     }
     catch (const std::exception& e) {
@@ -169,11 +240,54 @@ void SensorBoard::protocolGetSensorValue(const String& data, size_t tokenCount)
 
 void SensorBoard::protocolGetPowerValues()
 {
-    const double voltage = m_powerMonitor.getVoltage();
-    const double current = m_powerMonitor.getCurrent();
-    const double temperature = m_powerMonitor.getTemperature();
+    sendResponse("<POWER_VALUES>", makePowerValues());
+}
+
+// ---------------------------------------------------------------------------------------------- //
 
-    sendResponse("<POWER_VALUES>", String().format("%f;%f;%f", voltage, current, temperature));
+void SensorBoard::protocolGetAllValues()
+{
+    sendAllValues();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SensorBoard::protocolSubscribe(std::span<const std::string_view> tokens)
+{
+    try {
+        checkTokenCount(tokens.size(), 2);
+
+        unsigned long interval = 0;
+
+        if (!NumberParser::parse(tokens[1], interval))
+            throw InvalidArgumentError();
+
+        if (interval < Config::MinimumSubscriptionIntervalMs ||
+            interval > Config::MaximumSubscriptionIntervalMs)
+            throw InvalidArgumentError();
+
+        // Values are pushed from the update loop, so round to whole update periods
+        m_subscriptionTicks = (interval + Config::UpdatePeriodMs / 2) / Config::UpdatePeriodMs;
+
+        // Push the first values on the next update so the host does not have to wait
+        m_ticksSinceLastPush = m_subscriptionTicks - 1;
+
+        const unsigned long actualInterval = m_subscriptionTicks * Config::UpdatePeriodMs;
+        sendResponse("<SUBSCRIBED>", String().format("%lu", actualInterval));
+    }
+    catch (const std::exception& e) {
+        sendError(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SensorBoard::protocolUnsubscribe()
+{
+    m_subscriptionTicks = 0;
+    m_ticksSinceLastPush = 0;
+
+    sendResponse("<UNSUBSCRIBED>");
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -231,6 +345,48 @@ void SensorBoard::checkTokenCount(size_t tokenCount, size_t expectedCount)
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto SensorBoard::makePowerValues() const -> String
+{
+    const double voltage = m_powerMonitor.getVoltage();
+    const double current = m_powerMonitor.getCurrent();
+    const double temperature = m_powerMonitor.getTemperature();
+
+    return String().format("%f;%f;%f", voltage, current, temperature);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SensorBoard::sendAllValues()
+{
+    // One line per sensor plus one for the power values, all sent in a single
+    // transfer so the host needs only one round trip per update.
+    std::array<String, SensorManager::SensorCount + 1> lines;
+
+    for (uint8_t i = 0; i < SensorManager::SensorCount; ++i)
+    {
+        const char* type = Sensor::toString(m_sensorManager.sensorType(i));
+        const double value = m_sensorManager.sensorValue(i);
+
+        lines[i] = "<SENSOR_DATA> " + String().format("%d;%s;%f", i, type, value);
+        appendRequestId(lines[i]);
+    }
+
+    lines.back() = "<POWER_VALUES> " + makePowerValues();
+    appendRequestId(lines.back());
+
+    m_hostInterface.sendData(lines);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SensorBoard::appendRequestId(String& line) const
+{
+    if (!m_requestId.empty())
+        line += " " + m_requestId;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void SensorBoard::sendResponse(const String& tag, const String& data)
 {
     auto response = tag;
@@ -238,6 +394,7 @@ void SensorBoard::sendResponse(const String& tag, const String& data)
     if (!data.empty())
         response += " " + data;
 
+    appendRequestId(response);
     m_hostInterface.sendData(response);
 }
 
@@ -245,22 +402,22 @@ void SensorBoard::sendResponse(const String& tag, const String& data)
 
 void SensorBoard::sendError(const String& error)
 {
-    m_hostInterface.sendData("<ERROR> " + error);
+    String response = "<ERROR> " + error;
+
+    appendRequestId(response);
+    m_hostInterface.sendData(response);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-auto SensorBoard::toIndex(const String& s) -> size_t
+auto SensorBoard::toIndex(std::string_view s) -> size_t
 {
-    if (s.empty())
-        throw InvalidArgumentError();
-
-    auto index = s.toULong();
+    size_t index = 0;
 
-    if (index >= SensorManager::SensorCount)
+    if (!NumberParser::parse(s, index) || index >= SensorManager::SensorCount)
         throw InvalidArgumentError();
 
-    return static_cast<size_t>(index);
+    return index;
 }
 
 // ---------------------------------------------------------------------------------------------- //
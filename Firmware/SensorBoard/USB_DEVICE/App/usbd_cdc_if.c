@@ -96,6 +96,7 @@ uint8_t UserTxBufferFS[APP_TX_DATA_SIZE];
 /* USER CODE BEGIN PRIVATE_VARIABLES */
 static CDC_ReceiveCallback _receiveCallback = NULL;
 static CDC_TxCompleteCallback _txCompleteCallback = NULL;
+static CDC_DisconnectCallback _disconnectCallback = NULL;
 
 static USBD_CDC_LineCodingTypeDef lineCoding =
 {
@@ -175,6 +176,10 @@ static int8_t CDC_Init_FS(void)
 static int8_t CDC_DeInit_FS(void)
 {
   /* USER CODE BEGIN 4 */
+  /* Called when the cable is unplugged or the host resets the device */
+  if (_disconnectCallback)
+    _disconnectCallback();
+
   return (USBD_OK);
   /* USER CODE END 4 */
 }
@@ -237,7 +242,13 @@ static int8_t CDC_Control_FS(uint8_t cmd, uint8_t* pbuf, uint16_t length)
     break;
 
     case CDC_SET_CONTROL_LINE_STATE:
+    {
+        /* The host drops DTR when it closes the port */
+        USBD_SetupReqTypedef* req = (USBD_SetupReqTypedef*)pbuf;
 
+        if ((req->wValue & 0x0001) == 0 && _disconnectCallback)
+          _disconnectCallback();
+    }
     break;
 
     case CDC_SEND_BREAK:
@@ -345,6 +356,11 @@ void CDC_RegisterTxCompleteCallback(CDC_TxCompleteCallback callback)
 {
   _txCompleteCallback = callback;
 }
+
+void CDC_RegisterDisconnectCallback(CDC_DisconnectCallback callback)
+{
+  _disconnectCallback = callback;
+}
 /* USER CODE END PRIVATE_FUNCTIONS_IMPLEMENTATION */
 
 /**
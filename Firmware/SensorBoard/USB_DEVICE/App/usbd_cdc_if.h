@@ -115,6 +115,9 @@ void CDC_RegisterReceiveCallback(CDC_ReceiveCallback callback);
 
 typedef void (*CDC_TxCompleteCallback)(void);
 void CDC_RegisterTxCompleteCallback(CDC_TxCompleteCallback callback);
+
+typedef void (*CDC_DisconnectCallback)(void);
+void CDC_RegisterDisconnectCallback(CDC_DisconnectCallback callback);
 /* USER CODE END EXPORTED_FUNCTIONS */
 
 /**
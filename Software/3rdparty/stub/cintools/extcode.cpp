@@ -0,0 +1,146 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "extcode.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    std::atomic<LVStubPostHandler> g_postHandler = nullptr;
+    std::atomic<size_t> g_handleCount = 0;
+
+    auto elementSize(int32 typeCode) -> size_t
+    {
+        switch (typeCode)
+        {
+        case iB: case uB: return 1;
+        case iW: case uW: return 2;
+        case iL: case uL: case fS: return 4;
+        case iQ: case uQ: case fD: case cS: return 8;
+        default: return 16;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+UHandle DSNewHandle(size_t size)
+{
+    auto handle = static_cast<UHandle>(std::malloc(sizeof(UPtr)));
+
+    if (!handle)
+        return nullptr;
+
+    *handle = static_cast<UPtr>(std::calloc(1, size > 0 ? size : 1));
+
+    if (!*handle)
+    {
+        std::free(handle);
+        return nullptr;
+    }
+
+    g_handleCount++;
+    return handle;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MgErr DSSetHandleSize(UHandle handle, size_t size)
+{
+    auto ptr = static_cast<UPtr>(std::realloc(*handle, size > 0 ? size : 1));
+
+    if (!ptr)
+        return mFullErr;
+
+    *handle = ptr;
+    return mgNoErr;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MgErr DSDisposeHandle(UHandle handle)
+{
+    if (handle)
+    {
+        std::free(*handle);
+        std::free(handle);
+
+        g_handleCount--;
+    }
+
+    return mgNoErr;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MgErr NumericArrayResize(int32 typeCode, int32 numDims, UHandle* handle, size_t totalNewSize)
+{
+    // Dimension sizes are followed by the elements, aligned to their size
+    const size_t element = elementSize(typeCode);
+    const size_t header = numDims * sizeof(int32);
+    const size_t offset = (header + element - 1) / element * element;
+    const size_t size = offset + totalNewSize * element;
+
+    if (!*handle)
+    {
+        *handle = DSNewHandle(size);
+        return *handle ? mgNoErr : mFullErr;
+    }
+
+    return DSSetHandleSize(*handle, size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MoveBlock(const void* src, void* dest, size_t size)
+{
+    std::memmove(dest, src, size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MgErr PostLVUserEvent(LVUserEventRef ref, void* data)
+{
+    const LVStubPostHandler handler = g_postHandler;
+    return handler ? handler(ref, data) : mgNoErr;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void LVStubSetPostHandler(LVStubPostHandler handler)
+{
+    g_postHandler = handler;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t LVStubHandleCount()
+{
+    return g_handleCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,73 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+// Minimal stand-in for the LabVIEW runtime, covering only the functions used by libReDeX. It lets
+// the LabVIEW API be built and exercised without a LabVIEW installation.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+  #define LVSTUB_EXPORT
+#else
+  #define LVSTUB_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef int32_t int32;
+typedef uint8_t uChar;
+typedef uChar* UPtr;
+typedef UPtr* UHandle;
+typedef int32 MgErr;
+typedef uint32_t LVUserEventRef;
+
+enum { mgNoErr = 0, mFullErr = 2 };
+enum { iB = 1, iW, iL, iQ, uB, uW, uL, uQ, fS, fD, fX, cS, cD, cX };
+
+typedef MgErr (*LVStubPostHandler)(LVUserEventRef ref, void* data);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+LVSTUB_EXPORT UHandle DSNewHandle(size_t size);
+LVSTUB_EXPORT MgErr DSSetHandleSize(UHandle handle, size_t size);
+LVSTUB_EXPORT MgErr DSDisposeHandle(UHandle handle);
+
+LVSTUB_EXPORT MgErr NumericArrayResize(int32 typeCode, int32 numDims, UHandle* handle,
+                                       size_t totalNewSize);
+
+LVSTUB_EXPORT void MoveBlock(const void* src, void* dest, size_t size);
+
+// Events are discarded unless a handler has been installed
+LVSTUB_EXPORT MgErr PostLVUserEvent(LVUserEventRef ref, void* data);
+
+LVSTUB_EXPORT void LVStubSetPostHandler(LVStubPostHandler handler);
+
+// Number of handles allocated and not yet disposed
+LVSTUB_EXPORT size_t LVStubHandleCount(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
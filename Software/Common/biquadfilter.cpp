@@ -0,0 +1,276 @@
+/**************************************************************************************************
+ *                                                                                                *
+ *  This file is part of the ISF Utilities collection.                                            *
+ *                                                                                                *
+ *  Author:                                                                                       *
+ *  Marcel Hasler <marcel.hasler@h-brs.de>                                                        *
+ *                                                                                                *
+ *  Copyright (c) 2022                                                                            *
+ *  Bonn-Rhein-Sieg University of Applied Sciences                                                *
+ *                                                                                                *
+ *  Redistribution and use in source and binary forms, with or without modification,              *
+ *  are permitted provided that the following conditions are met:                                 *
+ *                                                                                                *
+ *  1. Redistributions of source code must retain the above copyright notice,                     *
+ *     this list of conditions and the following disclaimer.                                      *
+ *                                                                                                *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,                  *
+ *     this list of conditions and the following disclaimer in the documentation                  *
+ *     and/or other materials provided with the distribution.                                     *
+ *                                                                                                *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"                   *
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED             *
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.            *
+ *  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,              *
+ *  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT            *
+ *  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR            *
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,             *
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)            *
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE                    *
+ *  POSSIBILITY OF SUCH DAMAGE.                                                                   *
+ *                                                                                                *
+ **************************************************************************************************/
+
+#include "biquadfilter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr double Pi = 3.14159265358979323846;
+    constexpr double TwoPi = 2.0 * Pi;
+
+    // Samples mirrored at each end by the zero-phase mode, per section
+    constexpr size_t PaddingPerSection = 6;
+
+    // Sections filtered together sample by sample, so that their latencies overlap
+    constexpr size_t MaximumGroupSize = 4;
+
+    // Transposed direct form II
+    inline auto filterSample(const auto& s, double& z1, double& z2, double x) -> double
+    {
+        const double y = s.b0*x + z1;
+        z1 = s.b1*x + z2 - s.a1*y;
+        z2 = s.b2*x - s.a2*y;
+        return y;
+    }
+
+    template <size_t... I>
+    void filterGroup(const auto* sections, std::array<double, 2>* states,
+                     std::span<double> data, std::index_sequence<I...>)
+    {
+        const std::remove_cvref_t<decltype(*sections)> s[] = { sections[I]... };
+
+        double z1[] = { states[I][0]... };
+        double z2[] = { states[I][1]... };
+
+        for (double& x : data)
+            ((x = filterSample(s[I], z1[I], z2[I], x)), ...);
+
+        ((states[I] = { z1[I], z2[I] }), ...);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BiquadFilter::size() const -> size_t
+{
+    return m_sections.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BiquadFilter::response(double f) const -> double
+{
+    assert(f >= MinimumFrequency && f <= MaximumFrequency);
+
+    const auto z1 = std::polar(1.0, -TwoPi * f);
+    const auto z2 = z1 * z1;
+
+    double magnitude = 1.0;
+
+    for (const auto& s : m_sections)
+        magnitude *= std::abs((s.b0 + s.b1*z1 + s.b2*z2) / (1.0 + s.a1*z1 + s.a2*z2));
+
+    return magnitude;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BiquadFilter::apply(std::span<const double> input, std::span<double> output,
+                         State* state) const
+{
+    assert(input.size() == output.size());
+    assert(state);
+
+    if (input.empty())
+        return;
+
+    if (state->size() != m_sections.size())
+        initialize(input[0], state);
+
+    filter(input, output, state);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BiquadFilter::apply(std::span<const double> input, std::span<double> output) const
+{
+    assert(input.size() == output.size());
+
+    if (input.empty())
+        return;
+
+    const size_t size = input.size();
+    const size_t padding = std::min(PaddingPerSection * m_sections.size(), size - 1);
+
+    // Odd extension at both ends, so that the transients of the ends are filtered away
+    thread_local std::vector<double> data;
+    data.resize(size + 2*padding);
+
+    const double first = input.front();
+    const double last = input.back();
+
+    for (size_t i = 0; i < padding; ++i)
+    {
+        data[i] = 2.0*first - input[padding - i];
+        data[padding + size + i] = 2.0*last - input[size - 2 - i];
+    }
+
+    std::copy(input.begin(), input.end(), data.begin() + padding);
+
+    State state;
+
+    initialize(data.front(), &state);
+    filter(data, data, &state);
+
+    std::reverse(data.begin(), data.end());
+
+    initialize(data.front(), &state);
+    filter(data, data, &state);
+
+    std::reverse_copy(data.begin() + padding, data.end() - padding, output.begin());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BiquadFilter::operator*(const BiquadFilter& rhs) const -> BiquadFilter
+{
+    BiquadFilter out;
+    out.m_sections = m_sections;
+    out.m_sections.insert(out.m_sections.end(), rhs.m_sections.begin(), rhs.m_sections.end());
+    return out;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BiquadFilter::notch(double fl, double fh) -> BiquadFilter
+{
+    assert(fl > MinimumFrequency && fl < fh && fh < MaximumFrequency);
+
+    const double f0 = (fl + fh) / 2;
+    const double q = f0 / (fh - fl);
+
+    const double cosw0 = std::cos(TwoPi * f0);
+    const double alpha = std::sin(TwoPi * f0) / (2*q);
+    const double a0 = 1.0 + alpha;
+
+    BiquadFilter out;
+    out.m_sections.push_back({ 1.0 / a0, -2.0*cosw0 / a0, 1.0 / a0,
+                               -2.0*cosw0 / a0, (1.0 - alpha) / a0 });
+    return out;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BiquadFilter::lowPass(double fc, size_t order) -> BiquadFilter
+{
+    assert(fc > MinimumFrequency && fc < MaximumFrequency);
+    assert(order >= 2 && order % 2 == 0);
+
+    const double k = std::tan(Pi * fc);
+
+    BiquadFilter out;
+
+    for (size_t i = 0; i < order / 2; ++i)
+    {
+        const double q = 1.0 / (2.0 * std::sin((2*i + 1) * Pi / (2*order)));
+        const double norm = 1.0 / (1.0 + k/q + k*k);
+        const double b0 = k*k * norm;
+
+        out.m_sections.push_back({ b0, 2.0*b0, b0, 2.0*(k*k - 1.0) * norm,
+                                   (1.0 - k/q + k*k) * norm });
+    }
+
+    return out;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BiquadFilter::initialize(double input, State* state) const
+{
+    state->resize(m_sections.size());
+
+    for (size_t i = 0; i < m_sections.size(); ++i)
+    {
+        const auto& s = m_sections[i];
+
+        const double gain = (s.b0 + s.b1 + s.b2) / (1.0 + s.a1 + s.a2);
+        const double output = gain * input;
+
+        (*state)[i][1] = s.b2*input - s.a2*output;
+        (*state)[i][0] = output - s.b0*input;
+
+        input = output;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BiquadFilter::filter(std::span<const double> input, std::span<double> output,
+                          State* state) const
+{
+    if (input.data() != output.data())
+        std::copy(input.begin(), input.end(), output.begin());
+
+    // As few groups as possible, of balanced size
+    const size_t count = m_sections.size();
+    const size_t groups = (count + MaximumGroupSize - 1) / MaximumGroupSize;
+
+    for (size_t i = 0, first = 0; i < groups; ++i)
+    {
+        const size_t size = (count - first) / (groups - i);
+
+        const auto sections = &m_sections[first];
+        const auto states = &(*state)[first];
+
+        switch (size)
+        {
+        case 1:
+            filterGroup(sections, states, output, std::make_index_sequence<1>());
+            break;
+
+        case 2:
+            filterGroup(sections, states, output, std::make_index_sequence<2>());
+            break;
+
+        case 3:
+            filterGroup(sections, states, output, std::make_index_sequence<3>());
+            break;
+
+        case 4:
+            filterGroup(sections, states, output, std::make_index_sequence<4>());
+            break;
+        }
+
+        first += size;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
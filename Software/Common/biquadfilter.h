@@ -0,0 +1,90 @@
+/**************************************************************************************************
+ *                                                                                                *
+ *  This file is part of the ISF Utilities collection.                                            *
+ *                                                                                                *
+ *  Author:                                                                                       *
+ *  Marcel Hasler <marcel.hasler@h-brs.de>                                                        *
+ *                                                                                                *
+ *  Copyright (c) 2022                                                                            *
+ *  Bonn-Rhein-Sieg University of Applied Sciences                                                *
+ *                                                                                                *
+ *  Redistribution and use in source and binary forms, with or without modification,              *
+ *  are permitted provided that the following conditions are met:                                 *
+ *                                                                                                *
+ *  1. Redistributions of source code must retain the above copyright notice,                     *
+ *     this list of conditions and the following disclaimer.                                      *
+ *                                                                                                *
+ *  2. Redistributions in binary form must reproduce the above copyright notice,                  *
+ *     this list of conditions and the following disclaimer in the documentation                  *
+ *     and/or other materials provided with the distribution.                                     *
+ *                                                                                                *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"                   *
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED             *
+ *  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.            *
+ *  IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,              *
+ *  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT            *
+ *  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR            *
+ *  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,             *
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)            *
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE                    *
+ *  POSSIBILITY OF SUCH DAMAGE.                                                                   *
+ *                                                                                                *
+ **************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+class BiquadFilter
+{
+public:
+    static constexpr double MinimumFrequency = 0.0;
+    static constexpr double MaximumFrequency = 0.5;
+
+    static constexpr size_t DefaultLowPassOrder = 4;
+
+    // Delay line of every section, used and updated by the causal mode
+    using State = std::vector<std::array<double, 2>>;
+
+public:
+    // Number of second-order sections
+    auto size() const -> size_t;
+
+    // Magnitude response at the given frequency, relative to the sample rate
+    auto response(double f) const -> double;
+
+    // Causal, continues from the given state. An empty state is initialized as if the first input
+    // sample had been applied forever.
+    void apply(std::span<const double> input, std::span<double> output, State* state) const;
+
+    // Zero-phase, forward and backward. Thread-safe, the scratch buffer is kept per thread.
+    void apply(std::span<const double> input, std::span<double> output) const;
+
+    auto operator*(const BiquadFilter& rhs) const -> BiquadFilter;
+
+    static auto notch(double fl, double fh) -> BiquadFilter;
+
+    // Butterworth, the order must be even
+    static auto lowPass(double fc, size_t order = DefaultLowPassOrder) -> BiquadFilter;
+
+private:
+    // Normalized to a0 = 1
+    struct Section
+    {
+        double b0;
+        double b1;
+        double b2;
+        double a1;
+        double a2;
+    };
+
+    BiquadFilter() = default;
+
+    void initialize(double input, State* state) const;
+    void filter(std::span<const double> input, std::span<double> output, State* state) const;
+
+private:
+    std::vector<Section> m_sections;
+};
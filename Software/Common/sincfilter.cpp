@@ -34,17 +34,138 @@
 #include "sincfilter.h"
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cmath>
+#include <complex>
 #include <functional>
+#include <memory>
 #include <numeric>
 
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define SINCFILTER_SSE2
+#endif
+
 // ---------------------------------------------------------------------------------------------- //
 
 namespace {
     constexpr double Pi = 3.14159265358979323846;
     constexpr double TwoPi = 2.0 * Pi;
     constexpr double FourPi = 4.0 * Pi;
+
+    // Below these sizes the vectorized direct convolution is faster than the FFT
+    constexpr size_t MinimumFftKernelSize = 96;
+    constexpr size_t MinimumFftSignalToKernelRatio = 4;
+
+    // Below this size the padding costs more than the vectorized direct convolution saves
+    constexpr size_t MinimumVectorKernelSize = 8;
+
+    using Complex = std::complex<double>;
+
+    // Plain complex product, without the checks for infinite values of operator*
+    inline auto multiply(const Complex& a, const Complex& b) -> Complex
+    {
+        return { a.real() * b.real() - a.imag() * b.imag(),
+                 a.real() * b.imag() + a.imag() * b.real() };
+    }
+
+    // In-place iterative radix-2 FFT without scaling, the size must be a power of two
+    class Fft
+    {
+    public:
+        explicit Fft(size_t size)
+            : m_forward(size / 2),
+              m_inverse(size / 2),
+              m_reversed(size)
+        {
+            assert(std::has_single_bit(size));
+
+            for (size_t i = 0; i < m_forward.size(); ++i)
+            {
+                m_forward[i] = std::polar(1.0, -TwoPi * i / size);
+                m_inverse[i] = std::conj(m_forward[i]);
+            }
+
+            const int bits = std::countr_zero(size);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                size_t reversed = 0;
+
+                for (int bit = 0; bit < bits; ++bit)
+                    reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+
+                m_reversed[i] = reversed;
+            }
+        }
+
+        void transform(std::vector<Complex>& data, bool inverse) const
+        {
+            const size_t size = data.size();
+            assert(size == m_reversed.size());
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (i < m_reversed[i])
+                    std::swap(data[i], data[m_reversed[i]]);
+            }
+
+            const std::vector<Complex>& twiddles = inverse ? m_inverse : m_forward;
+
+            for (size_t length = 2; length <= size; length <<= 1)
+            {
+                const size_t half = length / 2;
+                const size_t stride = size / length;
+
+                for (size_t i = 0; i < size; i += length)
+                {
+                    Complex* lower = &data[i];
+                    Complex* upper = &data[i + half];
+
+                    for (size_t j = 0; j < half; ++j)
+                    {
+                        const Complex v = multiply(upper[j], twiddles[j * stride]);
+
+                        upper[j] = lower[j] - v;
+                        lower[j] += v;
+                    }
+                }
+            }
+        }
+
+    private:
+        std::vector<Complex> m_forward;
+        std::vector<Complex> m_inverse;
+        std::vector<size_t> m_reversed;
+    };
+
+    // Everything that only depends on the kernel, kept per thread for repeated use of a filter
+    struct FftPlan
+    {
+        explicit FftPlan(std::span<const double> kernel)
+            : kernel(kernel.begin(), kernel.end()),
+              blockSize(std::bit_ceil(4 * kernel.size())),
+              fft(blockSize),
+              response(blockSize),
+              block(blockSize),
+              segment(blockSize)
+        {
+            // The scaling of the inverse transform is applied to the kernel response right away
+            std::transform(kernel.begin(), kernel.end(), response.begin(),
+                           [this](double c) { return c / blockSize; });
+
+            fft.transform(response, false);
+        }
+
+        std::vector<double> kernel;
+        size_t blockSize;
+        Fft fft;
+        std::vector<Complex> response;
+
+        std::vector<Complex> block;
+        std::vector<double> segment;
+    };
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -97,7 +218,8 @@ auto SincFilter::coefficients() const -> const std::vector<double>&
 
 // ---------------------------------------------------------------------------------------------- //
 
-void SincFilter::apply(std::span<const double> input, std::span<double> output, double scale)
+void SincFilter::apply(std::span<const double> input, std::span<double> output,
+                       double scale) const
 {
     convolve(input, m_coeffs, output);
 
@@ -223,13 +345,165 @@ void SincFilter::convolve(std::span<const double> in1, std::span<const double> i
 {
     assert(out.size() >= in1.size() + in2.size() - 1);
 
+    const auto [signal, kernel] = std::minmax(in1, in2, [](const auto& a, const auto& b) {
+        return a.size() > b.size();
+    });
+
+    // The direct path keeps the order of the inputs, so it sums up in the original order
+    if (kernel.size() >= MinimumFftKernelSize
+            && signal.size() >= MinimumFftSignalToKernelRatio * kernel.size())
+        convolveFft(signal, kernel, out);
+    else
+        convolveDirect(in1, in2, out);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SincFilter::convolveDirect(std::span<const double> signal, std::span<const double> kernel,
+                                std::span<double> out)
+{
+#if defined(SINCFILTER_SSE2)
+    if (kernel.size() >= MinimumVectorKernelSize)
+    {
+        convolveVector(signal, kernel, out);
+        return;
+    }
+#endif
+
     std::fill(out.begin(), out.end(), 0.0);
 
-    for (size_t i = 0; i < in1.size(); ++i)
+    for (size_t i = 0; i < signal.size(); ++i)
+    {
+        for (size_t j = 0; j < kernel.size(); ++j)
+            out[i + j] += signal[i] * kernel[j];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(SINCFILTER_SSE2)
+
+// The outputs are computed in blocks of eight, accumulated in registers. Each kernel tap is
+// multiplied with the adjacent signal values of the block, so the products of each output are added
+// in the same order as in the plain nested loop and the result is the same for finite input.
+void SincFilter::convolveVector(std::span<const double> signal, std::span<const double> kernel,
+                                std::span<double> out)
+{
+    static constexpr size_t Block = 8;
+
+    const size_t overlap = kernel.size() - 1;
+    const size_t outputSize = signal.size() + overlap;
+
+    // Zeros on both sides let the first and last blocks read beyond the signal
+    thread_local std::vector<double> padded;
+
+    padded.assign(outputSize + overlap + Block, 0.0);
+    std::copy(signal.begin(), signal.end(), padded.begin() + overlap);
+
+    for (size_t first = 0; first < outputSize; first += Block)
+    {
+        // Only the taps that meet the signal for at least one output of the block
+        const size_t begin = first >= signal.size() ? first - signal.size() + 1 : 0;
+        const size_t end = std::min(first + Block, kernel.size());
+
+        __m128d sum0 = _mm_setzero_pd();
+        __m128d sum1 = _mm_setzero_pd();
+        __m128d sum2 = _mm_setzero_pd();
+        __m128d sum3 = _mm_setzero_pd();
+
+        for (size_t j = end; j-- > begin;)
+        {
+            const __m128d h = _mm_set1_pd(kernel[j]);
+            const double* x = padded.data() + first + overlap - j;
+
+            sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(x), h));
+            sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(x + 2), h));
+            sum2 = _mm_add_pd(sum2, _mm_mul_pd(_mm_loadu_pd(x + 4), h));
+            sum3 = _mm_add_pd(sum3, _mm_mul_pd(_mm_loadu_pd(x + 6), h));
+        }
+
+        double result[Block];
+
+        _mm_storeu_pd(result, sum0);
+        _mm_storeu_pd(result + 2, sum1);
+        _mm_storeu_pd(result + 4, sum2);
+        _mm_storeu_pd(result + 6, sum3);
+
+        std::copy_n(result, std::min(Block, outputSize - first), out.begin() + first);
+    }
+
+    std::fill(out.begin() + outputSize, out.end(), 0.0);
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Overlap-save: the signal, padded with zeros on both sides, is split into overlapping blocks.
+// Since the kernel is real, two blocks are transformed at once as real and imaginary part.
+void SincFilter::convolveFft(std::span<const double> signal, std::span<const double> kernel,
+                             std::span<double> out)
+{
+    thread_local std::unique_ptr<FftPlan> plan;
+
+    if (!plan || !std::equal(kernel.begin(), kernel.end(), plan->kernel.begin(), plan->kernel.end()))
+        plan = std::make_unique<FftPlan>(kernel);
+
+    const size_t overlap = kernel.size() - 1;
+    const size_t blockSize = plan->blockSize;
+    const size_t step = blockSize - overlap;
+
+    const size_t outputSize = signal.size() + overlap;
+
+    const Fft& fft = plan->fft;
+    const std::vector<Complex>& response = plan->response;
+
+    std::vector<Complex>& block = plan->block;
+    std::vector<double>& segment = plan->segment;
+
+    // Returns the block of the padded signal starting at the given position
+    const auto load = [&](size_t first) -> const std::vector<double>& {
+        std::fill(segment.begin(), segment.end(), 0.0);
+
+        const size_t begin = std::max(first, overlap);
+        const size_t end = std::min(first + blockSize, signal.size() + overlap);
+
+        if (begin < end)
+            std::copy(signal.begin() + (begin - overlap), signal.begin() + (end - overlap),
+                      segment.begin() + (begin - first));
+
+        return segment;
+    };
+
+    for (size_t first = 0; first < outputSize; first += 2 * step)
     {
-        for (size_t j = 0; j < in2.size(); ++j)
-            out[i + j] += in1[i] * in2[j];
+        const size_t second = first + step;
+
+        const std::vector<double>& real = load(first);
+
+        for (size_t i = 0; i < blockSize; ++i)
+            block[i] = real[i];
+
+        const std::vector<double>& imag = load(second);
+
+        for (size_t i = 0; i < blockSize; ++i)
+            block[i].imag(imag[i]);
+
+        fft.transform(block, false);
+
+        for (size_t i = 0; i < blockSize; ++i)
+            block[i] = multiply(block[i], response[i]);
+
+        fft.transform(block, true);
+
+        for (size_t i = 0; i < step && first + i < outputSize; ++i)
+            out[first + i] = block[overlap + i].real();
+
+        for (size_t i = 0; i < step && second + i < outputSize; ++i)
+            out[second + i] = block[overlap + i].imag();
     }
+
+    std::fill(out.begin() + outputSize, out.end(), 0.0);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -57,7 +57,9 @@ public:
     auto size() const -> size_t;
     auto coefficients() const -> const std::vector<double>&;
 
-    void apply(std::span<const double> input, std::span<double> output, double scale = 1.0);
+    // Thread-safe, the coefficients are never modified after construction
+    void apply(std::span<const double> input, std::span<double> output,
+               double scale = 1.0) const;
 
     auto operator+(const SincFilter& rhs) const -> SincFilter;
     auto operator-(const SincFilter& rhs) const -> SincFilter;
@@ -87,6 +89,15 @@ private:
     static void convolve(std::span<const double> in1, std::span<const double> in2,
                          std::span<double> out);
 
+    static void convolveDirect(std::span<const double> signal, std::span<const double> kernel,
+                               std::span<double> out);
+
+    static void convolveVector(std::span<const double> signal, std::span<const double> kernel,
+                               std::span<double> out);
+
+    static void convolveFft(std::span<const double> signal, std::span<const double> kernel,
+                            std::span<double> out);
+
 private:
     std::vector<double> m_coeffs;
 };
@@ -0,0 +1,80 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+// Minimal checks for the test executables registered with CTest. A failed check is reported
+// and the test continues, result() turns the failures into the exit code.
+namespace Testing {
+
+inline int failureCount = 0;
+
+inline auto check(bool condition, const char* expression, const char* file, int line) -> bool
+{
+    if (!condition)
+    {
+        std::cerr << file << ":" << line << ": Check failed: " << expression << std::endl;
+        ++failureCount;
+    }
+
+    return condition;
+}
+
+inline auto checkNear(double value, double expected, double tolerance,
+                      const char* expression, const char* file, int line) -> bool
+{
+    const bool condition = std::abs(value - expected) <= tolerance;
+
+    if (!condition)
+    {
+        std::cerr << file << ":" << line << ": Check failed: " << expression << " ("
+                  << value << " instead of " << expected << " +/- " << tolerance << ")"
+                  << std::endl;
+        ++failureCount;
+    }
+
+    return condition;
+}
+
+inline auto result() -> int
+{
+    if (failureCount > 0)
+        std::cerr << failureCount << " check(s) failed." << std::endl;
+
+    return failureCount > 0 ? 1 : 0;
+}
+
+} // End of namespace Testing
+
+#define CHECK(condition) \
+    Testing::check((condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_NEAR(value, expected, tolerance) \
+    Testing::checkNear((value), (expected), (tolerance), #value, __FILE__, __LINE__)
+
+#define CHECK_THROWS(statement) \
+    Testing::check([&] { try { statement; } catch (...) { return true; } return false; }(), \
+                   #statement " throws", __FILE__, __LINE__)
@@ -42,8 +42,10 @@ SOURCES += \
     analysiswidget.cpp \
     deviceselectiondialog.cpp \
     devicewrapper.cpp \
+    deviceworker.cpp \
     main.cpp \
     mainwindow.cpp \
+    minmaxdecimator.cpp \
     plotwidget.cpp \
     sensorwrapper.cpp \
     setupwidget.cpp
@@ -54,7 +56,9 @@ HEADERS += \
     device.h \
     deviceselectiondialog.h \
     devicewrapper.h \
+    deviceworker.h \
     mainwindow.h \
+    minmaxdecimator.h \
     plotwidget.h \
     sensorwrapper.h \
     setupwidget.h \
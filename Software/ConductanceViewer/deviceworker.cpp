@@ -0,0 +1,226 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "deviceworker.h"
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr std::chrono::milliseconds DeferredTimeout =    0ms;
+    constexpr std::chrono::milliseconds DefaultTimeout  =  500ms;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+class DeviceWorker::Listener : public Device::Listener
+{
+public:
+    Listener(DeviceWorker* owner);
+
+private:
+    void onDataAvailable(const Device::Data& data) override;
+    void onError(const std::string& msg) override;
+
+private:
+    DeviceWorker* m_owner;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceWorker::DeviceWorker(const DeviceInfo& info)
+    : m_listener(std::make_unique<Listener>(this)),
+      m_device(info),
+      m_powerTimer(this)
+{
+    m_device.addListener(m_listener.get());
+
+    const std::array<bool, Device::InputCount> inputsConnected = m_device.getInputsConnected();
+
+    for (size_t i = 0; i < Device::InputCount; ++i)
+    {
+        if (inputsConnected[i])
+        {
+            // Parented, so that it moves to the worker thread along with its timer
+            m_sensors[i] = std::make_unique<SensorWrapper>(&m_device, Device::toInput(i),
+                                                           &m_dataBuffers[i], this);
+
+            auto ptr = m_sensors[i].get();
+            connect(ptr,  SIGNAL(analysisComplete(Device::Input,double,double,double)),
+                    this, SIGNAL(analysisComplete(Device::Input,double,double,double)));
+        }
+    }
+
+    m_powerTimer.setSingleShot(true);
+    connect(&m_powerTimer, SIGNAL(timeout()), this, SLOT(updatePowerValues()));
+
+    restartPowerTimer(DeferredTimeout);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceWorker::~DeviceWorker() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto DeviceWorker::inputsConnected() const -> std::array<bool, Device::InputCount>
+{
+    std::array<bool, Device::InputCount> connected = {};
+
+    for (size_t i = 0; i < Device::InputCount; ++i)
+        connected[i] = m_sensors[i] != nullptr;
+
+    return connected;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::startCapture()
+{
+    try {
+        m_device.startCapture();
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::stopCapture()
+{
+    try {
+        m_device.stopCapture();
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::setGain(Device::Input input, Device::Gain gain)
+{
+    auto& sensor = m_sensors[Device::indexOf(input)];
+    Q_ASSERT(sensor != nullptr);
+
+    try {
+        sensor->setGain(gain);
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::setupSignal(Device::Input input,
+                               Device::Waveform waveform, unsigned int frequency, double amplitude)
+{
+    auto& sensor = m_sensors[Device::indexOf(input)];
+    Q_ASSERT(sensor != nullptr);
+
+    try {
+        sensor->setupSignal(waveform, frequency, amplitude);
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::setLeadResistance(Device::Input input, unsigned int milliohm)
+{
+    auto& sensor = m_sensors[Device::indexOf(input)];
+    Q_ASSERT(sensor != nullptr);
+
+    sensor->setLeadResistance(milliohm);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::handleDataAvailable(const SharedData& data)
+{
+    for (size_t i = 0; i < Device::InputCount; ++i)
+    {
+        auto& sensor = m_sensors[i];
+
+        if (sensor)
+            sensor->update(*data);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::updatePowerValues()
+{
+    restartPowerTimer(DefaultTimeout);
+
+    try {
+        const Device::PowerValues values = m_device.getPowerValues();
+        emit powerUpdated(values);
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::restartPowerTimer(std::chrono::milliseconds ms)
+{
+    m_powerTimer.stop();
+    m_powerTimer.start(ms);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceWorker::Listener::Listener(DeviceWorker* owner)
+    : m_owner(owner) {}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::Listener::onDataAvailable(const Device::Data& data)
+{
+    // Shared by the plots and the analysis, which must not wait for each other
+    const auto shared = std::make_shared<const Device::Data>(data);
+
+    emit m_owner->dataAvailable(shared);
+
+    QMetaObject::invokeMethod(m_owner, "handleDataAvailable", Qt::QueuedConnection,
+                              Q_ARG(DeviceWorker::SharedData, shared));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::Listener::onError(const std::string& msg)
+{
+    QMetaObject::invokeMethod(m_owner, "error", Qt::QueuedConnection,
+                              Q_ARG(QString, msg.c_str()));
+}
+
+// ---------------------------------------------------------------------------------------------- //
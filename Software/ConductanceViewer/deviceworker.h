@@ -0,0 +1,98 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "device.h"
+#include "sensorwrapper.h"
+
+#include <QObject>
+#include <QTimer>
+
+#include <chrono>
+#include <memory>
+
+// Owns the device and runs the control transfers and the analysis. Lives on its own thread, so a
+// slow device never stalls the GUI.
+class DeviceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    using SharedData = std::shared_ptr<const Device::Data>;
+
+public:
+    explicit DeviceWorker(const DeviceInfo& info);
+    ~DeviceWorker() override;
+
+    DeviceWorker(const DeviceWorker&) = delete;
+    auto operator=(const DeviceWorker&) = delete;
+
+    DeviceWorker(DeviceWorker&&) = delete;
+    auto operator=(DeviceWorker&&) = delete;
+
+    auto inputsConnected() const -> std::array<bool, Device::InputCount>;
+
+public slots:
+    void startCapture();
+    void stopCapture();
+
+    void setGain(Device::Input input, Device::Gain gain);
+
+    void setupSignal(Device::Input input,
+                     Device::Waveform waveform, unsigned int frequency, double amplitude);
+
+    void setLeadResistance(Device::Input input, unsigned int milliohm);
+
+signals:
+    // Emitted on the capture thread as soon as the data arrives
+    void dataAvailable(const DeviceWorker::SharedData& data);
+
+    void error(const QString& msg);
+
+    void analysisComplete(Device::Input input,
+                          double voltage, double current, double admittance);
+
+    void powerUpdated(const Device::PowerValues& values);
+
+private slots:
+    void handleDataAvailable(const DeviceWorker::SharedData& data);
+    void updatePowerValues();
+
+private:
+    void restartPowerTimer(std::chrono::milliseconds ms);
+
+private:
+    class Listener;
+    std::unique_ptr<Listener> m_listener;
+
+    Device m_device;
+
+    std::array<DataBuffer, Device::InputCount> m_dataBuffers = {
+        Device::Input::One, Device::Input::Two
+    };
+
+    std::array<std::unique_ptr<SensorWrapper>, Device::InputCount> m_sensors;
+
+    QTimer m_powerTimer;
+};
@@ -25,94 +25,72 @@
 
 // ---------------------------------------------------------------------------------------------- //
 
-namespace {
-    constexpr std::chrono::milliseconds DeferredTimeout =    0ms;
-    constexpr std::chrono::milliseconds DefaultTimeout  =  500ms;
-}
-
-// ---------------------------------------------------------------------------------------------- //
-
-class DeviceWrapper::Listener : public Device::Listener
+DeviceWrapper::DeviceWrapper(const DeviceInfo& info,
+                             const std::array<DataBuffer*, Device::InputCount>& data)
+    : m_dataBuffers(data)
 {
-public:
-    Listener(DeviceWrapper* owner);
+    auto worker = std::make_unique<DeviceWorker>(info);
+    m_inputsConnected = worker->inputsConnected();
 
-private:
-    void onDataAvailable(const Device::Data& data) override;
-    void onError(const std::string& msg) override;
+    m_worker = worker.release();
+    m_worker->moveToThread(&m_thread);
 
-private:
-    DeviceWrapper* m_owner;
-};
+    connect(&m_thread, SIGNAL(finished()), m_worker, SLOT(deleteLater()));
 
-// ---------------------------------------------------------------------------------------------- //
+    connect(m_worker, SIGNAL(dataAvailable(DeviceWorker::SharedData)),
+            this, SLOT(handleDataAvailable(DeviceWorker::SharedData)));
 
-DeviceWrapper::DeviceWrapper(const DeviceInfo& info,
-                             const std::array<DataBuffer*, Device::InputCount>& data)
-    : m_listener(std::make_unique<Listener>(this)),
-      m_device(info),
-      m_powerTimer(this)
-{
-    m_device.addListener(m_listener.get());
+    connect(m_worker, SIGNAL(error(QString)), this, SIGNAL(error(QString)));
 
-    const std::array<bool, Device::InputCount> inputsConnected = m_device.getInputsConnected();
-
-    for (size_t i = 0; i < Device::InputCount; ++i)
-    {
-        if (inputsConnected[i])
-        {
-            m_sensors[i] = std::make_unique<SensorWrapper>(&m_device, Device::toInput(i), data[i]);
-
-            auto ptr = m_sensors[i].get();
-            connect(ptr,  SIGNAL(analysisComplete(Device::Input,double,double,double)),
-                    this, SIGNAL(analysisComplete(Device::Input,double,double,double)));
-        }
-    }
+    connect(m_worker, SIGNAL(analysisComplete(Device::Input,double,double,double)),
+            this, SIGNAL(analysisComplete(Device::Input,double,double,double)));
 
-    m_powerTimer.setSingleShot(true);
-    connect(&m_powerTimer, SIGNAL(timeout()), this, SLOT(updatePowerValues()));
+    connect(m_worker, SIGNAL(powerUpdated(Device::PowerValues)),
+            this, SIGNAL(powerUpdated(Device::PowerValues)));
 
-    restartPowerTimer(DeferredTimeout);
+    m_thread.start();
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-DeviceWrapper::~DeviceWrapper() = default;
+DeviceWrapper::~DeviceWrapper()
+{
+    // Nothing may be posted to this object once it is gone. Signals that are already queued are
+    // removed along with it, so a later wrapper never receives anything from this worker.
+    m_worker->disconnect(this);
+
+    // Waits for a pending transfer at most, the worker and the device are deleted on the thread
+    m_thread.quit();
+    m_thread.wait();
+}
 
 // ---------------------------------------------------------------------------------------------- //
 
 void DeviceWrapper::startCapture()
 {
-    m_device.startCapture();
+    QMetaObject::invokeMethod(m_worker, "startCapture", Qt::QueuedConnection);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void DeviceWrapper::stopCapture()
 {
-    m_device.stopCapture();
+    QMetaObject::invokeMethod(m_worker, "stopCapture", Qt::QueuedConnection);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 auto DeviceWrapper::inputConnected(Device::Input input) const -> bool
 {
-    return m_sensors[Device::indexOf(input)] != nullptr;
+    return m_inputsConnected[Device::indexOf(input)];
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void DeviceWrapper::setGain(Device::Input input, Device::Gain gain)
 {
-    auto& sensor = m_sensors[Device::indexOf(input)];
-    Q_ASSERT(sensor != nullptr);
-
-    try {
-        sensor->setGain(gain);
-    }
-    catch (const std::exception& e) {
-        emit error(e.what());
-    }
+    QMetaObject::invokeMethod(m_worker, "setGain", Qt::QueuedConnection,
+                              Q_ARG(Device::Input, input), Q_ARG(Device::Gain, gain));
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -120,84 +98,30 @@ void DeviceWrapper::setGain(Device::Input input, Device::Gain gain)
 void DeviceWrapper::setupSignal(Device::Input input,
                                 Device::Waveform waveform, unsigned int frequency, double amplitude)
 {
-    auto& sensor = m_sensors[Device::indexOf(input)];
-    Q_ASSERT(sensor != nullptr);
-
-    try {
-        sensor->setupSignal(waveform, frequency, amplitude);
-    }
-    catch (const std::exception& e) {
-        emit error(e.what());
-    }
+    QMetaObject::invokeMethod(m_worker, "setupSignal", Qt::QueuedConnection,
+                              Q_ARG(Device::Input, input), Q_ARG(Device::Waveform, waveform),
+                              Q_ARG(unsigned int, frequency), Q_ARG(double, amplitude));
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void DeviceWrapper::setLeadResistance(Device::Input input, unsigned int milliohm)
 {
-    auto& sensor = m_sensors[Device::indexOf(input)];
-    Q_ASSERT(sensor != nullptr);
-
-    sensor->setLeadResistance(milliohm);
+    QMetaObject::invokeMethod(m_worker, "setLeadResistance", Qt::QueuedConnection,
+                              Q_ARG(Device::Input, input), Q_ARG(unsigned int, milliohm));
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void DeviceWrapper::handleDataAvailable(const Device::Data& data)
+void DeviceWrapper::handleDataAvailable(const DeviceWorker::SharedData& data)
 {
     for (size_t i = 0; i < Device::InputCount; ++i)
     {
-        auto& sensor = m_sensors[i];
-
-        if (sensor)
-            sensor->update(data);
+        if (m_inputsConnected[i])
+            m_dataBuffers[i]->update(*data);
     }
 
     emit dataUpdated();
 }
 
 // ---------------------------------------------------------------------------------------------- //
-
-void DeviceWrapper::updatePowerValues()
-{
-    restartPowerTimer(DefaultTimeout);
-
-    try {
-        const Device::PowerValues values = m_device.getPowerValues();
-        emit powerUpdated(values);
-    }
-    catch (const std::exception& e) {
-        emit error(e.what());
-    }
-}
-
-// ---------------------------------------------------------------------------------------------- //
-
-void DeviceWrapper::restartPowerTimer(std::chrono::milliseconds ms)
-{
-    m_powerTimer.stop();
-    m_powerTimer.start(ms);
-}
-
-// ---------------------------------------------------------------------------------------------- //
-
-DeviceWrapper::Listener::Listener(DeviceWrapper* owner)
-    : m_owner(owner) {}
-
-// ---------------------------------------------------------------------------------------------- //
-
-void DeviceWrapper::Listener::onDataAvailable(const Device::Data& data)
-{
-    QMetaObject::invokeMethod(m_owner, "handleDataAvailable", Qt::QueuedConnection,
-                              Q_ARG(Device::Data, data));
-}
-
-// ---------------------------------------------------------------------------------------------- //
-
-void DeviceWrapper::Listener::onError(const std::string& msg)
-{
-    QMetaObject::invokeMethod(m_owner, "error", Qt::QueuedConnection,
-                              Q_ARG(QString, msg.c_str()));
-}
-
-// ---------------------------------------------------------------------------------------------- //
@@ -23,17 +23,18 @@
 
 #pragma once
 
-#include "device.h"
-#include "sensorwrapper.h"
+#include "deviceworker.h"
 
 #include <QObject>
-#include <QTimer>
+#include <QThread>
 
 #include <chrono>
 #include <memory>
 
 using namespace std::chrono_literals;
 
+// Runs a DeviceWorker on its own thread. All calls return right away, errors are reported
+// through error().
 class DeviceWrapper : public QObject
 {
     Q_OBJECT
@@ -72,19 +73,12 @@ signals:
     void powerUpdated(const Device::PowerValues& values);
 
 private slots:
-    void handleDataAvailable(const Device::Data& data);
-    void updatePowerValues();
+    void handleDataAvailable(const DeviceWorker::SharedData& data);
 
 private:
-    void restartPowerTimer(std::chrono::milliseconds ms);
+    std::array<DataBuffer*, Device::InputCount> m_dataBuffers;
+    std::array<bool, Device::InputCount> m_inputsConnected = {};
 
-private:
-    class Listener;
-    std::unique_ptr<Listener> m_listener;
-
-    Device m_device;
-
-    std::array<std::unique_ptr<SensorWrapper>, Device::InputCount> m_sensors;
-
-    QTimer m_powerTimer;
+    QThread m_thread;
+    DeviceWorker* m_worker = nullptr; // Deleted on its thread once that finished
 };
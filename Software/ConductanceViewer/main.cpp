@@ -30,7 +30,11 @@
 auto main(int argc, char* argv[]) -> int
 {
     qRegisterMetaType<Device::Data>("Device::Data");
+    qRegisterMetaType<Device::Gain>("Device::Gain");
     qRegisterMetaType<Device::Input>("Device::Input");
+    qRegisterMetaType<Device::PowerValues>("Device::PowerValues");
+    qRegisterMetaType<Device::Waveform>("Device::Waveform");
+    qRegisterMetaType<DeviceWorker::SharedData>("DeviceWorker::SharedData");
 
     QCoreApplication::setOrganizationName("Bonn-Rhein-Sieg University of Applied Sciences");
     QCoreApplication::setApplicationName("ISF Conductance Viewer");
@@ -0,0 +1,223 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "minmaxdecimator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+MinMaxDecimator::MinMaxDecimator(const std::vector<double>& values, double sampleRate,
+                                 size_t cacheCount)
+    : m_values(values),
+      m_sampleRate(sampleRate),
+      m_period(values.size() - 1),
+      m_caches(cacheCount)
+{
+    assert(values.size() > 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MinMaxDecimator::refresh(uint64_t sampleCount)
+{
+    // The values were reset, so the caches cannot be updated incrementally
+    if (sampleCount < m_sampleCount)
+    {
+        for (auto& cache : m_caches)
+            cache.blockSize = 0;
+    }
+
+    m_sampleCount = sampleCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MinMaxDecimator::select(size_t cache, double minX, double maxX, int width,
+                             std::vector<size_t>* indices)
+{
+    indices->clear();
+
+    if (width <= 0 || maxX <= minX)
+        return;
+
+    const double size = static_cast<double>(m_values.size());
+
+    // Fractional sample positions of the column boundaries
+    const auto position = [&](int column) {
+        return std::clamp((minX + (maxX - minX) * column / width) * m_sampleRate, 0.0, size);
+    };
+
+    // One more sample on each side, for the lines leading out of the visible range
+    const auto first = static_cast<size_t>(
+        std::clamp(std::floor(minX * m_sampleRate) - 1.0, 0.0, size - 1.0));
+    const auto last = static_cast<size_t>(
+        std::clamp(std::ceil(maxX * m_sampleRate) + 1.0, 0.0, size - 1.0));
+
+    const double samplesPerColumn = (maxX - minX) * m_sampleRate / width;
+
+    if (samplesPerColumn < MinimumColumnSize)
+    {
+        for (size_t i = first; i <= last; ++i)
+            indices->push_back(i);
+
+        return;
+    }
+
+    // Each column combines a few cached blocks with the samples at its edges
+    const auto blockSize = static_cast<size_t>(std::sqrt(samplesPerColumn));
+
+    Cache& c = m_caches[cache];
+    update(&c, blockSize);
+
+    addIndex(first, indices);
+
+    auto begin = static_cast<size_t>(std::ceil(position(0)));
+
+    for (int column = 0; column < width; ++column)
+    {
+        const auto end = static_cast<size_t>(std::ceil(position(column + 1)));
+
+        if (begin < end)
+            addColumn(c, begin, end, indices);
+
+        begin = end;
+    }
+
+    addIndex(last, indices);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MinMaxDecimator::update(Cache* cache, size_t blockSize)
+{
+    const uint64_t newSamples = m_sampleCount - cache->sampleCount;
+
+    if (cache->blockSize != blockSize || m_sampleCount < cache->sampleCount
+            || newSamples >= m_period)
+    {
+        cache->blockSize = blockSize;
+        cache->blocks.resize((m_values.size() + blockSize - 1) / blockSize);
+
+        update(cache, 0, m_values.size());
+    }
+    else if (newSamples > 0)
+    {
+        const size_t end = m_sampleCount % m_period;
+        const size_t begin = (end + m_period - newSamples) % m_period;
+
+        if (begin < end)
+            update(cache, begin, end);
+        else
+        {
+            update(cache, begin, m_period);
+            update(cache, 0, end);
+        }
+
+        // The last sample repeats the first one
+        update(cache, m_period, m_values.size());
+    }
+
+    cache->sampleCount = m_sampleCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MinMaxDecimator::update(Cache* cache, size_t begin, size_t end)
+{
+    const size_t blockSize = cache->blockSize;
+
+    for (size_t i = begin / blockSize; i * blockSize < end; ++i)
+    {
+        const auto first = m_values.begin() + static_cast<ptrdiff_t>(i * blockSize);
+        const auto last = m_values.begin()
+                + static_cast<ptrdiff_t>(std::min((i + 1) * blockSize, m_values.size()));
+
+        const auto [minimum, maximum] = std::minmax_element(first, last);
+
+        cache->blocks[i].minimum = static_cast<uint32_t>(minimum - m_values.begin());
+        cache->blocks[i].maximum = static_cast<uint32_t>(maximum - m_values.begin());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MinMaxDecimator::addColumn(const Cache& cache, size_t begin, size_t end,
+                                std::vector<size_t>* indices) const
+{
+    size_t minimum = begin;
+    size_t maximum = begin;
+
+    const auto add = [&](size_t i) {
+        if (m_values[i] < m_values[minimum])
+            minimum = i;
+
+        if (m_values[i] > m_values[maximum])
+            maximum = i;
+    };
+
+    const size_t blockSize = cache.blockSize;
+
+    // Whole blocks from the cache, the partial ones at the edges sample by sample
+    const size_t firstBlock = (begin + blockSize - 1) / blockSize;
+    const size_t lastBlock = end / blockSize;
+
+    if (firstBlock >= lastBlock)
+    {
+        for (size_t i = begin; i < end; ++i)
+            add(i);
+    }
+    else
+    {
+        for (size_t i = begin; i < firstBlock * blockSize; ++i)
+            add(i);
+
+        for (size_t i = firstBlock; i < lastBlock; ++i)
+        {
+            add(cache.blocks[i].minimum);
+            add(cache.blocks[i].maximum);
+        }
+
+        for (size_t i = lastBlock * blockSize; i < end; ++i)
+            add(i);
+    }
+
+    addIndex(begin, indices);
+    addIndex(std::min(minimum, maximum), indices);
+    addIndex(std::max(minimum, maximum), indices);
+    addIndex(end - 1, indices);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+inline
+void MinMaxDecimator::addIndex(size_t index, std::vector<size_t>* indices)
+{
+    // Neighbouring extremes are often the same sample
+    if (indices->empty() || indices->back() < index)
+        indices->push_back(index);
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,83 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reduces the samples of every pixel column to the first, minimum, maximum and last one, in the
+// order they were sampled. Drawn as a polyline, these cover exactly the same pixels as all of the
+// samples.
+class MinMaxDecimator
+{
+public:
+    // Below this many samples per pixel column, every sample is selected
+    static constexpr double MinimumColumnSize = 4.0;
+
+public:
+    // The values are a ring of samples followed by a copy of the first one, sample i is at
+    // i / sampleRate. The extremes are cached separately for each of cacheCount views.
+    MinMaxDecimator(const std::vector<double>& values, double sampleRate, size_t cacheCount);
+
+    // Must be called whenever values were written, with the number written so far. The next
+    // one is written to sampleCount % (size - 1), a lower count means the values were reset.
+    void refresh(uint64_t sampleCount);
+
+    // Indices of the samples to draw from minX to maxX on the given number of pixel columns, in
+    // ascending order. Column k takes the samples in [minX + k*dx, minX + (k+1)*dx).
+    void select(size_t cache, double minX, double maxX, int width, std::vector<size_t>* indices);
+
+private:
+    // Indices of the extremes of a block of samples, blocks are smaller than a pixel column
+    struct Block
+    {
+        uint32_t minimum = 0;
+        uint32_t maximum = 0;
+    };
+
+    // Brought up to date with the new samples when selected
+    struct Cache
+    {
+        size_t blockSize = 0;
+        uint64_t sampleCount = 0;
+        std::vector<Block> blocks;
+    };
+
+    void update(Cache* cache, size_t blockSize);
+    void update(Cache* cache, size_t begin, size_t end);
+
+    void addColumn(const Cache& cache, size_t begin, size_t end,
+                   std::vector<size_t>* indices) const;
+
+    static void addIndex(size_t index, std::vector<size_t>* indices);
+
+private:
+    const std::vector<double>& m_values;
+    const double m_sampleRate;
+    const size_t m_period; // Samples in the ring
+
+    uint64_t m_sampleCount = 0;
+    std::vector<Cache> m_caches;
+};
@@ -22,17 +22,21 @@
 // ============================================================================================== //
 
 #include "device.h"
+#include "minmaxdecimator.h"
 #include "plotwidget.h"
 
 #include <qwt_plot_grid.h>
 #include <qwt_scale_draw.h>
+#include <qwt_series_data.h>
 #include <qwt_symbol.h>
 #include <qwt_text.h>
 
 #include <QApplication>
+#include <QResizeEvent>
 #include <QVBoxLayout>
 #include <QWheelEvent>
 
+#include <algorithm>
 #include <cmath> // for round()
 
 // ---------------------------------------------------------------------------------------------- //
@@ -45,6 +49,105 @@ namespace {
 
 // ---------------------------------------------------------------------------------------------- //
 
+// Selects the samples to draw with a MinMaxDecimator
+class PlotWidget::Data : public QwtSeriesData<QPointF>
+{
+public:
+    Data(const DataBuffer& buffer, Device::Channel channel);
+
+    // Must be called whenever the buffer was updated
+    void refresh();
+
+    // Brings the bounding rect up to date with the buffer, a pass over all samples
+    void updateBoundingRect();
+
+    // Selects the samples to draw for the given range and number of pixel columns
+    void select(ZoomLevel level, double minX, double maxX, int width);
+
+    auto size() const -> size_t override;
+    auto sample(size_t i) const -> QPointF override;
+    auto boundingRect() const -> QRectF override;
+
+private:
+    const std::vector<double>& m_offset;
+    const std::vector<double>& m_values;
+    const DataBuffer& m_buffer;
+
+    MinMaxDecimator m_decimator;
+    std::vector<size_t> m_indices;
+
+    QRectF m_boundingRect;
+    bool m_boundingRectValid = false;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+PlotWidget::Data::Data(const DataBuffer& buffer, Device::Channel channel)
+    : m_offset(buffer.offset()),
+      m_values(buffer.data(Device::toChannel(channel))),
+      m_buffer(buffer),
+      m_decimator(m_values, Device::SampleRate, ZoomLevelCount)
+{
+    refresh();
+    updateBoundingRect();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::Data::refresh()
+{
+    m_decimator.refresh(m_buffer.sampleCount());
+
+    // Updates arrive faster than the plot is drawn, so the extremes are only searched for when
+    // drawing
+    m_boundingRectValid = false;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::Data::updateBoundingRect()
+{
+    if (m_boundingRectValid)
+        return;
+
+    const auto [minimum, maximum] = std::minmax_element(m_values.begin(), m_values.end());
+    m_boundingRect = QRectF(m_offset.front(), *minimum,
+                            m_offset.back() - m_offset.front(), *maximum - *minimum);
+
+    m_boundingRectValid = true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::Data::select(ZoomLevel level, double minX, double maxX, int width)
+{
+    m_decimator.select(indexOf(level), minX, maxX, width, &m_indices);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PlotWidget::Data::size() const -> size_t
+{
+    return m_indices.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PlotWidget::Data::sample(size_t i) const -> QPointF
+{
+    const size_t index = m_indices[i];
+    return QPointF(m_offset[index], m_values[index]);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PlotWidget::Data::boundingRect() const -> QRectF
+{
+    return m_boundingRect;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 PlotWidget::PlotWidget(QWidget* parent)
     : QWidget(parent)
 {
@@ -79,6 +182,11 @@ PlotWidget::PlotWidget(QWidget* parent)
     m_curve->setPen(QPen(CurveColor, 2.0, Qt::SolidLine));
     m_curve->attach(m_plot);
 
+    m_replotTimer.setInterval(1000 / MaximumFrameRate);
+    m_replotTimer.setSingleShot(true);
+
+    connect(&m_replotTimer, SIGNAL(timeout()), this, SLOT(onReplotTimeout()));
+
     setAutoScale(false);
     scrollTo(0.0);
     updateAxisText();
@@ -88,10 +196,10 @@ PlotWidget::PlotWidget(QWidget* parent)
 
 void PlotWidget::setData(const DataBuffer& buffer, Device::Channel channel)
 {
-    const double* offset  = buffer.offset().data();
-    const double* values = buffer.data(Device::toChannel(channel)).data();
+    m_data = new Data(buffer, channel);
+    m_curve->setData(m_data);
 
-    m_curve->setRawSamples(offset, values, DataBuffer::DataSize);
+    draw();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -166,14 +274,24 @@ void PlotWidget::scrollTo(double seconds)
     }
 
     m_plot->setAxisScale(QwtPlot::xBottom, minValue, maxValue);
-    m_plot->replot();
+    draw();
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void PlotWidget::replot()
 {
-    m_plot->replot();
+    if (m_data)
+        m_data->refresh();
+
+    if (m_replotTimer.isActive())
+    {
+        m_replotPending = true;
+        return;
+    }
+
+    draw();
+    m_replotTimer.start();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -185,6 +303,27 @@ auto PlotWidget::toSeconds(ZoomLevel level) -> double
 
 // ---------------------------------------------------------------------------------------------- //
 
+void PlotWidget::onReplotTimeout()
+{
+    if (!m_replotPending)
+        return;
+
+    m_replotPending = false;
+
+    draw();
+    m_replotTimer.start();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    draw();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void PlotWidget::wheelEvent(QWheelEvent* event)
 {
     QWidget::wheelEvent(event);
@@ -207,6 +346,22 @@ void PlotWidget::setAxisText(QwtAxisId axis, const QString& text)
 
 // ---------------------------------------------------------------------------------------------- //
 
+void PlotWidget::draw()
+{
+    if (m_data)
+    {
+        const QwtInterval interval = m_plot->axisInterval(QwtPlot::xBottom);
+        const int width = m_plot->canvas()->contentsRect().width();
+
+        m_data->updateBoundingRect();
+        m_data->select(m_zoomLevel, interval.minValue(), interval.maxValue(), width);
+    }
+
+    m_plot->replot();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void PlotWidget::updateAxisZoom()
 {
     const QwtScaleDiv& scaleDiv = m_plot->axisScaleDiv(QwtPlot::xBottom);
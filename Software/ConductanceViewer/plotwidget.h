@@ -28,6 +28,8 @@
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
 
+#include <QTimer>
+
 class PlotWidget : public QWidget
 {
     Q_OBJECT
@@ -51,6 +53,8 @@ public:
     static constexpr auto MaximumZoomLevel = ZoomLevel::_5ms;
     static constexpr auto DefaultZoomLevel = ZoomLevel::_1000ms;
 
+    static constexpr int MaximumFrameRate = 30;
+
     template <typename T = size_t>
     static constexpr auto indexOf(ZoomLevel level) { return static_cast<T>(level); }
 
@@ -74,6 +78,7 @@ public:
 
     void scrollTo(double seconds);
 
+    // Picks up the new samples, but draws at most MaximumFrameRate times per second
     void replot();
 
     static auto toSeconds(ZoomLevel level) -> double;
@@ -81,16 +86,28 @@ public:
 signals:
     void scrollRequested(int amount);
 
+private slots:
+    void onReplotTimeout();
+
 private:
+    void resizeEvent(QResizeEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
 
+    void draw();
+
     void setAxisText(QwtAxisId axis, const QString& text);
 
     void updateAxisZoom();
     void updateAxisText();
 
 private:
+    class Data;
+    Data* m_data = nullptr;
+
     QwtPlot* m_plot = nullptr;
     QwtPlotCurve* m_curve = nullptr;
     ZoomLevel m_zoomLevel = DefaultZoomLevel;
+
+    QTimer m_replotTimer;
+    bool m_replotPending = false;
 };
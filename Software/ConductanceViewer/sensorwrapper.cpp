@@ -36,8 +36,10 @@ namespace {
 
 // ---------------------------------------------------------------------------------------------- //
 
-SensorWrapper::SensorWrapper(Device* device, Device::Input input, DataBuffer* buffer)
-    : m_device(device),
+SensorWrapper::SensorWrapper(Device* device, Device::Input input, DataBuffer* buffer,
+                             QObject* parent)
+    : QObject(parent),
+      m_device(device),
       m_input(input),
       m_dataBuffer(buffer),
       m_analysisTimer(this)
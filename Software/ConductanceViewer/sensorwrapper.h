@@ -33,7 +33,8 @@ class SensorWrapper : public QObject
     Q_OBJECT
 
 public:
-    SensorWrapper(Device* device, Device::Input input, DataBuffer* buffer);
+    SensorWrapper(Device* device, Device::Input input, DataBuffer* buffer,
+                  QObject* parent = nullptr);
 
     void setupSignal(Device::Waveform waveform, unsigned int frequency, double amplitude);
     void setGain(Device::Gain gain);
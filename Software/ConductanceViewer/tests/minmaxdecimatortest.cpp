@@ -0,0 +1,198 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "minmaxdecimator.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // As the DataBuffer of a conductance channel
+    constexpr double SampleRate = 10000.0;
+    constexpr size_t Period = 10000;
+
+    // Ring of samples followed by a copy of the first one
+    class Ring
+    {
+    public:
+        Ring() : values(Period + 1) {}
+
+        void write(size_t count, std::mt19937* generator)
+        {
+            std::normal_distribution<double> distribution(0.0, 1.0);
+
+            for (size_t i = 0; i < count; ++i)
+                values[sampleCount++ % Period] = distribution(*generator);
+
+            values.back() = values.front();
+        }
+
+        std::vector<double> values;
+        uint64_t sampleCount = 0;
+    };
+
+    // Every column must keep its first, minimum, maximum and last value, and nothing else
+    auto isExact(const std::vector<double>& values, const std::vector<size_t>& indices,
+                 double minX, double maxX, int width) -> bool
+    {
+        if (!std::is_sorted(indices.begin(), indices.end()))
+            return false;
+
+        const double size = static_cast<double>(values.size());
+
+        const auto boundary = [&](int column) {
+            const double position = (minX + (maxX - minX) * column / width) * SampleRate;
+            return static_cast<size_t>(std::ceil(std::clamp(position, 0.0, size)));
+        };
+
+        for (int column = 0; column < width; ++column)
+        {
+            const size_t begin = boundary(column);
+            const size_t end = boundary(column + 1);
+
+            if (begin >= end)
+                continue;
+
+            const auto first = std::lower_bound(indices.begin(), indices.end(), begin);
+            const auto last = std::lower_bound(indices.begin(), indices.end(), end);
+
+            if (first == last || *first != begin || *(last - 1) != end - 1 || last - first > 4)
+                return false;
+
+            const auto [minimum, maximum] = std::minmax_element(values.begin() + begin,
+                                                                values.begin() + end);
+            double selectedMinimum = values[*first];
+            double selectedMaximum = values[*first];
+
+            for (auto it = first; it != last; ++it)
+            {
+                selectedMinimum = std::min(selectedMinimum, values[*it]);
+                selectedMaximum = std::max(selectedMaximum, values[*it]);
+            }
+
+            if (selectedMinimum != *minimum || selectedMaximum != *maximum)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testColumns()
+{
+    std::mt19937 generator(42);
+
+    Ring ring;
+    ring.write(Period, &generator);
+
+    MinMaxDecimator decimator(ring.values, SampleRate, 1);
+    decimator.refresh(ring.sampleCount);
+
+    std::vector<size_t> indices;
+
+    // Ranges that do not start on a multiple of the samples per column, as when scrolled
+    struct View { double minX; double maxX; int width; };
+
+    for (const View& view : { View{ 0.0, 1.0, 850 }, View{ 0.0, 1.0, 997 },
+                              View{ 0.123456, 0.623456, 301 }, View{ 0.9001, 1.0, 7 },
+                              View{ -0.05, 0.3, 640 }, View{ 0.8, 1.1, 333 } })
+    {
+        decimator.select(0, view.minX, view.maxX, view.width, &indices);
+
+        if (!CHECK(isExact(ring.values, indices, view.minX, view.maxX, view.width)))
+            std::cerr << "  " << view.minX << " to " << view.maxX << " on " << view.width
+                      << " columns" << std::endl;
+
+        // Four points per column at most, plus one on each side
+        CHECK(indices.size() <= 4 * static_cast<size_t>(view.width) + 2);
+    }
+
+    // Few samples per column, all are drawn
+    decimator.select(0, 0.1, 0.11, 500, &indices);
+
+    CHECK(indices.size() == 103);
+    CHECK(indices.front() == 999 && indices.back() == 1101);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUpdates()
+{
+    std::mt19937 generator(7);
+
+    Ring ring;
+    MinMaxDecimator decimator(ring.values, SampleRate, 2);
+
+    std::vector<size_t> indices;
+    std::vector<size_t> expected;
+
+    // The cache is updated with the new samples only, across the end of the ring
+    for (size_t count : { 0, 200, 200, 5000, 4700, 400, 10000, 13 })
+    {
+        ring.write(count, &generator);
+        decimator.refresh(ring.sampleCount);
+
+        MinMaxDecimator fresh(ring.values, SampleRate, 1);
+        fresh.refresh(ring.sampleCount);
+
+        for (size_t cache : { 0, 1 })
+        {
+            const int width = cache == 0 ? 900 : 450;
+
+            decimator.select(cache, 0.0, 1.0, width, &indices);
+            fresh.select(0, 0.0, 1.0, width, &expected);
+
+            CHECK(indices == expected);
+            CHECK(isExact(ring.values, indices, 0.0, 1.0, width));
+        }
+    }
+
+    // A lower count means the values were reset, nothing of the cache can be kept
+    Ring cleared;
+    cleared.write(300, &generator);
+    ring.values = cleared.values;
+    ring.sampleCount = cleared.sampleCount;
+
+    decimator.refresh(ring.sampleCount);
+    decimator.select(0, 0.0, 1.0, 900, &indices);
+
+    CHECK(isExact(ring.values, indices, 0.0, 1.0, 900));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testColumns();
+    testUpdates();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -33,42 +33,60 @@ QMAKE_CXXFLAGS += -Wno-deprecated-enum-enum-conversion
 QMAKE_RPATHDIR += $ORIGIN
 
 INCLUDEPATH += include
-LIBS += -L. -lPotentiostat -lsft
+LIBS += -L. -lPotentiostat -lSerial -lsft
 
 DEFINES += APPLICATION_VERSION=\\\"1.0\\\"
 
 SOURCES += \
     CoSeSt2/CoSeSt2.cpp \
     aboutdialog.cpp \
+    biquadfilter.cpp \
     calibrationdialog.cpp \
+    datarecorder.cpp \
     devicelistener.cpp \
     fftplot.cpp \
     fftwindow.cpp \
     main.cpp \
     mainwindow.cpp \
     plotwidget.cpp \
+    recordingencoder.cpp \
+    recordingfile.cpp \
+    recordingindex.cpp \
+    recordingplot.cpp \
+    recordingwindow.cpp \
+    segmentbuffer.cpp \
     serialportwidget.cpp \
     setupwidget.cpp \
     signalfilter.cpp \
     sincfilter.cpp \
+    spectrogramwidget.cpp \
     storagewidget.cpp
 
 HEADERS += \
     CoSeSt2/CoSeSt2.h \
     aboutdialog.h \
     averagingbuffer.h \
+    biquadfilter.h \
     calibrationdialog.h \
+    datarecorder.h \
     device.h \
     devicelistener.h \
     fftplot.h \
     fftwindow.h \
     mainwindow.h \
     plotwidget.h \
+    recordingencoder.h \
+    recordingfile.h \
+    recordingindex.h \
+    recordingplot.h \
+    recordingwindow.h \
+    segmentbuffer.h \
     serialportwidget.h \
     settings.h \
     setupwidget.h \
     signalfilter.h \
     sincfilter.h \
+    spectrogramwidget.h \
     storagewidget.h
 
 FORMS += \
@@ -76,6 +94,7 @@ FORMS += \
     calibrationdialog.ui \
     fftwindow.ui \
     mainwindow.ui \
+    recordingwindow.ui \
     serialportwidget.ui \
     setupwidget.ui \
     storagewidget.ui
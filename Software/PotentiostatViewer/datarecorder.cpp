@@ -0,0 +1,229 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "datarecorder.h"
+
+#include <chrono>
+#include <filesystem>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr auto FlushInterval = 500ms;
+
+    constexpr size_t BufferSize = 4096 * RecordingEncoder::ColumnCount;
+    constexpr size_t MaxPendingValues = DataRecorder::MaxPendingSize / sizeof(double);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+DataRecorder::~DataRecorder()
+{
+    finish();
+    join();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto DataRecorder::fileExtension(FileType type) -> QString
+{
+    return (type == FileType::Binary) ? ".bin" : ".csv";
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::start(const QString& filename, FileType type, double sampleTime)
+{
+    Q_ASSERT(!m_active);
+
+    // The previous file may still be written
+    join();
+
+    m_file.clear();
+    m_file.open(std::filesystem::path(filename.toStdU16String()), std::ios::binary | std::ios::trunc);
+
+    if (!m_file)
+        throw Error("Unable to open file " + filename.toStdString() + " for writing.");
+
+    const std::string header = RecordingEncoder::header(type, sampleTime);
+    m_file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    m_filename = filename;
+    m_type = type;
+    m_active = true;
+
+    m_encoder.reset(sampleTime);
+
+    m_pending.clear();
+    m_finishing = false;
+    m_droppedRows = 0;
+    m_error.clear();
+
+    m_thread = std::thread(&DataRecorder::run, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::finish()
+{
+    if (!m_active)
+        return;
+
+    addRows(true);
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_finishing = true;
+    }
+
+    m_condition.notify_one();
+    m_active = false;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto DataRecorder::isActive() const -> bool
+{
+    return m_active;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::addSamples(std::span<const double> voltages, std::span<const double> currents)
+{
+    if (!m_active)
+        return;
+
+    m_encoder.addSamples(voltages, currents);
+
+    addRows(false);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::addFilteredSamples(std::span<const double> voltages,
+                                      std::span<const double> currents)
+{
+    if (!m_active)
+        return;
+
+    m_encoder.addFilteredSamples(voltages, currents);
+
+    addRows(false);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::addRows(bool finishing)
+{
+    bool notify = false;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        m_encoder.takeRows(m_pending, MaxPendingValues, finishing);
+        m_droppedRows = m_encoder.droppedRowCount();
+
+        notify = m_pending.size() >= BufferSize;
+    }
+
+    if (notify)
+        m_condition.notify_one();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::join()
+{
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::run()
+{
+    std::unique_lock lock(m_mutex);
+
+    for (;;)
+    {
+        m_condition.wait_for(lock, FlushInterval, [this] {
+            return m_finishing || m_pending.size() >= BufferSize;
+        });
+
+        // Nothing is added once finishing, so this is the last batch
+        const bool finishing = m_finishing;
+
+        std::swap(m_pending, m_writing);
+        lock.unlock();
+
+        if (!m_writing.empty())
+            write();
+
+        m_writing.clear();
+        lock.lock();
+
+        if (finishing)
+            break;
+    }
+
+    const uint64_t droppedRows = m_droppedRows;
+    lock.unlock();
+
+    m_file.close();
+
+    if (!m_file && m_error.empty())
+        m_error = "Unable to close file " + m_filename.toStdString() + ".";
+
+    if (droppedRows > 0 && m_error.empty())
+    {
+        m_error = std::to_string(droppedRows) + " rows were dropped because writing to file "
+                + m_filename.toStdString() + " fell behind.";
+    }
+
+    emit finished(m_filename, QString::fromStdString(m_error));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DataRecorder::write()
+{
+    // Rows are dropped after the first error, which is reported when finished
+    if (!m_file)
+        return;
+
+    m_buffer.clear();
+    RecordingEncoder::encode(m_type, m_writing, m_buffer);
+
+    m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    m_file.flush();
+
+    if (!m_file)
+        m_error = "Writing to file " + m_filename.toStdString() + " failed.";
+}
+
+// ---------------------------------------------------------------------------------------------- //
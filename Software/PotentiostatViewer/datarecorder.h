@@ -0,0 +1,107 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "recordingencoder.h"
+
+#include <QObject>
+#include <QString>
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Streams measurement data to a file on its own thread, so that neither long measurements nor
+// slow disks stall the GUI. The rows and file formats are those of RecordingEncoder. If the disk
+// falls behind by more than MaxPendingSize bytes, rows are dropped and reported when finished.
+class DataRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Error = std::runtime_error;
+
+    using FileType = RecordingEncoder::FileType;
+
+    static constexpr size_t MaxPendingSize = 64 << 20;
+    static constexpr auto DefaultFileType = FileType::Csv;
+
+public:
+    DataRecorder() = default;
+    ~DataRecorder() override;
+
+    static auto fileExtension(FileType type) -> QString;
+
+    // Throws if the file cannot be created
+    void start(const QString& filename, FileType type, double sampleTime);
+
+    // Writes the remaining rows and closes the file without waiting for it, finished() is
+    // emitted once done
+    void finish();
+
+    auto isActive() const -> bool;
+
+    void addSamples(std::span<const double> voltages, std::span<const double> currents);
+    void addFilteredSamples(std::span<const double> voltages, std::span<const double> currents);
+
+signals:
+    // The error is empty if all rows were written, dropped rows are an error
+    void finished(const QString& filename, const QString& error);
+
+private:
+    void addRows(bool finishing);
+    void join();
+
+    void run();
+    void write();
+
+private:
+    QString m_filename;
+    FileType m_type = DefaultFileType;
+    bool m_active = false;
+
+    // Only used by the GUI thread
+    RecordingEncoder m_encoder;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    // Protected by m_mutex
+    std::vector<double> m_pending;
+    bool m_finishing = false;
+    uint64_t m_droppedRows = 0;
+
+    // Only used by the writer thread
+    std::vector<double> m_writing;
+    std::string m_buffer;
+    std::ofstream m_file;
+    std::string m_error;
+
+    std::thread m_thread;
+};
@@ -29,6 +29,11 @@
 
 #include <QApplication>
 #include <QPen>
+#include <QScreen>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -48,8 +53,6 @@ public:
 FftPlot::FftPlot(QWidget* parent)
     : QwtPlot(parent),
       m_context(WindowSize),
-      m_samples(WindowSize),
-      m_filteredSamples(WindowSize),
       m_windowedSamples(WindowSize),
       m_results(SpectrumSize),
       m_frequencies(SpectrumSize),
@@ -85,6 +88,18 @@ FftPlot::FftPlot(QWidget* parent)
     m_curve->setPen(QPen(QColor(0x33, 0x22, 0x88), 2, Qt::SolidLine));
     m_curve->setData(m_data);
     m_curve->attach(this);
+
+    // Spectra are computed as samples arrive, but drawn at most once per frame
+    const QScreen* screen = QGuiApplication::primaryScreen();
+    const double refreshRate = screen ? screen->refreshRate() : 60.0;
+
+    m_refreshTimer.setInterval(static_cast<int>(1000.0 / refreshRate));
+    m_refreshTimer.setSingleShot(true);
+
+    connect(&m_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh()));
+
+    setSegmentCount(DefaultSegmentCount);
+    setOverlap(DefaultOverlap);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -92,7 +107,7 @@ FftPlot::FftPlot(QWidget* parent)
 void FftPlot::showEvent(QShowEvent* event)
 {
     QwtPlot::showEvent(event);
-    reprocess();
+    restart();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -121,39 +136,59 @@ void FftPlot::setTitle(const QString& title)
 void FftPlot::setFiltered(bool enable)
 {
     m_filtered = enable;
-    reprocess();
+    restart();
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void FftPlot::addSamples(std::span<const double> samples)
+void FftPlot::setOverlap(double overlap)
 {
-    std::copy(samples.begin(), samples.end(), std::back_inserter(m_samples));
+    Q_ASSERT(overlap >= 0.0 && overlap < 1.0);
+
+    const auto hopSize = static_cast<size_t>(std::lround(WindowSize * (1.0 - overlap)));
 
-    if (m_samples.size() > WindowSize)
-        m_samples.erase(m_samples.begin(), m_samples.end() - WindowSize);
+    m_samples.setHopSize(std::clamp<size_t>(hopSize, 1, WindowSize));
+    m_filteredSamples.setHopSize(m_samples.hopSize());
 
-    if (!m_filtered)
-        reprocess();
+    restart();
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void FftPlot::addFilteredSamples(std::span<const double> samples)
+void FftPlot::setSegmentCount(size_t count)
 {
-    std::copy(samples.begin(), samples.end(), std::back_inserter(m_filteredSamples));
+    Q_ASSERT(count > 0);
+
+    m_segments.assign(count, std::vector<double>(SpectrumSize));
+    restart();
+}
 
-    if (m_filteredSamples.size() > WindowSize)
-        m_filteredSamples.erase(m_filteredSamples.begin(), m_filteredSamples.end() - WindowSize);
+// ---------------------------------------------------------------------------------------------- //
 
-    if (m_filtered)
-        reprocess();
+void FftPlot::addSamples(std::span<const double> samples)
+{
+    append(&m_samples, samples, !m_filtered);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FftPlot::addFilteredSamples(std::span<const double> samples)
+{
+    append(&m_filteredSamples, samples, m_filtered);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void FftPlot::clear()
 {
+    m_samples.clear();
+    m_filteredSamples.clear();
+
+    m_nextSegment = 0;
+    m_segmentCount = 0;
+
+    m_refreshTimer.stop();
+
     std::fill(m_magnitudes.begin(), m_magnitudes.end(), 0.0);
     m_data->updateBoundingRect();
 
@@ -162,51 +197,97 @@ void FftPlot::clear()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void FftPlot::applyWindow(std::span<const double> in, std::span<double> out)
+void FftPlot::refresh()
 {
-    static constexpr double Pi = 3.14159265358979323846;
-    static constexpr double TwoPi = 2.0 * Pi;
+    if (!isVisible() || m_segmentCount == 0)
+        return;
 
-    Q_ASSERT(in.size() == out.size() && in.size() > 1);
+    for (size_t i = 0; i < SpectrumSize; ++i)
+    {
+        double power = 0.0;
 
-    const auto size = static_cast<int>(in.size());
-    const int m = size - 1;
+        for (size_t j = 0; j < m_segmentCount; ++j)
+            power += m_segments[j][i];
 
-    for (int i = 0; i < size; ++i)
-        out[i] = in[i] * (0.54 - 0.46*std::cos(TwoPi*i / m)); // Hamming
+        m_magnitudes[i] = std::sqrt(power / m_segmentCount) / WindowSize;
+
+        if (i != 0)
+            m_magnitudes[i] *= 2.0;
+    }
+
+    m_data->updateBoundingRect();
+
+    replot();
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void FftPlot::reprocess()
+void FftPlot::append(SegmentBuffer* buffer, std::span<const double> samples, bool active)
 {
+    buffer->append(samples, [&] {
+        if (active && isVisible())
+        {
+            addSegment(*buffer);
+
+            if (!m_refreshTimer.isActive())
+                m_refreshTimer.start();
+        }
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FftPlot::addSegment(const SegmentBuffer& buffer)
+{
+    buffer.applyWindow(m_window, m_windowedSamples);
+    m_context.transform(m_windowedSamples, m_results);
+
+    auto& power = m_segments[m_nextSegment];
+
+    for (size_t i = 0; i < SpectrumSize; ++i)
+        power[i] = std::norm(m_results[i]);
+
+    m_nextSegment = (m_nextSegment + 1) % m_segments.size();
+    m_segmentCount = std::min(m_segmentCount + 1, m_segments.size());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FftPlot::restart()
+{
+    m_nextSegment = 0;
+    m_segmentCount = 0;
+
     if (!isVisible())
         return;
 
-    if (m_filtered)
-    {
-        Q_ASSERT(m_filteredSamples.size() == WindowSize);
-        applyWindow(m_filteredSamples, m_windowedSamples);
-    }
-    else
+    const SegmentBuffer& buffer = m_filtered ? m_filteredSamples : m_samples;
+
+    // Start from the latest samples rather than waiting for a whole hop
+    if (buffer.isFull())
     {
-        Q_ASSERT(m_samples.size() == WindowSize);
-        applyWindow(m_samples, m_windowedSamples);
+        addSegment(buffer);
+        refresh();
     }
+}
 
-    m_context.transform(m_windowedSamples, m_results);
+// ---------------------------------------------------------------------------------------------- //
 
-    for (size_t i = 0; i < SpectrumSize; ++i)
-    {
-        m_magnitudes[i] = std::abs(m_results[i]) / WindowSize;
+auto FftPlot::makeWindow(size_t size) -> std::vector<double>
+{
+    static constexpr double Pi = 3.14159265358979323846;
+    static constexpr double TwoPi = 2.0 * Pi;
 
-        if (i != 0)
-            m_magnitudes[i] *= 2.0;
-    }
+    Q_ASSERT(size > 1);
 
-    m_data->updateBoundingRect();
+    std::vector<double> window(size);
 
-    replot();
+    const auto m = static_cast<double>(size - 1);
+
+    for (size_t i = 0; i < size; ++i)
+        window[i] = 0.54 - 0.46*std::cos(TwoPi*i / m); // Hamming
+
+    return window;
 }
 
 // ---------------------------------------------------------------------------------------------- //
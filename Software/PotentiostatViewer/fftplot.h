@@ -24,6 +24,7 @@
 #pragma once
 
 #include "device.h"
+#include "segmentbuffer.h"
 
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
@@ -31,6 +32,8 @@
 
 #include <sft/sft.h>
 
+#include <QTimer>
+
 #include <span>
 #include <vector>
 
@@ -44,24 +47,40 @@ public:
 
     static constexpr double MaximumFrequency = WindowSize * 0.5;
 
+    static constexpr double DefaultOverlap = 0.5;
+    static constexpr size_t DefaultSegmentCount = 4;
+
 public:
     FftPlot(QWidget* parent);
 
     void setTitle(const QString& title);
     void setFiltered(bool enable);
 
+    // Fraction of a segment shared with the previous one, a new segment is computed whenever
+    // the rest has been received
+    void setOverlap(double overlap);
+
+    // Number of segments whose power is averaged (Welch's method)
+    void setSegmentCount(size_t count);
+
     void addSamples(std::span<const double> samples);
     void addFilteredSamples(std::span<const double> samples);
 
     void clear();
 
+private slots:
+    void refresh();
+
 private:
     void showEvent(QShowEvent* event) override;
 
     void setTitle(QwtAxisId axis, const QString& text);
 
-    void applyWindow(std::span<const double> in, std::span<double> out);
-    void reprocess();
+    void append(SegmentBuffer* buffer, std::span<const double> samples, bool active);
+    void addSegment(const SegmentBuffer& buffer);
+    void restart();
+
+    static auto makeWindow(size_t size) -> std::vector<double>;
 
 private:
     sft::Context<sft::Real> m_context;
@@ -71,14 +90,22 @@ private:
 
     QwtPlotCurve* m_curve = nullptr;
 
-    std::vector<double> m_samples;
-    std::vector<double> m_filteredSamples;
+    SegmentBuffer m_samples = SegmentBuffer(WindowSize);
+    SegmentBuffer m_filteredSamples = SegmentBuffer(WindowSize);
 
+    const std::vector<double> m_window = makeWindow(WindowSize);
     std::vector<double> m_windowedSamples;
     std::vector<sft::Complex> m_results;
 
+    // Ring of segment power spectra
+    std::vector<std::vector<double>> m_segments;
+    size_t m_nextSegment = 0;
+    size_t m_segmentCount = 0;
+
     std::vector<double> m_frequencies;
     std::vector<double> m_magnitudes;
 
+    QTimer m_refreshTimer;
+
     bool m_filtered = false;
 };
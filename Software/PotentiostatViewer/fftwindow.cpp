@@ -22,8 +22,12 @@
 // ============================================================================================== //
 
 #include "fftwindow.h"
+#include "settings.h"
+
 #include "ui_fftwindow.h"
 
+#include <algorithm>
+
 // ---------------------------------------------------------------------------------------------- //
 
 FftWindow::FftWindow()
@@ -34,6 +38,9 @@ FftWindow::FftWindow()
 
     m_ui->voltagePlot->setTitle("Voltage (V)");
     m_ui->currentPlot->setTitle("Current (A)");
+
+    m_ui->voltageSpectrogram->setTitle("Voltage (dBV)");
+    m_ui->currentSpectrogram->setTitle("Current (dBA)");
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -62,6 +69,57 @@ void FftWindow::setFiltered(bool enable)
 {
     m_ui->voltagePlot->setFiltered(enable);
     m_ui->currentPlot->setFiltered(enable);
+
+    m_ui->voltageSpectrogram->setFiltered(enable);
+    m_ui->currentSpectrogram->setFiltered(enable);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FftWindow::saveSettings() const
+{
+    auto settings = Settings::getInstance()->getSpectrogramGroup();
+
+    settings->setColorMap(static_cast<int>(m_ui->voltageSpectrogram->colorMap()));
+    settings->setColumnRate(m_ui->voltageSpectrogram->columnRate());
+    settings->setVoltageMinimumLevel(m_ui->voltageSpectrogram->minimumLevel());
+    settings->setVoltageMaximumLevel(m_ui->voltageSpectrogram->maximumLevel());
+    settings->setCurrentMinimumLevel(m_ui->currentSpectrogram->minimumLevel());
+    settings->setCurrentMaximumLevel(m_ui->currentSpectrogram->maximumLevel());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FftWindow::loadSettings()
+{
+    const auto& settings = Settings::getConstInstance().getSpectrogramGroup();
+
+    auto colorMap = SpectrogramWidget::DefaultColorMap;
+
+    if (settings.getColorMap() == static_cast<int>(SpectrogramWidget::ColorMap::Grayscale))
+        colorMap = SpectrogramWidget::ColorMap::Grayscale;
+    else if (settings.getColorMap() == static_cast<int>(SpectrogramWidget::ColorMap::Jet))
+        colorMap = SpectrogramWidget::ColorMap::Jet;
+
+    const int columnRate = std::max(settings.getColumnRate(), 1);
+
+    for (auto spectrogram : { m_ui->voltageSpectrogram, m_ui->currentSpectrogram })
+    {
+        spectrogram->setColorMap(colorMap);
+        spectrogram->setColumnRate(static_cast<size_t>(columnRate));
+    }
+
+    const double voltageMinimum = settings.getVoltageMinimumLevel();
+    const double voltageMaximum = settings.getVoltageMaximumLevel();
+
+    if (voltageMinimum < voltageMaximum)
+        m_ui->voltageSpectrogram->setLevels(voltageMinimum, voltageMaximum);
+
+    const double currentMinimum = settings.getCurrentMinimumLevel();
+    const double currentMaximum = settings.getCurrentMaximumLevel();
+
+    if (currentMinimum < currentMaximum)
+        m_ui->currentSpectrogram->setLevels(currentMinimum, currentMaximum);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -72,6 +130,9 @@ void FftWindow::addSamples(std::span<const double> voltages, std::span<const dou
 
     m_ui->voltagePlot->addSamples(voltages);
     m_ui->currentPlot->addSamples(currents);
+
+    m_ui->voltageSpectrogram->addSamples(voltages);
+    m_ui->currentSpectrogram->addSamples(currents);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -83,6 +144,9 @@ void FftWindow::addFilteredSamples(std::span<const double> voltages,
 
     m_ui->voltagePlot->addFilteredSamples(voltages);
     m_ui->currentPlot->addFilteredSamples(currents);
+
+    m_ui->voltageSpectrogram->addFilteredSamples(voltages);
+    m_ui->currentSpectrogram->addFilteredSamples(currents);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -91,6 +155,9 @@ void FftWindow::clear()
 {
     m_ui->voltagePlot->clear();
     m_ui->currentPlot->clear();
+
+    m_ui->voltageSpectrogram->clear();
+    m_ui->currentSpectrogram->clear();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -44,6 +44,9 @@ public:
 
     void setFiltered(bool enable);
 
+    void saveSettings() const;
+    void loadSettings();
+
     void addSamples(std::span<const double> voltages, std::span<const double> currents);
     void addFilteredSamples(std::span<const double> voltages, std::span<const double> currents);
 
@@ -24,16 +24,17 @@
 #include "aboutdialog.h"
 #include "calibrationdialog.h"
 #include "mainwindow.h"
+#include "recordingwindow.h"
 #include "settings.h"
 
 #include "ui_mainwindow.h"
 
 #include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QPen>
 #include <QSettings>
-#include <QTextStream>
 
 #include <cmath>
 #include <iostream>
@@ -82,6 +83,7 @@ MainWindow::MainWindow(QWidget* parent)
     connect(m_ui->actionLoadCalibration, SIGNAL(triggered()), this, SLOT(loadCalibration()));
     connect(m_ui->actionFilter, SIGNAL(toggled(bool)), this, SLOT(toggleFilter(bool)));
     connect(m_ui->actionShowFft, SIGNAL(toggled(bool)), this, SLOT(toggleFftWindow(bool)));
+    connect(m_ui->actionOpenRecording, SIGNAL(triggered()), this, SLOT(openRecording()));
     connect(m_ui->actionAbout, SIGNAL(triggered()), this, SLOT(showAboutDialog()));
 
     connect(m_ui->runMeasurementButton, SIGNAL(clicked()), this, SLOT(startMeasurement()));
@@ -91,6 +93,9 @@ MainWindow::MainWindow(QWidget* parent)
             m_ui->saveDataButton, SLOT(setDisabled(bool)));
     connect(m_ui->saveDataButton, SIGNAL(clicked()), this, SLOT(saveData()));
 
+    connect(&m_dataRecorder, SIGNAL(finished(QString,QString)),
+            this, SLOT(onRecordingFinished(QString,QString)));
+
     connect(&m_statusTimer, SIGNAL(timeout()), this, SLOT(requestPowerValues()));
 
     connect(&m_deviceListener, SIGNAL(measurementStarted()), this, SLOT(onMeasurementStarted()));
@@ -116,6 +121,7 @@ MainWindow::~MainWindow()
 
 void MainWindow::closeEvent(QCloseEvent* event)
 {
+    m_fftWindow->saveSettings();
     m_fftWindow = nullptr;
     QMainWindow::closeEvent(event);
 }
@@ -160,6 +166,7 @@ void MainWindow::openDevice()
 void MainWindow::closeDevice()
 {
     m_statusTimer.stop();
+    m_dataRecorder.finish();
 
     m_device = nullptr;
 
@@ -359,6 +366,26 @@ void MainWindow::toggleFftWindow(bool show)
 
 // ---------------------------------------------------------------------------------------------- //
 
+void MainWindow::openRecording()
+{
+    const QString directory = QFileInfo(m_ui->storageWidget->getFilePath()).absolutePath();
+    const QString filename = QFileDialog::getOpenFileName(this, "Open Recording", directory,
+                                                          "Recordings (*.csv *.bin)");
+    if (filename.isEmpty())
+        return;
+
+    try {
+        // Deletes itself when closed
+        auto window = new RecordingWindow(filename, this);
+        window->show();
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Error", e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void MainWindow::showAboutDialog()
 {
     AboutDialog dialog(this);
@@ -369,13 +396,12 @@ void MainWindow::showAboutDialog()
 
 void MainWindow::saveData()
 {
-    const std::vector<double> times = m_ui->voltagePlot->getXData();
     const std::vector<double> voltages = m_ui->voltagePlot->getYData();
     const std::vector<double> currents = m_ui->currentPlot->getYData();
     const std::vector<double> filteredVoltages = m_ui->voltagePlot->getFilteredYData();
     const std::vector<double> filteredCurrents = m_ui->currentPlot->getFilteredYData();
 
-    const size_t size = times.size();
+    const size_t size = voltages.size();
 
     if (size == 0)
     {
@@ -383,33 +409,38 @@ void MainWindow::saveData()
         return;
     }
 
-    Q_ASSERT(voltages.size() == size && currents.size() == size &&
+    Q_ASSERT(currents.size() == size &&
              filteredVoltages.size() == size && filteredCurrents.size() == size);
 
     const QString filename = m_ui->storageWidget->getFilePath();
     Q_ASSERT(!QFile::exists(filename));
 
-    QFile file(filename);
-
-    if (!file.open(QFile::WriteOnly))
-    {
-        QMessageBox::critical(this, "Error", "Unable to open file " + filename + " for writing.");
+    try {
+        m_dataRecorder.start(filename, m_ui->storageWidget->getFileType(), Device::SampleTime);
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Error", e.what());
         return;
     }
 
-    QTextStream out(&file);
-    out << "Time (s);Voltage (V);Current (A);Filtered voltage (V);Filtered current (A)\n";
+    // Written on the recorder's thread, which reports back once done
+    m_dataRecorder.addSamples(voltages, currents);
+    m_dataRecorder.addFilteredSamples(filteredVoltages, filteredCurrents);
+    m_dataRecorder.finish();
+
+    m_ui->saveDataButton->setEnabled(false);
+}
+
+// ---------------------------------------------------------------------------------------------- //
 
-    for (size_t i = 0; i < size; ++i)
+void MainWindow::onRecordingFinished(const QString& filename, const QString& error)
+{
+    if (!error.isEmpty())
     {
-        out << times[i] << ";"
-            << voltages[i] << ";"
-            << currents[i] << ";"
-            << filteredVoltages[i] << ";"
-            << filteredCurrents[i] << "\n";
+        QMessageBox::critical(this, "Error", error);
+        return;
     }
 
-    m_ui->saveDataButton->setEnabled(false);
     m_ui->statusBar->showMessage("Data saved to " + filename + ".", 3000);
 }
 
@@ -423,6 +454,18 @@ void MainWindow::onMeasurementStarted()
     m_ui->abortMeasurementButton->setEnabled(true);
     m_ui->storageWidget->setEnabled(false);
     m_ui->saveDataButton->setEnabled(false);
+
+    if (!m_ui->storageWidget->autoSaveEnabled())
+        return;
+
+    // Streamed to disk while measuring, so nothing is lost if the measurement is interrupted
+    try {
+        m_dataRecorder.start(m_ui->storageWidget->getFilePath(),
+                             m_ui->storageWidget->getFileType(), Device::SampleTime);
+    }
+    catch (const std::exception& e) {
+        QMessageBox::critical(this, "Error", e.what());
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -437,6 +480,8 @@ void MainWindow::onMeasurementStopped()
 
     updateFilteredPlotData(m_filteredVoltages, m_filteredCurrents);
 
+    m_dataRecorder.addFilteredSamples(m_filteredVoltages, m_filteredCurrents);
+
     m_ui->actionLoadCalibration->setEnabled(true);
     m_ui->setupWidget->setEnabled(true);
     m_ui->runMeasurementButton->setEnabled(true);
@@ -444,8 +489,11 @@ void MainWindow::onMeasurementStopped()
     m_ui->storageWidget->setEnabled(true);
     m_ui->saveDataButton->setEnabled(true);
 
-    if (m_ui->storageWidget->autoSaveEnabled())
-        saveData();
+    if (m_dataRecorder.isActive())
+    {
+        m_dataRecorder.finish();
+        m_ui->saveDataButton->setEnabled(false);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -475,6 +523,9 @@ void MainWindow::onSamplesReceived(const DeviceListener::SampleBuffer& samples)
     updatePlotData(samples.voltages, samples.currents);
     updateFilteredPlotData(m_filteredVoltages, m_filteredCurrents);
 
+    m_dataRecorder.addSamples(samples.voltages, samples.currents);
+    m_dataRecorder.addFilteredSamples(m_filteredVoltages, m_filteredCurrents);
+
     m_fftWindow->addSamples(samples.voltages, samples.currents);
     m_fftWindow->addFilteredSamples(m_filteredVoltages, m_filteredCurrents);
 }
@@ -546,6 +597,12 @@ void MainWindow::saveSettings()
     m_ui->setupWidget->saveSettings();
     m_ui->storageWidget->saveSettings();
 
+    if (m_fftWindow)
+        m_fftWindow->saveSettings();
+
+    auto filter = Settings::getInstance()->getFilterGroup();
+    filter->setType(static_cast<int>(m_voltageFilter.type()));
+
     Settings::getInstance()->saveToDisk();
 }
 
@@ -561,6 +618,15 @@ void MainWindow::loadSettings()
 
     m_ui->setupWidget->loadSettings();
     m_ui->storageWidget->loadSettings();
+
+    m_fftWindow->loadSettings();
+
+    const auto& filter = Settings::getConstInstance().getFilterGroup();
+    const auto filterType = filter.getType() == static_cast<int>(SignalFilter::Type::Iir)
+            ? SignalFilter::Type::Iir : SignalFilter::Type::Fir;
+
+    m_voltageFilter.setType(filterType);
+    m_currentFilter.setType(filterType);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "datarecorder.h"
 #include "devicelistener.h"
 #include "fftwindow.h"
 #include "signalfilter.h"
@@ -68,9 +69,12 @@ private slots:
 
     void toggleFftWindow(bool show);
 
+    void openRecording();
+
     void showAboutDialog();
 
     void saveData();
+    void onRecordingFinished(const QString& filename, const QString& error);
 
     void onMeasurementStarted();
     void onMeasurementStopped();
@@ -110,5 +114,7 @@ private:
 
     Device::Calibration m_calibration = {};
 
+    DataRecorder m_dataRecorder;
+
     QTimer m_statusTimer;
 };
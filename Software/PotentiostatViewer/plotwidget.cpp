@@ -24,11 +24,22 @@
 #include "plotwidget.h"
 
 #include <qwt_plot_grid.h>
+#include <qwt_scale_engine.h>
 #include <qwt_text.h>
 
 #include <QApplication>
 #include <QPen>
 
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Relative to the data range
+    constexpr double TimeMargin = 0.25;
+    constexpr double ValueMargin = 0.1;
+}
+
 // ---------------------------------------------------------------------------------------------- //
 
 class PlotWidget::Data : public QwtArraySeriesData<QPointF>
@@ -95,12 +106,10 @@ PlotWidget::PlotWidget(QWidget* parent)
     setAxisFont(QwtPlot::xBottom, font);
     setAxisFont(QwtPlot::yLeft, font);
 
+    // Scaled by updateScales(), as autoscaling would rescale with every new sample
     setAxisScale(QwtPlot::xBottom, -1.0, 1.0);
     setAxisScale(QwtPlot::yLeft, -1.0, 1.0);
 
-    setAxisAutoScale(QwtPlot::xBottom, true);
-    setAxisAutoScale(QwtPlot::yLeft, true);
-
     auto grid = new QwtPlotGrid;
     grid->setPen(QPen(Qt::gray, 0, Qt::DotLine));
     grid->attach(this);
@@ -124,6 +133,8 @@ PlotWidget::PlotWidget(QWidget* parent)
     //m_filteredCurve->setCurveAttribute(QwtPlotCurve::Fitted);
 
     m_curve->attach(this);
+
+    m_directPainter = new QwtPlotDirectPainter(this);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -151,6 +162,7 @@ void PlotWidget::setFiltered(bool enable)
     m_curve->attach(m_filtered ? nullptr : this);
     m_filteredCurve->attach(m_filtered ? this : nullptr);
 
+    updateScales();
     replot();
 }
 
@@ -158,20 +170,20 @@ void PlotWidget::setFiltered(bool enable)
 
 void PlotWidget::addSamples(std::span<const double> xData, std::span<const double> yData)
 {
+    const size_t from = m_data->size();
     m_data->append(xData, yData);
 
-    if (!m_filtered)
-        replot();
+    drawSamples(m_data, m_curve, from);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void PlotWidget::addFilteredSamples(std::span<const double> xData, std::span<const double> yData)
 {
+    const size_t from = m_filteredData->size();
     m_filteredData->append(xData, yData);
 
-    if (m_filtered)
-        replot();
+    drawSamples(m_filteredData, m_filteredCurve, from);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -181,6 +193,7 @@ void PlotWidget::clear()
     m_data->clear();
     m_filteredData->clear();
 
+    updateScales();
     replot();
 }
 
@@ -242,3 +255,103 @@ auto PlotWidget::getFilteredYData() const -> std::vector<double>
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::drawSamples(const Data* data, QwtPlotCurve* curve, size_t from)
+{
+    const size_t size = data->size();
+
+    if (size == from)
+        return;
+
+    // Both curves share the scales, so that switching between them does not rescale
+    if (!fitsScales())
+    {
+        updateScales();
+        replot();
+
+        return;
+    }
+
+    if (!isVisible() || curve != (m_filtered ? m_filteredCurve : m_curve))
+        return;
+
+    // Starts at the last sample already drawn, so that the new segment connects to the curve
+    const auto first = static_cast<int>((from > 0) ? from - 1 : 0);
+    const auto last = static_cast<int>(size - 1);
+
+    m_directPainter->drawSeries(curve, first, last);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PlotWidget::fitsScales() const -> bool
+{
+    const QwtInterval xInterval = axisInterval(QwtPlot::xBottom);
+    const QwtInterval yInterval = axisInterval(QwtPlot::yLeft);
+
+    for (const Data* data : { m_data, m_filteredData })
+    {
+        if (data->size() == 0)
+            continue;
+
+        const QRectF rect = data->boundingRect();
+
+        if (!xInterval.contains(rect.left()) || !xInterval.contains(rect.right()) ||
+            !yInterval.contains(rect.top()) || !yInterval.contains(rect.bottom()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::updateScales()
+{
+    QRectF rect;
+    bool empty = true;
+
+    for (const Data* data : { m_data, m_filteredData })
+    {
+        if (data->size() == 0)
+            continue;
+
+        rect = empty ? data->boundingRect() : rect.united(data->boundingRect());
+        empty = false;
+    }
+
+    if (empty)
+    {
+        setAxisScale(QwtPlot::xBottom, -1.0, 1.0);
+        setAxisScale(QwtPlot::yLeft, -1.0, 1.0);
+
+        return;
+    }
+
+    // The time only grows, so it only needs headroom at the end
+    updateScale(QwtPlot::xBottom, rect.left(), rect.right(), 0.0, TimeMargin);
+    updateScale(QwtPlot::yLeft, rect.top(), rect.bottom(), ValueMargin, ValueMargin);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWidget::updateScale(QwtAxisId axis, double minimum, double maximum,
+                             double lowerMargin, double upperMargin)
+{
+    double range = maximum - minimum;
+
+    if (range <= 0.0)
+        range = (minimum != 0.0) ? std::abs(minimum) : 1.0;
+
+    double lower = minimum - lowerMargin * range;
+    double upper = maximum + upperMargin * range;
+    double step = 0.0;
+
+    // Rounds to the major ticks, as autoscaling would
+    axisScaleEngine(axis)->autoScale(axisMaxMajor(axis), lower, upper, step);
+    setAxisScale(axis, lower, upper, step);
+}
+
+// ---------------------------------------------------------------------------------------------- //
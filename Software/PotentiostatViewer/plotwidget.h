@@ -27,9 +27,12 @@
 
 #include <qwt_plot.h>
 #include <qwt_plot_curve.h>
+#include <qwt_plot_directpainter.h>
 
 #include <vector>
 
+// New samples are painted directly onto the canvas. The whole plot is only redrawn when they do
+// not fit the axes, which then get some headroom, so that this rarely happens.
 class PlotWidget : public QwtPlot
 {
 public:
@@ -56,6 +59,13 @@ private:
     class Data;
     auto getData(Data* data, QwtAxisId axis) const -> std::vector<double>;
 
+    void drawSamples(const Data* data, QwtPlotCurve* curve, size_t from);
+
+    auto fitsScales() const -> bool;
+    void updateScales();
+    void updateScale(QwtAxisId axis, double minimum, double maximum,
+                     double lowerMargin, double upperMargin);
+
 private:
     Data* m_data = nullptr;
     QwtPlotCurve* m_curve = nullptr;
@@ -64,5 +74,7 @@ private:
     QwtPlotCurve* m_filteredCurve = nullptr;
 
     bool m_filtered = false;
+
+    QwtPlotDirectPainter* m_directPainter = nullptr;
 };
 
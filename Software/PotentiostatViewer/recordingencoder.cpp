@@ -0,0 +1,172 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingencoder.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <limits>
+
+// ---------------------------------------------------------------------------------------------- //
+
+static_assert(std::endian::native == std::endian::little, "The binary format is little-endian.");
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr char Magic[] = "PSVDATA1";
+    constexpr char CsvHeader[] =
+            "Time (s);Voltage (V);Current (A);Filtered voltage (V);Filtered current (A)\n";
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingEncoder::RecordingEncoder(double sampleTime)
+    : m_sampleTime(sampleTime)
+{
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingEncoder::reset(double sampleTime)
+{
+    m_sampleTime = sampleTime;
+
+    m_voltages.clear();
+    m_currents.clear();
+    m_filteredVoltages.clear();
+    m_filteredCurrents.clear();
+
+    m_rowCount = 0;
+    m_droppedRowCount = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingEncoder::addSamples(std::span<const double> voltages,
+                                  std::span<const double> currents)
+{
+    assert(voltages.size() == currents.size());
+
+    m_voltages.insert(m_voltages.end(), voltages.begin(), voltages.end());
+    m_currents.insert(m_currents.end(), currents.begin(), currents.end());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingEncoder::addFilteredSamples(std::span<const double> voltages,
+                                          std::span<const double> currents)
+{
+    assert(voltages.size() == currents.size());
+
+    m_filteredVoltages.insert(m_filteredVoltages.end(), voltages.begin(), voltages.end());
+    m_filteredCurrents.insert(m_filteredCurrents.end(), currents.begin(), currents.end());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingEncoder::takeRows(std::vector<double>& values, size_t maxValues, bool finishing)
+    -> size_t
+{
+    size_t rows = std::min(m_voltages.size(), m_filteredVoltages.size());
+
+    if (finishing)
+    {
+        rows = std::max(m_voltages.size(), m_filteredVoltages.size());
+
+        constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+        m_voltages.resize(rows, NaN);
+        m_currents.resize(rows, NaN);
+        m_filteredVoltages.resize(rows, NaN);
+        m_filteredCurrents.resize(rows, NaN);
+    }
+
+    if (rows == 0)
+        return 0;
+
+    const size_t space = maxValues > values.size() ? (maxValues - values.size()) / ColumnCount : 0;
+    const size_t appended = std::min(rows, space);
+
+    for (size_t i = 0; i < appended; ++i)
+    {
+        values.push_back(static_cast<double>(m_rowCount++) * m_sampleTime);
+        values.push_back(m_voltages[i]);
+        values.push_back(m_currents[i]);
+        values.push_back(m_filteredVoltages[i]);
+        values.push_back(m_filteredCurrents[i]);
+    }
+
+    m_rowCount += rows - appended;
+    m_droppedRowCount += rows - appended;
+
+    // Only as many samples as the filters lag behind remain
+    const auto count = static_cast<ptrdiff_t>(rows);
+
+    m_voltages.erase(m_voltages.begin(), m_voltages.begin() + count);
+    m_currents.erase(m_currents.begin(), m_currents.begin() + count);
+    m_filteredVoltages.erase(m_filteredVoltages.begin(), m_filteredVoltages.begin() + count);
+    m_filteredCurrents.erase(m_filteredCurrents.begin(), m_filteredCurrents.begin() + count);
+
+    return appended;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingEncoder::header(FileType type, double sampleTime) -> std::string
+{
+    if (type == FileType::Csv)
+        return CsvHeader;
+
+    std::string header(Magic, sizeof(Magic) - 1);
+    header.append(reinterpret_cast<const char*>(&ColumnCount), sizeof(ColumnCount));
+    header.append(reinterpret_cast<const char*>(&sampleTime), sizeof(sampleTime));
+
+    return header;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingEncoder::encode(FileType type, std::span<const double> values, std::string& out)
+{
+    assert(values.size() % ColumnCount == 0);
+
+    if (type == FileType::Binary)
+    {
+        out.append(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+        return;
+    }
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        char number[32];
+        const auto result = std::to_chars(number, number + sizeof(number), values[i]);
+
+        out.append(number, result.ptr);
+        out += ((i + 1) % ColumnCount == 0) ? '\n' : ';';
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
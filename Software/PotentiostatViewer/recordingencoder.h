@@ -0,0 +1,83 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// Pairs the samples with their filtered values into the rows of a recording and encodes them.
+// Each row holds the time, the voltage and current and their filtered values. As the filters lag
+// behind, rows are only complete once the filtered samples arrived.
+//
+// The binary format starts with the magic "PSVDATA1", followed by the number of columns as a
+// 32-bit integer and the sample time as a double. Rows of little-endian doubles follow. The CSV
+// format has a header line and one line per row with the values separated by semicolons.
+class RecordingEncoder
+{
+public:
+    static constexpr uint32_t ColumnCount = 5;
+
+    enum class FileType
+    {
+        Csv,
+        Binary
+    };
+
+public:
+    explicit RecordingEncoder(double sampleTime = 0.0);
+
+    // Discards all samples and starts again at time zero
+    void reset(double sampleTime);
+
+    void addSamples(std::span<const double> voltages, std::span<const double> currents);
+    void addFilteredSamples(std::span<const double> voltages, std::span<const double> currents);
+
+    // Appends the complete rows to the values, but not beyond maxValues of them. The rows that
+    // don't fit are dropped, the time of the following rows still counts them. If finishing,
+    // values still missing at the end are written as NaN. Returns the number of rows appended.
+    auto takeRows(std::vector<double>& values, size_t maxValues, bool finishing = false)
+        -> size_t;
+
+    // Both appended and dropped
+    auto rowCount() const -> uint64_t { return m_rowCount; }
+    auto droppedRowCount() const -> uint64_t { return m_droppedRowCount; }
+
+    static auto header(FileType type, double sampleTime) -> std::string;
+
+    // The values hold whole rows
+    static void encode(FileType type, std::span<const double> values, std::string& out);
+
+private:
+    double m_sampleTime = 0.0;
+
+    std::vector<double> m_voltages;
+    std::vector<double> m_currents;
+    std::vector<double> m_filteredVoltages;
+    std::vector<double> m_filteredCurrents;
+
+    uint64_t m_rowCount = 0;
+    uint64_t m_droppedRowCount = 0;
+};
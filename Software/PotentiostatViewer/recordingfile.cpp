@@ -0,0 +1,107 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingfile.h"
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingFile::RecordingFile(const QString& filename)
+    : m_file(filename)
+{
+    if (!m_file.open(QFile::ReadOnly))
+        throw Error("Unable to open file " + filename.toStdString() + " for reading.");
+
+    const auto size = static_cast<size_t>(m_file.size());
+
+    if (size == 0)
+        throw Error("File " + filename.toStdString() + " is empty.");
+
+    const uchar* data = m_file.map(0, m_file.size());
+
+    if (!data)
+        throw Error("Unable to map file " + filename.toStdString() + ".");
+
+    try {
+        m_index = std::make_unique<RecordingIndex>(
+            std::span(reinterpret_cast<const char*>(data), size));
+    }
+    catch (const RecordingIndex::Error&) {
+        throw Error("File " + filename.toStdString() + " contains no recording.");
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingFile::~RecordingFile() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::columnCount() const -> size_t
+{
+    return m_index->columnCount();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::firstTime() const -> double
+{
+    return m_index->firstTime();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::lastTime() const -> double
+{
+    return m_index->lastTime();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::indexProgress() const -> double
+{
+    return m_index->indexProgress();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::isIndexed() const -> bool
+{
+    return m_index->isIndexed();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::rowCount() const -> uint64_t
+{
+    return m_index->rowCount();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingFile::select(size_t column, double from, double to,
+                           size_t maxCount) const -> std::vector<Point>
+{
+    return m_index->select(column, from, to, maxCount);
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,72 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "recordingindex.h"
+
+#include <QFile>
+#include <QString>
+
+#include <memory>
+
+// Memory-maps a recording written by the DataRecorder and indexes it, see RecordingIndex. Mapped
+// pages are backed by the file, so even files larger than the available memory can be opened.
+class RecordingFile
+{
+public:
+    using Error = RecordingIndex::Error;
+    using Point = RecordingIndex::Point;
+
+public:
+    // Throws if the file cannot be mapped or is no recording
+    explicit RecordingFile(const QString& filename);
+    ~RecordingFile();
+
+    RecordingFile(const RecordingFile&) = delete;
+    auto operator=(const RecordingFile&) = delete;
+
+    RecordingFile(RecordingFile&&) = delete;
+    auto operator=(RecordingFile&&) = delete;
+
+    auto columnCount() const -> size_t;
+
+    auto firstTime() const -> double;
+    auto lastTime() const -> double;
+
+    // Between 0 and 1
+    auto indexProgress() const -> double;
+    auto isIndexed() const -> bool;
+
+    // Only valid once indexed
+    auto rowCount() const -> uint64_t;
+
+    // See RecordingIndex::select()
+    auto select(size_t column, double from, double to, size_t maxCount) const -> std::vector<Point>;
+
+private:
+    QFile m_file;
+
+    // Declared last, so that its threads are stopped before the file is unmapped
+    std::unique_ptr<RecordingIndex> m_index;
+};
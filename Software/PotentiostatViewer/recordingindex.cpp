@@ -0,0 +1,481 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingindex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Written by the DataRecorder, followed by the column count and the sample time
+    constexpr char Magic[] = "PSVDATA1";
+    constexpr size_t MagicSize = sizeof(Magic) - 1;
+    constexpr size_t BinaryHeaderSize = MagicSize + sizeof(uint32_t) + sizeof(double);
+
+    constexpr size_t MaxColumnCount = 64;
+
+    // About 5 MB of summaries for each GB of a file with five columns
+    constexpr size_t BucketSize = 32 * 1024;
+    constexpr size_t ChunkBuckets = 32;
+
+    // Larger spans are drawn from the buckets
+    constexpr size_t RawLimit = 8 * 1024 * 1024;
+
+    constexpr unsigned int MaxThreadCount = 8;
+
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingIndex::RecordingIndex(std::span<const char> data)
+    : m_data(data.data()),
+      m_size(data.size())
+{
+    if (m_size == 0)
+        throw Error("The data contains no recording.");
+
+    readHeader();
+
+    if (m_columnCount < 2 || m_columnCount > MaxColumnCount || m_dataOffset >= m_size)
+        throw Error("The data contains no recording.");
+
+    m_firstTime = timeAt(m_dataOffset);
+    m_lastTime = timeAt(previousRowStart(m_size));
+
+    if (std::isnan(m_firstTime) || std::isnan(m_lastTime) || m_lastTime < m_firstTime)
+        throw Error("The data contains no recording.");
+
+    m_bucketCount = (m_size - m_dataOffset + m_bucketSize - 1) / m_bucketSize;
+    m_summaries.resize(m_bucketCount * m_columnCount);
+    m_ready = std::make_unique<std::atomic<bool>[]>(m_bucketCount);
+
+    const unsigned int threadCount = std::clamp(std::thread::hardware_concurrency(),
+                                                1u, MaxThreadCount);
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&RecordingIndex::runIndexer, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingIndex::~RecordingIndex()
+{
+    m_stopped = true;
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::columnCount() const -> size_t
+{
+    return m_columnCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::firstTime() const -> double
+{
+    return m_firstTime;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::lastTime() const -> double
+{
+    return m_lastTime;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::indexProgress() const -> double
+{
+    return static_cast<double>(m_indexedBuckets) / static_cast<double>(m_bucketCount);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::isIndexed() const -> bool
+{
+    return m_indexedBuckets == m_bucketCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::rowCount() const -> uint64_t
+{
+    assert(isIndexed());
+
+    uint64_t count = 0;
+
+    // The time is never missing
+    for (size_t i = 0; i < m_bucketCount; ++i)
+        count += m_summaries[i * m_columnCount].count;
+
+    return count;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::select(size_t column, double from, double to,
+                            size_t maxCount) const -> std::vector<Point>
+{
+    assert(column < m_columnCount);
+
+    if (maxCount == 0 || !(from < to))
+        return {};
+
+    // One more row on either side, so that curves reach the edges
+    size_t begin = offsetOf(from);
+    size_t end = offsetOf(to);
+
+    if (begin > m_dataOffset)
+        begin = previousRowStart(begin);
+
+    if (end < m_size)
+        end = rowStart(end + 1);
+
+    if (begin >= end)
+        return {};
+
+    if (end - begin <= RawLimit)
+        return selectRows(column, begin, end, maxCount);
+
+    return selectBuckets(column, begin, end, maxCount);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingIndex::readHeader()
+{
+    if (m_size >= BinaryHeaderSize && std::memcmp(m_data, Magic, MagicSize) == 0)
+    {
+        uint32_t columnCount = 0;
+        std::memcpy(&columnCount, m_data + MagicSize, sizeof(columnCount));
+
+        m_binary = true;
+        m_columnCount = columnCount;
+        m_dataOffset = BinaryHeaderSize;
+
+        if (m_columnCount == 0 || m_columnCount > MaxColumnCount)
+            return;
+
+        m_rowSize = m_columnCount * sizeof(double);
+
+        // A row that has only been written partially is left out
+        m_size = m_dataOffset + (m_size - m_dataOffset) / m_rowSize * m_rowSize;
+        m_bucketSize = std::max<size_t>(BucketSize / m_rowSize, 1) * m_rowSize;
+    }
+    else
+    {
+        const char* end = m_data + m_size;
+        const auto lineEnd = static_cast<const char*>(std::memchr(m_data, '\n', m_size));
+
+        // The header line is optional
+        double value = 0.0;
+
+        if (std::from_chars(m_data, end, value).ec != std::errc())
+            m_dataOffset = lineEnd ? static_cast<size_t>(lineEnd - m_data) + 1 : m_size;
+
+        m_columnCount = static_cast<size_t>(std::count(m_data, lineEnd ? lineEnd : end, ';')) + 1;
+        m_bucketSize = BucketSize;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::rowStart(size_t offset) const -> size_t
+{
+    if (offset <= m_dataOffset)
+        return m_dataOffset;
+
+    if (offset >= m_size)
+        return m_size;
+
+    if (m_binary)
+        return m_dataOffset + (offset - m_dataOffset + m_rowSize - 1) / m_rowSize * m_rowSize;
+
+    if (m_data[offset - 1] == '\n')
+        return offset;
+
+    const auto newline = static_cast<const char*>(std::memchr(m_data + offset, '\n',
+                                                              m_size - offset));
+
+    return newline ? static_cast<size_t>(newline - m_data) + 1 : m_size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::previousRowStart(size_t offset) const -> size_t
+{
+    if (offset <= m_dataOffset)
+        return m_dataOffset;
+
+    if (m_binary)
+        return m_dataOffset + (offset - m_dataOffset - 1) / m_rowSize * m_rowSize;
+
+    // Skips the newline that ends the previous row
+    size_t start = offset - 1;
+
+    while (start > m_dataOffset && m_data[start - 1] != '\n')
+        --start;
+
+    return start;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::offsetOf(double time) const -> size_t
+{
+    // Finds the first row whose time is not less than the given one
+    size_t low = m_dataOffset;
+    size_t high = m_size;
+
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        const size_t start = rowStart(middle);
+
+        if (start < m_size && timeAt(start) < time)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return rowStart(low);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::readRow(size_t offset, std::span<double> values) const -> size_t
+{
+    std::fill(values.begin(), values.end(), NaN);
+
+    if (m_binary)
+    {
+        const size_t count = std::min(values.size(), m_columnCount);
+        std::memcpy(values.data(), m_data + offset, count * sizeof(double));
+
+        return offset + m_rowSize;
+    }
+
+    const char* position = m_data + offset;
+    const char* end = m_data + m_size;
+
+    // Missing or invalid values remain NaN, as from_chars leaves them untouched
+    for (auto& value : values)
+    {
+        position = std::from_chars(position, end, value).ptr;
+
+        if (position == end || *position != ';')
+            break;
+
+        ++position;
+    }
+
+    const auto newline = static_cast<const char*>(std::memchr(position, '\n',
+                                                              static_cast<size_t>(end - position)));
+
+    return newline ? static_cast<size_t>(newline - m_data) + 1 : m_size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::timeAt(size_t offset) const -> double
+{
+    double time = NaN;
+    readRow(offset, std::span(&time, 1));
+
+    return time;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::selectRows(size_t column, size_t begin, size_t end,
+                                size_t maxCount) const -> std::vector<Point>
+{
+    std::vector<double> values(m_columnCount);
+    std::vector<Point> points;
+
+    for (size_t offset = begin; offset < end; )
+    {
+        offset = readRow(offset, values);
+
+        const double value = values[column];
+
+        if (!std::isnan(value))
+            points.push_back({ values[0], value, value, value });
+    }
+
+    if (points.size() <= maxCount)
+        return points;
+
+    const size_t groupSize = (points.size() + maxCount - 1) / maxCount;
+
+    std::vector<Point> groups;
+    groups.reserve(maxCount);
+
+    for (size_t i = 0; i < points.size(); i += groupSize)
+    {
+        const size_t last = std::min(i + groupSize, points.size()) - 1;
+
+        Point group = points[i];
+        double sum = group.mean;
+
+        for (size_t j = i + 1; j <= last; ++j)
+        {
+            group.minimum = std::min(group.minimum, points[j].minimum);
+            group.maximum = std::max(group.maximum, points[j].maximum);
+            sum += points[j].mean;
+        }
+
+        group.time = 0.5 * (points[i].time + points[last].time);
+        group.mean = sum / static_cast<double>(last - i + 1);
+
+        groups.push_back(group);
+    }
+
+    return groups;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingIndex::selectBuckets(size_t column, size_t begin, size_t end,
+                                   size_t maxCount) const -> std::vector<Point>
+{
+    const size_t firstBucket = (begin - m_dataOffset) / m_bucketSize;
+    const size_t lastBucket = (end - 1 - m_dataOffset) / m_bucketSize;
+
+    const size_t groupSize = (lastBucket - firstBucket + maxCount) / maxCount;
+
+    std::vector<Point> points;
+    points.reserve(maxCount + 1);
+
+    // Groups are aligned, so that they do not change while panning
+    for (size_t i = firstBucket - firstBucket % groupSize; i <= lastBucket; i += groupSize)
+    {
+        Summary group = { Infinity, -Infinity, 0.0, 0 };
+
+        double firstTime = NaN;
+        double lastTime = NaN;
+
+        for (size_t j = i; j < std::min(i + groupSize, m_bucketCount); ++j)
+        {
+            if (!m_ready[j].load(std::memory_order_acquire))
+                continue;
+
+            const Summary& time = m_summaries[j * m_columnCount];
+            const Summary& value = m_summaries[j * m_columnCount + column];
+
+            if (time.count == 0)
+                continue;
+
+            if (std::isnan(firstTime))
+                firstTime = time.minimum;
+
+            lastTime = time.maximum;
+
+            group.minimum = std::min(group.minimum, value.minimum);
+            group.maximum = std::max(group.maximum, value.maximum);
+            group.sum += value.sum;
+            group.count += value.count;
+        }
+
+        if (group.count > 0)
+        {
+            const double mean = group.sum / static_cast<double>(group.count);
+            points.push_back({ 0.5 * (firstTime + lastTime), group.minimum, mean, group.maximum });
+        }
+    }
+
+    return points;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingIndex::runIndexer()
+{
+    std::vector<double> values(m_columnCount);
+
+    const size_t chunkCount = (m_bucketCount + ChunkBuckets - 1) / ChunkBuckets;
+
+    // Each thread takes the next chunk, so the index fills up from the start of the file
+    for (size_t chunk = m_nextChunk++; chunk < chunkCount; chunk = m_nextChunk++)
+    {
+        const size_t last = std::min((chunk + 1) * ChunkBuckets, m_bucketCount);
+
+        for (size_t bucket = chunk * ChunkBuckets; bucket < last; ++bucket)
+        {
+            if (m_stopped)
+                return;
+
+            indexBucket(bucket, values);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingIndex::indexBucket(size_t bucket, std::span<double> values)
+{
+    // Holds all rows that start within the bucket
+    const size_t begin = rowStart(m_dataOffset + bucket * m_bucketSize);
+    const size_t end = std::min(m_dataOffset + (bucket + 1) * m_bucketSize, m_size);
+
+    const std::span summaries(&m_summaries[bucket * m_columnCount], m_columnCount);
+    std::fill(summaries.begin(), summaries.end(), Summary{ Infinity, -Infinity, 0.0, 0 });
+
+    for (size_t offset = begin; offset < end; )
+    {
+        offset = readRow(offset, values);
+
+        for (size_t i = 0; i < m_columnCount; ++i)
+        {
+            const double value = values[i];
+
+            if (std::isnan(value))
+                continue;
+
+            Summary& summary = summaries[i];
+
+            summary.minimum = std::min(summary.minimum, value);
+            summary.maximum = std::max(summary.maximum, value);
+            summary.sum += value;
+            ++summary.count;
+        }
+    }
+
+    m_ready[bucket].store(true, std::memory_order_release);
+    ++m_indexedBuckets;
+}
+
+// ---------------------------------------------------------------------------------------------- //
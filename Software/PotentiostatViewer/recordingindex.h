@@ -0,0 +1,132 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Summarizes a recording written by the DataRecorder, in either file type. Nothing is read up
+// front except the first and the last row. Background threads summarize the rows in buckets of
+// a fixed number of bytes, which is enough to draw the full span of files far larger than the
+// available memory. Spans that are small enough are read directly from the data.
+//
+// Column 0 holds the time, which must increase monotonically. The data is usually a mapped file
+// and must outlive the index.
+class RecordingIndex
+{
+public:
+    using Error = std::runtime_error;
+
+    struct Point
+    {
+        double time;
+        double minimum;
+        double mean;
+        double maximum;
+    };
+
+public:
+    // Throws if the data is no recording
+    explicit RecordingIndex(std::span<const char> data);
+    ~RecordingIndex();
+
+    RecordingIndex(const RecordingIndex&) = delete;
+    auto operator=(const RecordingIndex&) = delete;
+
+    RecordingIndex(RecordingIndex&&) = delete;
+    auto operator=(RecordingIndex&&) = delete;
+
+    auto columnCount() const -> size_t;
+
+    auto firstTime() const -> double;
+    auto lastTime() const -> double;
+
+    // Between 0 and 1
+    auto indexProgress() const -> double;
+    auto isIndexed() const -> bool;
+
+    // Only valid once indexed
+    auto rowCount() const -> uint64_t;
+
+    // Returns at most maxCount points of the given column between the given times. Buckets that
+    // have not been indexed yet are left out.
+    auto select(size_t column, double from, double to, size_t maxCount) const -> std::vector<Point>;
+
+private:
+    struct Summary
+    {
+        double minimum;
+        double maximum;
+        double sum;
+        uint64_t count;
+    };
+
+    void readHeader();
+
+    auto rowStart(size_t offset) const -> size_t;
+    auto previousRowStart(size_t offset) const -> size_t;
+    auto offsetOf(double time) const -> size_t;
+
+    // Returns the start of the next row
+    auto readRow(size_t offset, std::span<double> values) const -> size_t;
+    auto timeAt(size_t offset) const -> double;
+
+    auto selectRows(size_t column, size_t begin, size_t end,
+                    size_t maxCount) const -> std::vector<Point>;
+    auto selectBuckets(size_t column, size_t begin, size_t end,
+                       size_t maxCount) const -> std::vector<Point>;
+
+    void runIndexer();
+    void indexBucket(size_t bucket, std::span<double> values);
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_dataOffset = 0;
+
+    bool m_binary = false;
+    size_t m_columnCount = 0;
+    size_t m_rowSize = 0; // Binary only
+
+    double m_firstTime = 0.0;
+    double m_lastTime = 0.0;
+
+    size_t m_bucketSize = 0;
+    size_t m_bucketCount = 0;
+
+    // A bucket's summaries are only valid once it is marked as ready
+    std::vector<Summary> m_summaries;
+    std::unique_ptr<std::atomic<bool>[]> m_ready;
+
+    std::atomic<size_t> m_nextChunk = 0;
+    std::atomic<size_t> m_indexedBuckets = 0;
+    std::atomic<bool> m_stopped = false;
+
+    std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,73 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "recordingfile.h"
+
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_intervalcurve.h>
+
+#include <memory>
+
+// Draws one column of a recording over the time, as the mean and the range of the values that
+// fall on each pixel. Only the time axis is panned and zoomed, double-clicking shows it all.
+class RecordingPlot : public QwtPlot
+{
+    Q_OBJECT
+
+public:
+    RecordingPlot(QWidget* parent = nullptr);
+
+    void setAxisTitles(const QString& xTitle, const QString& yTitle);
+
+    void setRecording(std::shared_ptr<const RecordingFile> recording, size_t column);
+    void setColumn(size_t column);
+
+    // Selects the points for the visible interval before drawing
+    void replot() override;
+
+public slots:
+    void setInterval(double from, double to);
+    void showAll();
+
+signals:
+    void intervalChanged(double from, double to);
+
+private:
+    auto eventFilter(QObject* object, QEvent* event) -> bool override;
+    void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+
+    void updateSamples();
+
+private:
+    QwtPlotCurve* m_curve = nullptr;
+    QwtPlotIntervalCurve* m_range = nullptr;
+
+    std::shared_ptr<const RecordingFile> m_recording;
+    size_t m_column = 0;
+
+    QwtInterval m_interval;
+};
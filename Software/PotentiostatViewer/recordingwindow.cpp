@@ -0,0 +1,124 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingwindow.h"
+
+#include "ui_recordingwindow.h"
+
+#include <QFileInfo>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Time, voltage, current, filtered voltage and filtered current
+    enum Column : size_t
+    {
+        VoltageColumn = 1,
+        CurrentColumn = 2,
+        FilteredVoltageColumn = 3,
+        FilteredCurrentColumn = 4
+    };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingWindow::RecordingWindow(const QString& filename, QWidget* parent)
+    : QWidget(parent, Qt::Window),
+      m_ui(std::make_unique<Ui::RecordingWindow>()),
+      m_recording(std::make_shared<RecordingFile>(filename)),
+      m_progressTimer(this)
+{
+    if (m_recording->columnCount() <= CurrentColumn)
+        throw RecordingFile::Error("File " + filename.toStdString() + " contains no recording.");
+
+    m_ui->setupUi(this);
+
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowTitle(QFileInfo(filename).fileName());
+
+    m_ui->filteredCheckBox->setEnabled(m_recording->columnCount() > FilteredCurrentColumn);
+
+    m_ui->voltagePlot->setAxisTitles("Time (s)", "Voltage (V)");
+    m_ui->currentPlot->setAxisTitles("Time (s)", "Current (A)");
+
+    m_ui->voltagePlot->setRecording(m_recording, VoltageColumn);
+    m_ui->currentPlot->setRecording(m_recording, CurrentColumn);
+
+    connect(m_ui->voltagePlot, SIGNAL(intervalChanged(double,double)),
+            m_ui->currentPlot, SLOT(setInterval(double,double)));
+
+    connect(m_ui->currentPlot, SIGNAL(intervalChanged(double,double)),
+            m_ui->voltagePlot, SLOT(setInterval(double,double)));
+
+    connect(m_ui->filteredCheckBox, SIGNAL(toggled(bool)), this, SLOT(setFiltered(bool)));
+
+    // The plots fill in while the index is built
+    m_progressTimer.setInterval(250ms);
+    connect(&m_progressTimer, SIGNAL(timeout()), this, SLOT(updateProgress()));
+
+    m_progressTimer.start();
+    updateProgress();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RecordingWindow::~RecordingWindow() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingWindow::setFiltered(bool enable)
+{
+    m_ui->voltagePlot->setColumn(enable ? FilteredVoltageColumn : VoltageColumn);
+    m_ui->currentPlot->setColumn(enable ? FilteredCurrentColumn : CurrentColumn);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingWindow::updateProgress()
+{
+    m_ui->voltagePlot->replot();
+    m_ui->currentPlot->replot();
+
+    if (!m_recording->isIndexed())
+    {
+        const int percent = static_cast<int>(100.0 * m_recording->indexProgress());
+        m_ui->statusLabel->setText(QString("Indexing... %1 %").arg(percent));
+
+        return;
+    }
+
+    m_progressTimer.stop();
+
+    const QString text = QString("%1 samples from %2 s to %3 s")
+            .arg(m_recording->rowCount())
+            .arg(m_recording->firstTime())
+            .arg(m_recording->lastTime());
+
+    m_ui->statusLabel->setText(text);
+}
+
+// ---------------------------------------------------------------------------------------------- //
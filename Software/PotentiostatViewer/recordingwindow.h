@@ -0,0 +1,56 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "recordingfile.h"
+
+#include <QTimer>
+#include <QWidget>
+
+#include <memory>
+
+namespace Ui {
+    class RecordingWindow;
+}
+
+// Shows a recording from disk. Deletes itself when closed.
+class RecordingWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    // Throws if the file cannot be opened
+    explicit RecordingWindow(const QString& filename, QWidget* parent = nullptr);
+    ~RecordingWindow() override;
+
+private slots:
+    void setFiltered(bool enable);
+    void updateProgress();
+
+private:
+    std::unique_ptr<Ui::RecordingWindow> m_ui;
+    std::shared_ptr<const RecordingFile> m_recording;
+
+    QTimer m_progressTimer;
+};
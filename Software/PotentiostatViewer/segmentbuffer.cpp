@@ -0,0 +1,91 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "segmentbuffer.h"
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------------------------- //
+
+SegmentBuffer::SegmentBuffer(size_t segmentSize)
+    : m_samples(segmentSize)
+{
+    assert(segmentSize > 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SegmentBuffer::segmentSize() const -> size_t
+{
+    return m_samples.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SegmentBuffer::isFull() const -> bool
+{
+    return m_size == m_samples.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SegmentBuffer::setHopSize(size_t size)
+{
+    assert(size > 0);
+
+    m_hopSize = size;
+    m_pending = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SegmentBuffer::hopSize() const -> size_t
+{
+    return m_hopSize;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SegmentBuffer::applyWindow(std::span<const double> window, std::span<double> output) const
+{
+    assert(isFull() && window.size() == m_samples.size() && output.size() == m_samples.size());
+
+    const size_t tail = m_samples.size() - m_position;
+
+    for (size_t i = 0; i < tail; ++i)
+        output[i] = m_samples[m_position + i] * window[i];
+
+    for (size_t i = tail; i < m_samples.size(); ++i)
+        output[i] = m_samples[i - tail] * window[i];
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SegmentBuffer::clear()
+{
+    m_position = 0;
+    m_size = 0;
+    m_pending = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,92 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+// Latest segment of a sample stream, for spectra computed every hop size samples. A segment
+// may overlap the previous one (hop size below the segment size) or skip samples (above it).
+class SegmentBuffer
+{
+public:
+    explicit SegmentBuffer(size_t segmentSize);
+
+    auto segmentSize() const -> size_t;
+    auto isFull() const -> bool;
+
+    // Also restarts counting towards the next hop
+    void setHopSize(size_t size);
+    auto hopSize() const -> size_t;
+
+    // Calls onHop() whenever a hop is complete and the segment is full
+    template <typename Func>
+    void append(std::span<const double> samples, Func onHop);
+
+    // The segment, oldest sample first, multiplied by the window
+    void applyWindow(std::span<const double> window, std::span<double> output) const;
+
+    void clear();
+
+private:
+    std::vector<double> m_samples;
+    size_t m_position = 0; // Oldest sample once full
+    size_t m_size = 0;
+
+    size_t m_hopSize = 1;
+    size_t m_pending = 0; // Since the last hop
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Func>
+void SegmentBuffer::append(std::span<const double> samples, Func onHop)
+{
+    const size_t segmentSize = m_samples.size();
+
+    while (!samples.empty())
+    {
+        // Up to the next hop or the end of the ring, whichever comes first
+        const size_t count = std::min({ samples.size(), m_hopSize - m_pending,
+                                        segmentSize - m_position });
+
+        std::copy_n(samples.begin(), count, m_samples.begin() + m_position);
+        samples = samples.subspan(count);
+
+        m_position = (m_position + count) % segmentSize;
+        m_size = std::min(m_size + count, segmentSize);
+        m_pending += count;
+
+        if (m_pending == m_hopSize)
+        {
+            m_pending = 0;
+
+            if (isFull())
+                onHop();
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "spectrogramwidget.h"
 #include "storagewidget.h"
 
 #include "CoSeSt2/CoSeSt2.h"
@@ -68,6 +69,20 @@ COSEST_BEGIN(Settings, CoSeSt::StorageType::Global)
     COSEST_ENTRY(QString, Location, QDir::currentPath())
     COSEST_ENTRY(QString, Name,     StorageWidget::DefaultName)
     COSEST_ENTRY(QString, Format,   StorageWidget::DefaultFormat)
+    COSEST_ENTRY(int,     FileType, static_cast<int>(DataRecorder::DefaultFileType))
     COSEST_ENTRY(bool,    AutoSave, false)
   COSEST_END_GROUP(Storage)
+
+  COSEST_BEGIN_GROUP(Filter)
+    COSEST_ENTRY(int, Type, 0)
+  COSEST_END_GROUP(Filter)
+
+  COSEST_BEGIN_GROUP(Spectrogram)
+    COSEST_ENTRY(int,    ColorMap,            static_cast<int>(SpectrogramWidget::DefaultColorMap))
+    COSEST_ENTRY(int,    ColumnRate,          SpectrogramWidget::DefaultColumnRate)
+    COSEST_ENTRY(double, VoltageMinimumLevel, -140.0)
+    COSEST_ENTRY(double, VoltageMaximumLevel,  -40.0)
+    COSEST_ENTRY(double, CurrentMinimumLevel, -200.0)
+    COSEST_ENTRY(double, CurrentMaximumLevel, -100.0)
+  COSEST_END_GROUP(Spectrogram)
 COSEST_END
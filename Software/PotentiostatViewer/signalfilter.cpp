@@ -23,12 +23,33 @@
 
 #include "signalfilter.h"
 
+#include <cassert>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define SIGNALFILTER_SSE2
+#endif
+
+// ---------------------------------------------------------------------------------------------- //
+
+SignalFilter::SignalFilter(size_t decimation)
+    : m_decimation(decimation),
+      m_buffer(2 * m_filterSize)
+{
+    assert(decimation > 0);
+}
+
 // ---------------------------------------------------------------------------------------------- //
 
 void SignalFilter::reset()
 {
-    m_buffer.clear();
+    m_position = 0;
+    m_bufferedSamples = 0;
     m_pendingSamples = 0;
+    m_phase = 0;
+
+    m_biquadState.clear();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -38,12 +59,20 @@ void SignalFilter::update(InputBuffer input, OutputBuffer* output)
     if (input.empty())
         return;
 
-    if (m_buffer.empty())
+    if (m_type == Type::Iir)
+    {
+        updateBiquad(input, output);
+        return;
+    }
+
+    if (m_bufferedSamples == 0)
     {
         for (size_t i = 0; i < (m_filterSize - 1) / 2; ++i)
-            m_buffer.push_front(input[0]);
+            process(input[0], output);
     }
 
+    output->reserve(output->size() + input.size() / m_decimation + 1);
+
     for (size_t i = 0; i < input.size(); ++i)
     {
         ++m_pendingSamples;
@@ -55,10 +84,10 @@ void SignalFilter::update(InputBuffer input, OutputBuffer* output)
 
 void SignalFilter::finalize(OutputBuffer* output)
 {
-    if (m_buffer.empty())
+    if (m_bufferedSamples == 0)
         return;
 
-    const double sample = m_buffer.back();
+    const double sample = m_buffer[m_position + m_filterSize - 1];
 
     while (m_pendingSamples > 0)
         process(sample, output);
@@ -66,25 +95,106 @@ void SignalFilter::finalize(OutputBuffer* output)
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto SignalFilter::decimation() const -> size_t
+{
+    return m_decimation;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SignalFilter::setType(Type type)
+{
+    m_type = type;
+    reset();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SignalFilter::type() const -> Type
+{
+    return m_type;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 inline
 void SignalFilter::process(double input, OutputBuffer* output)
 {
-    m_buffer.push_back(input);
+    m_buffer[m_position] = input;
+    m_buffer[m_position + m_filterSize] = input;
+
+    if (++m_position == m_filterSize)
+        m_position = 0;
+
+    if (m_bufferedSamples < m_filterSize)
+        ++m_bufferedSamples;
+
+    if (m_bufferedSamples < m_filterSize)
+        return;
+
+    if (m_phase == 0)
+        output->push_back(dotProduct(&m_buffer[m_position]));
+
+    if (++m_phase == m_decimation)
+        m_phase = 0;
+
+    --m_pendingSamples;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SignalFilter::dotProduct(const double* samples) const -> double
+{
+    const double* coeffs = m_filter.coefficients().data();
+
+#if defined(SIGNALFILTER_SSE2)
+    __m128d sum0 = _mm_setzero_pd();
+    __m128d sum1 = _mm_setzero_pd();
+    __m128d sum2 = _mm_setzero_pd();
+    __m128d sum3 = _mm_setzero_pd();
 
-    if (m_buffer.size() >= m_filterSize)
+    size_t i = 0;
+
+    for (; i + 8 <= m_filterSize; i += 8)
     {
-        while (m_buffer.size() > m_filterSize)
-            m_buffer.pop_front();
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(coeffs + i), _mm_loadu_pd(samples + i)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(coeffs + i + 2),
+                                           _mm_loadu_pd(samples + i + 2)));
+        sum2 = _mm_add_pd(sum2, _mm_mul_pd(_mm_loadu_pd(coeffs + i + 4),
+                                           _mm_loadu_pd(samples + i + 4)));
+        sum3 = _mm_add_pd(sum3, _mm_mul_pd(_mm_loadu_pd(coeffs + i + 6),
+                                           _mm_loadu_pd(samples + i + 6)));
+    }
 
-        const auto& coeffs = m_filter.coefficients();
+    const __m128d sum = _mm_add_pd(_mm_add_pd(sum0, sum1), _mm_add_pd(sum2, sum3));
+
+    double value = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+
+    for (; i < m_filterSize; ++i)
+        value += coeffs[i] * samples[i];
+
+    return value;
+#else
+    return std::inner_product(coeffs, coeffs + m_filterSize, samples, 0.0);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SignalFilter::updateBiquad(InputBuffer input, OutputBuffer* output)
+{
+    m_biquadOutput.resize(input.size());
+    m_biquadFilter.apply(input, m_biquadOutput, &m_biquadState);
 
-        double value = 0.0;
+    output->reserve(output->size() + input.size() / m_decimation + 1);
 
-        for (size_t i = 0; i < m_filterSize; ++i)
-            value += coeffs[i] * m_buffer[i];
+    for (double value : m_biquadOutput)
+    {
+        if (m_phase == 0)
+            output->push_back(value);
 
-        output->push_back(value);
-        --m_pendingSamples;
+        if (++m_phase == m_decimation)
+            m_phase = 0;
     }
 }
 
@@ -117,3 +227,24 @@ auto SignalFilter::makeFilter() -> SincFilter
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+auto SignalFilter::makeBiquadFilter() -> BiquadFilter
+{
+    constexpr double StopBand1Low  = 45.0 / Device::SampleRate;
+    constexpr double StopBand1High = 55.0 / Device::SampleRate;
+
+    constexpr double StopBand2Low  =  95.0 / Device::SampleRate;
+    constexpr double StopBand2High = 105.0 / Device::SampleRate;
+
+    constexpr double StopBand3Low  = 145.0 / Device::SampleRate;
+    constexpr double StopBand3High = 155.0 / Device::SampleRate;
+
+    constexpr double LowPassCutoff = 180.0 / Device::SampleRate;
+
+    return BiquadFilter::notch(StopBand1Low, StopBand1High)
+         * BiquadFilter::notch(StopBand2Low, StopBand2High)
+         * BiquadFilter::notch(StopBand3Low, StopBand3High)
+         * BiquadFilter::lowPass(LowPassCutoff);
+}
+
+// ---------------------------------------------------------------------------------------------- //
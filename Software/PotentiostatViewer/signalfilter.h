@@ -23,10 +23,10 @@
 
 #pragma once
 
+#include "biquadfilter.h"
 #include "device.h"
 #include "sincfilter.h"
 
-#include <deque>
 #include <span>
 #include <vector>
 
@@ -36,20 +36,52 @@ public:
     using InputBuffer = std::span<const double>;
     using OutputBuffer = std::vector<double>;
 
+    enum class Type
+    {
+        Fir, // Linear phase, delayed by half the filter size
+        Iir  // Causal, much shorter delay but not linear phase
+    };
+
 public:
+    // Only every decimation-th output is computed, the others are skipped
+    explicit SignalFilter(size_t decimation = 1);
+
     void reset();
     void update(InputBuffer input, OutputBuffer* output);
     void finalize(OutputBuffer* output);
 
+    auto decimation() const -> size_t;
+
+    // Also resets the filter
+    void setType(Type type);
+    auto type() const -> Type;
+
 private:
     void process(double input, OutputBuffer* output);
+    auto dotProduct(const double* samples) const -> double;
+
+    void updateBiquad(InputBuffer input, OutputBuffer* output);
 
     static auto makeFilter() -> SincFilter;
+    static auto makeBiquadFilter() -> BiquadFilter;
 
 private:
     const SincFilter m_filter = makeFilter();
     const size_t m_filterSize = m_filter.size();
+    const size_t m_decimation;
+
+    Type m_type = Type::Fir;
+
+    const BiquadFilter m_biquadFilter = makeBiquadFilter();
+    BiquadFilter::State m_biquadState;
+    std::vector<double> m_biquadOutput;
+
+    // Every sample is stored twice, m_filterSize apart, so the latest m_filterSize samples are
+    // always contiguous, starting at m_position
+    std::vector<double> m_buffer;
+    size_t m_position = 0;
+    size_t m_bufferedSamples = 0;
 
-    std::deque<double> m_buffer;
     size_t m_pendingSamples = 0;
+    size_t m_phase = 0; // Outputs to skip before the next one is computed
 };
@@ -0,0 +1,386 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "spectrogramwidget.h"
+
+#include <QApplication>
+#include <QFontMetrics>
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr double MinimumMagnitude = 1.0e-20; // Keeps the logarithm finite
+
+    constexpr int FrequencyTickInterval = 100; // Hz
+    constexpr int Spacing = 4; // Pixels
+
+    struct ColorPoint
+    {
+        double position;
+        int red;
+        int green;
+        int blue;
+    };
+
+    constexpr ColorPoint GrayscalePoints[] = {
+        { 0.0,   0,   0,   0 },
+        { 1.0, 255, 255, 255 }
+    };
+
+    constexpr ColorPoint JetPoints[] = {
+        { 0.000,   0,   0, 128 },
+        { 0.125,   0,   0, 255 },
+        { 0.375,   0, 255, 255 },
+        { 0.625, 255, 255,   0 },
+        { 0.875, 255,   0,   0 },
+        { 1.000, 128,   0,   0 }
+    };
+
+    constexpr ColorPoint ViridisPoints[] = {
+        { 0.00,  68,   1,  84 },
+        { 0.25,  59,  82, 139 },
+        { 0.50,  33, 145, 140 },
+        { 0.75,  94, 201,  98 },
+        { 1.00, 253, 231,  37 }
+    };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+SpectrogramWidget::SpectrogramWidget(QWidget* parent)
+    : QWidget(parent),
+      m_context(SegmentSize),
+      m_windowedSamples(SegmentSize),
+      m_results(SpectrumSize),
+      m_levels(HistorySize),
+      m_image(HistorySize, SpectrumSize, QImage::Format_RGB32)
+{
+    setMinimumSize(200, 100);
+
+    setColumnRate(DefaultColumnRate);
+
+    updateColors();
+    redraw();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::setTitle(const QString& title)
+{
+    m_title = title;
+    update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::setFiltered(bool enable)
+{
+    m_filtered = enable;
+
+    // The samples of the other signal are not kept, the columns start over after a segment
+    m_samples.clear();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::setColumnRate(size_t rate)
+{
+    Q_ASSERT(rate > 0);
+
+    m_columnRate = rate;
+    m_samples.setHopSize(std::max<size_t>(Device::SampleRate / rate, 1));
+
+    update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SpectrogramWidget::columnRate() const -> size_t
+{
+    return m_columnRate;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::setColorMap(ColorMap map)
+{
+    m_colorMap = map;
+
+    updateColors();
+    redraw();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::setLevels(double minimum, double maximum)
+{
+    Q_ASSERT(minimum < maximum);
+
+    m_minimumLevel = minimum;
+    m_maximumLevel = maximum;
+
+    redraw();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SpectrogramWidget::colorMap() const -> ColorMap
+{
+    return m_colorMap;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SpectrogramWidget::minimumLevel() const -> double
+{
+    return m_minimumLevel;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SpectrogramWidget::maximumLevel() const -> double
+{
+    return m_maximumLevel;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::addSamples(std::span<const double> samples)
+{
+    if (!m_filtered)
+        append(samples);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::addFilteredSamples(std::span<const double> samples)
+{
+    if (m_filtered)
+        append(samples);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::clear()
+{
+    m_samples.clear();
+
+    m_nextColumn = 0;
+    m_columnCount = 0;
+
+    redraw();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QFont font = QApplication::font();
+    font.setPointSizeF(0.8 * font.pointSizeF());
+
+    const QFontMetrics metrics(font);
+
+    const int textHeight = metrics.height();
+    const int labelWidth = metrics.horizontalAdvance("000 Hz") + Spacing;
+
+    const QRect plotRect = rect().adjusted(labelWidth + Spacing, textHeight + Spacing,
+                                           -Spacing, -(textHeight + Spacing));
+    if (plotRect.isEmpty())
+        return;
+
+    QPainter painter(this);
+    painter.setFont(font);
+
+    painter.drawText(plotRect.left(), metrics.ascent(), m_title);
+    painter.drawImage(plotRect, m_image);
+
+    for (int f = 0; f <= MaximumFrequency; f += FrequencyTickInterval)
+    {
+        const int y = plotRect.bottom() - static_cast<int>(f / MaximumFrequency * plotRect.height());
+        const QRect labelRect(0, y - textHeight/2, labelWidth, textHeight);
+
+        painter.drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter, QString("%1 Hz").arg(f));
+    }
+
+    const double duration = static_cast<double>(HistorySize * m_samples.hopSize()) / Device::SampleRate;
+    const QRect timeRect(plotRect.left(), plotRect.bottom() + Spacing,
+                         plotRect.width(), textHeight);
+
+    painter.drawText(timeRect, Qt::AlignLeft | Qt::AlignTop, QString("-%1 s").arg(duration));
+    painter.drawText(timeRect, Qt::AlignRight | Qt::AlignTop, "0 s");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+
+    // No columns were added while hidden, so the history would hide a gap in time
+    m_nextColumn = 0;
+    m_columnCount = 0;
+
+    redraw();
+
+    // Start from the latest samples rather than waiting for a whole hop
+    if (m_samples.isFull())
+        addColumn();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::append(std::span<const double> samples)
+{
+    // The samples are still collected, so a column can be added as soon as the widget is shown
+    m_samples.append(samples, [this] {
+        if (isVisible())
+            addColumn();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::addColumn()
+{
+    m_samples.applyWindow(m_window, m_windowedSamples);
+    m_context.transform(m_windowedSamples, m_results);
+
+    auto& levels = m_levels[m_nextColumn];
+
+    for (size_t i = 0; i < SpectrumSize; ++i)
+    {
+        double magnitude = std::abs(m_results[i]) / SegmentSize;
+
+        if (i != 0)
+            magnitude *= 2.0;
+
+        levels[i] = static_cast<float>(20.0 * std::log10(std::max(magnitude, MinimumMagnitude)));
+    }
+
+    // Only the new column is drawn, the existing ones are moved one pixel to the left
+    const int width = m_image.width();
+
+    for (int y = 0; y < m_image.height(); ++y)
+    {
+        auto line = reinterpret_cast<QRgb*>(m_image.scanLine(y));
+        std::copy(line + 1, line + width, line);
+    }
+
+    drawColumn(m_nextColumn, width - 1);
+
+    m_nextColumn = (m_nextColumn + 1) % HistorySize;
+    m_columnCount = std::min(m_columnCount + 1, HistorySize);
+
+    update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::drawColumn(size_t column, int x)
+{
+    const auto& levels = m_levels[column];
+
+    const double scale = (m_colors.size() - 1) / (m_maximumLevel - m_minimumLevel);
+    const auto maximumIndex = static_cast<double>(m_colors.size() - 1);
+
+    for (size_t i = 0; i < SpectrumSize; ++i)
+    {
+        const double index = std::clamp((levels[i] - m_minimumLevel) * scale, 0.0, maximumIndex);
+        const auto y = static_cast<int>(SpectrumSize - 1 - i); // Lowest frequency at the bottom
+
+        reinterpret_cast<QRgb*>(m_image.scanLine(y))[x] = m_colors[static_cast<size_t>(index)];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::redraw()
+{
+    m_image.fill(m_colors.front());
+
+    const size_t first = (m_nextColumn + HistorySize - m_columnCount) % HistorySize;
+    const size_t offset = HistorySize - m_columnCount;
+
+    for (size_t i = 0; i < m_columnCount; ++i)
+        drawColumn((first + i) % HistorySize, static_cast<int>(offset + i));
+
+    update();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SpectrogramWidget::updateColors()
+{
+    std::span<const ColorPoint> points = ViridisPoints;
+
+    if (m_colorMap == ColorMap::Grayscale)
+        points = GrayscalePoints;
+    else if (m_colorMap == ColorMap::Jet)
+        points = JetPoints;
+
+    for (size_t i = 0; i < m_colors.size(); ++i)
+    {
+        const double position = static_cast<double>(i) / (m_colors.size() - 1);
+
+        size_t j = 1;
+
+        while (j < points.size() - 1 && points[j].position < position)
+            ++j;
+
+        const auto& p0 = points[j - 1];
+        const auto& p1 = points[j];
+
+        const double t = (position - p0.position) / (p1.position - p0.position);
+
+        m_colors[i] = qRgb(static_cast<int>(std::lround(p0.red   + t * (p1.red   - p0.red))),
+                           static_cast<int>(std::lround(p0.green + t * (p1.green - p0.green))),
+                           static_cast<int>(std::lround(p0.blue  + t * (p1.blue  - p0.blue))));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SpectrogramWidget::makeWindow(size_t size) -> std::vector<double>
+{
+    static constexpr double Pi = 3.14159265358979323846;
+    static constexpr double TwoPi = 2.0 * Pi;
+
+    Q_ASSERT(size > 1);
+
+    std::vector<double> window(size);
+
+    const auto m = static_cast<double>(size - 1);
+
+    for (size_t i = 0; i < size; ++i)
+        window[i] = 0.5 - 0.5*std::cos(TwoPi*i / m); // Hann
+
+    return window;
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,129 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "device.h"
+#include "segmentbuffer.h"
+
+#include <sft/sft.h>
+
+#include <QImage>
+#include <QWidget>
+
+#include <array>
+#include <span>
+#include <vector>
+
+class SpectrogramWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr size_t SegmentSize = Device::SampleRate / 2;
+    static constexpr size_t SpectrumSize = SegmentSize/2 + 1;
+
+    static constexpr double MaximumFrequency = Device::SampleRate * 0.5;
+
+    static constexpr size_t HistorySize = 600; // Columns
+
+    static constexpr size_t DefaultColumnRate = 10; // Per second
+
+    static constexpr double DefaultMinimumLevel = -140.0; // dB
+    static constexpr double DefaultMaximumLevel =  -40.0;
+
+    enum class ColorMap
+    {
+        Grayscale,
+        Jet,
+        Viridis
+    };
+
+    static constexpr auto DefaultColorMap = ColorMap::Viridis;
+
+public:
+    SpectrogramWidget(QWidget* parent = nullptr);
+
+    void setTitle(const QString& title);
+    void setFiltered(bool enable);
+
+    void setColumnRate(size_t rate);
+    auto columnRate() const -> size_t;
+
+    // Magnitudes at or below the minimum get the first color of the map, at or above the
+    // maximum the last one
+    void setColorMap(ColorMap map);
+    void setLevels(double minimum, double maximum);
+
+    auto colorMap() const -> ColorMap;
+    auto minimumLevel() const -> double;
+    auto maximumLevel() const -> double;
+
+    void addSamples(std::span<const double> samples);
+    void addFilteredSamples(std::span<const double> samples);
+
+    void clear();
+
+private:
+    void paintEvent(QPaintEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+
+    void append(std::span<const double> samples);
+
+    void addColumn();
+    void drawColumn(size_t column, int x);
+    void redraw();
+
+    void updateColors();
+
+    static auto makeWindow(size_t size) -> std::vector<double>;
+
+private:
+    sft::Context<sft::Real> m_context;
+
+    QString m_title;
+
+    // A column is added every hop, the hop size follows from the column rate
+    SegmentBuffer m_samples = SegmentBuffer(SegmentSize);
+    size_t m_columnRate = 0;
+
+    const std::vector<double> m_window = makeWindow(SegmentSize);
+    std::vector<double> m_windowedSamples;
+    std::vector<sft::Complex> m_results;
+
+    // Ring of column levels in dB, kept to redraw the image when the colors change
+    std::vector<std::array<float, SpectrumSize>> m_levels;
+    size_t m_nextColumn = 0;
+    size_t m_columnCount = 0;
+
+    // One pixel per column and frequency, the newest column on the right
+    QImage m_image;
+
+    ColorMap m_colorMap = DefaultColorMap;
+    double m_minimumLevel = DefaultMinimumLevel;
+    double m_maximumLevel = DefaultMaximumLevel;
+
+    std::array<QRgb, 256> m_colors;
+
+    bool m_filtered = false;
+};
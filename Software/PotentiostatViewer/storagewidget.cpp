@@ -55,6 +55,7 @@ void StorageWidget::saveSettings() const
     settings->setLocation(m_ui->location->text());
     settings->setName(m_ui->name->text());
     settings->setFormat(m_ui->format->text());
+    settings->setFileType(m_ui->fileType->currentIndex());
     settings->setAutoSave(m_ui->autoSave->isChecked());
 }
 
@@ -82,6 +83,7 @@ void StorageWidget::loadSettings()
     m_ui->location->setText(location);
     m_ui->name->setText(name);
     m_ui->format->setText(format);
+    m_ui->fileType->setCurrentIndex(settings.getFileType());
     m_ui->autoSave->setChecked(settings.getAutoSave());
 }
 
@@ -118,13 +120,23 @@ auto StorageWidget::getFilePath() const -> QString
     if (format.isEmpty())
         format = "Unnamed";
 
+    const QString extension = DataRecorder::fileExtension(getFileType());
+
     QString filename = format;
     int suffix = 0;
 
-    while (QDir(location).exists(filename + ".csv"))
+    while (QDir(location).exists(filename + extension))
         filename = format + "_" + QString::number(++suffix);
 
-    return location + "/" + filename + ".csv";
+    return location + "/" + filename + extension;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto StorageWidget::getFileType() const -> DataRecorder::FileType
+{
+    return (m_ui->fileType->currentIndex() == static_cast<int>(DataRecorder::FileType::Binary))
+            ? DataRecorder::FileType::Binary : DataRecorder::FileType::Csv;
 }
 
 // ---------------------------------------------------------------------------------------------- //
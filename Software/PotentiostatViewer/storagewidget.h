@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include "datarecorder.h"
+
 #include <QWidget>
 
 namespace Ui {
@@ -45,6 +47,7 @@ public:
     void loadSettings();
 
     auto getFilePath() const -> QString;
+    auto getFileType() const -> DataRecorder::FileType;
     auto autoSaveEnabled() const -> bool;
 
 signals:
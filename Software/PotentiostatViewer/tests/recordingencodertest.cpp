@@ -0,0 +1,217 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingencoder.h"
+#include "recordingindex.h"
+#include "testing.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    using FileType = RecordingEncoder::FileType;
+
+    constexpr size_t Unlimited = std::numeric_limits<size_t>::max();
+
+    auto samples(size_t first, size_t count, double scale) -> std::vector<double>
+    {
+        std::vector<double> values;
+
+        for (size_t i = first; i < first + count; ++i)
+            values.push_back(scale * static_cast<double>(i));
+
+        return values;
+    }
+
+    // The voltage is i, the current 10 i, the filtered values are negated
+    void addSamples(RecordingEncoder& encoder, size_t first, size_t count)
+    {
+        encoder.addSamples(samples(first, count, 1.0), samples(first, count, 10.0));
+    }
+
+    void addFilteredSamples(RecordingEncoder& encoder, size_t first, size_t count)
+    {
+        encoder.addFilteredSamples(samples(first, count, -1.0), samples(first, count, -10.0));
+    }
+
+    auto isRow(const std::vector<double>& values, size_t row, size_t sample, double time) -> bool
+    {
+        const double* value = values.data() + row * RecordingEncoder::ColumnCount;
+        const auto i = static_cast<double>(sample);
+
+        return value[0] == time && value[1] == i && value[2] == 10.0 * i && value[3] == -i &&
+                value[4] == -10.0 * i;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testPairing()
+{
+    RecordingEncoder encoder(0.5);
+    std::vector<double> values;
+
+    // Rows are only complete once the lagging filtered samples arrived
+    addSamples(encoder, 0, 10);
+    CHECK(encoder.takeRows(values, Unlimited) == 0);
+    CHECK(values.empty());
+
+    addFilteredSamples(encoder, 0, 4);
+    CHECK(encoder.takeRows(values, Unlimited) == 4);
+    CHECK(values.size() == 4 * RecordingEncoder::ColumnCount);
+
+    addSamples(encoder, 10, 2);
+    addFilteredSamples(encoder, 4, 6);
+    CHECK(encoder.takeRows(values, Unlimited) == 6);
+    CHECK(values.size() == 10 * RecordingEncoder::ColumnCount);
+    CHECK(encoder.rowCount() == 10);
+
+    for (size_t i = 0; i < 10; ++i)
+        CHECK(isRow(values, i, i, 0.5 * static_cast<double>(i)));
+
+    // The samples still missing their filtered values are padded when finishing
+    values.clear();
+    CHECK(encoder.takeRows(values, Unlimited, true) == 2);
+    CHECK(values.size() == 2 * RecordingEncoder::ColumnCount);
+    CHECK(values[0] == 5.0 && values[1] == 10.0 && values[2] == 100.0);
+    CHECK(std::isnan(values[3]) && std::isnan(values[4]));
+    CHECK(values[5] == 5.5 && values[6] == 11.0);
+    CHECK(std::isnan(values[8]) && std::isnan(values[9]));
+
+    CHECK(encoder.takeRows(values, Unlimited, true) == 0);
+    CHECK(encoder.droppedRowCount() == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDropped()
+{
+    RecordingEncoder encoder(1.0);
+    std::vector<double> values;
+
+    // Only three rows fit, the time of the rows after the dropped ones still counts them
+    addSamples(encoder, 0, 5);
+    addFilteredSamples(encoder, 0, 5);
+    CHECK(encoder.takeRows(values, 3 * RecordingEncoder::ColumnCount + 2) == 3);
+    CHECK(encoder.droppedRowCount() == 2);
+    CHECK(encoder.rowCount() == 5);
+
+    values.clear();
+    addSamples(encoder, 5, 2);
+    addFilteredSamples(encoder, 5, 2);
+    CHECK(encoder.takeRows(values, 3 * RecordingEncoder::ColumnCount) == 2);
+    CHECK(isRow(values, 0, 5, 5.0));
+    CHECK(isRow(values, 1, 6, 6.0));
+    CHECK(encoder.droppedRowCount() == 2);
+
+    // Nothing fits
+    addSamples(encoder, 7, 1);
+    addFilteredSamples(encoder, 7, 1);
+    CHECK(encoder.takeRows(values, RecordingEncoder::ColumnCount) == 0);
+    CHECK(encoder.droppedRowCount() == 3);
+
+    encoder.reset(1.0);
+    CHECK(encoder.rowCount() == 0);
+    CHECK(encoder.droppedRowCount() == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCsv()
+{
+    const std::vector<double> values = {0.0, 1.5, -0.25, 1e-9, std::nan(""),
+                                        0.5, 2.0, 3.0, 4.0, 5.0};
+
+    std::string data = RecordingEncoder::header(FileType::Csv, 0.5);
+    RecordingEncoder::encode(FileType::Csv, values, data);
+
+    CHECK(data == "Time (s);Voltage (V);Current (A);Filtered voltage (V);Filtered current (A)\n"
+                  "0;1.5;-0.25;1e-09;nan\n"
+                  "0.5;2;3;4;5\n");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBinary()
+{
+    const std::vector<double> values = samples(0, 3 * RecordingEncoder::ColumnCount, 0.5);
+
+    std::string data = RecordingEncoder::header(FileType::Binary, 0.001);
+    CHECK(data.size() == 20);
+    CHECK(data.compare(0, 8, "PSVDATA1") == 0);
+
+    uint32_t columnCount = 0;
+    double sampleTime = 0.0;
+    std::memcpy(&columnCount, data.data() + 8, sizeof(columnCount));
+    std::memcpy(&sampleTime, data.data() + 12, sizeof(sampleTime));
+    CHECK(columnCount == RecordingEncoder::ColumnCount);
+    CHECK(sampleTime == 0.001);
+
+    RecordingEncoder::encode(FileType::Binary, values, data);
+    CHECK(data.size() == 20 + values.size() * sizeof(double));
+    CHECK(std::memcmp(data.data() + 20, values.data(), values.size() * sizeof(double)) == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testReadable()
+{
+    // Both formats are read back by the recording window
+    for (const FileType type : {FileType::Csv, FileType::Binary})
+    {
+        RecordingEncoder encoder(0.25);
+        std::vector<double> values;
+
+        addSamples(encoder, 0, 100);
+        addFilteredSamples(encoder, 0, 100);
+        encoder.takeRows(values, Unlimited, true);
+
+        std::string data = RecordingEncoder::header(type, 0.25);
+        RecordingEncoder::encode(type, values, data);
+
+        const RecordingIndex index(data);
+        CHECK(index.columnCount() == RecordingEncoder::ColumnCount);
+        CHECK(index.firstTime() == 0.0);
+        CHECK(index.lastTime() == 24.75);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testPairing();
+    testDropped();
+    testCsv();
+    testBinary();
+    testReadable();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
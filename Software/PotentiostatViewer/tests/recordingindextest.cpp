@@ -0,0 +1,290 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recordingindex.h"
+#include "testing.h"
+
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Written by the DataRecorder, followed by the column count and the sample time
+    constexpr char Magic[] = "PSVDATA1";
+
+    // Time in ms, a sawtooth between -500 and 499 and a ramp
+    auto valueAt(size_t row, size_t column) -> double
+    {
+        const auto i = static_cast<double>(row);
+
+        if (column == 0)
+            return i / 1000.0;
+
+        if (column == 1)
+            return static_cast<double>(row % 1000) - 500.0;
+
+        return 2.0 * i;
+    }
+
+    auto binaryRecording(size_t rowCount, uint32_t columnCount) -> std::string
+    {
+        const double sampleTime = 0.001;
+
+        std::string data(Magic);
+        data.append(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+        data.append(reinterpret_cast<const char*>(&sampleTime), sizeof(sampleTime));
+
+        for (size_t i = 0; i < rowCount; ++i)
+        {
+            for (size_t j = 0; j < columnCount; ++j)
+            {
+                const double value = valueAt(i, j);
+                data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+        }
+
+        return data;
+    }
+
+    // The given row has no value in the last column
+    auto csvRecording(size_t rowCount, size_t missingRow) -> std::string
+    {
+        std::string data = "Time (s);Voltage (V);Current (A)\n";
+
+        for (size_t i = 0; i < rowCount; ++i)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                if (j > 0)
+                    data += ';';
+
+                if (i == missingRow && j == 2)
+                    continue;
+
+                char number[32];
+                const auto result = std::to_chars(number, number + sizeof(number), valueAt(i, j));
+                data.append(number, result.ptr);
+            }
+
+            data += '\n';
+        }
+
+        return data;
+    }
+
+    auto waitForIndex(const RecordingIndex& index) -> bool
+    {
+        for (int i = 0; i < 1000 && !index.isIndexed(); ++i)
+            std::this_thread::sleep_for(10ms);
+
+        return index.isIndexed();
+    }
+
+    // Every row between the given ones is returned as it is
+    auto isRaw(const std::vector<RecordingIndex::Point>& points, size_t column,
+               size_t firstRow, size_t lastRow) -> bool
+    {
+        if (points.size() != lastRow - firstRow + 1)
+            return false;
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            const double value = valueAt(firstRow + i, column);
+            const RecordingIndex::Point& point = points[i];
+
+            if (point.time != valueAt(firstRow + i, 0) || point.minimum != value ||
+                    point.mean != value || point.maximum != value)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBinary()
+{
+    // The last row has only been written partially
+    const std::string data = binaryRecording(1000, 3) + "12345";
+    const RecordingIndex index(data);
+
+    CHECK(index.columnCount() == 3);
+    CHECK(index.firstTime() == 0.0);
+    CHECK(index.lastTime() == 0.999);
+
+    if (!CHECK(waitForIndex(index)))
+        return;
+
+    CHECK(index.indexProgress() == 1.0);
+    CHECK(index.rowCount() == 1000);
+
+    CHECK(isRaw(index.select(1, 0.0, 1.0, 1000), 1, 0, 999));
+    CHECK(isRaw(index.select(2, 0.0, 1.0, 1000), 2, 0, 999));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCsv()
+{
+    const std::string data = csvRecording(1000, 500);
+    const RecordingIndex index(data);
+
+    CHECK(index.columnCount() == 3);
+    CHECK(index.firstTime() == 0.0);
+    CHECK(index.lastTime() == 0.999);
+
+    if (!CHECK(waitForIndex(index)))
+        return;
+
+    CHECK(index.rowCount() == 1000);
+    CHECK(isRaw(index.select(1, 0.0, 1.0, 1000), 1, 0, 999));
+
+    // The missing value is left out
+    const auto points = index.select(2, 0.0, 1.0, 1000);
+
+    if (CHECK(points.size() == 999))
+        CHECK(points[499].time == 0.499 && points[500].time == 0.501);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testZoom()
+{
+    const std::string binary = binaryRecording(1000, 3);
+    const std::string csv = csvRecording(1000, 1000);
+
+    for (const std::string* data : { &binary, &csv })
+    {
+        const RecordingIndex index(*data);
+
+        // One more row on either side, unless a row lies exactly on the end
+        CHECK(isRaw(index.select(1, 0.2, 0.3, 1000), 1, 199, 300));
+        CHECK(isRaw(index.select(1, 0.2005, 0.3005, 1000), 1, 200, 301));
+
+        CHECK(isRaw(index.select(1, -1.0, 0.0005, 1000), 1, 0, 1));
+        CHECK(isRaw(index.select(1, 0.9985, 2.0, 1000), 1, 998, 999));
+
+        CHECK(index.select(1, 0.3, 0.2, 1000).empty());
+        CHECK(index.select(1, 0.2, 0.3, 0).empty());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRowGroups()
+{
+    const std::string data = binaryRecording(1000, 3);
+    const RecordingIndex index(data);
+
+    // The sawtooth spans its full range in every group of 100 rows
+    const auto points = index.select(1, 0.0, 1.0, 10);
+
+    if (!CHECK(points.size() == 10))
+        return;
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        CHECK(points[i].time == 0.5 * (valueAt(100 * i, 0) + valueAt(100 * i + 99, 0)));
+        CHECK(points[i].minimum == valueAt(100 * i, 1));
+        CHECK(points[i].maximum == valueAt(100 * i + 99, 1));
+        CHECK(points[i].mean == 0.5 * (points[i].minimum + points[i].maximum));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBuckets()
+{
+    // 12 MB, long enough that the full span is drawn from the buckets
+    const size_t rowCount = 300000;
+
+    const std::string data = binaryRecording(rowCount, 5);
+    const RecordingIndex index(data);
+
+    if (!CHECK(waitForIndex(index)))
+        return;
+
+    CHECK(index.rowCount() == rowCount);
+
+    const auto points = index.select(2, 0.0, index.lastTime(), 100);
+
+    if (!CHECK(!points.empty() && points.size() <= 101))
+        return;
+
+    CHECK(points.front().minimum == 0.0);
+    CHECK(points.back().maximum == valueAt(rowCount - 1, 2));
+
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        CHECK(points[i].time > points[i - 1].time);
+        CHECK(points[i].minimum > points[i - 1].maximum);
+    }
+
+    // The mean of a ramp lies at its centre
+    for (const auto& point : points)
+        CHECK_NEAR(point.mean, 2000.0 * point.time, 1e-6 * point.maximum);
+
+    // Short spans are still read row by row
+    CHECK(isRaw(index.select(2, 100.0, 101.0, 2000), 2, 99999, 101000));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testInvalid()
+{
+    const std::string empty;
+    CHECK_THROWS(RecordingIndex(std::span(empty)));
+
+    // No rows, a single column and too many columns
+    CHECK_THROWS(RecordingIndex(binaryRecording(0, 3)));
+    CHECK_THROWS(RecordingIndex(binaryRecording(10, 1)));
+    CHECK_THROWS(RecordingIndex(binaryRecording(10, 65)));
+
+    CHECK_THROWS(RecordingIndex(std::string("Time (s);Voltage (V)\n")));
+    CHECK_THROWS(RecordingIndex(std::string("1;2\n0;3\n")));
+    CHECK_THROWS(RecordingIndex(std::string("Time (s);Voltage (V)\nabc;1\n")));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testBinary();
+    testCsv();
+    testZoom();
+    testRowGroups();
+    testBuckets();
+    testInvalid();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,193 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "segmentbuffer.h"
+#include "testing.h"
+
+#include <numeric>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    struct Hop
+    {
+        size_t sampleCount; // Appended before the hop
+        std::vector<double> segment;
+    };
+
+    // Appends the samples 0, 1, 2, ... in chunks of the given size and records every hop
+    auto run(SegmentBuffer* buffer, size_t sampleCount, size_t chunkSize) -> std::vector<Hop>
+    {
+        std::vector<double> samples(sampleCount);
+        std::iota(samples.begin(), samples.end(), 0.0);
+
+        const std::vector<double> window(buffer->segmentSize(), 1.0);
+
+        std::vector<Hop> hops;
+
+        for (size_t i = 0; i < sampleCount; i += chunkSize)
+        {
+            const size_t size = std::min(chunkSize, sampleCount - i);
+            const std::span<const double> chunk(samples.data() + i, size);
+
+            buffer->append(chunk, [&] {
+                Hop hop = { 0, std::vector<double>(buffer->segmentSize()) };
+                buffer->applyWindow(window, hop.segment);
+
+                // The newest sample of the segment tells how far the buffer got
+                hop.sampleCount = static_cast<size_t>(hop.segment.back()) + 1;
+                hops.push_back(std::move(hop));
+            });
+        }
+
+        return hops;
+    }
+
+    // The segment ends with the latest sample
+    auto isLatestSegment(const Hop& hop) -> bool
+    {
+        for (size_t i = 0; i < hop.segment.size(); ++i)
+        {
+            const double expected = static_cast<double>(hop.sampleCount - hop.segment.size() + i);
+
+            if (hop.segment[i] != expected)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testOverlap()
+{
+    // Half of each segment is shared with the previous one
+    for (size_t chunkSize : { 1, 3, 10, 64 })
+    {
+        SegmentBuffer buffer(10);
+        buffer.setHopSize(5);
+
+        const std::vector<Hop> hops = run(&buffer, 37, chunkSize);
+
+        if (!CHECK(hops.size() == 6))
+            continue;
+
+        for (size_t i = 0; i < hops.size(); ++i)
+        {
+            CHECK(hops[i].sampleCount == 10 + 5 * i);
+            CHECK(isLatestSegment(hops[i]));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testGaps()
+{
+    // Hops longer than a segment skip the samples in between
+    for (size_t chunkSize : { 1, 7, 100 })
+    {
+        SegmentBuffer buffer(10);
+        buffer.setHopSize(15);
+
+        const std::vector<Hop> hops = run(&buffer, 50, chunkSize);
+
+        if (!CHECK(hops.size() == 3))
+            continue;
+
+        for (size_t i = 0; i < hops.size(); ++i)
+        {
+            CHECK(hops[i].sampleCount == 15 * (i + 1));
+            CHECK(isLatestSegment(hops[i]));
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testWindow()
+{
+    SegmentBuffer buffer(4);
+    buffer.setHopSize(1);
+
+    const std::vector<double> samples = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    const std::vector<double> window = { 0.5, 1.0, 2.0, 4.0 };
+
+    buffer.append(samples, [] {});
+
+    // Oldest sample first, against the start of the window
+    std::vector<double> output(4);
+    buffer.applyWindow(window, output);
+
+    CHECK(output == std::vector<double>({ 1.5, 4.0, 10.0, 24.0 }));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRestart()
+{
+    SegmentBuffer buffer(10);
+    buffer.setHopSize(5);
+
+    size_t hopCount = 0;
+    const auto onHop = [&] { ++hopCount; };
+
+    const std::vector<double> samples(12, 1.0);
+
+    // Full after ten samples, with two samples towards the next hop
+    buffer.append(samples, onHop);
+    CHECK(buffer.isFull() && hopCount == 1);
+
+    // A new hop size counts from zero
+    buffer.setHopSize(4);
+    buffer.append(std::span(samples).first(3), onHop);
+    CHECK(hopCount == 1);
+
+    buffer.append(std::span(samples).first(1), onHop);
+    CHECK(hopCount == 2);
+
+    // Cleared, the segment has to fill up again
+    buffer.clear();
+    CHECK(!buffer.isFull());
+
+    buffer.append(std::span(samples).first(8), onHop);
+    CHECK(hopCount == 2);
+
+    buffer.append(std::span(samples).first(4), onHop);
+    CHECK(hopCount == 3);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testOverlap();
+    testGaps();
+    testWindow();
+    testRestart();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,200 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "signalfilter.h"
+#include "testing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr size_t FilterSize = 121;
+    constexpr size_t HalfSize = (FilterSize - 1) / 2;
+
+    auto randomSignal(size_t size) -> std::vector<double>
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        std::vector<double> signal(size);
+        std::generate(signal.begin(), signal.end(), [&] { return distribution(generator); });
+
+        return signal;
+    }
+
+    // Feeds the input in chunks of the given size and finalizes
+    auto filter(SignalFilter* filter, std::span<const double> input, size_t chunkSize)
+        -> std::vector<double>
+    {
+        std::vector<double> output;
+
+        for (size_t i = 0; i < input.size(); i += chunkSize)
+            filter->update(input.subspan(i, std::min(chunkSize, input.size() - i)), &output);
+
+        filter->finalize(&output);
+        return output;
+    }
+
+    // Convolution with the first and last sample repeated for half the filter size, as done by
+    // the FIR filter
+    auto convolve(std::span<const double> input, std::span<const double> kernel)
+        -> std::vector<double>
+    {
+        std::vector<double> extended(HalfSize, input.front());
+        extended.insert(extended.end(), input.begin(), input.end());
+        extended.insert(extended.end(), HalfSize, input.back());
+
+        std::vector<double> output(input.size(), 0.0);
+
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            for (size_t j = 0; j < kernel.size(); ++j)
+                output[i] += kernel[j] * extended[i + j];
+        }
+
+        return output;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testFir()
+{
+    // The response to a centered impulse is the (symmetric) kernel
+    std::vector<double> impulse(FilterSize, 0.0);
+    impulse[HalfSize] = 1.0;
+
+    SignalFilter impulseFilter;
+    const std::vector<double> kernel = filter(&impulseFilter, impulse, impulse.size());
+
+    if (!CHECK(kernel.size() == FilterSize))
+        return;
+
+    for (size_t i = 0; i < HalfSize; ++i)
+        CHECK(kernel[i] == kernel[FilterSize - 1 - i]);
+
+    const std::vector<double> input = randomSignal(20000);
+    const std::vector<double> expected = convolve(input, kernel);
+
+    SignalFilter signalFilter;
+    const std::vector<double> output = filter(&signalFilter, input, input.size());
+
+    if (!CHECK(output.size() == input.size()))
+        return;
+
+    double deviation = 0.0;
+
+    for (size_t i = 0; i < output.size(); ++i)
+        deviation = std::max(deviation, std::abs(output[i] - expected[i]));
+
+    // Only the order of summation differs
+    CHECK(deviation < 1e-13);
+
+    // The chunk size makes no difference at all
+    for (size_t chunkSize : { 1, 7, 333, 4096 })
+    {
+        signalFilter.reset();
+
+        if (!CHECK(filter(&signalFilter, input, chunkSize) == output))
+            std::cerr << "  chunk size " << chunkSize << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDecimation()
+{
+    const std::vector<double> input = randomSignal(10001);
+
+    for (SignalFilter::Type type : { SignalFilter::Type::Fir, SignalFilter::Type::Iir })
+    {
+        SignalFilter fullRate;
+        fullRate.setType(type);
+
+        const std::vector<double> expected = filter(&fullRate, input, 333);
+
+        for (size_t decimation : { 2, 4, 7 })
+        {
+            SignalFilter decimated(decimation);
+            decimated.setType(type);
+
+            CHECK(decimated.decimation() == decimation);
+
+            const std::vector<double> output = filter(&decimated, input, 333);
+
+            if (!CHECK(output.size() == (expected.size() + decimation - 1) / decimation))
+                continue;
+
+            // Every decimation-th output, computed in the same way
+            bool identical = true;
+
+            for (size_t i = 0; i < output.size(); ++i)
+                identical = identical && output[i] == expected[i * decimation];
+
+            CHECK(identical);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testIir()
+{
+    const std::vector<double> input = randomSignal(5000);
+
+    SignalFilter signalFilter;
+    signalFilter.setType(SignalFilter::Type::Iir);
+
+    CHECK(signalFilter.type() == SignalFilter::Type::Iir);
+
+    const std::vector<double> output = filter(&signalFilter, input, input.size());
+    CHECK(output.size() == input.size());
+
+    // The state carries over from chunk to chunk
+    signalFilter.reset();
+    CHECK(filter(&signalFilter, input, 100) == output);
+
+    // A constant input passes unchanged, since the state starts out settled on the first sample
+    const std::vector<double> constant(1000, 2.5);
+
+    signalFilter.reset();
+
+    for (double value : filter(&signalFilter, constant, constant.size()))
+        CHECK_NEAR(value, 2.5, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testFir();
+    testDecimation();
+    testIir();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -32,12 +32,13 @@ QMAKE_CXXFLAGS += -Wno-deprecated-enum-enum-conversion
 QMAKE_RPATHDIR += $ORIGIN
 
 INCLUDEPATH += include
-LIBS += -L. -lSensors
+LIBS += -L. -lSensors -lSerial
 
 DEFINES += APPLICATION_VERSION=\\\"1.0\\\"
 
 SOURCES += \
     aboutdialog.cpp \
+    deviceworker.cpp \
     main.cpp \
     mainwindow.cpp \
     nonewidget.cpp \
@@ -47,6 +48,7 @@ SOURCES += \
 
 HEADERS += \
     aboutdialog.h \
+    deviceworker.h \
     mainwindow.h \
     nonewidget.h \
     phwidget.h \
@@ -0,0 +1,72 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "deviceworker.h"
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceWorker::DeviceWorker(std::unique_ptr<Device> device, unsigned int generation)
+    : m_device(std::move(device)),
+      m_generation(generation),
+      m_updateTimer(this)
+{
+    Q_ASSERT(m_device != nullptr);
+
+    m_updateTimer.setInterval(500ms);
+    m_updateTimer.setSingleShot(true);
+
+    connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateValues()));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceWorker::~DeviceWorker() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::start()
+{
+    updateValues();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceWorker::updateValues()
+{
+    try {
+        auto values = std::make_shared<const Device::Values>(m_device->getAllValues());
+        emit valuesUpdated(m_generation, values);
+
+        // Single shot, so requests never pile up behind a slow port
+        m_updateTimer.start();
+    }
+    catch (const std::exception& e) {
+        emit error(m_generation, e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,68 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <sensors/device.h>
+
+#include <QObject>
+#include <QTimer>
+
+#include <memory>
+
+// Polls the device from its own thread, so that a slow serial port never stalls the GUI. Every
+// signal carries the generation the worker was created with, so that the receiver can drop the
+// ones still queued from a worker that has been replaced in the meantime.
+class DeviceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Device = isf::Sensors::Device;
+    using SharedValues = std::shared_ptr<const Device::Values>;
+
+public:
+    DeviceWorker(std::unique_ptr<Device> device, unsigned int generation);
+    ~DeviceWorker() override;
+
+    DeviceWorker(const DeviceWorker&) = delete;
+    auto operator=(const DeviceWorker&) = delete;
+
+    DeviceWorker(DeviceWorker&&) = delete;
+    auto operator=(DeviceWorker&&) = delete;
+
+public slots:
+    void start();
+
+signals:
+    void valuesUpdated(unsigned int generation, const DeviceWorker::SharedValues& values);
+    void error(unsigned int generation, const QString& msg);
+
+private slots:
+    void updateValues();
+
+private:
+    std::unique_ptr<Device> m_device;
+    const unsigned int m_generation;
+    QTimer m_updateTimer;
+};
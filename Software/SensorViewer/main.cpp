@@ -29,6 +29,8 @@
 
 auto main(int argc, char* argv[]) -> int
 {
+    qRegisterMetaType<DeviceWorker::SharedValues>("DeviceWorker::SharedValues");
+
     QApplication::setOrganizationName("Bonn-Rhein-Sieg University of Applied Sciences");
     QApplication::setApplicationName("ISF Sensor Viewer");
     QApplication::setApplicationVersion(APPLICATION_VERSION);
@@ -36,15 +36,10 @@
 
 // ---------------------------------------------------------------------------------------------- //
 
-using namespace std::chrono_literals;
-
-// ---------------------------------------------------------------------------------------------- //
-
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent),
       m_ui(std::make_unique<Ui::MainWindow>()),
-      m_powerLabel(new QLabel),
-      m_updateTimer(this)
+      m_powerLabel(new QLabel)
 {
     m_ui->setupUi(this);
 
@@ -61,29 +56,27 @@ MainWindow::MainWindow(QWidget* parent)
         m_ui->sensor1Group, m_ui->sensor2Group
     };
 
-    setupSensorWidgets();
+    setupSensorWidgets(nullptr);
 
     m_ui->statusBar->addPermanentWidget(m_powerLabel);
 
     //adjustSize();
     //setMinimumSize(sizeHint());
 
-    m_updateTimer.setInterval(500ms);
-    m_updateTimer.setSingleShot(true);
-
     connect(m_serialPortWidget, SIGNAL(serialPortChanged(QString)),
             this, SLOT(onSerialPortChanged(QString)));
 
     connect(m_ui->actionConnect, SIGNAL(triggered()), this, SLOT(openDevice()));
     connect(m_ui->actionDisconnect, SIGNAL(triggered()), this, SLOT(closeDevice()));
     connect(m_ui->actionAbout, SIGNAL(triggered()), this, SLOT(showAboutDialog()));
-
-    connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateStatus()));
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-MainWindow::~MainWindow() = default;
+MainWindow::~MainWindow()
+{
+    stopWorker();
+}
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -97,17 +90,28 @@ void MainWindow::onSerialPortChanged(const QString& port)
 void MainWindow::openDevice()
 {
     try {
-        m_device = std::make_unique<Device>(m_serialPortWidget->selectedSerialPort().toStdString());
+        auto device = std::make_unique<Device>(m_serialPortWidget->selectedSerialPort().toStdString());
+
+        setupSensorWidgets(device.get());
+        updateInfo(*device);
+
+        m_worker = new DeviceWorker(std::move(device), m_workerGeneration);
+        m_worker->moveToThread(&m_workerThread);
+
+        connect(&m_workerThread, SIGNAL(finished()), m_worker, SLOT(deleteLater()));
+
+        connect(m_worker, SIGNAL(valuesUpdated(uint,DeviceWorker::SharedValues)),
+                this, SLOT(onValuesUpdated(uint,DeviceWorker::SharedValues)));
+
+        connect(m_worker, SIGNAL(error(uint,QString)), this, SLOT(onDeviceError(uint,QString)));
+
+        m_workerThread.start();
+        QMetaObject::invokeMethod(m_worker, "start", Qt::QueuedConnection);
 
         m_serialPortWidget->setEnabled(false);
         m_ui->actionConnect->setEnabled(false);
         m_ui->actionDisconnect->setEnabled(true);
         m_ui->centralwidget->setEnabled(true);
-
-        setupSensorWidgets();
-
-        updateInfo();
-        updateStatus();
     }
     catch (const std::exception& e) {
         handleError(e.what());
@@ -118,15 +122,14 @@ void MainWindow::openDevice()
 
 void MainWindow::closeDevice()
 {
-    m_updateTimer.stop();
-    m_device = nullptr;
+    stopWorker();
 
     m_serialPortWidget->setEnabled(true);
     m_ui->actionConnect->setEnabled(true);
     m_ui->actionDisconnect->setEnabled(false);
     m_ui->centralwidget->setEnabled(false);
 
-    setupSensorWidgets();
+    setupSensorWidgets(nullptr);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -139,33 +142,39 @@ void MainWindow::showAboutDialog()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void MainWindow::updateStatus()
+void MainWindow::onValuesUpdated(unsigned int generation,
+                                 const DeviceWorker::SharedValues& values)
 {
-    if (!m_device)
+    // May still arrive from a worker that has already been stopped. Its address may even have
+    // been reused by the current one, so the generation is compared instead of sender().
+    if (generation != m_workerGeneration)
         return;
 
-    try {
-        for (size_t i = 0; i < Device::SensorCount; ++i)
-            m_sensorWidgets.at(i)->setValue(m_device->getSensorValue(i));
+    for (size_t i = 0; i < Device::SensorCount; ++i)
+        m_sensorWidgets.at(i)->setValue(values->sensorValues.at(i));
 
-        const Device::PowerValues powerValues = m_device->getPowerValues();
+    const Device::PowerValues& powerValues = values->powerValues;
 
-        const QString baseString = "Device power: %1 V @ %2 mA | Device temperature: %3 °C";
-        const QString powerString = baseString.arg(powerValues.voltage, 0, 'f', 2)
-                                              .arg(powerValues.current * 1000.0, 0, 'f', 0)
-                                              .arg(powerValues.temperature, 0, 'f', 1);
-        m_powerLabel->setText(powerString);
+    const QString baseString = "Device power: %1 V @ %2 mA | Device temperature: %3 °C";
+    const QString powerString = baseString.arg(powerValues.voltage, 0, 'f', 2)
+                                          .arg(powerValues.current * 1000.0, 0, 'f', 0)
+                                          .arg(powerValues.temperature, 0, 'f', 1);
+    m_powerLabel->setText(powerString);
+}
 
-        m_updateTimer.start();
-    }
-    catch (const std::exception& e) {
-        handleError(e.what());
-    }
+// ---------------------------------------------------------------------------------------------- //
+
+void MainWindow::onDeviceError(unsigned int generation, const QString& msg)
+{
+    if (generation != m_workerGeneration)
+        return;
+
+    handleError(msg);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void MainWindow::setupSensorWidgets()
+void MainWindow::setupSensorWidgets(const Device* device)
 {
     for (size_t i = 0; i < Device::SensorCount; ++i)
     {
@@ -180,9 +189,9 @@ void MainWindow::setupSensorWidgets()
 
         SensorWidget* widget = nullptr;
 
-        if (m_device)
+        if (device)
         {
-            Device::SensorType type = m_device->getSensorType(i);
+            Device::SensorType type = device->getSensorType(i);
 
             if (type == Device::SensorType::pH_ORP)
                 widget = new PhWidget(group);
@@ -200,21 +209,30 @@ void MainWindow::setupSensorWidgets()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void MainWindow::updateInfo()
+void MainWindow::updateInfo(const Device& device)
 {
-    if (!m_device)
-        return;
-
-    m_ui->hardwareVersion->setText(m_device->getHardwareVersion().c_str());
-    m_ui->firmwareVersion->setText(m_device->getFirmwareVersion().c_str());
-    m_ui->serialNumber->setText(m_device->getSerialNumber().c_str());
+    m_ui->hardwareVersion->setText(device.getHardwareVersion().c_str());
+    m_ui->firmwareVersion->setText(device.getFirmwareVersion().c_str());
+    m_ui->serialNumber->setText(device.getSerialNumber().c_str());
 
-    const auto date = QDateTime::fromSecsSinceEpoch(m_device->getBuildTimestamp()).date();
+    const auto date = QDateTime::fromSecsSinceEpoch(device.getBuildTimestamp()).date();
     m_ui->buildDate->setText(QLocale::system().toString(date, QLocale::ShortFormat));
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
+void MainWindow::stopWorker()
+{
+    // Waits for a pending request at most, the worker and the device are deleted on the thread
+    m_workerThread.quit();
+    m_workerThread.wait();
+
+    m_worker = nullptr;
+    ++m_workerGeneration;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void MainWindow::handleError(const QString& msg)
 {
     closeDevice();
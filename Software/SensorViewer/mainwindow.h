@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "deviceworker.h"
 #include "sensorwidget.h"
 #include "serialportwidget.h"
 
@@ -31,7 +32,7 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QMainWindow>
-#include <QTimer>
+#include <QThread>
 
 #include <memory>
 
@@ -55,24 +56,27 @@ private slots:
 
     void showAboutDialog();
 
-    void updateStatus();
+    void onValuesUpdated(unsigned int generation, const DeviceWorker::SharedValues& values);
+    void onDeviceError(unsigned int generation, const QString& msg);
 
 private:
-    void setupSensorWidgets();
-    void updateInfo();
+    using Device = isf::Sensors::Device;
+
+    void setupSensorWidgets(const Device* device);
+    void updateInfo(const Device& device);
+    void stopWorker();
     void handleError(const QString& msg);
 
 private:
     std::unique_ptr<Ui::MainWindow> m_ui;
     SerialPortWidget* m_serialPortWidget = nullptr;
 
-    using Device = isf::Sensors::Device;
-    std::unique_ptr<Device> m_device;
+    QThread m_workerThread;
+    DeviceWorker* m_worker = nullptr; // Deleted on its thread once that finished
+    unsigned int m_workerGeneration = 0; // Advanced whenever the worker is stopped
 
     std::array<QGroupBox*, Device::SensorCount> m_sensorGroups = {};
     std::array<SensorWidget*, Device::SensorCount> m_sensorWidgets = {};
 
     QLabel* m_powerLabel;
-
-    QTimer m_updateTimer;
 };
@@ -42,7 +42,10 @@ SOURCES += \
     plotwidget.cpp \
     plotwindow.cpp \
     powerwindow.cpp \
-    testpointwidget.cpp
+    testpointwidget.cpp \
+    trendhistory.cpp \
+    trendwidget.cpp \
+    trendwindow.cpp
 
 HEADERS += \
     aboutdialog.h \
@@ -52,6 +55,9 @@ HEADERS += \
     plotwindow.h \
     powerwindow.h \
     testpointwidget.h \
+    trendhistory.h \
+    trendwidget.h \
+    trendwindow.h \
     units.h
 
 FORMS += \
@@ -59,7 +65,8 @@ FORMS += \
     mainwindow.ui \
     plotwindow.ui \
     powerwindow.ui \
-    testpointwidget.ui
+    testpointwidget.ui \
+    trendwindow.ui
 
 RESOURCES += \
     TcpClient.qrc
@@ -144,6 +144,7 @@ void MainWindow::closeDevice()
 
     m_testpointWidgets.clear();
     m_plotWindows.clear();
+    m_trendWindows.clear();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -202,6 +203,16 @@ void MainWindow::showVoltammogram(const QString& testpointId)
 
 // ---------------------------------------------------------------------------------------------- //
 
+void MainWindow::showTrends(const QString& testpointId)
+{
+    auto window = getTrendWindow(testpointId);
+
+    if (window)
+        window->show();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void MainWindow::onNodeInfoReceived(const std::vector<redex::NodeInfo>& infos)
 {
     Q_ASSERT(m_device != nullptr);
@@ -230,6 +241,9 @@ void MainWindow::onTestpointInfoReceived(const std::vector<redex::TestpointInfo>
         connect(widget, SIGNAL(voltammogramRequested(QString)),
                 this, SLOT(showVoltammogram(QString)));
 
+        connect(widget, SIGNAL(trendsRequested(QString)),
+                this, SLOT(showTrends(QString)));
+
         m_ui->tabWidget->addTab(widget, id);
         m_testpointWidgets[id] = widget;
 
@@ -237,6 +251,11 @@ void MainWindow::onTestpointInfoReceived(const std::vector<redex::TestpointInfo>
         window->setWindowTitle(QString("Voltammogram (%1)").arg(id));
 
         m_plotWindows[id] = std::move(window);
+
+        auto trendWindow = std::make_unique<TrendWindow>();
+        trendWindow->setWindowTitle(QString("Trends (%1)").arg(id));
+
+        m_trendWindows[id] = std::move(trendWindow);
     }
 }
 
@@ -257,8 +276,15 @@ void MainWindow::onConductanceReceived(const QString& testpointId,
 {
     auto widget = getTestpointWidget(testpointId);
 
-    if (widget)
-        widget->setAdmittance(voltage, current, admittance);
+    if (!widget)
+        return;
+
+    widget->setAdmittance(voltage, current, admittance);
+
+    auto window = getTrendWindow(testpointId);
+
+    if (window)
+        window->setAdmittance(admittance);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -267,8 +293,15 @@ void MainWindow::onOrpValueReceived(const QString& testpointId, double value)
 {
     auto widget = getTestpointWidget(testpointId);
 
-    if (widget)
-        widget->setOrpValue(value);
+    if (!widget)
+        return;
+
+    widget->setOrpValue(value);
+
+    auto window = getTrendWindow(testpointId);
+
+    if (window)
+        window->setOrpValue(value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -277,8 +310,15 @@ void MainWindow::onPhValueReceived(const QString& testpointId, double value)
 {
     auto widget = getTestpointWidget(testpointId);
 
-    if (widget)
-        widget->setPhValue(value);
+    if (!widget)
+        return;
+
+    widget->setPhValue(value);
+
+    auto window = getTrendWindow(testpointId);
+
+    if (window)
+        window->setPhValue(value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -287,8 +327,15 @@ void MainWindow::onTemperatureReceived(const QString& testpointId, double value)
 {
     auto widget = getTestpointWidget(testpointId);
 
-    if (widget)
-        widget->setTemperature(value);
+    if (!widget)
+        return;
+
+    widget->setTemperature(value);
+
+    auto window = getTrendWindow(testpointId);
+
+    if (window)
+        window->setTemperature(value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -364,6 +411,21 @@ auto MainWindow::getPlotWindow(const QString& id) -> PlotWindow*
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto MainWindow::getTrendWindow(const QString& id) -> TrendWindow*
+{
+    auto it = m_trendWindows.find(id);
+
+    if (it == m_trendWindows.end())
+    {
+        onError("Unknown testpoint ID received.");
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 auto MainWindow::getHostName() const -> QString
 {
     QSettings settings;
@@ -27,6 +27,7 @@
 #include "plotwindow.h"
 #include "powerwindow.h"
 #include "testpointwidget.h"
+#include "trendwindow.h"
 
 #include <QMainWindow>
 
@@ -56,6 +57,7 @@ private slots:
     void showAboutDialog();
 
     void showVoltammogram(const QString& testpointId);
+    void showTrends(const QString& testpointId);
 
     void onNodeInfoReceived(const std::vector<redex::NodeInfo>& info);
     void onTestpointInfoReceived(const std::vector<redex::TestpointInfo>& info);
@@ -86,6 +88,7 @@ private:
 
     auto getTestpointWidget(const QString& id) -> TestpointWidget*;
     auto getPlotWindow(const QString& id) -> PlotWindow*;
+    auto getTrendWindow(const QString& id) -> TrendWindow*;
 
     auto getHostName() const -> QString;
 
@@ -97,4 +100,5 @@ private:
 
     std::map<QString, TestpointWidget*> m_testpointWidgets;
     std::map<QString, std::unique_ptr<PlotWindow>> m_plotWindows;
+    std::map<QString, std::unique_ptr<TrendWindow>> m_trendWindows;
 };
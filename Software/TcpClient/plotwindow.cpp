@@ -24,7 +24,14 @@
 #include "plotwindow.h"
 #include "ui_plotwindow.h"
 
-#include <redex.h>
+#include <QSettings>
+
+namespace {
+    // Shared by all plot windows, the index of the redex::FilterType
+    const QString FilterTypeKey = "filterType";
+}
+
+// ---------------------------------------------------------------------------------------------- //
 
 PlotWindow::PlotWindow(QWidget* parent)
     : QWidget(parent),
@@ -36,6 +43,15 @@ PlotWindow::PlotWindow(QWidget* parent)
     m_ui->voltagePlot->setAxisTitles("Time (s)", "Voltage (V)");
     m_ui->currentPlot->setAxisTitles("Time (s)", "Current (A)");
 
+    QSettings settings;
+
+    if (settings.value(FilterTypeKey, 0).toInt() == static_cast<int>(redex::FilterType::Iir))
+        m_filterType = redex::FilterType::Iir;
+
+    m_ui->filterType->setCurrentIndex(static_cast<int>(m_filterType));
+
+    connect(m_ui->filterType, SIGNAL(currentIndexChanged(int)), this, SLOT(setFilterType(int)));
+
     hide();
 }
 
@@ -47,11 +63,35 @@ PlotWindow::~PlotWindow() = default;
 
 void PlotWindow::setSamples(std::span<const double> voltage, std::span<const double> current)
 {
-    m_voltage.resize(voltage.size());
-    m_current.resize(current.size());
+    m_rawVoltage.assign(voltage.begin(), voltage.end());
+    m_rawCurrent.assign(current.begin(), current.end());
+
+    updateSamples();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWindow::setFilterType(int index)
+{
+    m_filterType = index == static_cast<int>(redex::FilterType::Iir) ? redex::FilterType::Iir
+                                                                     : redex::FilterType::Fir;
+
+    QSettings settings;
+    settings.setValue(FilterTypeKey, static_cast<int>(m_filterType));
+
+    if (!m_rawVoltage.empty())
+        updateSamples();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PlotWindow::updateSamples()
+{
+    m_voltage.resize(m_rawVoltage.size());
+    m_current.resize(m_rawCurrent.size());
 
-    redex::Client::filterVoltammetryData(voltage, m_voltage);
-    redex::Client::filterVoltammetryData(current, m_current);
+    redex::Client::filterVoltammetryData(m_rawVoltage, m_voltage, m_filterType);
+    redex::Client::filterVoltammetryData(m_rawCurrent, m_current, m_filterType);
 
     m_ui->voltammogramPlot->setSamples(m_voltage, m_current);
 
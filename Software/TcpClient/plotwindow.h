@@ -25,6 +25,8 @@
 
 #include <QWidget>
 
+#include <redex.h>
+
 #include <memory>
 #include <span>
 #include <vector>
@@ -43,12 +45,22 @@ public:
 
     void setSamples(std::span<const double> voltage, std::span<const double> current);
 
+private slots:
+    void setFilterType(int index);
+
 private:
+    void updateSamples();
     void updateTimes(size_t size);
 
 private:
     std::unique_ptr<Ui::PlotWindow> m_ui;
 
+    redex::FilterType m_filterType = redex::FilterType::Fir;
+
+    // Unfiltered, so the samples can be filtered again when the filter type changes
+    std::vector<double> m_rawVoltage;
+    std::vector<double> m_rawCurrent;
+
     std::vector<double> m_times;
     std::vector<double> m_voltage;
     std::vector<double> m_current;
@@ -47,8 +47,13 @@ TestpointWidget::TestpointWidget(const redex::TestpointInfo& info, QWidget* pare
     m_ui->temperatureLabel->setToolTip(makeToolTip(info.temperatureInfo));
     m_ui->voltammetryLabel->setToolTip(makeToolTip(info.potentiostatInfo));
 
+    m_ui->trendsLink->setText(QString("<a href=\"%1\">view</a>").arg(m_id));
+
     connect(m_ui->voltammetryValues, SIGNAL(linkActivated(QString)),
             this, SIGNAL(voltammogramRequested(QString)));
+
+    connect(m_ui->trendsLink, SIGNAL(linkActivated(QString)),
+            this, SIGNAL(trendsRequested(QString)));
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -49,6 +49,7 @@ public:
 
 signals:
     void voltammogramRequested(const QString& id);
+    void trendsRequested(const QString& id);
 
 private:
     std::unique_ptr<Ui::TestpointWidget> m_ui;
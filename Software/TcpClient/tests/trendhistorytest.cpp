@@ -0,0 +1,205 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "trendhistory.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    using Bucket = TrendHistory::Bucket;
+
+    // Sample i is taken at time i
+    auto value(size_t i) -> double
+    {
+        return std::sin(0.01 * i) + 0.001 * static_cast<double>(i % 17);
+    }
+
+    auto bucketSize(size_t level) -> size_t
+    {
+        size_t size = 1;
+
+        for (size_t i = 0; i < level; ++i)
+            size *= TrendHistory::LevelFactor;
+
+        return size;
+    }
+
+    // The bucket must summarize the samples [first, first + count)
+    auto summarizes(const Bucket& bucket, size_t first, size_t count) -> bool
+    {
+        double sum = 0.0;
+        double minimum = value(first);
+        double maximum = value(first);
+
+        for (size_t i = first; i < first + count; ++i)
+        {
+            sum += value(i);
+            minimum = std::min(minimum, value(i));
+            maximum = std::max(maximum, value(i));
+        }
+
+        const double time = first + (count - 1) / 2.0;
+
+        return std::abs(bucket.time - time) < 1e-6 && std::abs(bucket.mean - sum / count) < 1e-9
+                && bucket.minimum == minimum && bucket.maximum == maximum;
+    }
+
+    // Complete buckets of one level, followed by at most one bucket of the remaining samples
+    auto isConsistent(const std::vector<Bucket>& buckets, size_t sampleCount) -> bool
+    {
+        if (buckets.size() < 2)
+            return !buckets.empty();
+
+        // All but the last bucket are complete, their spacing tells the level
+        const auto size = static_cast<size_t>(std::lround(buckets[1].time - buckets[0].time));
+
+        for (size_t i = 0; i + 1 < buckets.size(); ++i)
+        {
+            const auto first = static_cast<size_t>(std::lround(buckets[i].time - (size - 1) / 2.0));
+
+            if (first % size != 0 || !summarizes(buckets[i], first, size))
+                return false;
+        }
+
+        const auto first = static_cast<size_t>(
+            std::lround(buckets[buckets.size() - 2].time + (size + 1) / 2.0));
+
+        const Bucket& last = buckets.back();
+
+        // The last one is either complete as well, or holds what is left
+        return summarizes(last, first, size)
+                || (first < sampleCount && summarizes(last, first, sampleCount - first));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testEmpty()
+{
+    const TrendHistory history;
+
+    CHECK(history.isEmpty());
+    CHECK(history.select(0.0, 100.0, 10).empty());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testLevels()
+{
+    static constexpr size_t SampleCount = 10000;
+
+    TrendHistory history(64);
+
+    for (size_t i = 0; i < SampleCount; ++i)
+        history.append(static_cast<double>(i), value(i));
+
+    CHECK(!history.isEmpty());
+    CHECK(history.firstTime() == 0.0);
+    CHECK(history.lastTime() == SampleCount - 1.0);
+
+    // The latest samples, one more on each side
+    std::vector<Bucket> buckets = history.select(9980.0, 9990.0, 20);
+
+    if (CHECK(buckets.size() == 12))
+    {
+        CHECK(buckets.front().time == 9979.0 && buckets.back().time == 9990.0);
+        CHECK(isConsistent(buckets, SampleCount));
+    }
+
+    // Too many samples, so the buckets of eight
+    buckets = history.select(9700.0, 9900.0, 30);
+
+    if (CHECK(!buckets.empty()))
+    {
+        CHECK(buckets.size() <= 30 + 2);
+        CHECK(std::lround(buckets[1].time - buckets[0].time) == 8);
+        CHECK(buckets.front().time <= 9700.0 && buckets.back().time >= 9900.0);
+        CHECK(isConsistent(buckets, SampleCount));
+    }
+
+    // With 64 buckets per level, only the buckets of 512 samples reach back that far
+    buckets = history.select(5000.0, 6000.0, 100);
+
+    if (CHECK(buckets.size() >= 2))
+    {
+        CHECK(std::lround(buckets[1].time - buckets[0].time) == 512);
+        CHECK(buckets.front().time <= 5000.0 && buckets.back().time >= 6000.0);
+        CHECK(isConsistent(buckets, SampleCount));
+    }
+
+    // Everything, with the samples since the last complete bucket at the end
+    buckets = history.select(0.0, SampleCount - 1.0, 5);
+
+    if (CHECK(buckets.size() >= 2))
+    {
+        const auto size = static_cast<size_t>(std::lround(buckets[1].time - buckets[0].time));
+        const size_t complete = SampleCount / size * size;
+
+        CHECK(size == bucketSize(TrendHistory::LevelCount - 1) || buckets.size() <= 5 + 2);
+        CHECK(isConsistent(buckets, SampleCount));
+        CHECK(summarizes(buckets.back(), complete, SampleCount - complete));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCapacity()
+{
+    TrendHistory history(16);
+
+    for (size_t i = 0; i < 1000; ++i)
+        history.append(static_cast<double>(i), value(i));
+
+    // The ring of samples only reaches back 16 samples
+    std::vector<Bucket> buckets = history.select(990.0, 999.0, 100);
+
+    CHECK(buckets.size() == 11 && buckets.front().time == 989.0);
+    CHECK(isConsistent(buckets, 1000));
+
+    // Not covered by the samples any more
+    buckets = history.select(900.0, 999.0, 100);
+
+    if (CHECK(buckets.size() >= 2))
+    {
+        CHECK(std::lround(buckets[1].time - buckets[0].time) == 8);
+        CHECK(buckets.front().time <= 900.0);
+        CHECK(isConsistent(buckets, 1000));
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testEmpty();
+    testLevels();
+    testCapacity();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,265 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "trendhistory.h"
+
+#include <algorithm>
+#include <cassert>
+
+// ---------------------------------------------------------------------------------------------- //
+
+TrendHistory::TrendHistory(size_t capacity)
+{
+    assert(capacity > 0);
+
+    for (size_t i = 0; i < LevelCount; ++i)
+        m_levels.emplace_back(capacity);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendHistory::append(double time, double value)
+{
+    if (m_empty)
+    {
+        m_firstTime = time;
+        m_empty = false;
+    }
+
+    m_lastTime = time;
+
+    Bucket bucket = { time, value, value, value };
+    size_t count = 1;
+
+    m_levels[0].push(bucket);
+
+    for (size_t level = 1; level < LevelCount; ++level)
+    {
+        auto& accumulator = m_accumulators[level - 1];
+        accumulator.add(bucket, count);
+
+        count *= LevelFactor;
+
+        if (accumulator.count < count)
+            break;
+
+        bucket = accumulator.bucket();
+        accumulator = {};
+
+        m_levels[level].push(bucket);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::isEmpty() const -> bool
+{
+    return m_empty;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::firstTime() const -> double
+{
+    return m_firstTime;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::lastTime() const -> double
+{
+    return m_lastTime;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::select(double from, double to, size_t maxCount) const -> std::vector<Bucket>
+{
+    if (m_empty)
+        return {};
+
+    const size_t index = selectLevel(from, to, maxCount);
+    const Level& level = m_levels[index];
+
+    size_t begin = level.lowerBound(from);
+    size_t end = std::min(level.lowerBound(to) + 1, level.size());
+
+    if (begin > 0)
+        --begin;
+
+    std::vector<Bucket> buckets;
+    buckets.reserve(end - begin + 1);
+
+    for (size_t i = begin; i < end; ++i)
+        buckets.push_back(level.at(i));
+
+    // The samples since the last complete bucket, which the finer levels still hold
+    if (end == level.size() && index > 0)
+    {
+        Accumulator remainder;
+
+        for (size_t i = 0; i < index; ++i)
+            remainder.add(m_accumulators[i]);
+
+        if (remainder.count > 0)
+            buckets.push_back(remainder.bucket());
+    }
+
+    return buckets;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::selectLevel(double from, double to, size_t maxCount) const -> size_t
+{
+    size_t coarsest = 0;
+
+    for (size_t i = 0; i < LevelCount; ++i)
+    {
+        const Level& level = m_levels[i];
+
+        if (level.size() == 0)
+            break;
+
+        coarsest = i;
+
+        // Unless it is full, a level reaches back to the first sample
+        const bool covered = !level.isFull() || level.at(0).time <= from;
+        const size_t count = level.lowerBound(to) - level.lowerBound(from);
+
+        if (covered && count <= maxCount)
+            return i;
+    }
+
+    return coarsest;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+TrendHistory::Level::Level(size_t capacity)
+    : m_capacity(capacity)
+{
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendHistory::Level::push(const Bucket& bucket)
+{
+    if (m_buckets.size() < m_capacity)
+    {
+        m_buckets.push_back(bucket);
+        return;
+    }
+
+    m_buckets[m_first] = bucket;
+
+    if (++m_first == m_capacity)
+        m_first = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::Level::size() const -> size_t
+{
+    return m_buckets.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::Level::isFull() const -> bool
+{
+    return m_buckets.size() == m_capacity;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::Level::at(size_t i) const -> const Bucket&
+{
+    assert(i < m_buckets.size());
+
+    i += m_first;
+
+    if (i >= m_buckets.size())
+        i -= m_buckets.size();
+
+    return m_buckets[i];
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::Level::lowerBound(double time) const -> size_t
+{
+    size_t first = 0;
+    size_t count = m_buckets.size();
+
+    while (count > 0)
+    {
+        const size_t step = count / 2;
+
+        if (at(first + step).time < time)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+
+    return first;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendHistory::Accumulator::add(const Bucket& bucket, size_t count)
+{
+    timeSum += bucket.time * count;
+    valueSum += bucket.mean * count;
+
+    minimum = std::min(minimum, bucket.minimum);
+    maximum = std::max(maximum, bucket.maximum);
+
+    this->count += count;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendHistory::Accumulator::add(const Accumulator& other)
+{
+    timeSum += other.timeSum;
+    valueSum += other.valueSum;
+
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+
+    count += other.count;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendHistory::Accumulator::bucket() const -> Bucket
+{
+    assert(count > 0);
+    return { timeSum / count, minimum, valueSum / count, maximum };
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,112 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Keeps the recent samples of a trend plus min/mean/max buckets at several coarser levels, each
+// in a ring of fixed capacity. The memory use is bounded, while the coarser levels reach back
+// further in time.
+class TrendHistory
+{
+public:
+    struct Bucket
+    {
+        double time = 0.0;
+        double minimum = 0.0;
+        double mean = 0.0;
+        double maximum = 0.0;
+    };
+
+    static constexpr size_t LevelCount = 5;
+    static constexpr size_t LevelFactor = 8;
+
+    static constexpr size_t DefaultCapacity = 16384;
+
+public:
+    explicit TrendHistory(size_t capacity = DefaultCapacity);
+
+    void append(double time, double value);
+
+    auto isEmpty() const -> bool;
+
+    auto firstTime() const -> double;
+    auto lastTime() const -> double;
+
+    // Returns the buckets of the finest level that still covers the given interval with no more
+    // than maxCount buckets, including one more bucket on each side if available
+    auto select(double from, double to, size_t maxCount) const -> std::vector<Bucket>;
+
+private:
+    class Level
+    {
+    public:
+        explicit Level(size_t capacity);
+
+        void push(const Bucket& bucket);
+
+        auto size() const -> size_t;
+        auto isFull() const -> bool;
+
+        auto at(size_t i) const -> const Bucket&;
+
+        // Index of the first bucket not before the given time
+        auto lowerBound(double time) const -> size_t;
+
+    private:
+        std::vector<Bucket> m_buckets;
+        size_t m_capacity;
+        size_t m_first = 0;
+    };
+
+    // Sums of the samples that are not yet part of a complete bucket of a level
+    struct Accumulator
+    {
+        void add(const Bucket& bucket, size_t count);
+        void add(const Accumulator& other);
+
+        auto bucket() const -> Bucket;
+
+        double timeSum = 0.0;
+        double valueSum = 0.0;
+        double minimum = std::numeric_limits<double>::max();
+        double maximum = std::numeric_limits<double>::lowest();
+        size_t count = 0;
+    };
+
+    auto selectLevel(double from, double to, size_t maxCount) const -> size_t;
+
+private:
+    std::vector<Level> m_levels;
+
+    // One for each level but the first one, which holds the samples themselves
+    std::array<Accumulator, LevelCount - 1> m_accumulators;
+
+    double m_firstTime = 0.0;
+    double m_lastTime = 0.0;
+    bool m_empty = true;
+};
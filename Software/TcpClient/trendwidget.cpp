@@ -0,0 +1,191 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "trendwidget.h"
+
+#include <qwt_plot_canvas.h>
+#include <qwt_plot_grid.h>
+#include <qwt_plot_magnifier.h>
+#include <qwt_plot_panner.h>
+#include <qwt_text.h>
+
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPen>
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------------------------- //
+
+TrendWidget::TrendWidget(QWidget* parent)
+    : QwtPlot(parent)
+{
+    static constexpr QColor CurveColor = { 0x33, 0x22, 0x88 };
+    static constexpr QColor RangeColor = { 0x33, 0x22, 0x88, 0x40 };
+    static constexpr double CurveWidth = 2.0;
+
+    QFont font = QApplication::font();
+    font.setPointSizeF(0.8 * font.pointSizeF());
+
+    setAxisFont(QwtPlot::xBottom, font);
+    setAxisFont(QwtPlot::yLeft, font);
+
+    setAxisScale(QwtPlot::xBottom, 0.0, 1.0);
+    setAxisAutoScale(QwtPlot::yLeft, true);
+
+    auto grid = new QwtPlotGrid;
+    grid->setPen(QPen(Qt::gray, 0, Qt::DotLine));
+    grid->attach(this);
+
+    setCanvasBackground(QBrush(QColor(245, 245, 245)));
+    canvas()->setCursor(Qt::ArrowCursor);
+    canvas()->installEventFilter(this);
+
+    m_range = new QwtPlotIntervalCurve;
+    m_range->setPen(Qt::NoPen);
+    m_range->setBrush(QBrush(RangeColor));
+    m_range->attach(this);
+
+    m_curve = new QwtPlotCurve;
+    m_curve->setPen(QPen(CurveColor, CurveWidth, Qt::SolidLine));
+    m_curve->attach(this);
+
+    // Only the time axis is panned and zoomed, the other one keeps following the data
+    auto panner = new QwtPlotPanner(canvas());
+    panner->setOrientations(Qt::Horizontal);
+
+    auto magnifier = new QwtPlotMagnifier(canvas());
+    magnifier->setAxisEnabled(QwtPlot::yLeft, false);
+
+    updateAxes();
+    m_interval = axisInterval(QwtPlot::xBottom);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::setAxisTitles(const QString& xTitle, const QString& yTitle)
+{
+    QFont font = QApplication::font();
+    font.setBold(true);
+
+    QwtText title;
+    title.setFont(font);
+
+    title.setText(xTitle);
+    setAxisTitle(QwtPlot::xBottom, title);
+
+    title.setText(yTitle);
+    setAxisTitle(QwtPlot::yLeft, title);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::append(double time, double value)
+{
+    m_history.append(time, value);
+
+    // Panned or zoomed views only change if the new sample is visible
+    if (isVisible() && (m_following || m_interval.contains(time)))
+        replot();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::replot()
+{
+    updateAxes();
+
+    // The panner and magnifier set the scale directly, so a different one means user interaction
+    if (axisInterval(QwtPlot::xBottom) != m_interval)
+        m_following = false;
+
+    if (m_following && !m_history.isEmpty())
+    {
+        setAxisScale(QwtPlot::xBottom, m_history.firstTime(),
+                     std::max(m_history.lastTime(), m_history.firstTime() + 1.0));
+        updateAxes();
+    }
+
+    m_interval = axisInterval(QwtPlot::xBottom);
+    updateSamples();
+
+    QwtPlot::replot();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendWidget::eventFilter(QObject* object, QEvent* event) -> bool
+{
+    if (object == canvas() && event->type() == QEvent::MouseButtonDblClick)
+    {
+        m_following = true;
+        replot();
+
+        return true;
+    }
+
+    return QwtPlot::eventFilter(object, event);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::resizeEvent(QResizeEvent* event)
+{
+    QwtPlot::resizeEvent(event);
+    replot();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::showEvent(QShowEvent* event)
+{
+    QwtPlot::showEvent(event);
+    replot();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWidget::updateSamples()
+{
+    // Two buckets per pixel column are plenty, as each one also spans its minimum and maximum
+    const size_t maxCount = 2 * static_cast<size_t>(std::max(canvas()->width(), 1));
+
+    const auto buckets = m_history.select(m_interval.minValue(), m_interval.maxValue(), maxCount);
+
+    QVector<QPointF> means;
+    QVector<QwtIntervalSample> ranges;
+
+    means.reserve(static_cast<int>(buckets.size()));
+    ranges.reserve(static_cast<int>(buckets.size()));
+
+    for (const auto& bucket : buckets)
+    {
+        means.append(QPointF(bucket.time, bucket.mean));
+        ranges.append(QwtIntervalSample(bucket.time, bucket.minimum, bucket.maximum));
+    }
+
+    m_curve->setSamples(means);
+    m_range->setSamples(ranges);
+}
+
+// ---------------------------------------------------------------------------------------------- //
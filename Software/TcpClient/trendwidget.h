@@ -0,0 +1,60 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "trendhistory.h"
+
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_intervalcurve.h>
+
+class TrendWidget : public QwtPlot
+{
+public:
+    TrendWidget(QWidget* parent = nullptr);
+
+    void setAxisTitles(const QString& xTitle, const QString& yTitle);
+
+    void append(double time, double value);
+
+    // Selects the buckets for the visible interval before drawing
+    void replot() override;
+
+private:
+    auto eventFilter(QObject* object, QEvent* event) -> bool override;
+    void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+
+    void updateSamples();
+
+private:
+    QwtPlotCurve* m_curve = nullptr;
+    QwtPlotIntervalCurve* m_range = nullptr;
+
+    TrendHistory m_history;
+
+    // Shows the whole history until the user pans or zooms
+    bool m_following = true;
+    QwtInterval m_interval;
+};
@@ -0,0 +1,84 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "trendwindow.h"
+#include "ui_trendwindow.h"
+
+// ---------------------------------------------------------------------------------------------- //
+
+TrendWindow::TrendWindow(QWidget* parent)
+    : QWidget(parent),
+      m_ui(std::make_unique<Ui::TrendWindow>())
+{
+    m_ui->setupUi(this);
+
+    m_ui->admittancePlot->setAxisTitles("Time (s)", "Admittance (S)");
+    m_ui->phPlot->setAxisTitles("Time (s)", "pH");
+    m_ui->orpPlot->setAxisTitles("Time (s)", "ORP (V)");
+    m_ui->temperaturePlot->setAxisTitles("Time (s)", "Temperature (°C)");
+
+    m_timer.start();
+
+    hide();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+TrendWindow::~TrendWindow() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWindow::setAdmittance(double admittance)
+{
+    m_ui->admittancePlot->append(elapsedSeconds(), admittance);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWindow::setPhValue(double value)
+{
+    m_ui->phPlot->append(elapsedSeconds(), value);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWindow::setOrpValue(double value)
+{
+    m_ui->orpPlot->append(elapsedSeconds(), value);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TrendWindow::setTemperature(double value)
+{
+    m_ui->temperaturePlot->append(elapsedSeconds(), value);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TrendWindow::elapsedSeconds() const -> double
+{
+    return 1e-3 * static_cast<double>(m_timer.elapsed());
+}
+
+// ---------------------------------------------------------------------------------------------- //
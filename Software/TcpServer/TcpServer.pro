@@ -33,7 +33,7 @@ QMAKE_RPATHDIR += $ORIGIN
 DEFINES += QT_DEPRECATED_WARNINGS
 
 INCLUDEPATH += include
-LIBS += -L. -lConductance -lPotentiostat -lSensors
+LIBS += -L. -lConductance -lPotentiostat -lSensors -lSerial
 
 SOURCES += \
     alarm.cpp \
@@ -27,6 +27,7 @@
 #include <QDir>
 #include <QDomDocument>
 #include <QFile>
+#include <QSaveFile>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -47,6 +48,24 @@ void readConfigFile(const QString& filename, QDomDocument* result)
 
 // ---------------------------------------------------------------------------------------------- //
 
+static
+void writeConfigFile(const QString& filename, const QDomDocument& document)
+{
+    static constexpr int IndentSize = 4;
+
+    QSaveFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly))
+        throw Exception(QString("Unable to open file %1 for writing.").arg(filename));
+
+    file.write(document.toByteArray(IndentSize));
+
+    if (!file.commit())
+        throw Exception(QString("Unable to write file %1.").arg(filename));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 Configuration::Configuration(const QString& filename)
     : m_filename(filename)
 {
@@ -140,6 +159,73 @@ auto Configuration::testpoints() const -> const TestpointMap&
 
 // ---------------------------------------------------------------------------------------------- //
 
+void Configuration::storeCalibration(const QString& nodeId,
+                                     int voltageOffset, int currentOffset, int signalOffset)
+{
+    const QString sensorId = findPotentiostatSensor(nodeId);
+
+    if (sensorId.isEmpty())
+        throw Exception("No potentiostat sensor is assigned to node " + nodeId + ".");
+
+    const std::map<QString,int> values = {
+        { "voltage_offset", voltageOffset },
+        { "current_offset", currentOffset },
+        { "signal_offset", signalOffset }
+    };
+
+    // Re-read the file so that comments and unrelated changes are preserved
+    QDomDocument document;
+    readConfigFile(m_filename, &document);
+
+    const QDomElement root = document.documentElement();
+    const QDomElement sensors = root.firstChildElement("sensors");
+
+    QDomElement sensor = sensors.firstChildElement("potentiostat");
+
+    while (!sensor.isNull() && sensor.attribute("id") != sensorId)
+        sensor = sensor.nextSiblingElement("potentiostat");
+
+    if (sensor.isNull())
+        throw Exception("Sensor " + sensorId + " not found in " + m_filename + ".");
+
+    QDomElement config = sensor.firstChildElement("config");
+
+    if (config.isNull())
+        config = sensor.appendChild(document.createElement("config")).toElement();
+
+    for (const auto& [key, value] : values)
+    {
+        QDomElement element = config.firstChildElement(key);
+
+        if (element.isNull())
+            element = config.appendChild(document.createElement(key)).toElement();
+
+        while (element.hasChildNodes())
+            element.removeChild(element.firstChild());
+
+        element.appendChild(document.createTextNode(QString::number(value)));
+
+        m_sensors[sensorId].config[key] = QString::number(value);
+    }
+
+    writeConfigFile(m_filename, document);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Configuration::findPotentiostatSensor(const QString& nodeId) const -> QString
+{
+    for (const auto& [id, sensor] : m_sensors)
+    {
+        if (sensor.type == "potentiostat" && sensor.node == nodeId)
+            return id;
+    }
+
+    return {};
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 auto Configuration::parseEntries(const QDomNode& parent,
                                  const StringList& validKeys) const -> StringMap
 {
@@ -80,10 +80,15 @@ public:
     auto sensors() const -> const SensorMap&;
     auto testpoints() const -> const TestpointMap&;
 
+    void storeCalibration(const QString& nodeId,
+                          int voltageOffset, int currentOffset, int signalOffset);
+
 private:
     auto parseEntries(const QDomNode& parent,
                       const StringList& validKeys = {}) const -> StringMap;
 
+    auto findPotentiostatSensor(const QString& nodeId) const -> QString;
+
     auto parseSensor(const QDomElement& parent) const -> Sensor;
     auto parseTestpoint(const QDomNode& parent) const -> StringMap;
 
@@ -23,6 +23,7 @@
 
 #include "assertions.h"
 #include "devicerunner.h"
+#include "logger.h"
 #include "protocol.h"
 
 // ---------------------------------------------------------------------------------------------- //
@@ -54,6 +55,15 @@ DeviceRunner::DeviceRunner(const DeviceManager& devices)
         connect(t, SIGNAL(temperatureAvailable(QString,double)),
                 this,  SLOT(processTemperature(QString,double)));
     }
+
+    for (auto node : potentiostatNodes())
+    {
+        connect(node, SIGNAL(calibrationProgress(QString,int)),
+                this, SLOT(processCalibrationProgress(QString,int)));
+
+        connect(node, SIGNAL(calibrationComplete(QString,int,int,int)),
+                this, SLOT(processCalibrationResult(QString,int,int,int)));
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -105,6 +115,27 @@ void DeviceRunner::stopMeasurement()
 
 // ---------------------------------------------------------------------------------------------- //
 
+void DeviceRunner::startCalibration()
+{
+    if (!m_timer.isActive())
+    {
+        Logger::warning("Devices are not running. Ignoring request to start calibration.");
+        return;
+    }
+
+    // Calibration only reacts to samples delivered by the shared serial reactor,
+    // so all potentiostats can be calibrated at the same time.
+    try {
+        for (auto node : potentiostatNodes())
+            node->startCalibration();
+    }
+    catch (const std::exception& e) {
+        emit error(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void DeviceRunner::update()
 {
     const std::vector<Node*>& nodes = m_devices.nodes();
@@ -182,3 +213,38 @@ void DeviceRunner::processTemperature(const QString& id, double value)
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+void DeviceRunner::processCalibrationProgress(const QString& id, int percent)
+{
+    const QString record = Protocol::joinTokens("<CALIBRATION_PROGRESS>", "%1", "%2");
+    emit recordAvailable(record.arg(id).arg(percent));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void DeviceRunner::processCalibrationResult(const QString& id,
+                                            int voltageOffset, int currentOffset, int signalOffset)
+{
+    const QString values = Protocol::joinValues("%2", "%3", "%4");
+    const QString record = Protocol::joinTokens("<CALIBRATION_RESULT>", "%1", values);
+
+    emit recordAvailable(record.arg(id).arg(voltageOffset).arg(currentOffset).arg(signalOffset));
+    emit calibrationAvailable(id, voltageOffset, currentOffset, signalOffset);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto DeviceRunner::potentiostatNodes() const -> std::vector<PotentiostatNode*>
+{
+    std::vector<PotentiostatNode*> result;
+
+    for (auto node : m_devices.nodes())
+    {
+        if (auto potentiostat = dynamic_cast<PotentiostatNode*>(node))
+            result.push_back(potentiostat);
+    }
+
+    return result;
+}
+
+// ---------------------------------------------------------------------------------------------- //
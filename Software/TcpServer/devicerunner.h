@@ -43,8 +43,12 @@ public slots:
     void startMeasurement();
     void stopMeasurement();
 
+    void startCalibration();
+
 signals:
     void recordAvailable(const QString& record);
+    void calibrationAvailable(const QString& nodeId,
+                              int voltageOffset, int currentOffset, int signalOffset);
     void error(const QString& msg);
 
 private slots:
@@ -57,6 +61,13 @@ private slots:
     void processVoltammogram(const QString& id, const Voltammogram& data);
     void processTemperature(const QString& id, double value);
 
+    void processCalibrationProgress(const QString& id, int percent);
+    void processCalibrationResult(const QString& id,
+                                  int voltageOffset, int currentOffset, int signalOffset);
+
+private:
+    auto potentiostatNodes() const -> std::vector<PotentiostatNode*>;
+
 private:
     const DeviceManager& m_devices;
     QTimer m_timer;
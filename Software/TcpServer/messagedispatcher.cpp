@@ -70,6 +70,8 @@ void MessageDispatcher::parseData(const QString& data)
         emit startMeasurementReceived();
     else if (tag == "<STOP_MEASUREMENT>")
         emit stopMeasurementReceived();
+    else if (tag == "<START_CALIBRATION>")
+        emit startCalibrationReceived();
     else
         throw ParserError("Client sent an invalid message tag \"" + tag + "\".");
 
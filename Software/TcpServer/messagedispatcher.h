@@ -44,6 +44,8 @@ signals:
     void startMeasurementReceived();
     void stopMeasurementReceived();
 
+    void startCalibrationReceived();
+
 private:
     void parseData(const QString& data);
 
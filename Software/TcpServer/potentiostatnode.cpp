@@ -73,6 +73,9 @@ void PotentiostatNode::startMeasurement()
     if (m_measurementStarted)
         return;
 
+    if (m_calibrationRunning)
+        throw Exception("Potentiostat " + id() + " is being calibrated.");
+
     startNextMeasurement();
     m_measurementStarted = true;
 }
@@ -81,6 +84,9 @@ void PotentiostatNode::startMeasurement()
 
 void PotentiostatNode::stopMeasurement()
 {
+    if (m_calibrationRunning)
+        abortCalibration();
+
     if (!m_measurementStarted)
         return;
 
@@ -108,6 +114,51 @@ void PotentiostatNode::update()
 
 // ---------------------------------------------------------------------------------------------- //
 
+void PotentiostatNode::startCalibration()
+{
+    if (m_calibrationRunning)
+        return;
+
+    if (m_measurementStarted || m_measurementRunning)
+        throw Exception("Potentiostat " + id() + " can't be calibrated while measuring.");
+
+    // The calibrator drives our own device, so measurement callbacks are
+    // ignored until it has finished.
+    m_calibrator = std::make_unique<DeviceCalibrator>(&m_device, this);
+    m_calibrationRunning = true;
+
+    m_calibrator->start();
+
+    Logger::info("Potentiostat " + id() + " started calibration.");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PotentiostatNode::abortCalibration()
+{
+    if (!m_calibrationRunning)
+        return;
+
+    m_calibrator->abort();
+    m_calibrator.reset();
+
+    // The calibrator zeroes the offsets while it runs
+    m_device.setCalibration(m_calibration);
+
+    m_calibrationRunning = false;
+
+    Logger::warning("Calibration of potentiostat " + id() + " aborted.");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PotentiostatNode::calibrationRunning() const -> bool
+{
+    return m_calibrationRunning;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void PotentiostatNode::handlePowerValues(double voltage, double current, double temperature)
 {
     const Status status = {
@@ -119,6 +170,39 @@ void PotentiostatNode::handlePowerValues(double voltage, double current, double
 
 // ---------------------------------------------------------------------------------------------- //
 
+void PotentiostatNode::handleCalibrationProgress(int percent)
+{
+    if (!m_calibrationRunning) // May have been aborted
+        return;
+
+    emit calibrationProgress(id(), percent);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PotentiostatNode::handleCalibrationComplete(int voltageOffset,
+                                                 int currentOffset, int signalOffset)
+{
+    if (!m_calibrationRunning) // May have been aborted
+        return;
+
+    m_calibrator.reset();
+    m_calibrationRunning = false;
+
+    m_calibration = {
+        voltageOffset, currentOffset, signalOffset
+    };
+
+    m_device.setCalibration(m_calibration);
+
+    static const QString msg = "Potentiostat %1 calibrated with offsets %2, %3 and %4.";
+    Logger::info(msg.arg(id()).arg(voltageOffset).arg(currentOffset).arg(signalOffset));
+
+    emit calibrationComplete(id(), voltageOffset, currentOffset, signalOffset);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void PotentiostatNode::registerSensor(PotentiostatSensor* sensor, size_t input)
 {
     RETURN_IF_NULL(sensor);
@@ -143,6 +227,8 @@ void PotentiostatNode::unregisterSensor(PotentiostatSensor* sensor)
 void PotentiostatNode::setup(const Device::Setup& setup, const Device::Calibration& calibration)
 {
     m_setup = setup;
+    m_calibration = calibration;
+
     m_device.setCalibration(calibration);
 }
 
@@ -178,6 +264,9 @@ void PotentiostatNode::handleMeasurementComplete()
 
 void PotentiostatNode::onMeasurementStarted() noexcept
 {
+    if (m_calibrationRunning)
+        return;
+
     m_measurementRunning = true;
 }
 
@@ -185,6 +274,9 @@ void PotentiostatNode::onMeasurementStarted() noexcept
 
 void PotentiostatNode::onMeasurementStopped() noexcept
 {
+    if (m_calibrationRunning)
+        return;
+
     m_measurementRunning = false;
 }
 
@@ -192,6 +284,9 @@ void PotentiostatNode::onMeasurementStopped() noexcept
 
 void PotentiostatNode::onMeasurementComplete() noexcept
 {
+    if (m_calibrationRunning)
+        return;
+
     RETURN_IF(m_measurementComplete);
 
     m_measurementComplete = true;
@@ -211,6 +306,9 @@ void PotentiostatNode::onCurrentRangeChanged(Device::CurrentRange range) noexcep
 void PotentiostatNode::onSamplesReceived(std::span<const double> voltages,
                                          std::span<const double> currents) noexcept
 {
+    if (m_calibrationRunning)
+        return;
+
     m_data.voltage.reserve(m_data.voltage.size() + voltages.size());
     m_data.current.reserve(m_data.current.size() + currents.size());
 
@@ -236,3 +334,21 @@ void PotentiostatNode::onError(const std::string& msg) noexcept
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+void PotentiostatNode::onCalibrationProgress(int percent) noexcept
+{
+    QMetaObject::invokeMethod(this, "handleCalibrationProgress", Qt::QueuedConnection,
+                              Q_ARG(int, percent));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PotentiostatNode::onCalibrationComplete(const Device::Calibration& results) noexcept
+{
+    QMetaObject::invokeMethod(this, "handleCalibrationComplete", Qt::QueuedConnection,
+                              Q_ARG(int, results.voltageOffset),
+                              Q_ARG(int, results.currentOffset),
+                              Q_ARG(int, results.signalOffset));
+}
+
+// ---------------------------------------------------------------------------------------------- //
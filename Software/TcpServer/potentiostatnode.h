@@ -26,8 +26,11 @@
 #include "node.h"
 
 #include <potentiostat/device.h>
+#include <potentiostat/devicecalibrator.h>
 
+#include <atomic>
 #include <exception>
+#include <memory>
 #include <vector>
 
 class PotentiostatSensor;
@@ -38,7 +41,9 @@ struct Voltammogram
     std::vector<double> current;
 };
 
-class PotentiostatNode : public Node, public isf::Potentiostat::Device::Listener
+class PotentiostatNode : public Node,
+                         public isf::Potentiostat::Device::Listener,
+                         public isf::Potentiostat::DeviceCalibrator::Listener
 {
     Q_OBJECT
 
@@ -46,6 +51,7 @@ public:
     static constexpr size_t InputCount = 1;
 
     using Device = isf::Potentiostat::Device;
+    using DeviceCalibrator = isf::Potentiostat::DeviceCalibrator;
 
 public:
     PotentiostatNode(const QString& id, const QString& serialPort);
@@ -57,9 +63,22 @@ public:
 
     void update() override;
 
+    void startCalibration();
+    void abortCalibration();
+
+    auto calibrationRunning() const -> bool;
+
+signals:
+    void calibrationProgress(const QString& id, int percent);
+    void calibrationComplete(const QString& id,
+                             int voltageOffset, int currentOffset, int signalOffset);
+
 private slots:
     void handlePowerValues(double voltage, double current, double temperature);
 
+    void handleCalibrationProgress(int percent);
+    void handleCalibrationComplete(int voltageOffset, int currentOffset, int signalOffset);
+
 private:
     friend class PotentiostatSensor;
     void registerSensor(PotentiostatSensor* sensor, size_t input);
@@ -80,6 +99,9 @@ private:
     void onPowerValuesReceived(const Device::PowerValues& values) noexcept override;
     void onError(const std::string& msg) noexcept override;
 
+    void onCalibrationProgress(int percent) noexcept override;
+    void onCalibrationComplete(const Device::Calibration& results) noexcept override;
+
 private:
     Device m_device;
     Device::Setup m_setup = {};
@@ -90,6 +112,11 @@ private:
     bool m_measurementRunning = false;
     bool m_measurementComplete = false;
 
+    Device::Calibration m_calibration = {};
+
+    std::unique_ptr<DeviceCalibrator> m_calibrator;
+    std::atomic<bool> m_calibrationRunning = false;
+
     std::exception_ptr m_exception;
 
     PotentiostatSensor* m_sensor = nullptr;
@@ -23,6 +23,7 @@
 
 #include "assertions.h"
 #include "exception.h"
+#include "logger.h"
 #include "sensorsnode.h"
 #include "sensorssensor.h"
 
@@ -32,6 +33,15 @@ SensorsNode::SensorsNode(const QString& id, const QString& serialPort)
     : Node(id, "sensors"),
       m_device(serialPort.toStdString())
 {
+    // Let the board push its values, so updates only read the cached values
+    try {
+        const auto interval = m_device.subscribe(UpdateInterval);
+        Logger::info(QString("Sensors node %1 pushes values every %2 ms.")
+                     .arg(id()).arg(interval.count()));
+    }
+    catch (const Device::Error&) {
+        Logger::info("Sensors node " + id() + " does not support push mode, polling values.");
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -76,12 +86,19 @@ auto SensorsNode::alarmThresholds() const -> const Alarm::Thresholds&
 void SensorsNode::startMeasurement()
 {
     m_measurementStarted = true;
+
+    m_updateCount = 0;
+    m_requestCountAtStart = m_device.getRequestCount();
+    m_updateDuration = {};
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void SensorsNode::stopMeasurement()
 {
+    if (m_measurementStarted)
+        logUpdateStatistics();
+
     m_measurementStarted = false;
 }
 
@@ -89,10 +106,20 @@ void SensorsNode::stopMeasurement()
 
 void SensorsNode::update()
 {
-    updateStatus();
+    const auto start = std::chrono::steady_clock::now();
+
+    // Sensor and power values are read from the cache or in a single round trip
+    const Device::Values values = m_device.getAllValues();
+
+    updateStatus(values.powerValues);
 
     if (m_measurementStarted)
-        updateMeasurement();
+    {
+        updateMeasurement(values);
+
+        ++m_updateCount;
+        m_updateDuration += std::chrono::steady_clock::now() - start;
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -121,10 +148,8 @@ void SensorsNode::unregisterSensor(SensorsSensor* sensor)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void SensorsNode::updateStatus()
+void SensorsNode::updateStatus(const Device::PowerValues& values)
 {
-    const Device::PowerValues values = m_device.getPowerValues();
-
     const Status status = {
         values.voltage, values.current, values.temperature
     };
@@ -134,15 +159,35 @@ void SensorsNode::updateStatus()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void SensorsNode::updateMeasurement()
+void SensorsNode::updateMeasurement(const Device::Values& values)
 {
     RETURN_IF_NOT(m_measurementStarted);
 
     for (size_t i = 0; i < InputCount; ++i)
     {
         if (m_sensors[i])
-            m_sensors[i]->processValue(m_device.getSensorValue(i));
+            m_sensors[i]->processValue(values.sensorValues[i]);
     }
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+void SensorsNode::logUpdateStatistics() const
+{
+    RETURN_IF(m_updateCount == 0);
+
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    const size_t requests = m_device.getRequestCount() - m_requestCountAtStart;
+    const double duration = Microseconds(m_updateDuration).count() / m_updateCount;
+
+    static const QString msg = "Sensors node %1: %2 updates, %3 requests per update, "
+                               "%4 us per update.";
+
+    Logger::info(msg.arg(id())
+                    .arg(m_updateCount)
+                    .arg(double(requests) / m_updateCount, 0, 'f', 2)
+                    .arg(duration, 0, 'f', 0));
+}
+
+// ---------------------------------------------------------------------------------------------- //
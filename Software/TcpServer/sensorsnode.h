@@ -56,12 +56,18 @@ private:
     void registerSensor(SensorsSensor* sensor, size_t input);
     void unregisterSensor(SensorsSensor* sensor);
 
-    void updateStatus();
-    void updateMeasurement();
+    void updateStatus(const Device::PowerValues& values);
+    void updateMeasurement(const Device::Values& values);
+
+    void logUpdateStatistics() const;
 
 private:
     Device m_device;
     std::array<SensorsSensor*, InputCount> m_sensors = {};
 
     bool m_measurementStarted = false;
+
+    size_t m_updateCount = 0;
+    size_t m_requestCountAtStart = 0;
+    std::chrono::steady_clock::duration m_updateDuration = {};
 };
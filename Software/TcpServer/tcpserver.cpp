@@ -31,8 +31,9 @@
 
 // ---------------------------------------------------------------------------------------------- //
 
-TcpServer::TcpServer(const Configuration& config, const DeviceManager& devices)
-    : m_portNumber(config.tcpPort()),
+TcpServer::TcpServer(Configuration& config, const DeviceManager& devices)
+    : m_config(config),
+      m_portNumber(config.tcpPort()),
       m_deviceRunner(devices),
       m_powerMonitor(devices),
       m_statusBoard(config.statusPort()),
@@ -56,8 +57,13 @@ TcpServer::TcpServer(const Configuration& config, const DeviceManager& devices)
     connect(&m_dispatcher, SIGNAL(stopMeasurementReceived()),
             this, SLOT(onStopMeasurementReceived()));
 
+    connect(&m_dispatcher, SIGNAL(startCalibrationReceived()),
+            this, SLOT(onStartCalibrationReceived()));
+
     connect(&m_deviceRunner, SIGNAL(recordAvailable(QString)),
             this, SLOT(handleRecord(QString)));
+    connect(&m_deviceRunner, SIGNAL(calibrationAvailable(QString,int,int,int)),
+            this, SLOT(storeCalibration(QString,int,int,int)));
     connect(&m_deviceRunner, SIGNAL(error(QString)),
             this, SLOT(handleError(QString)));
 
@@ -227,6 +233,38 @@ void TcpServer::onStopMeasurementReceived()
 
 // ---------------------------------------------------------------------------------------------- //
 
+void TcpServer::onStartCalibrationReceived()
+{
+    if (m_measurementRunning || m_criticalState)
+    {
+        const QString message = "Device is busy or in critical state.";
+        sendError(message);
+
+        Logger::warning(message + " Ignoring request to start calibration.");
+        return;
+    }
+
+    m_deviceRunner.startCalibration();
+
+    Logger::info("Calibration started.");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TcpServer::storeCalibration(const QString& nodeId,
+                                 int voltageOffset, int currentOffset, int signalOffset)
+{
+    try {
+        m_config.storeCalibration(nodeId, voltageOffset, currentOffset, signalOffset);
+        Logger::info("Calibration of potentiostat " + nodeId + " saved to configuration.");
+    }
+    catch (const std::exception& e) {
+        Logger::error(QString("Unable to save calibration: ") + e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void TcpServer::handleRecord(const QString& data)
 {
     sendData(data);
@@ -44,7 +44,7 @@ class TcpServer : public QObject
     REDEX_DELETE_COPY_MOVE(TcpServer);
 
 public:
-    TcpServer(const Configuration& config, const DeviceManager& devices);
+    TcpServer(Configuration& config, const DeviceManager& devices);
     ~TcpServer() override;
 
 public slots:
@@ -68,6 +68,10 @@ private slots:
     void onStartMeasurementReceived();
     void onStopMeasurementReceived();
 
+    void onStartCalibrationReceived();
+    void storeCalibration(const QString& nodeId,
+                          int voltageOffset, int currentOffset, int signalOffset);
+
     void handleRecord(const QString& data);
     void handleError(const QString& msg);
 
@@ -89,6 +93,7 @@ private:
     static auto makeTestpointInfo(const DeviceManager& devices) -> QString;
 
 private:
+    Configuration& m_config;
     const quint16 m_portNumber;
 
     QTcpServer m_server;
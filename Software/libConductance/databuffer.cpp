@@ -68,6 +68,8 @@ void DataBuffer::update(const Device::Data& data)
             m_dataPosition = 0;
     }
 
+    m_sampleCount += Device::SamplesPerTransfer;
+
     for (size_t input = 0; input < Device::InputCount; ++input)
     {
         m_voltage.back() = m_voltage.front();
@@ -133,10 +135,20 @@ auto DataBuffer::data(Device::Channel channel) const -> const DataVector&
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto DataBuffer::sampleCount() const -> uint64_t
+{
+    return m_sampleCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void DataBuffer::clear()
 {
     std::fill(m_voltage.begin(), m_voltage.end(), 0.0);
     std::fill(m_current.begin(), m_current.end(), 0.0);
+
+    m_dataPosition = 0;
+    m_sampleCount = 0;
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -60,6 +60,10 @@ public:
     auto data(Device::Channel channel) -> DataVector&;
     auto data(Device::Channel channel) const -> const DataVector&;
 
+    // Samples written since construction or the last clear(), the next one is written to
+    // sampleCount() % Device::SampleRate
+    auto sampleCount() const -> uint64_t;
+
     void clear();
 
 private:
@@ -70,6 +74,7 @@ private:
     DataVector m_current;
 
     size_t m_dataPosition = 0;
+    uint64_t m_sampleCount = 0;
 };
 
 ISF_CONDUCTANCE_END_NAMESPACE();
@@ -22,20 +22,23 @@
 // ============================================================================================== //
 
 #include "averagingbuffer.h"
-#include "serialport.h"
 
 #include <potentiostat/device.h>
+#include <serial/serialport.h>
 
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <thread>
 
 // ---------------------------------------------------------------------------------------------- //
 
 using namespace isf::Potentiostat;
+using isf::Serial::SerialPort;
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -100,8 +103,6 @@ public:
 public:
     Private(const std::string& port);
 
-    void work();
-
     void sendCommand(std::string command) const;
 
     void setCurrentRange(CurrentRange range);
@@ -124,10 +125,9 @@ public:
     SerialPort serialPort;
 
     std::vector<Listener*> listeners;
-
-    bool running = false;
-
-    std::thread thread;
+    std::mutex listenerMutex;
+    std::condition_variable listenerCondition;
+    std::thread::id notifyingThread;
 
     std::string currentLine;
 
@@ -155,18 +155,17 @@ public:
 Device::Device(const std::string& port)
     : d(std::make_unique<Private>(port))
 {
-    d->running = true;
-    d->thread = std::thread(&Device::Private::work, d.get());
+    // Incoming data is parsed on the I/O thread shared by all serial devices
+    d->serialPort.setReadCallback(
+        [this](std::span<const char> data) { d->parseData(data); },
+        [this](const std::string& error) { d->notifyListeners(&Listener::onError, error); });
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 Device::~Device()
 {
-    assert(d->thread.joinable());
-
-    d->running = false;
-    d->thread.join();
+    d->serialPort.setReadCallback({});
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -175,6 +174,7 @@ void Device::addListener(Listener* listener)
 {
     assert(listener != nullptr);
 
+    std::lock_guard lock(d->listenerMutex);
     auto it = std::find(d->listeners.begin(), d->listeners.end(), listener);
 
     if (it == d->listeners.end())
@@ -185,10 +185,19 @@ void Device::addListener(Listener* listener)
 
 void Device::removeListener(Listener* listener)
 {
+    std::unique_lock lock(d->listenerMutex);
     auto it = std::find(d->listeners.begin(), d->listeners.end(), listener);
 
     if (it != d->listeners.end())
         d->listeners.erase(it);
+
+    // The listener may be destroyed after returning, so wait for a notification running on
+    // the I/O thread. Removing a listener from within a callback returns immediately.
+    const auto thisThread = std::this_thread::get_id();
+
+    d->listenerCondition.wait(lock, [&] {
+        return d->notifyingThread == std::thread::id() || d->notifyingThread == thisThread;
+    });
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -300,28 +309,6 @@ Device::Private::Private(const std::string& port)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void Device::Private::work()
-{
-    static constexpr std::chrono::milliseconds ReadInterval = 50ms;
-
-    while (running)
-    {
-        try {
-            const bool dataAvailable = serialPort.getNumberOfBytesAvailable() > 0;
-
-            if (dataAvailable)
-                parseData(serialPort.readAllData());
-        }
-        catch (const std::exception& e) {
-            notifyListeners(&Listener::onError, e.what());
-        }
-
-        std::this_thread::sleep_for(ReadInterval);
-    }
-}
-
-// ---------------------------------------------------------------------------------------------- //
-
 void Device::Private::sendCommand(std::string command) const
 {
     command += "\r\n";
@@ -510,8 +497,33 @@ void Device::Private::updateCurrentRange(double current)
 template <typename Func, typename... Args>
 void Device::Private::notifyListeners(Func&& func, Args&&... args)
 {
-    for (auto listener : listeners)
-        std::invoke(std::forward<Func>(func), listener, std::forward<Args>(args)...);
+    // Listeners are called without the lock held, so they can add or remove listeners
+    std::vector<Listener*> currentListeners;
+
+    {
+        std::lock_guard lock(listenerMutex);
+
+        currentListeners = listeners;
+        notifyingThread = std::this_thread::get_id();
+    }
+
+    for (auto listener : currentListeners)
+    {
+        {
+            // Skip listeners removed by a previous callback
+            std::lock_guard lock(listenerMutex);
+
+            if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end())
+                continue;
+        }
+
+        std::invoke(func, listener, args...);
+    }
+
+    std::lock_guard lock(listenerMutex);
+
+    notifyingThread = {};
+    listenerCondition.notify_all();
 }
 
 // ---------------------------------------------------------------------------------------------- //
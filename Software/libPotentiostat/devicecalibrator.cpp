@@ -21,10 +21,11 @@
 //                                                                                                //
 // ============================================================================================== //
 
+#include "runningstatistics.h"
+
 #include <potentiostat/devicecalibrator.h>
 
 #include <cassert>
-#include <numeric>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -42,35 +43,64 @@ namespace  {
 class DeviceCalibrator::Private
 {
 public:
-    Private(const char* port) : device(port) {}
+    Private(const char* port)
+        : ownedDevice(std::make_unique<Device>(port)),
+          device(ownedDevice.get()) {}
+
+    Private(Device* device)
+        : device(device) {}
+
+    void reset();
+
+    std::unique_ptr<Device> ownedDevice;
+    Device* device;
 
-    Device device;
     Listener* listener = nullptr;
 
     enum class Stage { Adc, Dac };
     Stage stage = Stage::Adc;
 
-    double voltage = 0.0;
-    double current = 0.0;
-
-    int sampleCount = 0;
+    RunningStatistics<double> voltage;
+    RunningStatistics<double> current;
 
     Device::Calibration result = {};
 };
 
 // ---------------------------------------------------------------------------------------------- //
 
+void DeviceCalibrator::Private::reset()
+{
+    voltage.clear();
+    current.clear();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 DeviceCalibrator::DeviceCalibrator(const char* port, Listener* listener)
     : d(std::make_unique<Private>(port))
 {
     assert(listener != nullptr);
-    d->device.addListener(this);
+    d->device->addListener(this);
     d->listener = listener;
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-DeviceCalibrator::~DeviceCalibrator() = default;
+DeviceCalibrator::DeviceCalibrator(Device* device, Listener* listener)
+    : d(std::make_unique<Private>(device))
+{
+    assert(device != nullptr);
+    assert(listener != nullptr);
+    d->device->addListener(this);
+    d->listener = listener;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+DeviceCalibrator::~DeviceCalibrator()
+{
+    d->device->removeListener(this);
+}
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -83,7 +113,7 @@ void DeviceCalibrator::start()
 
 void DeviceCalibrator::abort()
 {
-    d->device.stopMeasurement();
+    d->device->stopMeasurement();
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -103,16 +133,14 @@ void DeviceCalibrator::startAdc()
     };
 
     d->stage = Private::Stage::Adc;
-    d->voltage = 0.0;
-    d->current = 0.0;
-    d->sampleCount = 0;
+    d->reset();
 
     d->result.voltageOffset = 0;
     d->result.currentOffset = 0;
     d->result.signalOffset = 0;
 
-    d->device.setCalibration(d->result);
-    d->device.startMeasurement(setup);
+    d->device->setCalibration(d->result);
+    d->device->startMeasurement(setup);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -132,12 +160,10 @@ void DeviceCalibrator::startDac()
     };
 
     d->stage = Private::Stage::Dac;
-    d->voltage = 0.0;
-    d->current = 0.0;
-    d->sampleCount = 0;
+    d->reset();
 
-    d->device.setCalibration(d->result);
-    d->device.startMeasurement(setup);
+    d->device->setCalibration(d->result);
+    d->device->startMeasurement(setup);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -146,19 +172,18 @@ void DeviceCalibrator::onMeasurementComplete() noexcept
 {
     if (d->stage == Private::Stage::Adc)
     {
-        d->voltage /= d->sampleCount;
-        d->current /= d->sampleCount;
-        d->current *= Device::gainOf(CurrentRange);
+        const double voltage = d->voltage.mean();
+        const double current = d->current.mean() * Device::gainOf(CurrentRange);
 
-        d->result.voltageOffset = Device::toAdcOffset(-d->voltage);
-        d->result.currentOffset = Device::toAdcOffset(-d->current);
+        d->result.voltageOffset = Device::toAdcOffset(-voltage);
+        d->result.currentOffset = Device::toAdcOffset(-current);
 
         startDac();
     }
     else
     {
-        d->voltage /= d->sampleCount;
-        d->result.signalOffset = Device::toDacOffset(-d->voltage);
+        const double voltage = d->voltage.mean();
+        d->result.signalOffset = Device::toDacOffset(-voltage);
 
         d->listener->onCalibrationComplete(d->result);
     }
@@ -169,18 +194,20 @@ void DeviceCalibrator::onMeasurementComplete() noexcept
 void DeviceCalibrator::onSamplesReceived(std::span<const double> voltages,
                                          std::span<const double> currents) noexcept
 {
-    static constexpr int TotalSampleCount =
-            CalibrationDuration.count() * Device::SampleRate / Device::SampleBufferSize;
+    static constexpr size_t TotalSampleCount = CalibrationDuration.count() * Device::SampleRate;
+
+    for (double voltage : voltages)
+        d->voltage.addSample(voltage);
 
-    d->voltage += std::accumulate(voltages.begin(), voltages.end(), 0.0) / voltages.size();
-    d->current += std::accumulate(currents.begin(), currents.end(), 0.0) / currents.size();
+    for (double current : currents)
+        d->current.addSample(current);
 
-    ++d->sampleCount;
+    const auto percent = static_cast<int>(50 * d->voltage.count() / TotalSampleCount);
 
     if (d->stage == Private::Stage::Adc)
-        d->listener->onCalibrationProgress(50 * d->sampleCount / TotalSampleCount);
+        d->listener->onCalibrationProgress(percent);
     else
-        d->listener->onCalibrationProgress(50 + 50 * d->sampleCount / TotalSampleCount);
+        d->listener->onCalibrationProgress(50 + percent);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -44,6 +44,7 @@ public:
 
 public:
     DeviceCalibrator(const char* port, Listener* listener);
+    DeviceCalibrator(Device* device, Listener* listener);
     ~DeviceCalibrator();
 
     DeviceCalibrator(const DeviceCalibrator&) = delete;
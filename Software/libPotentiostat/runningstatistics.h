@@ -0,0 +1,114 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+class RunningStatistics
+{
+public:
+    RunningStatistics() = default;
+    ~RunningStatistics() noexcept = default;
+
+    RunningStatistics(const RunningStatistics& other) = delete;
+    RunningStatistics(RunningStatistics&& other) = delete;
+
+    auto operator=(const RunningStatistics& other) -> RunningStatistics& = delete;
+    auto operator=(RunningStatistics&& other) noexcept -> RunningStatistics& = delete;
+
+    void addSample(const T& sample);
+
+    auto count() const -> size_t;
+    auto mean() const -> T;
+    auto variance() const -> T;
+    auto standardDeviation() const -> T;
+
+    void clear();
+
+private:
+    size_t m_count = 0;
+    T m_mean = {};
+    T m_m2 = {};
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RunningStatistics<T>::addSample(const T& sample)
+{
+    // Welford's algorithm, numerically stable without storing the samples
+    ++m_count;
+
+    const T delta = sample - m_mean;
+    m_mean += delta / static_cast<T>(m_count);
+    m_m2 += delta * (sample - m_mean);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto RunningStatistics<T>::count() const -> size_t
+{
+    return m_count;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto RunningStatistics<T>::mean() const -> T
+{
+    return m_mean;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto RunningStatistics<T>::variance() const -> T
+{
+    return m_count > 1 ? m_m2 / static_cast<T>(m_count - 1) : T();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto RunningStatistics<T>::standardDeviation() const -> T
+{
+    return std::sqrt(variance());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RunningStatistics<T>::clear()
+{
+    m_count = 0;
+    m_mean = {};
+    m_m2 = {};
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -1 +0,0 @@
-../Common/serialport.cpp
\ No newline at end of file
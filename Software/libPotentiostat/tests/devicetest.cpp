@@ -0,0 +1,386 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+#include "testing.h"
+
+#include <potentiostat/device.h>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using isf::Potentiostat::Device;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// The board end of a pseudo terminal
+class FakeBoard
+{
+public:
+    FakeBoard();
+    ~FakeBoard();
+
+    auto port() const -> std::string;
+
+    void send(const std::string& data);
+    auto receiveLine(std::chrono::milliseconds timeout = 2s) -> std::string;
+
+    void disconnect();
+
+private:
+    int m_master = -1;
+    int m_slave = -1;
+
+    std::string m_buffer;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+FakeBoard::FakeBoard()
+{
+    m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (m_master < 0 || ::grantpt(m_master) < 0 || ::unlockpt(m_master) < 0)
+        std::abort();
+
+    // Keeps the terminal raw until the device has configured it
+    m_slave = ::open(::ptsname(m_master), O_RDWR | O_NOCTTY);
+
+    ::termios termios = {};
+    ::tcgetattr(m_slave, &termios);
+    ::cfmakeraw(&termios);
+    ::tcsetattr(m_slave, TCSANOW, &termios);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+FakeBoard::~FakeBoard()
+{
+    disconnect();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto FakeBoard::port() const -> std::string
+{
+    // Device expects a name relative to /dev
+    return std::string(::ptsname(m_master)).substr(5);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::send(const std::string& data)
+{
+    if (::write(m_master, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+        std::abort();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto FakeBoard::receiveLine(std::chrono::milliseconds timeout) -> std::string
+{
+    const auto end = std::chrono::steady_clock::now() + timeout;
+
+    while (m_buffer.find("\r\n") == std::string::npos && std::chrono::steady_clock::now() < end)
+    {
+        ::pollfd fd = { m_master, POLLIN, 0 };
+
+        if (::poll(&fd, 1, 5) > 0 && (fd.revents & POLLIN))
+        {
+            char data[256];
+            const ssize_t size = ::read(m_master, data, sizeof(data));
+
+            if (size > 0)
+                m_buffer.append(data, size);
+        }
+    }
+
+    const size_t lineEnd = m_buffer.find("\r\n");
+
+    if (lineEnd == std::string::npos)
+        return {};
+
+    const std::string line = m_buffer.substr(0, lineEnd);
+    m_buffer.erase(0, lineEnd + 2);
+
+    return line;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::disconnect()
+{
+    if (m_slave >= 0)
+        ::close(m_slave);
+
+    if (m_master >= 0)
+        ::close(m_master);
+
+    m_slave = -1;
+    m_master = -1;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+class RecordingListener : public Device::Listener
+{
+public:
+    auto waitFor(std::function<bool()> condition) -> bool;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    size_t startedCount = 0;
+    size_t completeCount = 0;
+    std::vector<double> voltages;
+    std::vector<double> currents;
+    std::vector<Device::PowerValues> powerValues;
+    std::vector<std::string> errors;
+
+private:
+    void onMeasurementStarted() noexcept override;
+    void onMeasurementComplete() noexcept override;
+
+    void onSamplesReceived(std::span<const double> voltages,
+                           std::span<const double> currents) noexcept override;
+
+    void onPowerValuesReceived(const Device::PowerValues& values) noexcept override;
+    void onError(const std::string& error) noexcept override;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RecordingListener::waitFor(std::function<bool()> condition) -> bool
+{
+    std::unique_lock lock(mutex);
+    return changed.wait_for(lock, 2s, condition);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingListener::onMeasurementStarted() noexcept
+{
+    std::lock_guard lock(mutex);
+    ++startedCount;
+    changed.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingListener::onMeasurementComplete() noexcept
+{
+    std::lock_guard lock(mutex);
+    ++completeCount;
+    changed.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingListener::onSamplesReceived(std::span<const double> voltages,
+                                          std::span<const double> currents) noexcept
+{
+    std::lock_guard lock(mutex);
+    this->voltages.insert(this->voltages.end(), voltages.begin(), voltages.end());
+    this->currents.insert(this->currents.end(), currents.begin(), currents.end());
+    changed.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingListener::onPowerValuesReceived(const Device::PowerValues& values) noexcept
+{
+    std::lock_guard lock(mutex);
+    powerValues.push_back(values);
+    changed.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RecordingListener::onError(const std::string& error) noexcept
+{
+    std::lock_guard lock(mutex);
+    errors.push_back(error);
+    changed.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCommands()
+{
+    FakeBoard board;
+    Device device(board.port());
+
+    device.setCalibration({ 1, -2, 3 });
+    CHECK(board.receiveLine() == "<SET_CALIBRATION> 1;-2;3");
+
+    Device::Setup setup;
+    setup.measurementType = Device::MeasurementType::CyclicVoltammetry;
+    setup.currentRange = Device::CurrentRange::_100uA;
+    setup.duration = 10s;
+    setup.scanRate = 50;
+    setup.vertex0 = -500;
+    setup.vertex1 = 500;
+    setup.vertex2 = 0;
+    setup.cycleCount = 2;
+
+    device.startMeasurement(setup);
+    CHECK(board.receiveLine() == "<START_MEASUREMENT> 3;2;10;50;-500;500;0;2");
+
+    device.requestPowerValues();
+    CHECK(board.receiveLine() == "<GET_POWER_VALUES>");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testMeasurement()
+{
+    // Half the full-scale ADC value is 0 V
+    static constexpr int ZeroVolts = 16 * 0xffff / 2;
+    static constexpr size_t SampleCount = 250;
+
+    FakeBoard board;
+    Device device(board.port());
+
+    RecordingListener listener;
+    device.addListener(&listener);
+
+    std::string data = "<MEASUREMENT_STARTED>\r\n";
+
+    for (size_t i = 0; i < SampleCount; ++i)
+        data += "<S> 3;" + std::to_string(ZeroVolts) + ";" + std::to_string(ZeroVolts) + "\r\n";
+
+    data += "<MEASUREMENT_COMPLETE>\r\n";
+
+    // Lines split across reads are joined again
+    for (size_t i = 0; i < data.size(); i += 61)
+        board.send(data.substr(i, 61));
+
+    CHECK(listener.waitFor([&] { return listener.completeCount == 1; }));
+
+    std::lock_guard lock(listener.mutex);
+
+    CHECK(listener.startedCount == 1);
+    CHECK(listener.errors.empty());
+
+    if (CHECK(listener.voltages.size() == SampleCount && listener.currents.size() == SampleCount))
+    {
+        CHECK_NEAR(listener.voltages.front(), 0.0, 1e-9);
+        CHECK_NEAR(listener.currents.back(), 0.0, 1e-9);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testPowerValues()
+{
+    FakeBoard board;
+    Device device(board.port());
+
+    RecordingListener listener;
+    device.addListener(&listener);
+
+    board.send("<P> 5.02;0.125;25.5\r\n<ERROR> INVALID_ARGUMENT\r\n");
+
+    CHECK(listener.waitFor([&] { return !listener.errors.empty(); }));
+
+    std::lock_guard lock(listener.mutex);
+
+    if (CHECK(listener.powerValues.size() == 1))
+    {
+        CHECK_NEAR(listener.powerValues[0].voltage, 5.02, 1e-9);
+        CHECK_NEAR(listener.powerValues[0].current, 0.125, 1e-9);
+        CHECK_NEAR(listener.powerValues[0].temperature, 25.5, 1e-9);
+    }
+
+    CHECK(listener.errors == std::vector<std::string>{ "Invalid argument." });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRemoveListener()
+{
+    FakeBoard board;
+    Device device(board.port());
+
+    RecordingListener listener;
+    device.addListener(&listener);
+
+    board.send("<MEASUREMENT_STARTED>\r\n");
+    CHECK(listener.waitFor([&] { return listener.startedCount == 1; }));
+
+    device.removeListener(&listener);
+
+    board.send("<MEASUREMENT_STARTED>\r\n<MEASUREMENT_COMPLETE>\r\n");
+    std::this_thread::sleep_for(50ms);
+
+    std::lock_guard lock(listener.mutex);
+
+    CHECK(listener.startedCount == 1);
+    CHECK(listener.completeCount == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDisconnect()
+{
+    FakeBoard board;
+    Device device(board.port());
+
+    RecordingListener listener;
+    device.addListener(&listener);
+
+    board.disconnect();
+
+    CHECK(listener.waitFor([&] { return !listener.errors.empty(); }));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    try {
+        testCommands();
+        testMeasurement();
+        testPowerValues();
+        testRemoveListener();
+        testDisconnect();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,502 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "batchqueue.h"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+class BatchQueue::HubListener : public Listener
+{
+public:
+    HubListener(BatchQueue* queue, size_t hub) : m_queue(queue), m_hub(hub) {}
+
+private:
+    void onNodeInfoReceived(std::span<const NodeInfo> info) override;
+
+    void onTestpointInfoReceived(std::span<const TestpointInfo> info) override;
+
+    void onStatusChanged(Status status) override;
+
+    void onConductanceReceived(const std::string& testpointId,
+                               double voltage, double current, double admittance) override;
+
+    void onOrpValueReceived(const std::string& testpointId, double value) override;
+
+    void onPhValueReceived(const std::string& testpointId, double value) override;
+
+    void onTemperatureReceived(const std::string& testpointId, double value) override;
+
+    void onVoltammogramReceived(const std::string& testpointId,
+                                std::span<const double> voltage,
+                                std::span<const double> current) override;
+
+    void onHubAlarm(AlarmType type, AlarmSeverity severity) override;
+
+    void onNodeAlarm(const std::string& nodeId, AlarmType type, AlarmSeverity severity) override;
+
+    void onHubStatusReceived(double temperature) override;
+
+    void onNodeStatusReceived(const std::string& nodeId,
+                              double voltage, double current, double temperature) override;
+
+    void onCalibrationProgress(const std::string& nodeId, int percent) override;
+
+    void onCalibrationResult(const std::string& nodeId,
+                             int voltageOffset, int currentOffset, int signalOffset) override;
+
+    void onError(const std::string& msg) override;
+
+    void addStatistics(const std::string& testpointId, Channel channel, double value);
+
+    template <typename T>
+    static auto push(std::vector<T>& records, T&& record) -> size_t;
+
+private:
+    BatchQueue* m_queue;
+    size_t m_hub;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+BatchQueue::BatchQueue(size_t hubCount, bool merge)
+    : m_merge(merge),
+      m_statistics(hubCount)
+{
+    m_pending.hubs.resize(hubCount);
+
+    for (size_t hub = 0; hub < hubCount; ++hub)
+        m_listeners.push_back(std::make_unique<HubListener>(this, hub));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+BatchQueue::~BatchQueue() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BatchQueue::listener(size_t hub) -> Listener*
+{
+    return m_listeners.at(hub).get();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BatchQueue::take(Batch& batch, std::chrono::milliseconds timeout) -> bool
+{
+    std::unique_lock lock(m_mutex);
+    wait(lock, timeout);
+
+    Batch& pending = m_pending.hubs.front();
+
+    if (pending.empty())
+        return false;
+
+    // Hand over the pending records and keep the capacity of the caller's batch for the next ones
+    batch.clear();
+    std::swap(batch, pending);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BatchQueue::take(MultiBatch& batch, std::chrono::milliseconds timeout) -> bool
+{
+    std::unique_lock lock(m_mutex);
+    wait(lock, timeout);
+
+    if (m_pending.empty())
+        return false;
+
+    const size_t hubCount = m_pending.hubs.size();
+
+    batch.clear();
+    std::swap(batch, m_pending);
+
+    m_pending.hubs.resize(hubCount);
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::close()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_closed = true;
+    }
+
+    m_condition.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BatchQueue::statistics() -> RollingStatistics&
+{
+    return m_statistics;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto BatchQueue::recorder() -> Recorder&
+{
+    return m_recorder;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::dispatch(const Batch& batch, Listener* listener)
+{
+    for (const RecordIndex& record : batch.records)
+    {
+        const size_t i = record.index;
+
+        switch (record.type)
+        {
+        case RecordType::NodeInfo:
+            listener->onNodeInfoReceived(batch.nodeInfo);
+            break;
+
+        case RecordType::TestpointInfo:
+            listener->onTestpointInfoReceived(batch.testpointInfo);
+            break;
+
+        case RecordType::Status:
+            listener->onStatusChanged(batch.statusChanges[i]);
+            break;
+
+        case RecordType::Conductance: {
+            const ConductanceRecord& r = batch.conductance[i];
+            listener->onConductanceReceived(batch.testpointIds[r.testpoint],
+                                            r.voltage, r.current, r.admittance);
+            break;
+        }
+
+        case RecordType::OrpValue: {
+            const SensorRecord& r = batch.orpValues[i];
+            listener->onOrpValueReceived(batch.testpointIds[r.testpoint], r.value);
+            break;
+        }
+
+        case RecordType::PhValue: {
+            const SensorRecord& r = batch.phValues[i];
+            listener->onPhValueReceived(batch.testpointIds[r.testpoint], r.value);
+            break;
+        }
+
+        case RecordType::Temperature: {
+            const SensorRecord& r = batch.temperatures[i];
+            listener->onTemperatureReceived(batch.testpointIds[r.testpoint], r.value);
+            break;
+        }
+
+        case RecordType::Voltammogram: {
+            const VoltammogramRecord& r = batch.voltammograms[i];
+            listener->onVoltammogramReceived(batch.testpointIds[r.testpoint],
+                                             batch.voltage(r), batch.current(r));
+            break;
+        }
+
+        case RecordType::HubAlarm: {
+            const HubAlarmRecord& r = batch.hubAlarms[i];
+            listener->onHubAlarm(r.type, r.severity);
+            break;
+        }
+
+        case RecordType::NodeAlarm: {
+            const NodeAlarmRecord& r = batch.nodeAlarms[i];
+            listener->onNodeAlarm(r.nodeId, r.type, r.severity);
+            break;
+        }
+
+        case RecordType::HubStatus:
+            listener->onHubStatusReceived(batch.hubStatus[i].temperature);
+            break;
+
+        case RecordType::NodeStatus: {
+            const NodeStatusRecord& r = batch.nodeStatus[i];
+            listener->onNodeStatusReceived(r.nodeId, r.voltage, r.current, r.temperature);
+            break;
+        }
+
+        case RecordType::CalibrationProgress: {
+            const CalibrationProgressRecord& r = batch.calibrationProgress[i];
+            listener->onCalibrationProgress(r.nodeId, r.percent);
+            break;
+        }
+
+        case RecordType::CalibrationResult: {
+            const CalibrationResultRecord& r = batch.calibrationResults[i];
+            listener->onCalibrationResult(r.nodeId,
+                                          r.voltageOffset, r.currentOffset, r.signalOffset);
+            break;
+        }
+
+        case RecordType::Error:
+            listener->onError(batch.errors[i]);
+            break;
+        }
+    }
+
+    if (batch.droppedRecords > 0)
+    {
+        listener->onError(std::to_string(batch.droppedRecords) +
+                          " records dropped because the listener could not keep up.");
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Func>
+void BatchQueue::append(size_t hub, RecordType type, Func func, size_t samples)
+{
+    {
+        std::lock_guard lock(m_mutex);
+
+        Batch& batch = m_pending.hubs[hub];
+
+        if (batch.records.size() >= MaximumPendingRecords ||
+            batch.voltammogramVoltage.size() + samples > MaximumPendingSamples)
+        {
+            ++batch.droppedRecords;
+            return;
+        }
+
+        const size_t index = func(batch);
+        batch.records.push_back({ type, index });
+
+        if (m_recorder.isActive())
+            m_recorder.add(hub, type, batch, index);
+
+        if (m_merge)
+            m_pending.merged.push_back({ hub, type, index, std::chrono::steady_clock::now() });
+    }
+
+    m_condition.notify_one();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::wait(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout)
+{
+    m_condition.wait_for(lock, timeout, [&] { return m_closed || !m_pending.empty(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::addStatistics(const std::string& testpointId, Channel channel,
+                                            double value)
+{
+    RollingStatistics& statistics = m_queue->m_statistics;
+
+    if (statistics.isEnabled())
+        statistics.add(m_hub, testpointId, channel, value, RollingWindow::Clock::now());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto BatchQueue::HubListener::push(std::vector<T>& records, T&& record) -> size_t
+{
+    records.push_back(std::move(record));
+    return records.size() - 1;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onNodeInfoReceived(std::span<const NodeInfo> info)
+{
+    m_queue->append(m_hub, RecordType::NodeInfo, [&](Batch& batch) -> size_t {
+        batch.nodeInfo.assign(info.begin(), info.end());
+        batch.nodeInfoReceived = true;
+        return 0;
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onTestpointInfoReceived(std::span<const TestpointInfo> info)
+{
+    m_queue->append(m_hub, RecordType::TestpointInfo, [&](Batch& batch) -> size_t {
+        batch.testpointInfo.assign(info.begin(), info.end());
+        batch.testpointInfoReceived = true;
+        return 0;
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onStatusChanged(Status status)
+{
+    m_queue->append(m_hub, RecordType::Status, [&](Batch& batch) {
+        return push(batch.statusChanges, Status(status));
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onConductanceReceived(const std::string& testpointId,
+                                                    double voltage, double current,
+                                                    double admittance)
+{
+    addStatistics(testpointId, Channel::Voltage, voltage);
+    addStatistics(testpointId, Channel::Current, current);
+    addStatistics(testpointId, Channel::Admittance, admittance);
+
+    m_queue->append(m_hub, RecordType::Conductance, [&](Batch& batch) {
+        return push(batch.conductance, ConductanceRecord{ batch.addTestpointId(testpointId),
+                                                          voltage, current, admittance });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onOrpValueReceived(const std::string& testpointId, double value)
+{
+    addStatistics(testpointId, Channel::Orp, value);
+
+    m_queue->append(m_hub, RecordType::OrpValue, [&](Batch& batch) {
+        return push(batch.orpValues, SensorRecord{ batch.addTestpointId(testpointId), value });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onPhValueReceived(const std::string& testpointId, double value)
+{
+    addStatistics(testpointId, Channel::Ph, value);
+
+    m_queue->append(m_hub, RecordType::PhValue, [&](Batch& batch) {
+        return push(batch.phValues, SensorRecord{ batch.addTestpointId(testpointId), value });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onTemperatureReceived(const std::string& testpointId, double value)
+{
+    addStatistics(testpointId, Channel::Temperature, value);
+
+    m_queue->append(m_hub, RecordType::Temperature, [&](Batch& batch) {
+        return push(batch.temperatures, SensorRecord{ batch.addTestpointId(testpointId), value });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onVoltammogramReceived(const std::string& testpointId,
+                                                     std::span<const double> voltage,
+                                                     std::span<const double> current)
+{
+    const size_t size = std::min(voltage.size(), current.size());
+
+    m_queue->append(m_hub, RecordType::Voltammogram, [&](Batch& batch) {
+        const size_t offset = batch.voltammogramVoltage.size();
+
+        batch.voltammogramVoltage.insert(batch.voltammogramVoltage.end(),
+                                         voltage.begin(), voltage.begin() + size);
+        batch.voltammogramCurrent.insert(batch.voltammogramCurrent.end(),
+                                         current.begin(), current.begin() + size);
+
+        return push(batch.voltammograms,
+                    VoltammogramRecord{ batch.addTestpointId(testpointId), offset, size });
+    }, size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onHubAlarm(AlarmType type, AlarmSeverity severity)
+{
+    m_queue->append(m_hub, RecordType::HubAlarm, [&](Batch& batch) {
+        return push(batch.hubAlarms, HubAlarmRecord{ type, severity });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onNodeAlarm(const std::string& nodeId,
+                                          AlarmType type, AlarmSeverity severity)
+{
+    m_queue->append(m_hub, RecordType::NodeAlarm, [&](Batch& batch) {
+        return push(batch.nodeAlarms, NodeAlarmRecord{ nodeId, type, severity });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onHubStatusReceived(double temperature)
+{
+    m_queue->append(m_hub, RecordType::HubStatus, [&](Batch& batch) {
+        return push(batch.hubStatus, HubStatusRecord{ temperature });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onNodeStatusReceived(const std::string& nodeId,
+                                                   double voltage, double current,
+                                                   double temperature)
+{
+    m_queue->append(m_hub, RecordType::NodeStatus, [&](Batch& batch) {
+        return push(batch.nodeStatus, NodeStatusRecord{ nodeId, voltage, current, temperature });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onCalibrationProgress(const std::string& nodeId, int percent)
+{
+    m_queue->append(m_hub, RecordType::CalibrationProgress, [&](Batch& batch) {
+        return push(batch.calibrationProgress, CalibrationProgressRecord{ nodeId, percent });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onCalibrationResult(const std::string& nodeId, int voltageOffset,
+                                                  int currentOffset, int signalOffset)
+{
+    m_queue->append(m_hub, RecordType::CalibrationResult, [&](Batch& batch) {
+        return push(batch.calibrationResults,
+                    CalibrationResultRecord{ nodeId, voltageOffset, currentOffset, signalOffset });
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void BatchQueue::HubListener::onError(const std::string& msg)
+{
+    m_queue->append(m_hub, RecordType::Error, [&](Batch& batch) {
+        return push(batch.errors, std::string(msg));
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
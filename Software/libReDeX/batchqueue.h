@@ -0,0 +1,89 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include "recorder.h"
+#include "rollingstatistics.h"
+
+#include <redex.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace redex {
+
+// Collects the records reported by one or more TcpClients until they are taken as one batch
+class BatchQueue
+{
+public:
+    // Per hub, further records are dropped until the batch is taken
+    static constexpr size_t MaximumPendingRecords = 100000;
+    static constexpr size_t MaximumPendingSamples = 4 << 20; // Of all voltammograms
+
+public:
+    explicit BatchQueue(size_t hubCount = 1, bool merge = false);
+    ~BatchQueue();
+
+    // The listener to be passed to the TcpClient of the given hub
+    auto listener(size_t hub = 0) -> Listener*;
+
+    auto take(Batch& batch, std::chrono::milliseconds timeout) -> bool;
+    auto take(MultiBatch& batch, std::chrono::milliseconds timeout) -> bool;
+
+    // Wakes up all waiting take() calls and makes further calls return immediately
+    void close();
+
+    // Updated with the values as they arrive, before they are taken
+    auto statistics() -> RollingStatistics&;
+
+    // Records are passed to the recorder as they are appended
+    auto recorder() -> Recorder&;
+
+    // Calls the listener for every record in the order of arrival
+    static void dispatch(const Batch& batch, Listener* listener);
+
+private:
+    class HubListener;
+
+    // Func appends a record to the batch and returns its index
+    template <typename Func>
+    void append(size_t hub, RecordType type, Func func, size_t samples = 0);
+
+    void wait(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    MultiBatch m_pending;
+    bool m_merge;
+    bool m_closed = false;
+
+    RollingStatistics m_statistics;
+    Recorder m_recorder;
+
+    std::vector<std::unique_ptr<HubListener>> m_listeners;
+};
+
+} // End of namespace redex
@@ -0,0 +1 @@
+../Common/biquadfilter.cpp
\ No newline at end of file
@@ -0,0 +1 @@
+../Common/biquadfilter.h
\ No newline at end of file
@@ -33,10 +33,13 @@
   #define REDEX_EXPORT __attribute__((visibility("default")))
 #endif
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace redex {
 
@@ -84,6 +87,241 @@ enum class AlarmSeverity
     Critical
 };
 
+enum class RecordType
+{
+    NodeInfo,
+    TestpointInfo,
+    Status,
+    Conductance,
+    OrpValue,
+    PhValue,
+    Temperature,
+    Voltammogram,
+    HubAlarm,
+    NodeAlarm,
+    HubStatus,
+    NodeStatus,
+    CalibrationProgress,
+    CalibrationResult,
+    Error
+};
+
+// The testpoint is the index into Batch::testpointIds
+struct ConductanceRecord
+{
+    size_t testpoint;
+    double voltage;
+    double current;
+    double admittance;
+};
+
+struct SensorRecord
+{
+    size_t testpoint;
+    double value;
+};
+
+struct VoltammogramRecord
+{
+    size_t testpoint;
+    size_t offset; // First sample in Batch::voltammogramVoltage/voltammogramCurrent.
+    size_t size;
+};
+
+struct HubAlarmRecord
+{
+    AlarmType type;
+    AlarmSeverity severity;
+};
+
+struct NodeAlarmRecord
+{
+    std::string nodeId;
+    AlarmType type;
+    AlarmSeverity severity;
+};
+
+struct HubStatusRecord
+{
+    double temperature;
+};
+
+struct NodeStatusRecord
+{
+    std::string nodeId;
+    double voltage;
+    double current;
+    double temperature;
+};
+
+struct CalibrationProgressRecord
+{
+    std::string nodeId;
+    int percent;
+};
+
+struct CalibrationResultRecord
+{
+    std::string nodeId;
+    int voltageOffset;
+    int currentOffset;
+    int signalOffset;
+};
+
+struct RecordIndex
+{
+    RecordType type;
+    size_t index; // Into the records of the given type
+};
+
+// Records of one kind are kept in the order they were received, records lists all of them in the
+// order of arrival. Each testpoint ID is stored once per batch. The vectors keep their capacity
+// when a batch is reused, so polling into the same batch does not allocate in the steady state.
+struct Batch
+{
+    bool nodeInfoReceived = false;     // nodeInfo holds the latest reply
+    bool testpointInfoReceived = false; // testpointInfo holds the latest reply
+
+    std::vector<NodeInfo> nodeInfo;
+    std::vector<TestpointInfo> testpointInfo;
+
+    std::vector<Status> statusChanges;
+
+    std::vector<ConductanceRecord> conductance;
+    std::vector<SensorRecord> orpValues;
+    std::vector<SensorRecord> phValues;
+    std::vector<SensorRecord> temperatures;
+
+    std::vector<VoltammogramRecord> voltammograms;
+    std::vector<double> voltammogramVoltage;
+    std::vector<double> voltammogramCurrent;
+
+    std::vector<HubAlarmRecord> hubAlarms;
+    std::vector<NodeAlarmRecord> nodeAlarms;
+
+    std::vector<HubStatusRecord> hubStatus;
+    std::vector<NodeStatusRecord> nodeStatus;
+
+    std::vector<CalibrationProgressRecord> calibrationProgress;
+    std::vector<CalibrationResultRecord> calibrationResults;
+
+    std::vector<std::string> errors;
+
+    std::vector<std::string> testpointIds;
+    std::vector<RecordIndex> records;
+
+    // Records received while too many were waiting to be taken, since the previous batch
+    size_t droppedRecords = 0;
+
+    REDEX_EXPORT void clear();
+    REDEX_EXPORT auto empty() const -> bool;
+
+    // Returns the index of the ID in testpointIds, adding it if necessary
+    REDEX_EXPORT auto addTestpointId(const std::string& id) -> size_t;
+
+    REDEX_EXPORT auto voltage(const VoltammogramRecord& record) const -> std::span<const double>;
+    REDEX_EXPORT auto current(const VoltammogramRecord& record) const -> std::span<const double>;
+};
+
+struct MergedRecord
+{
+    size_t hub;
+    RecordType type;
+    size_t index; // Into the records of the given type in MultiBatch::hubs[hub]
+    std::chrono::steady_clock::time_point time;
+};
+
+struct MultiBatch
+{
+    std::vector<Batch> hubs;
+
+    // Only filled if merging is enabled, ordered by time of arrival
+    std::vector<MergedRecord> merged;
+
+    REDEX_EXPORT void clear();
+    REDEX_EXPORT auto empty() const -> bool;
+};
+
+// Voltage, Current and Admittance refer to the conductance measurement
+enum class Channel
+{
+    Voltage,
+    Current,
+    Admittance,
+    Orp,
+    Ph,
+    Temperature
+};
+
+// A window is limited by the number of samples, by their age or by both. Zero means no limit.
+struct StatisticsWindow
+{
+    size_t count = 0;
+    std::chrono::milliseconds duration = std::chrono::milliseconds(0);
+};
+
+// Values that are not defined for the number of samples in the window are NaN. Samples that are
+// NaN or infinite are left out.
+struct Statistics
+{
+    size_t count;
+    double mean;
+    double standardDeviation;
+    double minimum;
+    double maximum;
+    double slope; // Change per second, based on the time of arrival
+};
+
+enum class RecordFormat
+{
+    // Starts with the magic "REDEXREC" and a uint32 version. Every record consists of an int64
+    // time in nanoseconds since the epoch, uint16 hub, uint8 RecordType, uint32 payload size and
+    // the payload. The payload holds the fields of the record in declaration order: strings as
+    // uint16 length and characters, floating point values as double, other numbers as int32 and
+    // enums as uint8. Lists are preceded by their uint32 length, a voltammogram has one length for
+    // its voltage and its current samples. All values are little-endian.
+    Binary,
+
+    // One line per record with time in seconds, hub, type name and the same fields as above
+    Csv
+};
+
+struct RecorderSettings
+{
+    std::string directory;
+    std::string prefix = "redex";
+    RecordFormat format = RecordFormat::Binary;
+
+    std::vector<RecordType> types; // Empty to record all types
+
+    // A new file is started when one of the limits is reached. Zero means no limit.
+    uint64_t maxFileSize = 0;
+    std::chrono::seconds maxFileDuration = std::chrono::seconds(0);
+
+    size_t bufferSize = 4 << 20; // Written at once
+    size_t maxPending = 64 << 20; // Records beyond are dropped until the disk catches up
+};
+
+struct RecorderStatistics
+{
+    uint64_t records = 0;
+    uint64_t droppedRecords = 0;
+    uint64_t bytes = 0;
+    size_t files = 0;
+
+    size_t writeErrors = 0;
+    std::string lastError;
+};
+
+enum class FilterType
+{
+    // 121-tap FIR, linear phase
+    Fir,
+
+    // Cascade of biquad notches and a low-pass, applied forward and backward for zero phase
+    Iir
+};
+
 using Error = std::runtime_error;
 
 class REDEX_EXPORT Listener
@@ -117,6 +355,11 @@ public:
     virtual void onNodeStatusReceived(const std::string& nodeId,
                                       double voltage, double current, double temperature);
 
+    virtual void onCalibrationProgress(const std::string& nodeId, int percent);
+
+    virtual void onCalibrationResult(const std::string& nodeId,
+                                     int voltageOffset, int currentOffset, int signalOffset);
+
     virtual void onError(const std::string& msg);
 };
 
@@ -129,9 +372,18 @@ class Client
     auto operator=(Client&&) = delete;
 
 public:
+    // The host name may be followed by the port of the server, as in "hub:5433"
+    REDEX_EXPORT explicit Client(const std::string& host);
+
+    // The listener is called from an internal thread with the records of one batch at a time, in
+    // the order they were received.
     REDEX_EXPORT Client(const std::string& host, Listener* listener);
     REDEX_EXPORT ~Client();
 
+    // Replaces the batch with all records received since the previous call. Returns false if
+    // nothing arrived within the timeout. Not available if the client was given a listener.
+    REDEX_EXPORT auto poll(Batch& batch, std::chrono::milliseconds timeout) -> bool;
+
     REDEX_EXPORT void requestNodeInfo();
     REDEX_EXPORT void requestTestpointInfo();
 
@@ -141,8 +393,75 @@ public:
     REDEX_EXPORT void startMeasurement();
     REDEX_EXPORT void stopMeasurement();
 
+    REDEX_EXPORT void startCalibration();
+
+    // Maintains rolling statistics of every testpoint and channel over the given windows, starting
+    // from scratch. An empty list disables the statistics.
+    REDEX_EXPORT void setStatisticsWindows(const std::vector<StatisticsWindow>& windows);
+
+    // The window is the index into the list of windows. Can be called at any time, from any thread.
+    REDEX_EXPORT auto statistics(const std::string& testpointId, Channel channel,
+                                 size_t window = 0) const -> Statistics;
+
+    // Writes the received records to files on a separate thread. Replaces a running recording.
+    REDEX_EXPORT void startRecording(const RecorderSettings& settings);
+    REDEX_EXPORT void stopRecording();
+
+    REDEX_EXPORT auto recorderStatistics() const -> RecorderStatistics;
+
     REDEX_EXPORT static void filterVoltammetryData(std::span<const double> input,
-                                                   std::span<double> output);
+                                                   std::span<double> output,
+                                                   FilterType type = FilterType::Fir);
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+class MultiClient
+{
+    MultiClient(const MultiClient&) = delete;
+    MultiClient(MultiClient&&) = delete;
+
+    auto operator=(const MultiClient&) = delete;
+    auto operator=(MultiClient&&) = delete;
+
+public:
+    // Hubs are identified by their index in the list of hosts, given as for Client. Hubs that
+    // cannot be reached are reported by an error record and may be reconnected later.
+    REDEX_EXPORT explicit MultiClient(const std::vector<std::string>& hosts, bool merge = false);
+    REDEX_EXPORT ~MultiClient();
+
+    REDEX_EXPORT auto hubCount() const -> size_t;
+    REDEX_EXPORT auto host(size_t hub) const -> const std::string&;
+
+    REDEX_EXPORT auto isConnected(size_t hub) const -> bool;
+    REDEX_EXPORT void reconnect(size_t hub);
+
+    REDEX_EXPORT void requestNodeInfo(size_t hub);
+    REDEX_EXPORT void requestTestpointInfo(size_t hub);
+
+    REDEX_EXPORT void startPowerMonitor(size_t hub);
+    REDEX_EXPORT void stopPowerMonitor(size_t hub);
+
+    REDEX_EXPORT void startMeasurement(size_t hub);
+    REDEX_EXPORT void stopMeasurement(size_t hub);
+
+    REDEX_EXPORT void startCalibration(size_t hub);
+
+    // The same windows apply to all hubs
+    REDEX_EXPORT void setStatisticsWindows(const std::vector<StatisticsWindow>& windows);
+
+    REDEX_EXPORT auto statistics(size_t hub, const std::string& testpointId, Channel channel,
+                                 size_t window = 0) const -> Statistics;
+
+    // Records of all hubs go to the same files
+    REDEX_EXPORT void startRecording(const RecorderSettings& settings);
+    REDEX_EXPORT void stopRecording();
+
+    REDEX_EXPORT auto recorderStatistics() const -> RecorderStatistics;
+
+    REDEX_EXPORT auto poll(MultiBatch& batch, std::chrono::milliseconds timeout) -> bool;
 
 private:
     class Private;
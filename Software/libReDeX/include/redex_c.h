@@ -0,0 +1,340 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#ifdef _WIN32
+  #ifdef REDEX_BUILD_PROCESS
+    #define REDEX_EXPORT __declspec(dllexport)
+  #else
+    #define REDEX_EXPORT __declspec(dllimport)
+  #endif
+#else
+  #define REDEX_EXPORT __attribute__((visibility("default")))
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _redex_client *redex_client;
+typedef struct _redex_batch *redex_batch;
+
+typedef enum {
+    REDEX_SUCCESS,
+    REDEX_CONNECTION_FAILED,
+    REDEX_CONNECTION_LOST,
+    REDEX_TIMEOUT,
+    REDEX_INVALID_ARGUMENT
+} redex_result;
+
+typedef enum {
+    REDEX_MEASUREMENT_STARTED,
+    REDEX_MEASUREMENT_STOPPED,
+    REDEX_MEASUREMENT_ERROR
+} redex_status;
+
+typedef enum {
+    REDEX_OVERVOLTAGE,
+    REDEX_UNDERVOLTAGE,
+    REDEX_OVERCURRENT,
+    REDEX_OVERHEAT
+} redex_alarm_type;
+
+typedef enum {
+    REDEX_WARNING,
+    REDEX_CRITICAL
+} redex_alarm_severity;
+
+typedef enum {
+    REDEX_CHANNEL_VOLTAGE,
+    REDEX_CHANNEL_CURRENT,
+    REDEX_CHANNEL_ADMITTANCE,
+    REDEX_CHANNEL_ORP,
+    REDEX_CHANNEL_PH,
+    REDEX_CHANNEL_TEMPERATURE
+} redex_channel;
+
+/* A window is limited by the number of samples, by their age or by both. Zero means no limit. */
+typedef struct {
+    uint32_t count;
+    uint32_t duration_ms;
+} redex_statistics_window;
+
+/* Values that are not defined for the number of samples in the window are NaN. */
+typedef struct {
+    size_t count;
+    double mean;
+    double standard_deviation;
+    double minimum;
+    double maximum;
+    double slope;
+} redex_statistics;
+
+typedef enum {
+    REDEX_RECORD_NODE_INFO,
+    REDEX_RECORD_TESTPOINT_INFO,
+    REDEX_RECORD_STATUS,
+    REDEX_RECORD_CONDUCTANCE,
+    REDEX_RECORD_ORP,
+    REDEX_RECORD_PH,
+    REDEX_RECORD_TEMPERATURE,
+    REDEX_RECORD_VOLTAMMOGRAM,
+    REDEX_RECORD_HUB_ALARM,
+    REDEX_RECORD_NODE_ALARM,
+    REDEX_RECORD_HUB_STATUS,
+    REDEX_RECORD_NODE_STATUS,
+    REDEX_RECORD_CALIBRATION_PROGRESS,
+    REDEX_RECORD_CALIBRATION_RESULT,
+    REDEX_RECORD_ERROR
+} redex_record_type;
+
+typedef struct {
+    redex_record_type type;
+    size_t index; /* Into the records returned by the getter of the given type */
+} redex_record_index;
+
+typedef enum {
+    REDEX_FORMAT_BINARY,
+    REDEX_FORMAT_CSV
+} redex_record_format;
+
+/* See redex::RecorderSettings. A zero size or type mask selects the default. */
+typedef struct {
+    const char *directory;
+    const char *prefix;
+    redex_record_format format;
+    uint32_t type_mask; /* Bit (1 << redex_record_type) per recorded type */
+    uint64_t max_file_size;
+    uint32_t max_file_duration_s;
+    size_t buffer_size;
+    size_t max_pending;
+} redex_recorder_settings;
+
+typedef struct {
+    uint64_t records;
+    uint64_t dropped_records;
+    uint64_t bytes;
+    uint32_t files;
+    uint32_t write_errors;
+} redex_recorder_statistics;
+
+/* All strings and arrays are owned by the batch and stay valid until it is polled again. */
+
+typedef struct {
+    const char *id;
+    const char *type;
+} redex_node_info;
+
+typedef struct {
+    const char *sensor_id;
+    const char *node_id;
+    uint32_t input;
+} redex_sensor_info;
+
+typedef struct {
+    const char *testpoint_id;
+    redex_sensor_info conductance_info;
+    redex_sensor_info orp_info;
+    redex_sensor_info ph_info;
+    redex_sensor_info potentiostat_info;
+    redex_sensor_info temperature_info;
+} redex_testpoint_info;
+
+typedef struct {
+    const char *testpoint_id;
+    double voltage;
+    double current;
+    double admittance;
+} redex_conductance_record;
+
+typedef struct {
+    const char *testpoint_id;
+    double value;
+} redex_sensor_record;
+
+typedef struct {
+    const char *testpoint_id;
+    const double *voltage;
+    const double *current;
+    size_t count;
+} redex_voltammogram_record;
+
+typedef struct {
+    redex_alarm_type type;
+    redex_alarm_severity severity;
+} redex_hub_alarm_record;
+
+typedef struct {
+    const char *node_id;
+    redex_alarm_type type;
+    redex_alarm_severity severity;
+} redex_node_alarm_record;
+
+typedef struct {
+    double temperature;
+} redex_hub_status_record;
+
+typedef struct {
+    const char *node_id;
+    double voltage;
+    double current;
+    double temperature;
+} redex_node_status_record;
+
+typedef struct {
+    const char *node_id;
+    int32_t percent;
+} redex_calibration_progress_record;
+
+typedef struct {
+    const char *node_id;
+    int32_t voltage_offset;
+    int32_t current_offset;
+    int32_t signal_offset;
+} redex_calibration_result_record;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The host name may be followed by the port of the server, as in "hub:5433". */
+REDEX_EXPORT
+redex_result redex_connect(const char *host, redex_client *client);
+
+REDEX_EXPORT
+redex_result redex_close(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_request_node_info(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_request_testpoint_info(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_start_power_monitor(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_stop_power_monitor(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_start_measurement(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_stop_measurement(redex_client client);
+
+REDEX_EXPORT
+redex_result redex_start_calibration(redex_client client);
+
+/* Passing no windows disables the statistics. */
+REDEX_EXPORT
+redex_result redex_set_statistics_windows(redex_client client,
+                                          const redex_statistics_window *windows, size_t count);
+
+/* The window is the index into the list of windows. */
+REDEX_EXPORT
+redex_result redex_get_statistics(redex_client client, const char *testpoint_id,
+                                  redex_channel channel, size_t window,
+                                  redex_statistics *statistics);
+
+REDEX_EXPORT
+redex_result redex_start_recording(redex_client client, const redex_recorder_settings *settings);
+
+REDEX_EXPORT
+redex_result redex_stop_recording(redex_client client);
+
+/* The last write error is available from redex_get_last_error() afterwards. */
+REDEX_EXPORT
+redex_result redex_get_recorder_statistics(redex_client client,
+                                           redex_recorder_statistics *statistics);
+
+REDEX_EXPORT
+redex_batch redex_batch_create(void);
+
+REDEX_EXPORT
+void redex_batch_destroy(redex_batch batch);
+
+/* Returns REDEX_TIMEOUT and an empty batch if nothing was received within the timeout. */
+REDEX_EXPORT
+redex_result redex_poll(redex_client client, redex_batch batch, uint32_t timeout_ms);
+
+/* The getters return the number of records of one kind and point records to the first one. */
+
+REDEX_EXPORT
+size_t redex_batch_get_node_info(redex_batch batch, const redex_node_info **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_testpoint_info(redex_batch batch, const redex_testpoint_info **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_status(redex_batch batch, const redex_status **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_conductance(redex_batch batch, const redex_conductance_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_orp(redex_batch batch, const redex_sensor_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_ph(redex_batch batch, const redex_sensor_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_temperature(redex_batch batch, const redex_sensor_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_voltammograms(redex_batch batch, const redex_voltammogram_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_hub_alarms(redex_batch batch, const redex_hub_alarm_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_node_alarms(redex_batch batch, const redex_node_alarm_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_hub_status(redex_batch batch, const redex_hub_status_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_node_status(redex_batch batch, const redex_node_status_record **records);
+
+REDEX_EXPORT
+size_t redex_batch_get_calibration_progress(redex_batch batch,
+                                            const redex_calibration_progress_record **records);
+REDEX_EXPORT
+size_t redex_batch_get_calibration_results(redex_batch batch,
+                                           const redex_calibration_result_record **records);
+REDEX_EXPORT
+size_t redex_batch_get_errors(redex_batch batch, const char *const **messages);
+
+/* All records of the batch in the order they were received. */
+REDEX_EXPORT
+size_t redex_batch_get_records(redex_batch batch, const redex_record_index **records);
+
+/* Records dropped since the previous batch because too many were waiting to be polled. */
+REDEX_EXPORT
+size_t redex_batch_get_dropped_records(redex_batch batch);
+
+REDEX_EXPORT
+const char* redex_get_last_error(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
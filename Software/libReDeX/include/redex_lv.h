@@ -55,6 +55,11 @@ typedef enum {
     REDEX_LV_MEASUREMENT_ERROR
 } redex_lv_status;
 
+typedef enum {
+    REDEX_LV_FILTER_FIR,
+    REDEX_LV_FILTER_IIR
+} redex_lv_filter_type;
+
 #ifdef REDEX_ARCH_WIN32
 #pragma pack(push,1)
 #endif
@@ -152,6 +157,52 @@ typedef struct
     redex_lv_string_handle message;
 } redex_lv_error_data;
 
+typedef struct {
+    int32_t count;
+    redex_lv_conductance_data entries[1];
+} **redex_lv_conductance_array_handle;
+
+typedef struct {
+    redex_lv_conductance_array_handle records;
+} redex_lv_conductance_batch_data;
+
+typedef struct {
+    int32_t count;
+    redex_lv_sensors_data entries[1];
+} **redex_lv_sensors_array_handle;
+
+typedef struct {
+    redex_lv_sensors_array_handle records;
+} redex_lv_sensors_batch_data;
+
+typedef redex_lv_sensors_batch_data redex_lv_orp_batch_data;
+typedef redex_lv_sensors_batch_data redex_lv_ph_batch_data;
+typedef redex_lv_sensors_batch_data redex_lv_temperature_batch_data;
+
+typedef struct {
+    int32_t count;
+    redex_lv_potentiostat_data entries[1];
+} **redex_lv_potentiostat_array_handle;
+
+typedef struct {
+    redex_lv_potentiostat_array_handle records;
+} redex_lv_potentiostat_batch_data;
+
+typedef struct {
+    int32_t count;
+    redex_lv_node_status_data entries[1];
+} **redex_lv_node_status_array_handle;
+
+typedef struct {
+    redex_lv_node_status_array_handle records;
+} redex_lv_node_status_batch_data;
+
+typedef struct {
+    uint64_t posted_events;
+    uint64_t coalesced_records; /* Records that were posted as part of a batch event */
+    uint64_t dropped_records;   /* Records that could not be posted */
+} redex_lv_statistics;
+
 #ifdef REDEX_ARCH_WIN32
 #pragma pack(pop)
 #endif
@@ -160,6 +211,7 @@ typedef struct
 extern "C" {
 #endif
 
+/* The host name may be followed by the port of the server, as in "hub:5433". */
 REDEX_EXPORT
 redex_lv_result redex_lv_connect(const char *host, redex_lv_handle *handle);
 
@@ -199,6 +251,34 @@ redex_lv_result redex_lv_register_node_status_event(redex_lv_handle handle,
 REDEX_EXPORT
 redex_lv_result redex_lv_register_error_event(redex_lv_handle handle,
                                               redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_conductance_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_orp_batch_event(redex_lv_handle handle,
+                                                  redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_ph_batch_event(redex_lv_handle handle,
+                                                 redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_potentiostat_batch_event(redex_lv_handle handle,
+                                                           redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_temperature_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref *ref);
+REDEX_EXPORT
+redex_lv_result redex_lv_register_node_status_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref *ref);
+
+/* While batching, records with a registered batch event are collected and posted as one event
+   every interval_ms or as soon as max_records are pending. Zero disables either limit, and
+   disables batching if both are zero. */
+REDEX_EXPORT
+redex_lv_result redex_lv_set_batching(redex_lv_handle handle,
+                                      uint32_t interval_ms, uint32_t max_records);
+REDEX_EXPORT
+redex_lv_result redex_lv_get_statistics(redex_lv_handle handle, redex_lv_statistics *statistics);
+
 REDEX_EXPORT
 redex_lv_result redex_lv_request_node_info(redex_lv_handle handle);
 
@@ -217,9 +297,18 @@ redex_lv_result redex_lv_start_measurement(redex_lv_handle handle);
 REDEX_EXPORT
 redex_lv_result redex_lv_stop_measurement(redex_lv_handle handle);
 
+REDEX_EXPORT
+redex_lv_result redex_lv_start_calibration(redex_lv_handle handle);
+
 REDEX_EXPORT
 redex_lv_result redex_lv_filter_voltammetry_data(const redex_lv_double_array_handle input,
                                                  redex_lv_double_array_handle output);
+
+REDEX_EXPORT
+redex_lv_result redex_lv_filter_voltammetry_data_with_type(
+        const redex_lv_double_array_handle input, redex_lv_double_array_handle output,
+        redex_lv_filter_type type);
+
 REDEX_EXPORT
 const char* redex_lv_get_last_error(void);
 
@@ -0,0 +1,526 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "batchqueue.h"
+#include "tcpclient.h"
+
+#include <redex.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <winsock2.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+#if defined(__linux__)
+    constexpr size_t MaximumEventCount = 64;
+    constexpr uint64_t WakeupId = ~uint64_t(0);
+#elif defined(_WIN32)
+    constexpr int PollTimeout = 100; // ms
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// All hubs are served by a single I/O thread. A hub whose connection fails is only taken out of
+// the set of watched sockets, so it never holds up the others.
+class MultiClient::Private
+{
+public:
+    struct Hub
+    {
+        std::string host;
+
+        std::mutex mutex;
+
+        // Protected by mutex. Requests and reads use a copy, so a blocking send doesn't hold up
+        // the I/O thread and a client replaced by a reconnect stays alive until they're done.
+        std::shared_ptr<TcpClient> client;
+        uint32_t generation = 0; // Identifies stale events after a reconnect
+        bool connected = false;
+        bool connecting = false;
+    };
+
+public:
+    Private(const std::vector<std::string>& hosts, bool merge);
+    ~Private();
+
+    void connect(size_t index);
+
+    template <typename Func>
+    void request(size_t index, Func func);
+
+    void run();
+    void readHub(size_t index, uint32_t generation);
+
+    void watch(size_t index, Hub& hub);
+    void unwatch(Hub& hub);
+
+    static auto systemError(const std::string& error) -> std::string;
+
+public:
+    BatchQueue queue;
+    std::vector<std::unique_ptr<Hub>> hubs;
+
+    std::thread thread;
+    std::atomic<bool> running = true;
+
+#if defined(__linux__)
+    int epoll = -1;
+    int wakeup = -1;
+#endif
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+MultiClient::Private::Private(const std::vector<std::string>& hosts, bool merge)
+    : queue(hosts.size(), merge)
+{
+    for (const std::string& host : hosts)
+    {
+        hubs.push_back(std::make_unique<Hub>());
+        hubs.back()->host = host;
+    }
+
+#if defined(__linux__)
+    epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+    if (epoll < 0)
+        throw Error(systemError("Unable to create I/O reactor:"));
+
+    wakeup = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (wakeup < 0)
+    {
+        ::close(epoll);
+        throw Error(systemError("Unable to create I/O reactor:"));
+    }
+
+    ::epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WakeupId;
+
+    ::epoll_ctl(epoll, EPOLL_CTL_ADD, wakeup, &event);
+#endif
+
+    thread = std::thread(&Private::run, this);
+
+    // Connect to all hubs at once, unreachable hubs would otherwise add up their timeouts
+    std::vector<std::future<void>> connections;
+
+    for (size_t index = 0; index < hubs.size(); ++index)
+    {
+        connections.push_back(std::async(std::launch::async, [this, index] {
+            try {
+                connect(index);
+            }
+            catch (const std::exception& e) {
+                queue.listener(index)->onError(e.what());
+            }
+        }));
+    }
+
+    for (auto& connection : connections)
+        connection.wait();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MultiClient::Private::~Private()
+{
+    running = false;
+
+#if defined(__linux__)
+    const uint64_t value = 1;
+    [[maybe_unused]] const ssize_t count = ::write(wakeup, &value, sizeof(value));
+#endif
+
+    thread.join();
+    queue.close();
+
+    // Stops the measurements on all hubs still connected
+    hubs.clear();
+
+#if defined(__linux__)
+    ::close(wakeup);
+    ::close(epoll);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::Private::connect(size_t index)
+{
+    Hub& hub = *hubs.at(index);
+
+    {
+        std::lock_guard lock(hub.mutex);
+
+        if (hub.connected || hub.connecting)
+            return;
+
+        hub.connecting = true;
+    }
+
+    std::shared_ptr<TcpClient> client;
+
+    try {
+        client = std::make_shared<TcpClient>(hub.host, queue.listener(index),
+                                             TcpClient::ReadMode::External);
+    }
+    catch (...)
+    {
+        std::lock_guard lock(hub.mutex);
+        hub.connecting = false;
+
+        throw;
+    }
+
+    std::shared_ptr<TcpClient> previous;
+
+    {
+        std::lock_guard lock(hub.mutex);
+        hub.connecting = false;
+
+        previous = std::move(hub.client);
+        hub.client = std::move(client);
+        hub.generation++;
+
+        watch(index, hub);
+        hub.connected = true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Func>
+void MultiClient::Private::request(size_t index, Func func)
+{
+    Hub& hub = *hubs.at(index);
+    std::shared_ptr<TcpClient> client;
+
+    {
+        std::lock_guard lock(hub.mutex);
+
+        if (!hub.connected)
+            throw Error("Hub " + hub.host + " is not connected.");
+
+        client = hub.client;
+    }
+
+    func(*client);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::Private::run()
+{
+#if defined(__linux__)
+    std::array<::epoll_event, MaximumEventCount> events;
+
+    while (running)
+    {
+        const int count = ::epoll_wait(epoll, events.data(), events.size(), -1);
+
+        if (count < 0 && errno != EINTR)
+            return;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const uint64_t id = events[i].data.u64;
+
+            if (id == WakeupId)
+                break;
+
+            // Hangups and errors are detected by the read as well
+            readHub(static_cast<uint32_t>(id), static_cast<uint32_t>(id >> 32));
+        }
+    }
+#elif defined(_WIN32)
+    std::vector<::WSAPOLLFD> fds;
+    std::vector<std::pair<size_t, uint32_t>> ids;
+
+    while (running)
+    {
+        fds.clear();
+        ids.clear();
+
+        for (size_t index = 0; index < hubs.size(); ++index)
+        {
+            Hub& hub = *hubs[index];
+            std::lock_guard lock(hub.mutex);
+
+            if (hub.connected)
+            {
+                fds.push_back({ static_cast<SOCKET>(hub.client->descriptor()), POLLRDNORM, 0 });
+                ids.push_back({ index, hub.generation });
+            }
+        }
+
+        if (fds.empty())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeout));
+            continue;
+        }
+
+        if (::WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), PollTimeout) <= 0)
+            continue;
+
+        for (size_t i = 0; i < fds.size(); ++i)
+        {
+            if (fds[i].revents != 0)
+                readHub(ids[i].first, ids[i].second);
+        }
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::Private::readHub(size_t index, uint32_t generation)
+{
+    Hub& hub = *hubs[index];
+    std::shared_ptr<TcpClient> client;
+
+    {
+        std::lock_guard lock(hub.mutex);
+
+        if (!hub.connected || hub.generation != generation)
+            return;
+
+        client = hub.client;
+    }
+
+    std::string error = "Connection closed by server.";
+    bool open = false;
+
+    try {
+        open = client->readAvailableData();
+    }
+    catch (const std::exception& e) {
+        error = e.what();
+    }
+
+    if (open)
+        return;
+
+    {
+        std::lock_guard lock(hub.mutex);
+
+        // Reconnected in the meantime
+        if (!hub.connected || hub.generation != generation)
+            return;
+
+        unwatch(hub);
+        hub.connected = false;
+    }
+
+    queue.listener(index)->onError(error);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::Private::watch([[maybe_unused]] size_t index, [[maybe_unused]] Hub& hub)
+{
+#if defined(__linux__)
+    const int fd = static_cast<int>(hub.client->descriptor());
+
+    ::epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = (uint64_t(hub.generation) << 32) | index;
+
+    if (::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+        throw Error(systemError("Unable to register hub connection:"));
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::Private::unwatch([[maybe_unused]] Hub& hub)
+{
+#if defined(__linux__)
+    const int fd = static_cast<int>(hub.client->descriptor());
+    ::epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::Private::systemError(const std::string& error) -> std::string
+{
+    return error + " " + std::string(std::strerror(errno)) + ".";
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// ---------------------------------------------------------------------------------------------- //
+
+MultiClient::MultiClient(const std::vector<std::string>& hosts, bool merge)
+    : d(std::make_unique<Private>(hosts, merge))
+{
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+MultiClient::~MultiClient() = default;
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::hubCount() const -> size_t
+{
+    return d->hubs.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::host(size_t hub) const -> const std::string&
+{
+    return d->hubs.at(hub)->host;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::isConnected(size_t hub) const -> bool
+{
+    Private::Hub& h = *d->hubs.at(hub);
+    std::lock_guard lock(h.mutex);
+
+    return h.connected;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::reconnect(size_t hub)
+{
+    d->connect(hub);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::requestNodeInfo(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.requestNodeInfo(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::requestTestpointInfo(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.requestTestpointInfo(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::startPowerMonitor(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.startPowerMonitor(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::stopPowerMonitor(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.stopPowerMonitor(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::startMeasurement(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.startMeasurement(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::stopMeasurement(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.stopMeasurement(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::startCalibration(size_t hub)
+{
+    d->request(hub, [](TcpClient& client) { client.startCalibration(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::setStatisticsWindows(const std::vector<StatisticsWindow>& windows)
+{
+    d->queue.statistics().setWindows(windows);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::statistics(size_t hub, const std::string& testpointId, Channel channel,
+                             size_t window) const -> Statistics
+{
+    return d->queue.statistics().statistics(hub, testpointId, channel, window);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::startRecording(const RecorderSettings& settings)
+{
+    d->queue.recorder().start(settings);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiClient::stopRecording()
+{
+    d->queue.recorder().stop();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::recorderStatistics() const -> RecorderStatistics
+{
+    return d->queue.recorder().statistics();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiClient::poll(MultiBatch& batch, std::chrono::milliseconds timeout) -> bool
+{
+    return d->queue.take(batch, timeout);
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,603 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "recorder.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <utility>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+static_assert(std::endian::native == std::endian::little, "The binary format is little-endian.");
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr auto FlushInterval = std::chrono::milliseconds(500);
+
+    constexpr char Magic[] = "REDEXREC";
+    constexpr uint32_t Version = 1;
+
+    const char* RecordTypeNames[] = {
+        "NodeInfo", "TestpointInfo", "Status", "Conductance", "OrpValue", "PhValue",
+        "Temperature", "Voltammogram", "HubAlarm", "NodeAlarm", "HubStatus", "NodeStatus",
+        "CalibrationProgress", "CalibrationResult", "Error"
+    };
+
+    const char* StatusNames[] = { "MeasurementStarted", "MeasurementStopped", "MeasurementError" };
+    const char* AlarmTypeNames[] = { "Overvoltage", "Undervoltage", "Overcurrent", "Overheat" };
+    const char* AlarmSeverityNames[] = { "Warning", "Critical" };
+
+    using Time = std::chrono::system_clock::time_point;
+
+    class BinaryEncoder
+    {
+    public:
+        explicit BinaryEncoder(std::string& out) : m_out(out) {}
+
+        void begin(Time time, size_t hub, RecordType type)
+        {
+            append(static_cast<int64_t>(std::chrono::nanoseconds(time.time_since_epoch()).count()));
+            append(static_cast<uint16_t>(hub));
+            append(static_cast<uint8_t>(type));
+
+            m_sizeOffset = m_out.size();
+            append(uint32_t(0));
+        }
+
+        void end()
+        {
+            const auto size = static_cast<uint32_t>(m_out.size() - m_sizeOffset - sizeof(uint32_t));
+            std::memcpy(m_out.data() + m_sizeOffset, &size, sizeof(size));
+        }
+
+        void string(const std::string& s)
+        {
+            const size_t size = std::min<size_t>(s.size(), UINT16_MAX);
+
+            append(static_cast<uint16_t>(size));
+            m_out.append(s.data(), size);
+        }
+
+        void number(double value) { append(value); }
+        void integer(int32_t value) { append(value); }
+        void count(size_t value) { append(static_cast<uint32_t>(value)); }
+        void enumeration(uint8_t value, const char*) { append(value); }
+
+        void numbers(std::span<const double> values)
+        {
+            m_out.append(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+        }
+
+    private:
+        template <typename T>
+        void append(T value)
+        {
+            m_out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+    private:
+        std::string& m_out;
+        size_t m_sizeOffset = 0;
+    };
+
+    class CsvEncoder
+    {
+    public:
+        explicit CsvEncoder(std::string& out) : m_out(out) {}
+
+        void begin(Time time, size_t hub, RecordType type)
+        {
+            const int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   time.time_since_epoch()).count();
+
+            char fraction[16];
+            std::snprintf(fraction, sizeof(fraction), ".%06d", static_cast<int>(us % 1000000));
+
+            append(us / 1000000);
+            m_out += fraction;
+            m_out += ',';
+            append(hub);
+            m_out += ',';
+            m_out += RecordTypeNames[static_cast<size_t>(type)];
+        }
+
+        void end() { m_out += '\n'; }
+
+        void string(const std::string& s)
+        {
+            m_out += ',';
+
+            if (s.find_first_of(",\"\r\n") == std::string::npos)
+            {
+                m_out += s;
+                return;
+            }
+
+            m_out += '"';
+
+            for (const char c : s)
+            {
+                if (c == '"')
+                    m_out += '"';
+
+                m_out += c;
+            }
+
+            m_out += '"';
+        }
+
+        void number(double value)
+        {
+            m_out += ',';
+            append(value);
+        }
+
+        void integer(int32_t value)
+        {
+            m_out += ',';
+            append(value);
+        }
+
+        void count(size_t value)
+        {
+            m_out += ',';
+            append(value);
+        }
+
+        void enumeration(uint8_t, const char* name)
+        {
+            m_out += ',';
+            m_out += name;
+        }
+
+        void numbers(std::span<const double> values)
+        {
+            for (const double value : values)
+                number(value);
+        }
+
+    private:
+        template <typename T>
+        void append(T value)
+        {
+            char buffer[32];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            m_out.append(buffer, result.ptr);
+        }
+
+    private:
+        std::string& m_out;
+    };
+
+    template <typename Encoder>
+    void sensor(Encoder& e, const SensorInfo& info)
+    {
+        e.string(info.sensorId);
+        e.string(info.nodeId);
+        e.integer(static_cast<int32_t>(info.input));
+    }
+
+    template <typename Encoder>
+    void alarm(Encoder& e, AlarmType type, AlarmSeverity severity)
+    {
+        e.enumeration(static_cast<uint8_t>(type), AlarmTypeNames[static_cast<size_t>(type)]);
+        e.enumeration(static_cast<uint8_t>(severity),
+                      AlarmSeverityNames[static_cast<size_t>(severity)]);
+    }
+
+    template <typename Encoder>
+    void encode(Encoder& e, const Batch& batch, RecordType type, size_t index)
+    {
+        switch (type)
+        {
+        case RecordType::NodeInfo:
+            e.count(batch.nodeInfo.size());
+
+            for (const NodeInfo& info : batch.nodeInfo)
+            {
+                e.string(info.id);
+                e.string(info.type);
+            }
+
+            break;
+
+        case RecordType::TestpointInfo:
+            e.count(batch.testpointInfo.size());
+
+            for (const TestpointInfo& info : batch.testpointInfo)
+            {
+                e.string(info.testpointId);
+                sensor(e, info.conductanceInfo);
+                sensor(e, info.orpInfo);
+                sensor(e, info.phInfo);
+                sensor(e, info.potentiostatInfo);
+                sensor(e, info.temperatureInfo);
+            }
+
+            break;
+
+        case RecordType::Status: {
+            const Status status = batch.statusChanges[index];
+            e.enumeration(static_cast<uint8_t>(status), StatusNames[static_cast<size_t>(status)]);
+            break;
+        }
+
+        case RecordType::Conductance: {
+            const ConductanceRecord& r = batch.conductance[index];
+            e.string(batch.testpointIds[r.testpoint]);
+            e.number(r.voltage);
+            e.number(r.current);
+            e.number(r.admittance);
+            break;
+        }
+
+        case RecordType::OrpValue:
+        case RecordType::PhValue:
+        case RecordType::Temperature: {
+            const auto& records = type == RecordType::OrpValue ? batch.orpValues
+                                : type == RecordType::PhValue  ? batch.phValues
+                                                               : batch.temperatures;
+            e.string(batch.testpointIds[records[index].testpoint]);
+            e.number(records[index].value);
+            break;
+        }
+
+        case RecordType::Voltammogram: {
+            const VoltammogramRecord& r = batch.voltammograms[index];
+            e.string(batch.testpointIds[r.testpoint]);
+            e.count(r.size);
+            e.numbers(batch.voltage(r));
+            e.numbers(batch.current(r));
+            break;
+        }
+
+        case RecordType::HubAlarm: {
+            const HubAlarmRecord& r = batch.hubAlarms[index];
+            alarm(e, r.type, r.severity);
+            break;
+        }
+
+        case RecordType::NodeAlarm: {
+            const NodeAlarmRecord& r = batch.nodeAlarms[index];
+            e.string(r.nodeId);
+            alarm(e, r.type, r.severity);
+            break;
+        }
+
+        case RecordType::HubStatus:
+            e.number(batch.hubStatus[index].temperature);
+            break;
+
+        case RecordType::NodeStatus: {
+            const NodeStatusRecord& r = batch.nodeStatus[index];
+            e.string(r.nodeId);
+            e.number(r.voltage);
+            e.number(r.current);
+            e.number(r.temperature);
+            break;
+        }
+
+        case RecordType::CalibrationProgress: {
+            const CalibrationProgressRecord& r = batch.calibrationProgress[index];
+            e.string(r.nodeId);
+            e.integer(r.percent);
+            break;
+        }
+
+        case RecordType::CalibrationResult: {
+            const CalibrationResultRecord& r = batch.calibrationResults[index];
+            e.string(r.nodeId);
+            e.integer(r.voltageOffset);
+            e.integer(r.currentOffset);
+            e.integer(r.signalOffset);
+            break;
+        }
+
+        case RecordType::Error:
+            e.string(batch.errors[index]);
+            break;
+        }
+    }
+
+    template <typename Encoder>
+    void encode(std::string& out, Time time, size_t hub, RecordType type,
+                const Batch& batch, size_t index)
+    {
+        Encoder e(out);
+        e.begin(time, hub, type);
+        encode(e, batch, type, index);
+        e.end();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+Recorder::~Recorder()
+{
+    stop();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::start(const RecorderSettings& settings)
+{
+    std::lock_guard control(m_controlMutex);
+
+    if (m_thread.joinable())
+    {
+        m_active = false;
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    if (settings.bufferSize == 0 || settings.maxPending < settings.bufferSize)
+        throw Error("The pending records must be allowed to fill at least one buffer.");
+
+    uint32_t types = 0;
+
+    for (const RecordType type : settings.types)
+        types |= 1u << static_cast<uint32_t>(type);
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        m_settings = settings;
+        m_types = settings.types.empty() ? ~0u : types;
+
+        m_pending.clear();
+        m_pending.reserve(m_settings.bufferSize);
+        m_pendingRecords = 0;
+
+        m_statistics = RecorderStatistics();
+    }
+
+    std::filesystem::create_directories(settings.directory);
+
+    openFile();
+
+    if (!m_file)
+        throw Error(m_statistics.lastError);
+
+    m_writing.reserve(m_settings.bufferSize);
+
+    m_active = true;
+    m_thread = std::thread(&Recorder::run, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::stop()
+{
+    std::lock_guard control(m_controlMutex);
+
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_active = false;
+    }
+
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Recorder::isActive() const -> bool
+{
+    return m_active;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::add(size_t hub, RecordType type, const Batch& batch, size_t index)
+{
+    const Time time = std::chrono::system_clock::now();
+
+    std::unique_lock lock(m_mutex);
+
+    if (!m_active || !(m_types & (1u << static_cast<uint32_t>(type))))
+        return;
+
+    const size_t size = m_pending.size();
+
+    if (m_settings.format == RecordFormat::Binary)
+        encode<BinaryEncoder>(m_pending, time, hub, type, batch, index);
+    else
+        encode<CsvEncoder>(m_pending, time, hub, type, batch, index);
+
+    if (m_pending.size() > m_settings.maxPending)
+    {
+        m_pending.resize(size);
+        ++m_statistics.droppedRecords;
+        return;
+    }
+
+    ++m_pendingRecords;
+
+    if (size < m_settings.bufferSize && m_pending.size() >= m_settings.bufferSize)
+    {
+        lock.unlock();
+        m_condition.notify_one();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Recorder::statistics() const -> RecorderStatistics
+{
+    std::lock_guard lock(m_mutex);
+    return m_statistics;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::run()
+{
+    std::unique_lock lock(m_mutex);
+
+    for (;;)
+    {
+        m_condition.wait_for(lock, FlushInterval, [this] {
+            return !m_active || m_pending.size() >= m_settings.bufferSize;
+        });
+
+        // Nothing is added after the recorder was stopped, so this is the last batch
+        const bool active = m_active;
+
+        std::swap(m_pending, m_writing);
+        const size_t records = std::exchange(m_pendingRecords, 0);
+
+        lock.unlock();
+
+        if (!m_writing.empty())
+            write(records);
+
+        m_writing.clear();
+
+        lock.lock();
+
+        if (!active)
+            break;
+    }
+
+    m_file.close();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::write(size_t records)
+{
+    const bool full = m_settings.maxFileSize > 0
+                   && m_fileSize + m_writing.size() > m_settings.maxFileSize;
+
+    const bool expired = m_settings.maxFileDuration.count() > 0
+                      && std::chrono::steady_clock::now() - m_fileOpened >= m_settings.maxFileDuration;
+
+    // Files are only switched between writes, so they exceed the size limit only by a single
+    // buffer that is larger than the limit
+    if (!m_file || full || expired)
+        openFile();
+
+    if (!m_file)
+    {
+        std::lock_guard lock(m_mutex);
+        m_statistics.droppedRecords += records;
+        return;
+    }
+
+    m_file.write(m_writing.data(), static_cast<std::streamsize>(m_writing.size()));
+    m_file.flush();
+
+    if (!m_file)
+    {
+        reportError("Writing the recording failed.", records);
+        return;
+    }
+
+    m_fileSize += m_writing.size();
+
+    std::lock_guard lock(m_mutex);
+    m_statistics.records += records;
+    m_statistics.bytes += m_writing.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::openFile()
+{
+    if (m_file.is_open())
+        m_file.close();
+
+    m_file.clear();
+
+    const std::time_t now = std::time(nullptr);
+    std::tm local = {};
+
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+
+    char time[32];
+    std::strftime(time, sizeof(time), "%Y%m%d_%H%M%S", &local);
+
+    char sequence[16];
+    std::snprintf(sequence, sizeof(sequence), "_%04zu", m_statistics.files);
+
+    const std::string extension = m_settings.format == RecordFormat::Binary ? ".rdx" : ".csv";
+    const std::filesystem::path path = std::filesystem::path(m_settings.directory)
+                                     / (m_settings.prefix + "_" + time + sequence + extension);
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+
+    if (!m_file)
+    {
+        reportError("Unable to create " + path.string() + ".", 0);
+        return;
+    }
+
+    if (m_settings.format == RecordFormat::Binary)
+    {
+        m_file.write(Magic, sizeof(Magic) - 1);
+        m_file.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+    }
+    else
+    {
+        m_file << "time,hub,type,fields\n";
+    }
+
+    m_fileSize = static_cast<uint64_t>(m_file.tellp());
+    m_fileOpened = std::chrono::steady_clock::now();
+
+    std::lock_guard lock(m_mutex);
+    ++m_statistics.files;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Recorder::reportError(const std::string& error, size_t droppedRecords)
+{
+    m_file.close();
+
+    std::lock_guard lock(m_mutex);
+
+    m_statistics.droppedRecords += droppedRecords;
+    ++m_statistics.writeErrors;
+    m_statistics.lastError = error;
+}
+
+// ---------------------------------------------------------------------------------------------- //
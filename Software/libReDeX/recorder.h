@@ -0,0 +1,87 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <redex.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace redex {
+
+// Writes records to files on its own thread. Records are serialized into a memory buffer by the
+// receiving thread, which never waits for the disk. Thread-safe.
+class Recorder
+{
+public:
+    Recorder() = default;
+    ~Recorder();
+
+    // Throws if the first file cannot be created
+    void start(const RecorderSettings& settings);
+
+    // Writes the remaining records and closes the file
+    void stop();
+
+    auto isActive() const -> bool;
+
+    // Record as appended to the batch with the given index
+    void add(size_t hub, RecordType type, const Batch& batch, size_t index);
+
+    auto statistics() const -> RecorderStatistics;
+
+private:
+    void run();
+    void write(size_t records);
+    void openFile();
+
+    void reportError(const std::string& error, size_t droppedRecords);
+
+private:
+    std::mutex m_controlMutex; // Serializes start() and stop()
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    // Protected by m_mutex
+    std::atomic<bool> m_active = false;
+    RecorderSettings m_settings;
+    uint32_t m_types = 0; // Bit mask of RecordType
+    std::string m_pending;
+    size_t m_pendingRecords = 0;
+    RecorderStatistics m_statistics;
+
+    // Only used by the writer thread
+    std::string m_writing;
+    std::ofstream m_file;
+    uint64_t m_fileSize = 0;
+    std::chrono::steady_clock::time_point m_fileOpened;
+
+    std::thread m_thread;
+};
+
+} // End of namespace redex
@@ -21,11 +21,16 @@
 //                                                                                                //
 // ============================================================================================== //
 
+#include "batchqueue.h"
 #include "tcpclient.h"
 #include "voltammogramfilter.h"
 
 #include <redex.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 // ---------------------------------------------------------------------------------------------- //
 
 using namespace redex;
@@ -35,12 +40,68 @@ using namespace redex;
 class Client::Private
 {
 public:
-    Private(const std::string& host, Listener* listener) : client(host, listener) {}
+    Private(const std::string& host, Listener* listener);
+    ~Private();
+
+    void dispatch();
+
+    BatchQueue queue;
     TcpClient client;
+
+    Listener* listener;
+
+    std::thread thread;
+    std::atomic<bool> running = false;
 };
 
 // ---------------------------------------------------------------------------------------------- //
 
+Client::Private::Private(const std::string& host, Listener* listener)
+    : client(host, queue.listener()),
+      listener(listener)
+{
+    if (listener)
+    {
+        running = true;
+        thread = std::thread(&Private::dispatch, this);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+Client::Private::~Private()
+{
+    running = false;
+    queue.close();
+
+    if (thread.joinable())
+        thread.join();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Client::Private::dispatch()
+{
+    static constexpr auto Timeout = std::chrono::milliseconds(100);
+
+    Batch batch;
+
+    while (running)
+    {
+        if (queue.take(batch, Timeout))
+            BatchQueue::dispatch(batch, listener);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+Client::Client(const std::string& host)
+    : d(std::make_unique<Private>(host, nullptr))
+{
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 Client::Client(const std::string& host, Listener* listener)
     : d(std::make_unique<Private>(host, listener))
 {
@@ -52,6 +113,16 @@ Client::~Client() = default;
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto Client::poll(Batch& batch, std::chrono::milliseconds timeout) -> bool
+{
+    if (d->listener)
+        throw Error("Polling is not available for a client with listener.");
+
+    return d->queue.take(batch, timeout);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void Client::requestNodeInfo()
 {
     d->client.requestNodeInfo();
@@ -94,10 +165,145 @@ void Client::stopMeasurement()
 
 // ---------------------------------------------------------------------------------------------- //
 
-void Client::filterVoltammetryData(std::span<const double> input, std::span<double> output)
+void Client::startCalibration()
+{
+    d->client.startCalibration();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Client::setStatisticsWindows(const std::vector<StatisticsWindow>& windows)
 {
-    static VoltammogramFilter filter;
-    filter.apply(input, output);
+    d->queue.statistics().setWindows(windows);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Client::statistics(const std::string& testpointId, Channel channel,
+                        size_t window) const -> Statistics
+{
+    return d->queue.statistics().statistics(0, testpointId, channel, window);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Client::startRecording(const RecorderSettings& settings)
+{
+    d->queue.recorder().start(settings);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Client::stopRecording()
+{
+    d->queue.recorder().stop();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Client::recorderStatistics() const -> RecorderStatistics
+{
+    return d->queue.recorder().statistics();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Client::filterVoltammetryData(std::span<const double> input, std::span<double> output,
+                                   FilterType type)
+{
+    static const VoltammogramFilter firFilter(VoltammogramFilter::Type::Fir);
+    static const VoltammogramFilter iirFilter(VoltammogramFilter::Type::Iir);
+
+    if (type == FilterType::Iir)
+        iirFilter.apply(input, output);
+    else
+        firFilter.apply(input, output);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Batch::clear()
+{
+    nodeInfoReceived = false;
+    testpointInfoReceived = false;
+
+    nodeInfo.clear();
+    testpointInfo.clear();
+    statusChanges.clear();
+    conductance.clear();
+    orpValues.clear();
+    phValues.clear();
+    temperatures.clear();
+    voltammograms.clear();
+    voltammogramVoltage.clear();
+    voltammogramCurrent.clear();
+    hubAlarms.clear();
+    nodeAlarms.clear();
+    hubStatus.clear();
+    nodeStatus.clear();
+    calibrationProgress.clear();
+    calibrationResults.clear();
+    errors.clear();
+    testpointIds.clear();
+    records.clear();
+
+    droppedRecords = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Batch::empty() const -> bool
+{
+    return !nodeInfoReceived && !testpointInfoReceived && statusChanges.empty()
+        && conductance.empty() && orpValues.empty() && phValues.empty() && temperatures.empty()
+        && voltammograms.empty() && hubAlarms.empty() && nodeAlarms.empty() && hubStatus.empty()
+        && nodeStatus.empty() && calibrationProgress.empty() && calibrationResults.empty()
+        && errors.empty() && droppedRecords == 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Batch::addTestpointId(const std::string& id) -> size_t
+{
+    // There are only a few testpoints, so a linear search beats hashing
+    const auto it = std::find(testpointIds.begin(), testpointIds.end(), id);
+
+    if (it != testpointIds.end())
+        return it - testpointIds.begin();
+
+    testpointIds.push_back(id);
+    return testpointIds.size() - 1;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Batch::voltage(const VoltammogramRecord& record) const -> std::span<const double>
+{
+    return std::span(voltammogramVoltage).subspan(record.offset, record.size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Batch::current(const VoltammogramRecord& record) const -> std::span<const double>
+{
+    return std::span(voltammogramCurrent).subspan(record.offset, record.size);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void MultiBatch::clear()
+{
+    for (Batch& batch : hubs)
+        batch.clear();
+
+    merged.clear();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto MultiBatch::empty() const -> bool
+{
+    return std::all_of(hubs.begin(), hubs.end(), [](const Batch& batch) { return batch.empty(); });
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -151,6 +357,14 @@ void Listener::onNodeStatusReceived(const std::string&, double, double, double)
 
 // ---------------------------------------------------------------------------------------------- //
 
+void Listener::onCalibrationProgress(const std::string&, int) {}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Listener::onCalibrationResult(const std::string&, int, int, int) {}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void Listener::onError(const std::string&) {}
 
 // ---------------------------------------------------------------------------------------------- //
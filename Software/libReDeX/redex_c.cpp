@@ -0,0 +1,555 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include <redex.h>
+#include <redex_c.h>
+
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    thread_local std::string g_lastError = "No error.";
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct _redex_client
+{
+    explicit _redex_client(const char* host) : client(host) {}
+    Client client;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+struct _redex_batch
+{
+    void update();
+
+    Batch batch;
+
+    // Views into the batch, rebuilt after each poll
+    std::vector<redex_node_info> nodeInfo;
+    std::vector<redex_testpoint_info> testpointInfo;
+    std::vector<redex_status> statusChanges;
+    std::vector<redex_conductance_record> conductance;
+    std::vector<redex_sensor_record> orpValues;
+    std::vector<redex_sensor_record> phValues;
+    std::vector<redex_sensor_record> temperatures;
+    std::vector<redex_voltammogram_record> voltammograms;
+    std::vector<redex_hub_alarm_record> hubAlarms;
+    std::vector<redex_node_alarm_record> nodeAlarms;
+    std::vector<redex_hub_status_record> hubStatus;
+    std::vector<redex_node_status_record> nodeStatus;
+    std::vector<redex_calibration_progress_record> calibrationProgress;
+    std::vector<redex_calibration_result_record> calibrationResults;
+    std::vector<const char*> errors;
+    std::vector<redex_record_index> records;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Func>
+auto tryRequest(Func func) -> redex_result
+{
+    try {
+        func();
+        return REDEX_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        g_lastError = e.what();
+        return REDEX_CONNECTION_LOST;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T, typename U, typename Func>
+void makeView(std::vector<T>& view, const std::vector<U>& records, Func convert)
+{
+    view.resize(records.size());
+
+    for (size_t i = 0; i < records.size(); ++i)
+        view[i] = convert(records[i]);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+auto getView(const std::vector<T>& view, const T** records) -> size_t
+{
+    *records = view.data();
+    return view.size();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static auto toSensorInfo(const SensorInfo& info) -> redex_sensor_info
+{
+    return { info.sensorId.c_str(), info.nodeId.c_str(), static_cast<uint32_t>(info.input) };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void _redex_batch::update()
+{
+    makeView(nodeInfo, batch.nodeInfo, [](const NodeInfo& info) -> redex_node_info {
+        return { info.id.c_str(), info.type.c_str() };
+    });
+
+    makeView(testpointInfo, batch.testpointInfo, [](const TestpointInfo& info) {
+        return redex_testpoint_info {
+            info.testpointId.c_str(),
+            toSensorInfo(info.conductanceInfo),
+            toSensorInfo(info.orpInfo),
+            toSensorInfo(info.phInfo),
+            toSensorInfo(info.potentiostatInfo),
+            toSensorInfo(info.temperatureInfo)
+        };
+    });
+
+    makeView(statusChanges, batch.statusChanges, [](Status status) -> redex_status {
+        if (status == Status::MeasurementStarted)
+            return REDEX_MEASUREMENT_STARTED;
+
+        if (status == Status::MeasurementStopped)
+            return REDEX_MEASUREMENT_STOPPED;
+
+        return REDEX_MEASUREMENT_ERROR;
+    });
+
+    const auto testpointId = [this](size_t testpoint) {
+        return batch.testpointIds[testpoint].c_str();
+    };
+
+    const auto toSensorRecord = [&](const SensorRecord& r) -> redex_sensor_record {
+        return { testpointId(r.testpoint), r.value };
+    };
+
+    makeView(conductance, batch.conductance, [&](const ConductanceRecord& r) {
+        return redex_conductance_record {
+            testpointId(r.testpoint), r.voltage, r.current, r.admittance
+        };
+    });
+
+    makeView(orpValues, batch.orpValues, toSensorRecord);
+    makeView(phValues, batch.phValues, toSensorRecord);
+    makeView(temperatures, batch.temperatures, toSensorRecord);
+
+    makeView(voltammograms, batch.voltammograms, [&](const VoltammogramRecord& r) {
+        return redex_voltammogram_record {
+            testpointId(r.testpoint), batch.voltage(r).data(), batch.current(r).data(), r.size
+        };
+    });
+
+    makeView(hubAlarms, batch.hubAlarms, [](const HubAlarmRecord& r) {
+        return redex_hub_alarm_record {
+            static_cast<redex_alarm_type>(r.type),
+            static_cast<redex_alarm_severity>(r.severity)
+        };
+    });
+
+    makeView(nodeAlarms, batch.nodeAlarms, [](const NodeAlarmRecord& r) {
+        return redex_node_alarm_record {
+            r.nodeId.c_str(),
+            static_cast<redex_alarm_type>(r.type),
+            static_cast<redex_alarm_severity>(r.severity)
+        };
+    });
+
+    makeView(hubStatus, batch.hubStatus, [](const HubStatusRecord& r) {
+        return redex_hub_status_record { r.temperature };
+    });
+
+    makeView(nodeStatus, batch.nodeStatus, [](const NodeStatusRecord& r) {
+        return redex_node_status_record {
+            r.nodeId.c_str(), r.voltage, r.current, r.temperature
+        };
+    });
+
+    makeView(calibrationProgress, batch.calibrationProgress,
+             [](const CalibrationProgressRecord& r) {
+        return redex_calibration_progress_record { r.nodeId.c_str(), r.percent };
+    });
+
+    makeView(calibrationResults, batch.calibrationResults, [](const CalibrationResultRecord& r) {
+        return redex_calibration_result_record {
+            r.nodeId.c_str(), r.voltageOffset, r.currentOffset, r.signalOffset
+        };
+    });
+
+    makeView(errors, batch.errors, [](const std::string& msg) {
+        return msg.c_str();
+    });
+
+    makeView(records, batch.records, [](const RecordIndex& r) {
+        return redex_record_index { static_cast<redex_record_type>(r.type), r.index };
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_connect(const char* host, redex_client* client)
+{
+    try {
+        *client = new _redex_client(host);
+        return REDEX_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        g_lastError = e.what();
+
+        *client = nullptr;
+        return REDEX_CONNECTION_FAILED;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_close(redex_client client)
+{
+    delete client;
+    return REDEX_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_request_node_info(redex_client client)
+{
+    return tryRequest([&] { client->client.requestNodeInfo(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_request_testpoint_info(redex_client client)
+{
+    return tryRequest([&] { client->client.requestTestpointInfo(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_start_power_monitor(redex_client client)
+{
+    return tryRequest([&] { client->client.startPowerMonitor(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_stop_power_monitor(redex_client client)
+{
+    return tryRequest([&] { client->client.stopPowerMonitor(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_start_measurement(redex_client client)
+{
+    return tryRequest([&] { client->client.startMeasurement(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_stop_measurement(redex_client client)
+{
+    return tryRequest([&] { client->client.stopMeasurement(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_start_calibration(redex_client client)
+{
+    return tryRequest([&] { client->client.startCalibration(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_set_statistics_windows(redex_client client,
+                                          const redex_statistics_window* windows, size_t count)
+{
+    std::vector<StatisticsWindow> limits(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        limits[i].count = windows[i].count;
+        limits[i].duration = std::chrono::milliseconds(windows[i].duration_ms);
+    }
+
+    try {
+        client->client.setStatisticsWindows(limits);
+        return REDEX_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        g_lastError = e.what();
+        return REDEX_INVALID_ARGUMENT;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_get_statistics(redex_client client, const char* testpoint_id,
+                                  redex_channel channel, size_t window,
+                                  redex_statistics* statistics)
+{
+    try {
+        const Statistics s = client->client.statistics(testpoint_id,
+                                                       static_cast<Channel>(channel), window);
+
+        *statistics = {
+            s.count, s.mean, s.standardDeviation, s.minimum, s.maximum, s.slope
+        };
+
+        return REDEX_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        g_lastError = e.what();
+        return REDEX_INVALID_ARGUMENT;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_start_recording(redex_client client, const redex_recorder_settings* settings)
+{
+    RecorderSettings s;
+    s.directory = settings->directory;
+
+    if (settings->prefix)
+        s.prefix = settings->prefix;
+
+    s.format = static_cast<RecordFormat>(settings->format);
+
+    for (uint32_t type = 0; type <= REDEX_RECORD_ERROR; ++type)
+    {
+        if (settings->type_mask & (1u << type))
+            s.types.push_back(static_cast<RecordType>(type));
+    }
+
+    s.maxFileSize = settings->max_file_size;
+    s.maxFileDuration = std::chrono::seconds(settings->max_file_duration_s);
+
+    if (settings->buffer_size > 0)
+        s.bufferSize = settings->buffer_size;
+
+    if (settings->max_pending > 0)
+        s.maxPending = settings->max_pending;
+
+    try {
+        client->client.startRecording(s);
+        return REDEX_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        g_lastError = e.what();
+        return REDEX_INVALID_ARGUMENT;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_stop_recording(redex_client client)
+{
+    client->client.stopRecording();
+    return REDEX_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_get_recorder_statistics(redex_client client,
+                                           redex_recorder_statistics* statistics)
+{
+    const RecorderStatistics s = client->client.recorderStatistics();
+
+    *statistics = {
+        s.records, s.droppedRecords, s.bytes,
+        static_cast<uint32_t>(s.files), static_cast<uint32_t>(s.writeErrors)
+    };
+
+    if (s.writeErrors > 0)
+        g_lastError = s.lastError;
+
+    return REDEX_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_batch redex_batch_create()
+{
+    return new _redex_batch;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void redex_batch_destroy(redex_batch batch)
+{
+    delete batch;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_result redex_poll(redex_client client, redex_batch batch, uint32_t timeout_ms)
+{
+    const bool received = client->client.poll(batch->batch, std::chrono::milliseconds(timeout_ms));
+
+    if (!received)
+        batch->batch.clear();
+
+    batch->update();
+    return received ? REDEX_SUCCESS : REDEX_TIMEOUT;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_node_info(redex_batch batch, const redex_node_info** records)
+{
+    return getView(batch->nodeInfo, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_testpoint_info(redex_batch batch, const redex_testpoint_info** records)
+{
+    return getView(batch->testpointInfo, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_status(redex_batch batch, const redex_status** records)
+{
+    return getView(batch->statusChanges, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_conductance(redex_batch batch, const redex_conductance_record** records)
+{
+    return getView(batch->conductance, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_orp(redex_batch batch, const redex_sensor_record** records)
+{
+    return getView(batch->orpValues, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_ph(redex_batch batch, const redex_sensor_record** records)
+{
+    return getView(batch->phValues, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_temperature(redex_batch batch, const redex_sensor_record** records)
+{
+    return getView(batch->temperatures, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_voltammograms(redex_batch batch, const redex_voltammogram_record** records)
+{
+    return getView(batch->voltammograms, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_hub_alarms(redex_batch batch, const redex_hub_alarm_record** records)
+{
+    return getView(batch->hubAlarms, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_node_alarms(redex_batch batch, const redex_node_alarm_record** records)
+{
+    return getView(batch->nodeAlarms, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_hub_status(redex_batch batch, const redex_hub_status_record** records)
+{
+    return getView(batch->hubStatus, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_node_status(redex_batch batch, const redex_node_status_record** records)
+{
+    return getView(batch->nodeStatus, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_calibration_progress(redex_batch batch,
+                                            const redex_calibration_progress_record** records)
+{
+    return getView(batch->calibrationProgress, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_calibration_results(redex_batch batch,
+                                           const redex_calibration_result_record** records)
+{
+    return getView(batch->calibrationResults, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_errors(redex_batch batch, const char* const** messages)
+{
+    return getView(batch->errors, messages);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_records(redex_batch batch, const redex_record_index** records)
+{
+    return getView(batch->records, records);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+size_t redex_batch_get_dropped_records(redex_batch batch)
+{
+    return batch->batch.droppedRecords;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+const char* redex_get_last_error()
+{
+    return g_lastError.c_str();
+}
+
+// ---------------------------------------------------------------------------------------------- //
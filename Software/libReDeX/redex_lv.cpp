@@ -28,7 +28,13 @@
 
 #include <extcode.h> // LabVIEW API
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -38,13 +44,61 @@ using namespace redex;
 
 namespace {
     std::string g_lastError = "";
+
+    // Bounds the memory used while LabVIEW is not keeping up with the batches
+    constexpr size_t MaximumPendingRecords = 100000;
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
+// LabVIEW copies the event data when posting, so the same handles can be used for every event.
+// They are only ever grown and disposed of together with the pool.
+class HandlePool
+{
+public:
+    HandlePool() = default;
+    ~HandlePool();
+
+    HandlePool(const HandlePool&) = delete;
+    auto operator=(const HandlePool&) = delete;
+
+    auto makeString(size_t index, const std::string& str) -> redex_lv_string_handle;
+    auto makeDoubles(size_t index, std::span<const double> values) -> redex_lv_double_array_handle;
+
+    template <typename Handle>
+    auto makeArray(size_t index, size_t count) -> Handle;
+
+private:
+    struct Entry
+    {
+        UHandle handle = nullptr;
+        size_t capacity = 0;
+    };
+
+    static auto entry(std::vector<Entry>& entries, size_t index) -> Entry&;
+    static void reserve(Entry& entry, size_t size);
+
+private:
+    std::vector<Entry> m_strings;
+    std::vector<Entry> m_doubles;
+    std::vector<Entry> m_arrays;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
 class ListenerImpl : public redex::Listener
 {
 public:
+    struct Statistics
+    {
+        std::atomic<uint64_t> postedEvents = 0;
+        std::atomic<uint64_t> coalescedRecords = 0;
+        std::atomic<uint64_t> droppedRecords = 0;
+    };
+
+public:
+    ~ListenerImpl();
+
     void setNodeInfoRef(redex_lv_event_ref* ref);
     void setTestpointInfoRef(redex_lv_event_ref* ref);
     void setStatusRef(redex_lv_event_ref* ref);
@@ -57,6 +111,17 @@ public:
     void setNodeStatusRef(redex_lv_event_ref* ref);
     void setErrorRef(redex_lv_event_ref* ref);
 
+    void setConductanceBatchRef(redex_lv_event_ref* ref);
+    void setOrpBatchRef(redex_lv_event_ref* ref);
+    void setPhBatchRef(redex_lv_event_ref* ref);
+    void setPotentiostatBatchRef(redex_lv_event_ref* ref);
+    void setTemperatureBatchRef(redex_lv_event_ref* ref);
+    void setNodeStatusBatchRef(redex_lv_event_ref* ref);
+
+    void setBatching(std::chrono::milliseconds interval, size_t maximumCount);
+
+    auto statistics() const -> const Statistics&;
+
 private:
     void onNodeInfoReceived(std::span<const NodeInfo> info) override;
 
@@ -84,7 +149,18 @@ private:
 
     void onError(const std::string& msg) override;
 
-    static auto makeString(const std::string& str) -> redex_lv_string_handle;
+    void postSensorValue(redex_lv_event_ref ref, const std::string& id, double value);
+    auto post(redex_lv_event_ref ref, void* data, size_t recordCount = 1) -> bool;
+
+    // Returns false if the record is to be posted on its own
+    template <typename Func>
+    auto enqueue(redex_lv_event_ref batchRef, Func func) -> bool;
+
+    void flush();
+    void postBatch(const Batch& batch);
+
+    template <typename Data, typename Record, typename Func>
+    void postRecords(redex_lv_event_ref ref, const std::vector<Record>& records, Func makeEntry);
 
 private:
     redex_lv_event_ref m_nodeInfoRef = 0;
@@ -98,6 +174,38 @@ private:
     redex_lv_event_ref m_hubStatusRef = 0;
     redex_lv_event_ref m_nodeStatusRef = 0;
     redex_lv_event_ref m_errorRef = 0;
+
+    redex_lv_event_ref m_conductanceBatchRef = 0;
+    redex_lv_event_ref m_orpBatchRef = 0;
+    redex_lv_event_ref m_phBatchRef = 0;
+    redex_lv_event_ref m_potentiostatBatchRef = 0;
+    redex_lv_event_ref m_temperatureBatchRef = 0;
+    redex_lv_event_ref m_nodeStatusBatchRef = 0;
+
+    HandlePool m_pool; // Only used on the client thread
+    HandlePool m_batchPool; // Only used on the flush thread
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    // Protected by m_mutex
+    Batch m_pending;
+    size_t m_pendingCount = 0;
+    bool m_batching = false;
+
+    // Batches that reached the maximum count, in the order they are to be posted
+    std::deque<Batch> m_ready;
+    size_t m_readyCount = 0;
+
+    std::vector<Batch> m_spare; // Posted batches, kept for their capacity
+
+    std::chrono::milliseconds m_interval = {};
+    size_t m_maximumCount = 0;
+
+    std::thread m_thread;
+    Batch m_flushing;
+
+    Statistics m_statistics;
 };
 
 // ---------------------------------------------------------------------------------------------- //
@@ -251,6 +359,80 @@ redex_lv_result redex_lv_register_error_event(redex_lv_handle handle, redex_lv_e
 
 // ---------------------------------------------------------------------------------------------- //
 
+redex_lv_result redex_lv_register_conductance_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref* ref)
+{
+    handle->listener->setConductanceBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_register_orp_batch_event(redex_lv_handle handle, redex_lv_event_ref* ref)
+{
+    handle->listener->setOrpBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_register_ph_batch_event(redex_lv_handle handle, redex_lv_event_ref* ref)
+{
+    handle->listener->setPhBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_register_potentiostat_batch_event(redex_lv_handle handle,
+                                                           redex_lv_event_ref* ref)
+{
+    handle->listener->setPotentiostatBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_register_temperature_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref* ref)
+{
+    handle->listener->setTemperatureBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_register_node_status_batch_event(redex_lv_handle handle,
+                                                          redex_lv_event_ref* ref)
+{
+    handle->listener->setNodeStatusBatchRef(ref);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_set_batching(redex_lv_handle handle,
+                                      uint32_t interval_ms, uint32_t max_records)
+{
+    handle->listener->setBatching(std::chrono::milliseconds(interval_ms), max_records);
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_get_statistics(redex_lv_handle handle, redex_lv_statistics* statistics)
+{
+    const ListenerImpl::Statistics& stats = handle->listener->statistics();
+
+    statistics->posted_events = stats.postedEvents;
+    statistics->coalesced_records = stats.coalescedRecords;
+    statistics->dropped_records = stats.droppedRecords;
+
+    return REDEX_LV_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 redex_lv_result redex_lv_request_node_info(redex_lv_handle handle)
 {
     return tryRequest([handle]{ handle->client->requestNodeInfo(); });
@@ -293,10 +475,27 @@ redex_lv_result redex_lv_stop_measurement(redex_lv_handle handle)
 
 // ---------------------------------------------------------------------------------------------- //
 
+redex_lv_result redex_lv_start_calibration(redex_lv_handle handle)
+{
+    return tryRequest([handle]{ handle->client->startCalibration(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 redex_lv_result redex_lv_filter_voltammetry_data(const redex_lv_double_array_handle input,
                                                  redex_lv_double_array_handle output)
 {
-    static VoltammogramFilter filter;
+    return redex_lv_filter_voltammetry_data_with_type(input, output, REDEX_LV_FILTER_FIR);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+redex_lv_result redex_lv_filter_voltammetry_data_with_type(
+        const redex_lv_double_array_handle input, redex_lv_double_array_handle output,
+        redex_lv_filter_type type)
+{
+    static const VoltammogramFilter firFilter(VoltammogramFilter::Type::Fir);
+    static const VoltammogramFilter iirFilter(VoltammogramFilter::Type::Iir);
 
     NumericArrayResize(::fD, 1, reinterpret_cast<UHandle*>(&output), (*input)->count);
     (*output)->count = (*input)->count;
@@ -305,7 +504,11 @@ redex_lv_result redex_lv_filter_voltammetry_data(const redex_lv_double_array_han
         std::span<const double> in((*input)->entries, (*input)->count);
         std::span<double> out((*output)->entries, (*output)->count);
 
-        filter.apply(in, out);
+        if (type == REDEX_LV_FILTER_IIR)
+            iirFilter.apply(in, out);
+        else
+            firFilter.apply(in, out);
+
         return REDEX_LV_SUCCESS;
     }
     catch (const std::exception& e)
@@ -325,6 +528,110 @@ const char* redex_lv_get_last_error()
 // ---------------------------------------------------------------------------------------------- //
 // ---------------------------------------------------------------------------------------------- //
 
+HandlePool::~HandlePool()
+{
+    for (auto* entries : { &m_strings, &m_doubles, &m_arrays })
+    {
+        for (const Entry& entry : *entries)
+            DSDisposeHandle(entry.handle);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HandlePool::makeString(size_t index, const std::string& str) -> redex_lv_string_handle
+{
+    Entry& e = entry(m_strings, index);
+
+    const size_t length = str.length();
+    reserve(e, sizeof(int32_t) + length);
+
+    auto string = reinterpret_cast<redex_lv_string_handle>(e.handle);
+
+    (*string)->count = static_cast<int32_t>(length);
+    MoveBlock(str.c_str(), (*string)->bytes, length);
+
+    return string;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HandlePool::makeDoubles(size_t index,
+                             std::span<const double> values) -> redex_lv_double_array_handle
+{
+    Entry& e = entry(m_doubles, index);
+
+    if (e.capacity < values.size() || !e.handle)
+    {
+        if (NumericArrayResize(::fD, 1, &e.handle, values.size()) != mgNoErr)
+            throw std::bad_alloc();
+
+        e.capacity = values.size();
+    }
+
+    auto array = reinterpret_cast<redex_lv_double_array_handle>(e.handle);
+
+    (*array)->count = static_cast<int32_t>(values.size());
+    MoveBlock(values.data(), (*array)->entries, values.size() * sizeof(double));
+
+    return array;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Handle>
+auto HandlePool::makeArray(size_t index, size_t count) -> Handle
+{
+    using Array = std::remove_pointer_t<std::remove_pointer_t<Handle>>;
+    using Element = std::remove_extent_t<decltype(Array::entries)>;
+
+    Entry& e = entry(m_arrays, index);
+    reserve(e, offsetof(Array, entries) + count * sizeof(Element));
+
+    auto array = reinterpret_cast<Handle>(e.handle);
+    (*array)->count = static_cast<int32_t>(count);
+
+    return array;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto HandlePool::entry(std::vector<Entry>& entries, size_t index) -> Entry&
+{
+    if (index >= entries.size())
+        entries.resize(index + 1);
+
+    return entries[index];
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void HandlePool::reserve(Entry& entry, size_t size)
+{
+    if (entry.handle && entry.capacity >= size)
+        return;
+
+    if (!entry.handle)
+        entry.handle = DSNewHandle(size);
+    else if (DSSetHandleSize(entry.handle, size) != mgNoErr)
+        throw std::bad_alloc();
+
+    if (!entry.handle)
+        throw std::bad_alloc();
+
+    entry.capacity = size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// ---------------------------------------------------------------------------------------------- //
+
+ListenerImpl::~ListenerImpl()
+{
+    setBatching({}, 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void ListenerImpl::setNodeInfoRef(redex_lv_event_ref* ref)
 {
     m_nodeInfoRef = *ref;
@@ -402,99 +709,140 @@ void ListenerImpl::setErrorRef(redex_lv_event_ref* ref)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void ListenerImpl::onNodeInfoReceived(std::span<const NodeInfo> infos)
+void ListenerImpl::setConductanceBatchRef(redex_lv_event_ref* ref)
 {
-    static auto makeNodeInfo = [](const NodeInfo& info) -> redex_lv_node_info
-    {
-        redex_lv_node_info lvInfo = {};
+    m_conductanceBatchRef = *ref;
+}
 
-        lvInfo.id = makeString(info.id);
-        lvInfo.type = makeString(info.type);
+// ---------------------------------------------------------------------------------------------- //
 
-        return lvInfo;
-    };
+void ListenerImpl::setOrpBatchRef(redex_lv_event_ref* ref)
+{
+    m_orpBatchRef = *ref;
+}
 
-    static auto freeNodeInfo = [](const redex_lv_node_info& lvInfo)
-    {
-        DSDisposeHandle(lvInfo.id);
-        DSDisposeHandle(lvInfo.type);
-    };
+// ---------------------------------------------------------------------------------------------- //
 
-    if (!m_nodeInfoRef)
-        return;
+void ListenerImpl::setPhBatchRef(redex_lv_event_ref* ref)
+{
+    m_phBatchRef = *ref;
+}
 
-    UHandle handle = DSNewHandle(sizeof(int32) + infos.size() * sizeof(redex_lv_node_info));
+// ---------------------------------------------------------------------------------------------- //
 
-    redex_lv_node_info_data data = {};
-    data.infos = reinterpret_cast<redex_lv_node_info_array_handle>(handle);
+void ListenerImpl::setPotentiostatBatchRef(redex_lv_event_ref* ref)
+{
+    m_potentiostatBatchRef = *ref;
+}
 
-    (*data.infos)->count = static_cast<int32_t>(infos.size());
+// ---------------------------------------------------------------------------------------------- //
 
-    for (size_t i = 0; i < infos.size(); ++i)
+void ListenerImpl::setTemperatureBatchRef(redex_lv_event_ref* ref)
+{
+    m_temperatureBatchRef = *ref;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void ListenerImpl::setNodeStatusBatchRef(redex_lv_event_ref* ref)
+{
+    m_nodeStatusBatchRef = *ref;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void ListenerImpl::setBatching(std::chrono::milliseconds interval, size_t maximumCount)
+{
+    // The flush thread posts the remaining records before exiting
+    if (m_thread.joinable())
     {
-        const NodeInfo& info = infos[i];
-        assert(!info.id.empty());
+        {
+            std::lock_guard lock(m_mutex);
+            m_batching = false;
+        }
 
-        (*data.infos)->entries[i] = makeNodeInfo(info);
+        m_condition.notify_all();
+        m_thread.join();
     }
 
-    PostLVUserEvent(m_nodeInfoRef, &data);
+    if (interval.count() == 0 && maximumCount == 0)
+        return;
 
-    for (size_t i = 0; i < infos.size(); ++i)
-        freeNodeInfo((*data.infos)->entries[i]);
+    {
+        std::lock_guard lock(m_mutex);
 
-    DSDisposeHandle(handle);
+        m_interval = interval;
+        m_maximumCount = maximumCount;
+        m_batching = true;
+    }
+
+    m_thread = std::thread(&ListenerImpl::flush, this);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void ListenerImpl::onTestpointInfoReceived(std::span<const TestpointInfo> infos)
+auto ListenerImpl::statistics() const -> const Statistics&
 {
-    static auto makeSensorInfo = [](const SensorInfo& info) -> redex_lv_sensor_info
-    {
-        redex_lv_sensor_info lvInfo = {};
+    return m_statistics;
+}
 
-        lvInfo.sensor_id = makeString(info.sensorId);
-        lvInfo.node_id = makeString(info.nodeId);
-        lvInfo.input = info.input;
+// ---------------------------------------------------------------------------------------------- //
 
-        return lvInfo;
-    };
+void ListenerImpl::onNodeInfoReceived(std::span<const NodeInfo> infos)
+{
+    if (!m_nodeInfoRef)
+        return;
 
-    static auto freeSensorInfo = [](const redex_lv_sensor_info& lvInfo)
-    {
-        DSDisposeHandle(lvInfo.sensor_id);
-        DSDisposeHandle(lvInfo.node_id);
-    };
+    redex_lv_node_info_data data = {};
+    data.infos = m_pool.makeArray<redex_lv_node_info_array_handle>(0, infos.size());
 
-    static auto freeTestpointInfo = [](const redex_lv_testpoint_info& lvInfo)
+    for (size_t i = 0; i < infos.size(); ++i)
     {
-        DSDisposeHandle(lvInfo.testpoint_id);
-        freeSensorInfo(lvInfo.conductance_info);
-        freeSensorInfo(lvInfo.orp_info);
-        freeSensorInfo(lvInfo.ph_info);
-        freeSensorInfo(lvInfo.potentiostat_info);
-        freeSensorInfo(lvInfo.temperature_info);
-    };
+        const NodeInfo& info = infos[i];
+        assert(!info.id.empty());
+
+        redex_lv_node_info& lvInfo = (*data.infos)->entries[i];
+
+        lvInfo.id = m_pool.makeString(2 * i, info.id);
+        lvInfo.type = m_pool.makeString(2 * i + 1, info.type);
+    }
+
+    post(m_nodeInfoRef, &data, infos.size());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void ListenerImpl::onTestpointInfoReceived(std::span<const TestpointInfo> infos)
+{
+    static constexpr size_t StringCount = 11; // testpoint ID, sensor and node ID of each sensor
 
     if (!m_testpointInfoRef)
         return;
 
-    UHandle handle = DSNewHandle(sizeof(int32) + infos.size() * sizeof(redex_lv_testpoint_info));
-
     redex_lv_testpoint_info_data data = {};
-    data.infos = reinterpret_cast<redex_lv_testpoint_info_array_handle>(handle);
-
-    (*data.infos)->count = static_cast<int32_t>(infos.size());
+    data.infos = m_pool.makeArray<redex_lv_testpoint_info_array_handle>(0, infos.size());
 
     for (size_t i = 0; i < infos.size(); ++i)
     {
         const TestpointInfo& info = infos[i];
         assert(!info.testpointId.empty());
 
+        size_t index = StringCount * i;
+
+        const auto makeSensorInfo = [&](const SensorInfo& info) -> redex_lv_sensor_info
+        {
+            redex_lv_sensor_info lvInfo = {};
+
+            lvInfo.sensor_id = m_pool.makeString(index++, info.sensorId);
+            lvInfo.node_id = m_pool.makeString(index++, info.nodeId);
+            lvInfo.input = info.input;
+
+            return lvInfo;
+        };
+
         redex_lv_testpoint_info& lvInfo = (*data.infos)->entries[i];
 
-        lvInfo.testpoint_id = makeString(info.testpointId);
+        lvInfo.testpoint_id = m_pool.makeString(index++, info.testpointId);
         lvInfo.conductance_info = makeSensorInfo(info.conductanceInfo);
         lvInfo.orp_info = makeSensorInfo(info.orpInfo);
         lvInfo.ph_info = makeSensorInfo(info.phInfo);
@@ -502,12 +850,7 @@ void ListenerImpl::onTestpointInfoReceived(std::span<const TestpointInfo> infos)
         lvInfo.temperature_info = makeSensorInfo(info.temperatureInfo);
     }
 
-    PostLVUserEvent(m_testpointInfoRef, &data);
-
-    for (size_t i = 0; i < infos.size(); ++i)
-        freeTestpointInfo((*data.infos)->entries[i]);
-
-    DSDisposeHandle(handle);
+    post(m_testpointInfoRef, &data, infos.size());
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -528,7 +871,7 @@ void ListenerImpl::onStatusChanged(Status status)
     if (m_statusRef)
     {
         redex_lv_status_data data = { toLvStatus(status) };
-        PostLVUserEvent(m_statusRef, &data);
+        post(m_statusRef, &data);
     }
 }
 
@@ -537,11 +880,20 @@ void ListenerImpl::onStatusChanged(Status status)
 void ListenerImpl::onConductanceReceived(const std::string& id,
                                          double voltage, double current, double admittance)
 {
-    if (m_conductanceRef)
+    const bool queued = enqueue(m_conductanceBatchRef, [&](Batch& batch) {
+        batch.conductance.push_back({ batch.addTestpointId(id), voltage, current, admittance });
+    });
+
+    if (!queued && m_conductanceRef)
     {
-        redex_lv_conductance_data data = { makeString(id), voltage, current, admittance };
-        PostLVUserEvent(m_conductanceRef, &data);
-        DSDisposeHandle(data.testpoint_id);
+        redex_lv_conductance_data data = {
+            m_pool.makeString(0, id),
+            voltage,
+            current,
+            admittance
+        };
+
+        post(m_conductanceRef, &data);
     }
 }
 
@@ -549,36 +901,36 @@ void ListenerImpl::onConductanceReceived(const std::string& id,
 
 void ListenerImpl::onOrpValueReceived(const std::string& id, double value)
 {
-    if (m_orpRef)
-    {
-        redex_lv_orp_data data = { makeString(id), value };
-        PostLVUserEvent(m_orpRef, &data);
-        DSDisposeHandle(data.testpoint_id);
-    }
+    const bool queued = enqueue(m_orpBatchRef, [&](Batch& batch) {
+        batch.orpValues.push_back({ batch.addTestpointId(id), value });
+    });
+
+    if (!queued)
+        postSensorValue(m_orpRef, id, value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void ListenerImpl::onPhValueReceived(const std::string& id, double value)
 {
-    if (m_phRef)
-    {
-        redex_lv_ph_data data = { makeString(id), value };
-        PostLVUserEvent(m_phRef, &data);
-        DSDisposeHandle(data.testpoint_id);
-    }
+    const bool queued = enqueue(m_phBatchRef, [&](Batch& batch) {
+        batch.phValues.push_back({ batch.addTestpointId(id), value });
+    });
+
+    if (!queued)
+        postSensorValue(m_phRef, id, value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 void ListenerImpl::onTemperatureReceived(const std::string& id, double value)
 {
-    if (m_temperatureRef)
-    {
-        redex_lv_temperature_data data = { makeString(id), value };
-        PostLVUserEvent(m_temperatureRef, &data);
-        DSDisposeHandle(data.testpoint_id);
-    }
+    const bool queued = enqueue(m_temperatureBatchRef, [&](Batch& batch) {
+        batch.temperatures.push_back({ batch.addTestpointId(id), value });
+    });
+
+    if (!queued)
+        postSensorValue(m_temperatureRef, id, value);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -587,31 +939,27 @@ void ListenerImpl::onVoltammogramReceived(const std::string& id,
                                           std::span<const double> voltage,
                                           std::span<const double> current)
 {
-    static auto makeArray = [](std::span<const double> samples) -> redex_lv_double_array_handle
-    {
-        redex_lv_double_array_handle handle = nullptr;
-        NumericArrayResize(::fD, 1, reinterpret_cast<UHandle*>(&handle), samples.size());
-
-        (*handle)->count = static_cast<int32_t>(samples.size());
-        MoveBlock(samples.data(), (*handle)->entries, samples.size() * sizeof(double));
-
-        return handle;
-    };
+    const bool queued = enqueue(m_potentiostatBatchRef, [&](Batch& batch) {
+        const size_t offset = batch.voltammogramVoltage.size();
 
-    if (!m_potentiostatRef)
-        return;
+        batch.voltammogramVoltage.insert(batch.voltammogramVoltage.end(),
+                                         voltage.begin(), voltage.end());
+        batch.voltammogramCurrent.insert(batch.voltammogramCurrent.end(),
+                                         current.begin(), current.end());
 
-    redex_lv_potentiostat_data data = {
-        makeString(id),
-        makeArray(voltage),
-        makeArray(current)
-    };
+        batch.voltammograms.push_back({ batch.addTestpointId(id), offset, voltage.size() });
+    });
 
-    PostLVUserEvent(m_potentiostatRef, &data);
+    if (!queued && m_potentiostatRef)
+    {
+        redex_lv_potentiostat_data data = {
+            m_pool.makeString(0, id),
+            m_pool.makeDoubles(0, voltage),
+            m_pool.makeDoubles(1, current)
+        };
 
-    DSDisposeHandle(data.testpoint_id);
-    DSDisposeHandle(data.voltage);
-    DSDisposeHandle(data.current);
+        post(m_potentiostatRef, &data);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -621,7 +969,7 @@ void ListenerImpl::onHubStatusReceived(double temperature)
     if (m_hubStatusRef)
     {
         redex_lv_hub_status_data data = { temperature };
-        PostLVUserEvent(m_hubStatusRef, &data);
+        post(m_hubStatusRef, &data);
     }
 }
 
@@ -630,17 +978,20 @@ void ListenerImpl::onHubStatusReceived(double temperature)
 void ListenerImpl::onNodeStatusReceived(const std::string& nodeId,
                                         double voltage, double current, double temperature)
 {
-    if (m_nodeStatusRef)
+    const bool queued = enqueue(m_nodeStatusBatchRef, [&](Batch& batch) {
+        batch.nodeStatus.push_back({ nodeId, voltage, current, temperature });
+    });
+
+    if (!queued && m_nodeStatusRef)
     {
         redex_lv_node_status_data data = {
-            makeString(nodeId),
+            m_pool.makeString(0, nodeId),
             voltage,
             current,
             temperature
         };
 
-        PostLVUserEvent(m_nodeStatusRef, &data);
-        DSDisposeHandle(data.node_id);
+        post(m_nodeStatusRef, &data);
     }
 }
 
@@ -650,23 +1001,205 @@ void ListenerImpl::onError(const std::string& msg)
 {
     if (m_errorRef)
     {
-        redex_lv_error_data data = { makeString(msg) };
-        PostLVUserEvent(m_errorRef, &data);
-        DSDisposeHandle(data.message);
+        redex_lv_error_data data = { m_pool.makeString(0, msg) };
+        post(m_errorRef, &data);
     }
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-auto ListenerImpl::makeString(const std::string& str) -> redex_lv_string_handle
+void ListenerImpl::postSensorValue(redex_lv_event_ref ref, const std::string& id, double value)
 {
-    const size_t length = str.length();
-    auto string = reinterpret_cast<redex_lv_string_handle>(DSNewHandle(sizeof(int32_t) + length));
+    if (ref)
+    {
+        redex_lv_sensors_data data = { m_pool.makeString(0, id), value };
+        post(ref, &data);
+    }
+}
 
-    (*string)->count = static_cast<int32_t>(length);
-    MoveBlock(str.c_str(), (*string)->bytes, length);
+// ---------------------------------------------------------------------------------------------- //
 
-    return string;
+auto ListenerImpl::post(redex_lv_event_ref ref, void* data, size_t recordCount) -> bool
+{
+    if (PostLVUserEvent(ref, data) != mgNoErr)
+    {
+        m_statistics.droppedRecords += recordCount;
+        return false;
+    }
+
+    m_statistics.postedEvents++;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Func>
+auto ListenerImpl::enqueue(redex_lv_event_ref batchRef, Func func) -> bool
+{
+    if (!batchRef)
+        return false;
+
+    bool notify = false;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        if (!m_batching)
+            return false;
+
+        if (m_pendingCount + m_readyCount >= MaximumPendingRecords)
+        {
+            m_statistics.droppedRecords++;
+            return true;
+        }
+
+        func(m_pending);
+        m_pendingCount++;
+
+        // Full batches are queued while the flush thread is posting, so no event carries more
+        // than the maximum count
+        if (m_maximumCount > 0 && m_pendingCount >= m_maximumCount)
+        {
+            m_ready.push_back(std::move(m_pending));
+            m_readyCount += m_pendingCount;
+
+            m_pending = Batch();
+            m_pendingCount = 0;
+
+            if (!m_spare.empty())
+            {
+                std::swap(m_pending, m_spare.back());
+                m_spare.pop_back();
+            }
+
+            notify = true;
+        }
+    }
+
+    if (notify)
+        m_condition.notify_all();
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void ListenerImpl::flush()
+{
+    std::unique_lock lock(m_mutex);
+
+    const auto ready = [&] { return !m_batching || !m_ready.empty(); };
+
+    auto deadline = std::chrono::steady_clock::now() + m_interval;
+
+    while (true)
+    {
+        if (m_interval.count() > 0)
+            m_condition.wait_until(lock, deadline, ready);
+        else
+            m_condition.wait(lock, ready);
+
+        if (!m_ready.empty())
+        {
+            // Full batches always hold the maximum count
+            std::swap(m_flushing, m_ready.front());
+            m_readyCount -= m_maximumCount;
+
+            m_spare.push_back(std::move(m_ready.front()));
+            m_ready.pop_front();
+        }
+        else
+        {
+            std::swap(m_pending, m_flushing);
+            m_pendingCount = 0;
+        }
+
+        lock.unlock();
+
+        postBatch(m_flushing);
+        m_flushing.clear();
+
+        lock.lock();
+
+        // The remaining records are posted before exiting
+        if (!m_batching && m_ready.empty() && m_pendingCount == 0)
+            return;
+
+        // Batches posted early because of their size don't shift the interval
+        const auto now = std::chrono::steady_clock::now();
+
+        if (now >= deadline)
+            deadline = now + m_interval;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void ListenerImpl::postBatch(const Batch& batch)
+{
+    postRecords<redex_lv_conductance_batch_data>(m_conductanceBatchRef, batch.conductance,
+                                                 [&](const ConductanceRecord& r, size_t i) {
+        return redex_lv_conductance_data {
+            m_batchPool.makeString(i, batch.testpointIds[r.testpoint]),
+            r.voltage,
+            r.current,
+            r.admittance
+        };
+    });
+
+    const auto makeSensorData = [&](const SensorRecord& r, size_t i) {
+        return redex_lv_sensors_data {
+            m_batchPool.makeString(i, batch.testpointIds[r.testpoint]), r.value
+        };
+    };
+
+    postRecords<redex_lv_orp_batch_data>(m_orpBatchRef, batch.orpValues, makeSensorData);
+    postRecords<redex_lv_ph_batch_data>(m_phBatchRef, batch.phValues, makeSensorData);
+    postRecords<redex_lv_temperature_batch_data>(m_temperatureBatchRef, batch.temperatures,
+                                                 makeSensorData);
+
+    postRecords<redex_lv_potentiostat_batch_data>(m_potentiostatBatchRef, batch.voltammograms,
+                                                  [&](const VoltammogramRecord& r, size_t i) {
+        return redex_lv_potentiostat_data {
+            m_batchPool.makeString(i, batch.testpointIds[r.testpoint]),
+            m_batchPool.makeDoubles(2 * i, batch.voltage(r)),
+            m_batchPool.makeDoubles(2 * i + 1, batch.current(r))
+        };
+    });
+
+    postRecords<redex_lv_node_status_batch_data>(m_nodeStatusBatchRef, batch.nodeStatus,
+                                                 [&](const NodeStatusRecord& r, size_t i) {
+        return redex_lv_node_status_data {
+            m_batchPool.makeString(i, r.nodeId), r.voltage, r.current, r.temperature
+        };
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename Data, typename Record, typename Func>
+void ListenerImpl::postRecords(redex_lv_event_ref ref, const std::vector<Record>& records,
+                               Func makeEntry)
+{
+    if (records.empty())
+        return;
+
+    Data data = {};
+
+    try {
+        data.records = m_batchPool.makeArray<decltype(data.records)>(0, records.size());
+
+        for (size_t i = 0; i < records.size(); ++i)
+            (*data.records)->entries[i] = makeEntry(records[i], i);
+    }
+    catch (const std::bad_alloc&)
+    {
+        m_statistics.droppedRecords += records.size();
+        return;
+    }
+
+    if (post(ref, &data, records.size()))
+        m_statistics.coalescedRecords += records.size();
 }
 
 // ---------------------------------------------------------------------------------------------- //
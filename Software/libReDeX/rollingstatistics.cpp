@@ -0,0 +1,301 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "rollingstatistics.h"
+
+#include <cmath>
+#include <limits>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    // Removing samples lets rounding errors of the running sums accumulate, so they are
+    // recomputed after a window's worth of removals, but not more often than this
+    constexpr size_t MinimumRecomputeInterval = 1024;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+RollingWindow::RollingWindow(const StatisticsWindow& limits)
+    : m_limits(limits)
+{
+    if (m_limits.count > 0)
+        m_samples.reserve(m_limits.count + 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingWindow::add(double value, Clock::time_point time)
+{
+    // A single NaN or infinity would poison the running sums until they are recomputed
+    if (!std::isfinite(value))
+    {
+        expire(time);
+        return;
+    }
+
+    if (m_samples.empty())
+        m_origin = time;
+
+    const Sample sample = { m_nextIndex++, seconds(time), value };
+    m_samples.push_back(sample);
+
+    const double n = static_cast<double>(m_samples.size());
+    const double dt = sample.time - m_meanTime;
+    const double dv = sample.value - m_meanValue;
+
+    m_meanTime += dt / n;
+    m_meanValue += dv / n;
+
+    m_timeSquares += dt * (sample.time - m_meanTime);
+    m_valueSquares += dv * (sample.value - m_meanValue);
+    m_products += dt * (sample.value - m_meanValue);
+
+    while (!m_minimum.empty() && m_minimum.back().value >= value)
+        m_minimum.pop_back();
+
+    m_minimum.push_back(sample);
+
+    while (!m_maximum.empty() && m_maximum.back().value <= value)
+        m_maximum.pop_back();
+
+    m_maximum.push_back(sample);
+
+    if (m_limits.count > 0 && m_samples.size() > m_limits.count)
+        removeFirst();
+
+    expire(time);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingWindow::expire(Clock::time_point time)
+{
+    if (m_limits.duration.count() <= 0)
+        return;
+
+    const double oldest = seconds(time - m_limits.duration);
+
+    while (!m_samples.empty() && m_samples.front().time < oldest)
+        removeFirst();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RollingWindow::statistics() const -> Statistics
+{
+    const size_t n = m_samples.size();
+
+    Statistics result = { n, NaN, NaN, NaN, NaN, NaN };
+
+    if (n == 0)
+        return result;
+
+    result.mean = m_meanValue;
+    result.minimum = m_minimum.front().value;
+    result.maximum = m_maximum.front().value;
+
+    if (n > 1)
+    {
+        result.standardDeviation = std::sqrt(std::max(m_valueSquares, 0.0) / (n - 1));
+
+        if (m_timeSquares > 0.0)
+            result.slope = m_products / m_timeSquares;
+    }
+
+    return result;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingWindow::removeFirst()
+{
+    const Sample sample = m_samples.front();
+    m_samples.pop_front();
+
+    if (m_minimum.front().index == sample.index)
+        m_minimum.pop_front();
+
+    if (m_maximum.front().index == sample.index)
+        m_maximum.pop_front();
+
+    if (m_samples.empty())
+    {
+        recompute();
+        return;
+    }
+
+    // Inverse of the update in add()
+    const double n = static_cast<double>(m_samples.size());
+    const double dt = sample.time - m_meanTime;
+    const double dv = sample.value - m_meanValue;
+
+    m_meanTime -= dt / n;
+    m_meanValue -= dv / n;
+
+    m_timeSquares -= dt * (sample.time - m_meanTime);
+    m_valueSquares -= dv * (sample.value - m_meanValue);
+    m_products -= dt * (sample.value - m_meanValue);
+
+    if (++m_removals >= std::max(m_samples.size(), MinimumRecomputeInterval))
+        recompute();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingWindow::recompute()
+{
+    const size_t n = m_samples.size();
+
+    m_removals = 0;
+
+    m_meanTime = 0.0;
+    m_meanValue = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_meanTime += m_samples[i].time;
+        m_meanValue += m_samples[i].value;
+    }
+
+    if (n > 0)
+    {
+        m_meanTime /= n;
+        m_meanValue /= n;
+    }
+
+    m_timeSquares = 0.0;
+    m_valueSquares = 0.0;
+    m_products = 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double dt = m_samples[i].time - m_meanTime;
+        const double dv = m_samples[i].value - m_meanValue;
+
+        m_timeSquares += dt * dt;
+        m_valueSquares += dv * dv;
+        m_products += dt * dv;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RollingWindow::seconds(Clock::time_point time) const -> double
+{
+    return std::chrono::duration<double>(time - m_origin).count();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+// ---------------------------------------------------------------------------------------------- //
+
+RollingStatistics::RollingStatistics(size_t hubCount)
+    : m_hubs(hubCount)
+{
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingStatistics::setWindows(const std::vector<StatisticsWindow>& windows)
+{
+    for (const StatisticsWindow& window : windows)
+    {
+        if (window.count == 0 && window.duration.count() <= 0)
+            throw Error("Statistics window without limit.");
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    m_windows = windows;
+
+    for (auto& testpoints : m_hubs)
+        testpoints.clear();
+
+    m_enabled = !m_windows.empty();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RollingStatistics::isEnabled() const -> bool
+{
+    return m_enabled;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void RollingStatistics::add(size_t hub, const std::string& testpointId, Channel channel,
+                            double value, RollingWindow::Clock::time_point time)
+{
+    std::lock_guard lock(m_mutex);
+
+    // Values arrive on the client threads, where an exception would end the connection
+    if (hub >= m_hubs.size())
+        return;
+
+    auto& testpoints = m_hubs[hub];
+    auto it = testpoints.find(testpointId);
+
+    if (it == testpoints.end())
+    {
+        it = testpoints.emplace(testpointId, Testpoint()).first;
+
+        for (std::vector<RollingWindow>& windows : it->second)
+        {
+            for (const StatisticsWindow& limits : m_windows)
+                windows.emplace_back(limits);
+        }
+    }
+
+    for (RollingWindow& window : it->second[static_cast<size_t>(channel)])
+        window.add(value, time);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto RollingStatistics::statistics(size_t hub, const std::string& testpointId, Channel channel,
+                                   size_t window) -> Statistics
+{
+    std::lock_guard lock(m_mutex);
+
+    if (window >= m_windows.size())
+        throw Error("Invalid statistics window " + std::to_string(window) + ".");
+
+    auto& testpoints = m_hubs.at(hub);
+    const auto it = testpoints.find(testpointId);
+
+    if (it == testpoints.end())
+        return { 0, NaN, NaN, NaN, NaN, NaN };
+
+    RollingWindow& w = it->second[static_cast<size_t>(channel)][window];
+    w.expire(RollingWindow::Clock::now());
+
+    return w.statistics();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,202 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <redex.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <map>
+#include <mutex>
+
+namespace redex {
+
+// Queue with amortized constant time insertion and removal at both ends that keeps its capacity
+template <typename T>
+class RingBuffer
+{
+public:
+    auto size() const -> size_t { return m_size; }
+    auto empty() const -> bool { return m_size == 0; }
+
+    auto operator[](size_t index) const -> const T& { return m_data[wrap(m_first + index)]; }
+
+    auto front() const -> const T& { return m_data[m_first]; }
+    auto back() const -> const T& { return m_data[wrap(m_first + m_size - 1)]; }
+
+    void reserve(size_t capacity);
+
+    void push_back(const T& value);
+    void pop_front();
+    void pop_back();
+
+    void clear();
+
+private:
+    auto wrap(size_t index) const -> size_t { return index & (m_data.size() - 1); }
+
+private:
+    std::vector<T> m_data; // Size is zero or a power of two
+    size_t m_first = 0;
+    size_t m_size = 0;
+};
+
+// Moments, extrema and the least squares slope of the samples in one window. Every update takes
+// amortized constant time.
+class RollingWindow
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RollingWindow(const StatisticsWindow& limits);
+
+    // Values that are not finite are skipped, but still expire the older samples
+    void add(double value, Clock::time_point time);
+
+    // Drops the samples that are too old at the given time
+    void expire(Clock::time_point time);
+
+    auto statistics() const -> Statistics;
+
+private:
+    struct Sample
+    {
+        uint64_t index;
+        double time; // Seconds since m_origin
+        double value;
+    };
+
+    void removeFirst();
+    void recompute();
+
+    auto seconds(Clock::time_point time) const -> double;
+
+private:
+    StatisticsWindow m_limits;
+
+    RingBuffer<Sample> m_samples;
+
+    // Candidates for the minimum and maximum, monotonic in value
+    RingBuffer<Sample> m_minimum;
+    RingBuffer<Sample> m_maximum;
+
+    Clock::time_point m_origin;
+    uint64_t m_nextIndex = 0;
+    size_t m_removals = 0;
+
+    double m_meanTime = 0.0;
+    double m_meanValue = 0.0;
+    double m_timeSquares = 0.0;  // Sum of squared deviations of the time
+    double m_valueSquares = 0.0; // Sum of squared deviations of the value
+    double m_products = 0.0;     // Sum of the products of the deviations of time and value
+};
+
+// Rolling statistics for every hub, testpoint and channel. Thread-safe.
+class RollingStatistics
+{
+public:
+    explicit RollingStatistics(size_t hubCount = 1);
+
+    // Discards the collected statistics. An empty list disables collection.
+    void setWindows(const std::vector<StatisticsWindow>& windows);
+
+    auto isEnabled() const -> bool;
+
+    // Values of unknown hubs are ignored
+    void add(size_t hub, const std::string& testpointId, Channel channel, double value,
+             RollingWindow::Clock::time_point time);
+
+    auto statistics(size_t hub, const std::string& testpointId, Channel channel,
+                    size_t window) -> Statistics;
+
+private:
+    static constexpr size_t ChannelCount = static_cast<size_t>(Channel::Temperature) + 1;
+
+    using Testpoint = std::array<std::vector<RollingWindow>, ChannelCount>;
+
+    std::mutex m_mutex;
+    std::atomic<bool> m_enabled = false;
+
+    std::vector<StatisticsWindow> m_windows;
+    std::vector<std::map<std::string, Testpoint, std::less<>>> m_hubs;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RingBuffer<T>::reserve(size_t capacity)
+{
+    if (capacity <= m_data.size())
+        return;
+
+    std::vector<T> data(std::bit_ceil(capacity));
+
+    for (size_t i = 0; i < m_size; ++i)
+        data[i] = (*this)[i];
+
+    m_data = std::move(data);
+    m_first = 0;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RingBuffer<T>::push_back(const T& value)
+{
+    if (m_size == m_data.size())
+        reserve(std::max<size_t>(16, 2 * m_size));
+
+    m_data[wrap(m_first + m_size)] = value;
+    ++m_size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RingBuffer<T>::pop_front()
+{
+    m_first = wrap(m_first + 1);
+    --m_size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RingBuffer<T>::pop_back()
+{
+    --m_size;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+template <typename T>
+void RingBuffer<T>::clear()
+{
+    m_first = 0;
+    m_size = 0;
+}
+
+} // End of namespace redex
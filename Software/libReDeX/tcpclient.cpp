@@ -23,8 +23,10 @@
 
 #include "tcpclient.h"
 
+#include <algorithm>
 #include <cassert>
-#include <sstream>
+#include <charconv>
+#include <cstring>
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -33,46 +35,71 @@ using namespace redex;
 // ---------------------------------------------------------------------------------------------- //
 
 namespace {
-    constexpr uint16_t TcpPort = 5432;
-
     constexpr const char* LineTerminator = "\r\n";
     constexpr size_t LineTerminatorLength = 2;
 
     constexpr char TokenSeparator = 0x1f; // ASCII unit separator
     constexpr char ValueSeparator = ';';
 
-    auto split(const std::string& s, char delim) -> std::vector<std::string>
+    // The host name may be followed by a port, which replaces the given one
+    auto connectToHost(const std::string& host, uint16_t port) -> TcpSocket
     {
-        std::vector<std::string> result;
+        const size_t pos = host.rfind(':');
+
+        if (pos == std::string::npos)
+            return TcpSocket(TcpAddress::fromHostName(host), port);
+
+        const char* first = host.data() + pos + 1;
+        const char* last = host.data() + host.size();
+
+        const auto [ptr, error] = std::from_chars(first, last, port);
 
-        std::istringstream stream(s);
-        std::string token;
+        if (error != std::errc() || ptr != last || first == last)
+            throw std::runtime_error("Invalid port in host name " + host + ".");
 
-        while (std::getline(stream, token, delim))
-            result.push_back(token);
+        return TcpSocket(TcpAddress::fromHostName(host.substr(0, pos)), port);
+    }
+
+    void split(std::string_view s, char delim, std::vector<std::string_view>& result)
+    {
+        result.clear();
+
+        size_t start = 0;
+        size_t end = 0;
+
+        while ((end = s.find(delim, start)) != std::string_view::npos)
+        {
+            result.push_back(s.substr(start, end - start));
+            start = end + 1;
+        }
+
+        result.push_back(s.substr(start));
+    }
 
-        if (s.back() == delim)
-            result.push_back("");
+    auto split(std::string_view s, char delim) -> std::vector<std::string_view>
+    {
+        std::vector<std::string_view> result;
+        split(s, delim, result);
 
         return result;
     }
 
     template <typename T>
-    auto to(const std::string& s) -> T
+    auto to(std::string_view s) -> T
     {
-        std::istringstream stream(s);
+        const char* last = s.data() + s.size();
 
         T t = {};
-        stream >> t;
+        const auto [ptr, error] = std::from_chars(s.data(), last, t);
 
-        if (stream.fail())
-            throw std::runtime_error("Invalid value " + s + " received.");
+        if (error != std::errc() || ptr != last)
+            throw std::runtime_error("Invalid value " + std::string(s) + " received.");
 
         return t;
     }
 
     template <>
-    auto to(const std::string& s) -> AlarmType
+    auto to(std::string_view s) -> AlarmType
     {
         if (s == "OVERVOLTAGE")
             return AlarmType::Overvoltage;
@@ -86,11 +113,11 @@ namespace {
         if (s == "OVERHEAT")
             return AlarmType::Overheat;
 
-        throw std::runtime_error("Invalid alarm type " + s + " received.");
+        throw std::runtime_error("Invalid alarm type " + std::string(s) + " received.");
     }
 
     template <>
-    auto to(const std::string& s) -> AlarmSeverity
+    auto to(std::string_view s) -> AlarmSeverity
     {
         if (s == "WARNING")
             return AlarmSeverity::Warning;
@@ -98,45 +125,76 @@ namespace {
         if (s == "CRITICAL")
             return AlarmSeverity::Critical;
 
-        throw std::runtime_error("Invalid alarm severity " + s + " received.");
+        throw std::runtime_error("Invalid alarm severity " + std::string(s) + " received.");
     }
 
-    auto toDouble(const std::string& s) -> double
+    auto toDouble(std::string_view s) -> double
     {
         if (s == "nan")
             return std::numeric_limits<double>::quiet_NaN();
 
         return to<double>(s);
     }
+
+    // Parses a list of values without splitting it into tokens first
+    void toDoubles(std::string_view s, std::vector<double>& result)
+    {
+        result.clear();
+
+        if (s.empty())
+            return;
+
+        result.reserve(std::count(s.begin(), s.end(), ValueSeparator) + 1);
+
+        const char* first = s.data();
+        const char* last = first + s.size();
+
+        while (first < last)
+        {
+            const auto* end = static_cast<const char*>(std::memchr(first, ValueSeparator,
+                                                                   last - first));
+            if (end == nullptr)
+                end = last;
+
+            result.push_back(toDouble({ first, static_cast<size_t>(end - first) }));
+            first = end + 1;
+        }
+    }
 }
+
 // ---------------------------------------------------------------------------------------------- //
 
-TcpClient::TcpClient(const std::string& host, Listener* listener)
-    : m_socket(TcpAddress::fromHostName(host), TcpPort),
-      m_listener(listener)
+TcpClient::TcpClient(const std::string& host, Listener* listener, ReadMode mode, uint16_t port)
+    : m_socket(connectToHost(host, port)),
+      m_listener(listener),
+      m_receiveBuffer(ReceiveBufferSize)
 {
     assert(listener != nullptr);
 
     waitForPreamble();
 
-    m_running = true;
-    m_thread = std::thread(&TcpClient::work, this);
+    if (mode == ReadMode::Thread)
+    {
+        m_running = true;
+        m_thread = std::thread(&TcpClient::work, this);
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
 TcpClient::~TcpClient()
 {
-    assert(m_thread.joinable());
-
     try {
         stopMeasurement();
     }
     catch (...) {
     }
 
-    m_running = false;
-    m_thread.join();
+    if (m_thread.joinable())
+    {
+        m_running = false;
+        m_thread.join();
+    }
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -183,6 +241,33 @@ void TcpClient::stopMeasurement()
 
 // ---------------------------------------------------------------------------------------------- //
 
+void TcpClient::startCalibration()
+{
+    sendData("<START_CALIBRATION>\r\n");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TcpClient::descriptor() const -> intptr_t
+{
+    return m_socket.descriptor();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TcpClient::readAvailableData() -> bool
+{
+    const size_t size = m_socket.readData(m_receiveBuffer);
+
+    if (size == 0)
+        return false;
+
+    processData({ m_receiveBuffer.data(), size });
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void TcpClient::waitForPreamble()
 {
     static constexpr std::chrono::milliseconds Timeout = 500ms;
@@ -204,10 +289,10 @@ void TcpClient::waitForPreamble()
 
     string.erase(string.size() - LineTerminatorLength);
 
-    const std::vector<std::string> tokens = split(string, TokenSeparator);
+    const std::vector<std::string_view> tokens = split(string, TokenSeparator);
 
     if (tokens.front() == "<ERROR>")
-        throw Error(tokens.back());
+        throw Error(std::string(tokens.back()));
 
     if (tokens.front() != "<WELCOME>")
         throw Error("Invalid preamble received from server.");
@@ -219,8 +304,15 @@ void TcpClient::work()
 {
     while (m_running)
     {
-        if (m_socket.waitForDataAvailable())
-            processData(m_socket.readAllData());
+        try {
+            if (m_socket.waitForDataAvailable() && !readAvailableData())
+                throw Error("Connection closed by server.");
+        }
+        catch (const std::exception& e)
+        {
+            m_listener->onError(e.what());
+            return;
+        }
     }
 }
 
@@ -228,49 +320,78 @@ void TcpClient::work()
 
 void TcpClient::processData(std::span<const char> data)
 {
-    for (char byte : data)
+    const char* first = data.data();
+    const char* last = first + data.size();
+
+    while (first < last)
     {
-        m_currentData += byte;
+        const auto* end = static_cast<const char*>(std::memchr(first, '\n', last - first));
 
-        if (m_currentData.ends_with(LineTerminator))
+        if (end == nullptr)
         {
-            m_currentData.erase(m_currentData.size() - LineTerminatorLength);
+            m_currentData.append(first, last);
+            return;
+        }
 
-            const std::vector<std::string> tokens = split(m_currentData, TokenSeparator);
-            m_currentData.clear();
+        const std::string_view line(first, end - first);
+        first = end + 1;
 
-            try {
-                if (tokens.front() == "<NODE_INFO>")
-                    parseNodeInfo(tokens);
-                else if (tokens.front() == "<TESTPOINT_INFO>")
-                    parseTestpointInfo(tokens);
-                else if (tokens.front() == "<HUB_ALARM>")
-                    parseHubAlarm(tokens);
-                else if (tokens.front() == "<NODE_ALARM>")
-                    parseNodeAlarm(tokens);
-                else if (tokens.front() == "<HUB_STATUS>")
-                    parseHubStatus(tokens);
-                else if (tokens.front() == "<NODE_STATUS>")
-                    parseNodeStatus(tokens);
-                else if (tokens.front() == "<STATUS>")
-                    parseStatus(tokens);
-                else if (tokens.front() == "<ERROR>")
-                    parseError(tokens);
-                else if (tokens.front() == "<VOLTAMMOGRAM>")
-                    parseVoltammogram(tokens);
-                else
-                    parseSensorData(tokens);
-            }
-            catch (const std::exception& e) {
-                m_listener->onError(e.what());
-            }
+        // Only lines split across several reads are copied
+        if (m_currentData.empty())
+            processLine(line);
+        else
+        {
+            m_currentData.append(line);
+            processLine(m_currentData);
+            m_currentData.clear();
         }
     }
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-auto TcpClient::parseSensorInfo(std::span<const std::string> values) -> SensorInfo
+void TcpClient::processLine(std::string_view line)
+{
+    if (line.ends_with(LineTerminator[0]))
+        line.remove_suffix(1);
+
+    split(line, TokenSeparator, m_tokens);
+    const std::span<const std::string_view> tokens = m_tokens;
+
+    try {
+        if (tokens.front() == "<NODE_INFO>")
+            parseNodeInfo(tokens);
+        else if (tokens.front() == "<TESTPOINT_INFO>")
+            parseTestpointInfo(tokens);
+        else if (tokens.front() == "<HUB_ALARM>")
+            parseHubAlarm(tokens);
+        else if (tokens.front() == "<NODE_ALARM>")
+            parseNodeAlarm(tokens);
+        else if (tokens.front() == "<HUB_STATUS>")
+            parseHubStatus(tokens);
+        else if (tokens.front() == "<NODE_STATUS>")
+            parseNodeStatus(tokens);
+        else if (tokens.front() == "<CALIBRATION_PROGRESS>")
+            parseCalibrationProgress(tokens);
+        else if (tokens.front() == "<CALIBRATION_RESULT>")
+            parseCalibrationResult(tokens);
+        else if (tokens.front() == "<STATUS>")
+            parseStatus(tokens);
+        else if (tokens.front() == "<ERROR>")
+            parseError(tokens);
+        else if (tokens.front() == "<VOLTAMMOGRAM>")
+            parseVoltammogram(tokens);
+        else
+            parseSensorData(tokens);
+    }
+    catch (const std::exception& e) {
+        m_listener->onError(e.what());
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto TcpClient::parseSensorInfo(std::span<const std::string_view> values) -> SensorInfo
 {
     static constexpr size_t RequiredValueCount = 3; // id, nodeId, input
 
@@ -278,8 +399,8 @@ auto TcpClient::parseSensorInfo(std::span<const std::string> values) -> SensorIn
         throw Error("Invalid number of sensor-info values received.");
 
     SensorInfo info =  {};
-    info.sensorId = values[0];
-    info.nodeId = values[1];
+    info.sensorId = std::string(values[0]);
+    info.nodeId = std::string(values[1]);
     info.input = values[2].empty() ? 0 : to<size_t>(values[2]);
 
     return info;
@@ -287,7 +408,7 @@ auto TcpClient::parseSensorInfo(std::span<const std::string> values) -> SensorIn
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseNodeInfo(std::span<const std::string> tokens)
+void TcpClient::parseNodeInfo(std::span<const std::string_view> tokens)
 {
     static constexpr size_t MinimumTokenCount = 2; // tag, count
     static constexpr size_t RequiredValueCount = 2; // id, type
@@ -306,18 +427,17 @@ void TcpClient::parseNodeInfo(std::span<const std::string> tokens)
 
     for (size_t i = 0; i < count; ++i)
     {
-        const std::string& token = tokens[2 + i];
-        const std::vector<std::string> values = split(token, ValueSeparator);
+        const std::vector<std::string_view> values = split(tokens[2 + i], ValueSeparator);
 
         if (values.size() != RequiredValueCount)
             throw Error("Invalid number of node-info values received.");
 
-        const std::string& id = values[0];
+        const std::string_view id = values[0];
 
         if (id.empty())
             throw Error("Empty node ID received.");
 
-        const std::string& type = values[1];
+        const std::string_view type = values[1];
 
         if (type.empty())
             throw Error("Empty node type received.");
@@ -331,7 +451,7 @@ void TcpClient::parseNodeInfo(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseTestpointInfo(std::span<const std::string> tokens)
+void TcpClient::parseTestpointInfo(std::span<const std::string_view> tokens)
 {
     static constexpr size_t MinimumTokenCount = 2; // tag, count
     static constexpr size_t SensorValueCount = 3; // id, nodeId, input
@@ -351,18 +471,17 @@ void TcpClient::parseTestpointInfo(std::span<const std::string> tokens)
 
     for (size_t i = 0; i < count; ++i)
     {
-        const std::string& token = tokens[2 + i];
-        const std::vector<std::string> values = split(token, ValueSeparator);
+        const std::vector<std::string_view> values = split(tokens[2 + i], ValueSeparator);
 
         if (values.size() != RequiredValueCount)
             throw Error("Invalid number of testpoint-info values received.");
 
-        const std::string& id = values[0];
+        const std::string_view id = values[0];
 
         if (id.empty())
             throw Error("Empty testpoint ID received.");
 
-        const auto makeValueSpan = [&values](size_t offset) -> std::span<const std::string> {
+        const auto makeValueSpan = [&values](size_t offset) -> std::span<const std::string_view> {
             return { &values[1 + offset*SensorValueCount], SensorValueCount };
         };
 
@@ -379,7 +498,7 @@ void TcpClient::parseTestpointInfo(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseHubAlarm(std::span<const std::string> tokens)
+void TcpClient::parseHubAlarm(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 2; // tag, values
     static constexpr size_t RequiredValueCount = 2; // type, severity
@@ -389,7 +508,7 @@ void TcpClient::parseHubAlarm(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<HUB_ALARM>");
 
-    const std::vector<std::string> values = split(tokens[1], ValueSeparator);
+    const std::vector<std::string_view> values = split(tokens[1], ValueSeparator);
 
     if (values.size() != RequiredValueCount)
         throw Error("Invalid number of hub-alarm values received.");
@@ -402,7 +521,7 @@ void TcpClient::parseHubAlarm(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseNodeAlarm(std::span<const std::string> tokens)
+void TcpClient::parseNodeAlarm(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 3; // tag, id, values
     static constexpr size_t RequiredValueCount = 2; // type, severity
@@ -412,12 +531,12 @@ void TcpClient::parseNodeAlarm(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<NODE_ALARM>");
 
-    const std::string& id = tokens[1];
+    const std::string id(tokens[1]);
 
     if (id.empty())
         throw Error("Empty node ID received.");
 
-    const std::vector<std::string> values = split(tokens[2], ValueSeparator);
+    const std::vector<std::string_view> values = split(tokens[2], ValueSeparator);
 
     if (values.size() != RequiredValueCount)
         throw Error("Invalid number of node-alarm values received.");
@@ -430,7 +549,7 @@ void TcpClient::parseNodeAlarm(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseHubStatus(std::span<const std::string> tokens)
+void TcpClient::parseHubStatus(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 2; // tag, temperature
 
@@ -445,7 +564,7 @@ void TcpClient::parseHubStatus(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseNodeStatus(std::span<const std::string> tokens)
+void TcpClient::parseNodeStatus(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 3; // tag, id, values
     static constexpr size_t RequiredValueCount = 3; // voltage, current, temperature
@@ -455,12 +574,12 @@ void TcpClient::parseNodeStatus(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<NODE_STATUS>");
 
-    const std::string& id = tokens[1];
+    const std::string id(tokens[1]);
 
     if (id.empty())
         throw Error("Empty node ID received.");
 
-    const std::vector<std::string> values = split(tokens[2], ValueSeparator);
+    const std::vector<std::string_view> values = split(tokens[2], ValueSeparator);
 
     if (values.size() != RequiredValueCount)
         throw Error("Invalid number of power values received.");
@@ -474,7 +593,56 @@ void TcpClient::parseNodeStatus(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseStatus(std::span<const std::string> tokens)
+void TcpClient::parseCalibrationProgress(std::span<const std::string_view> tokens)
+{
+    static constexpr size_t RequiredTokenCount = 3; // tag, id, percent
+
+    if (tokens.size() != RequiredTokenCount)
+        throw Error("Invalid number of calibration-progress tokens received.");
+
+    assert(tokens[0] == "<CALIBRATION_PROGRESS>");
+
+    const std::string id(tokens[1]);
+
+    if (id.empty())
+        throw Error("Empty node ID received.");
+
+    const auto percent = to<int>(tokens[2]);
+    m_listener->onCalibrationProgress(id, percent);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TcpClient::parseCalibrationResult(std::span<const std::string_view> tokens)
+{
+    static constexpr size_t RequiredTokenCount = 3; // tag, id, values
+    static constexpr size_t RequiredValueCount = 3; // voltage, current and signal offset
+
+    if (tokens.size() != RequiredTokenCount)
+        throw Error("Invalid number of calibration-result tokens received.");
+
+    assert(tokens[0] == "<CALIBRATION_RESULT>");
+
+    const std::string id(tokens[1]);
+
+    if (id.empty())
+        throw Error("Empty node ID received.");
+
+    const std::vector<std::string_view> values = split(tokens[2], ValueSeparator);
+
+    if (values.size() != RequiredValueCount)
+        throw Error("Invalid number of calibration values received.");
+
+    const auto voltageOffset = to<int>(values[0]);
+    const auto currentOffset = to<int>(values[1]);
+    const auto signalOffset = to<int>(values[2]);
+
+    m_listener->onCalibrationResult(id, voltageOffset, currentOffset, signalOffset);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void TcpClient::parseStatus(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 2; // tag, status
 
@@ -483,7 +651,7 @@ void TcpClient::parseStatus(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<STATUS>");
 
-    const std::string& token = tokens[1];
+    const std::string_view token = tokens[1];
     auto status = Status::MeasurementError;
 
     if (token == "running")
@@ -496,7 +664,7 @@ void TcpClient::parseStatus(std::span<const std::string> tokens)
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseError(std::span<const std::string> tokens)
+void TcpClient::parseError(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 2; // tag, message
 
@@ -505,27 +673,14 @@ void TcpClient::parseError(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<ERROR>");
 
-    const std::string& message = tokens[1];
+    const std::string message(tokens[1]);
     m_listener->onError(message);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseVoltammogram(std::span<const std::string> tokens)
+void TcpClient::parseVoltammogram(std::span<const std::string_view> tokens)
 {
-    static auto convertData = [](const std::string& s) -> std::vector<double>
-    {
-        std::vector<double> result;
-
-        std::istringstream stream(s);
-        std::string token;
-
-        while (std::getline(stream, token, ValueSeparator))
-            result.push_back(toDouble(token));
-
-        return result;
-    };
-
     static constexpr size_t RequiredTokenCount = 4; // tag, id, voltage, current
 
     if (tokens.size() != RequiredTokenCount)
@@ -533,30 +688,31 @@ void TcpClient::parseVoltammogram(std::span<const std::string> tokens)
 
     assert(tokens[0] == "<VOLTAMMOGRAM>");
 
-    const std::string& id = tokens[1];
+    const std::string id(tokens[1]);
 
-    const std::vector<double> voltage = convertData(tokens[2]);
-    const std::vector<double> current = convertData(tokens[3]);
+    // The buffers are reused, voltammograms can contain tens of thousands of values
+    toDoubles(tokens[2], m_voltage);
+    toDoubles(tokens[3], m_current);
 
-    if (voltage.size() != current.size())
+    if (m_voltage.size() != m_current.size())
         throw Error("Invalid voltammogram received.");
 
-    m_listener->onVoltammogramReceived(id, voltage, current);
+    m_listener->onVoltammogramReceived(id, m_voltage, m_current);
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void TcpClient::parseSensorData(std::span<const std::string> tokens)
+void TcpClient::parseSensorData(std::span<const std::string_view> tokens)
 {
     static constexpr size_t RequiredTokenCount = 3; // tag, id, values
 
     if (tokens.size() != RequiredTokenCount)
         throw Error("Invalid number of sensor-data tokens received.");
 
-    const std::string& tag = tokens[0];
-    const std::string& id = tokens[1];
+    const std::string_view tag = tokens[0];
+    const std::string id(tokens[1]);
 
-    const std::vector<std::string> values = split(tokens[2], ValueSeparator);
+    const std::vector<std::string_view> values = split(tokens[2], ValueSeparator);
 
     if (tag == "<CONDUCTANCE>")
     {
@@ -588,7 +744,7 @@ void TcpClient::parseSensorData(std::span<const std::string> tokens)
             m_listener->onTemperatureReceived(id, value);
     }
     else
-        throw Error("Unknown tag " + tag + " received.");
+        throw Error("Unknown tag " + std::string(tag) + " received.");
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -27,14 +27,24 @@
 
 #include <redex.h>
 
+#include <string_view>
 #include <thread>
+#include <vector>
 
 namespace redex {
 
 class TcpClient
 {
 public:
-    TcpClient(const std::string& host, Listener* listener);
+    static constexpr uint16_t DefaultPort = 5432;
+    static constexpr size_t ReceiveBufferSize = 64 * 1024;
+
+    // External: the owner waits for incoming data and calls readAvailableData()
+    enum class ReadMode { Thread, External };
+
+public:
+    TcpClient(const std::string& host, Listener* listener, ReadMode mode = ReadMode::Thread,
+              uint16_t port = DefaultPort);
     ~TcpClient();
 
     TcpClient(const TcpClient&) = delete;
@@ -52,29 +62,40 @@ public:
     void startMeasurement();
     void stopMeasurement();
 
+    void startCalibration();
+
+    auto descriptor() const -> intptr_t;
+
+    // Returns false if the server has closed the connection
+    auto readAvailableData() -> bool;
+
 private:
     void waitForPreamble();
 
     void work();
 
     void processData(std::span<const char> data);
+    void processLine(std::string_view line);
+
+    auto parseSensorInfo(std::span<const std::string_view> values) -> SensorInfo;
 
-    auto parseSensorInfo(std::span<const std::string> values) -> SensorInfo;
+    void parseNodeInfo(std::span<const std::string_view> tokens);
+    void parseTestpointInfo(std::span<const std::string_view> tokens);
 
-    void parseNodeInfo(std::span<const std::string> tokens);
-    void parseTestpointInfo(std::span<const std::string> tokens);
+    void parseHubAlarm(std::span<const std::string_view> tokens);
+    void parseNodeAlarm(std::span<const std::string_view> tokens);
 
-    void parseHubAlarm(std::span<const std::string> tokens);
-    void parseNodeAlarm(std::span<const std::string> tokens);
+    void parseHubStatus(std::span<const std::string_view> tokens);
+    void parseNodeStatus(std::span<const std::string_view> tokens);
 
-    void parseHubStatus(std::span<const std::string> tokens);
-    void parseNodeStatus(std::span<const std::string> tokens);
+    void parseCalibrationProgress(std::span<const std::string_view> tokens);
+    void parseCalibrationResult(std::span<const std::string_view> tokens);
 
-    void parseStatus(std::span<const std::string> tokens);
-    void parseError(std::span<const std::string> tokens);
+    void parseStatus(std::span<const std::string_view> tokens);
+    void parseError(std::span<const std::string_view> tokens);
 
-    void parseVoltammogram(std::span<const std::string> tokens);
-    void parseSensorData(std::span<const std::string> tokens);
+    void parseVoltammogram(std::span<const std::string_view> tokens);
+    void parseSensorData(std::span<const std::string_view> tokens);
 
     void sendData(const std::string& data);
 
@@ -85,7 +106,13 @@ private:
     std::thread m_thread;
     bool m_running = false;
 
+    std::vector<char> m_receiveBuffer;
     std::string m_currentData;
+
+    std::vector<std::string_view> m_tokens;
+
+    std::vector<double> m_voltage;
+    std::vector<double> m_current;
 };
 
 } // End of namespace redex
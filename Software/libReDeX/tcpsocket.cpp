@@ -234,6 +234,13 @@ auto TcpSocket::port() const -> uint16_t
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto TcpSocket::descriptor() const -> intptr_t
+{
+    return static_cast<intptr_t>(d->fd);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void TcpSocket::sendData(std::span<const char> data)
 {
 #if defined(_WIN32)
@@ -284,6 +291,18 @@ auto TcpSocket::readAllData() -> std::vector<char>
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto TcpSocket::readData(std::span<char> buffer) -> size_t
+{
+    const int64_t read = ::recv(d->fd, buffer.data(), buffer.size(), 0);
+
+    if (read < 0)
+        throwSystemError("Reading from TCP socket failed:");
+
+    return static_cast<size_t>(read);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 auto TcpSocket::wait(WaitType type, std::chrono::milliseconds timeout) -> bool
 {
     ::pollfd fd = {};
@@ -100,11 +100,14 @@ public:
     auto address() const -> TcpAddress;
     auto port() const -> uint16_t;
 
+    auto descriptor() const -> intptr_t;
+
     void sendData(std::span<const char> data);
     auto waitForDataWritten(std::chrono::milliseconds timeout = DefaultTimeout) -> bool;
 
     auto waitForDataAvailable(std::chrono::milliseconds timeout = DefaultTimeout) -> bool;
     auto readAllData() -> std::vector<char>;
+    auto readData(std::span<char> buffer) -> size_t;
 
 private:
     enum class WaitType { Read, Write };
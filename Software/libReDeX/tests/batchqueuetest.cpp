@@ -0,0 +1,195 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "batchqueue.h"
+
+#include <sstream>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Logs every call as one line
+class LoggingListener : public Listener
+{
+public:
+    void onStatusChanged(Status status) override
+    {
+        log << "status " << static_cast<int>(status) << "\n";
+    }
+
+    void onConductanceReceived(const std::string& testpointId,
+                               double voltage, double current, double admittance) override
+    {
+        log << "conductance " << testpointId << " "
+            << voltage << " " << current << " " << admittance << "\n";
+    }
+
+    void onOrpValueReceived(const std::string& testpointId, double value) override
+    {
+        log << "orp " << testpointId << " " << value << "\n";
+    }
+
+    void onPhValueReceived(const std::string& testpointId, double value) override
+    {
+        log << "ph " << testpointId << " " << value << "\n";
+    }
+
+    void onVoltammogramReceived(const std::string& testpointId,
+                                std::span<const double> voltage,
+                                std::span<const double> current) override
+    {
+        log << "voltammogram " << testpointId << " " << voltage.size() << " "
+            << voltage.front() << " " << current.back() << "\n";
+    }
+
+    void onHubStatusReceived(double temperature) override
+    {
+        log << "hub " << temperature << "\n";
+    }
+
+    void onError(const std::string& msg) override
+    {
+        log << "error " << msg << "\n";
+    }
+
+    std::ostringstream log;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testArrivalOrder()
+{
+    BatchQueue queue;
+    Listener* hub = queue.listener();
+
+    const std::vector<double> voltage = { 0.1, 0.2, 0.3 };
+    const std::vector<double> current = { 1.0, 2.0, 3.0 };
+
+    hub->onConductanceReceived("TP1", 1, 2, 3);
+    hub->onStatusChanged(Status::MeasurementStarted);
+    hub->onOrpValueReceived("TP2", 4);
+    hub->onVoltammogramReceived("TP1", voltage, current);
+    hub->onError("failed");
+    hub->onPhValueReceived("TP1", 5);
+    hub->onConductanceReceived("TP2", 6, 7, 8);
+
+    Batch batch;
+    CHECK(queue.take(batch, 0ms));
+
+    // Each testpoint ID is stored once
+    CHECK(batch.testpointIds == std::vector<std::string>({ "TP1", "TP2" }));
+    CHECK(batch.conductance.size() == 2);
+    CHECK(batch.conductance[0].testpoint == 0);
+    CHECK(batch.conductance[1].testpoint == 1);
+    CHECK(batch.voltammograms.size() == 1 && batch.voltammograms[0].testpoint == 0);
+
+    CHECK(batch.records.size() == 7);
+    CHECK(batch.records[3].type == RecordType::Voltammogram && batch.records[3].index == 0);
+    CHECK(batch.records[6].type == RecordType::Conductance && batch.records[6].index == 1);
+
+    LoggingListener listener;
+    BatchQueue::dispatch(batch, &listener);
+
+    CHECK(listener.log.str() == "conductance TP1 1 2 3\n"
+                                "status 0\n"
+                                "orp TP2 4\n"
+                                "voltammogram TP1 3 0.1 3\n"
+                                "error failed\n"
+                                "ph TP1 5\n"
+                                "conductance TP2 6 7 8\n");
+
+    // Nothing left
+    CHECK(!queue.take(batch, 0ms));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRecordLimit()
+{
+    static constexpr size_t ExtraRecords = 5;
+
+    BatchQueue queue;
+    Listener* hub = queue.listener();
+
+    for (size_t i = 0; i < BatchQueue::MaximumPendingRecords + ExtraRecords; ++i)
+        hub->onHubStatusReceived(25.0);
+
+    Batch batch;
+    CHECK(queue.take(batch, 0ms));
+
+    CHECK(batch.hubStatus.size() == BatchQueue::MaximumPendingRecords);
+    CHECK(batch.droppedRecords == ExtraRecords);
+
+    // Drops are reported once
+    hub->onHubStatusReceived(25.0);
+
+    CHECK(queue.take(batch, 0ms));
+    CHECK(batch.hubStatus.size() == 1);
+    CHECK(batch.droppedRecords == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSampleLimit()
+{
+    BatchQueue queue;
+    Listener* hub = queue.listener();
+
+    const std::vector<double> samples(BatchQueue::MaximumPendingSamples / 2 + 1, 1.0);
+
+    hub->onVoltammogramReceived("TP1", samples, samples);
+    hub->onVoltammogramReceived("TP1", samples, samples);
+    hub->onHubStatusReceived(25.0);
+
+    Batch batch;
+    CHECK(queue.take(batch, 0ms));
+
+    CHECK(batch.voltammograms.size() == 1);
+    CHECK(batch.voltammogramVoltage.size() == samples.size());
+    CHECK(batch.hubStatus.size() == 1);
+    CHECK(batch.droppedRecords == 1);
+
+    LoggingListener listener;
+    BatchQueue::dispatch(batch, &listener);
+
+    CHECK(listener.log.str().ends_with(
+              "hub 25\nerror 1 records dropped because the listener could not keep up.\n"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testArrivalOrder();
+    testRecordLimit();
+    testSampleLimit();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
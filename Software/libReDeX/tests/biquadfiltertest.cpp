@@ -0,0 +1,182 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "biquadfilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr double Pi = 3.14159265358979323846;
+
+    constexpr double SampleRate = 1000.0;
+
+    // The mains filter of VoltammogramFilter and the PotentiostatViewer
+    auto makeMainsFilter() -> BiquadFilter
+    {
+        return BiquadFilter::notch(45.0 / SampleRate, 55.0 / SampleRate)
+             * BiquadFilter::notch(95.0 / SampleRate, 105.0 / SampleRate)
+             * BiquadFilter::notch(145.0 / SampleRate, 155.0 / SampleRate)
+             * BiquadFilter::lowPass(180.0 / SampleRate);
+    }
+
+    auto sine(double frequency, size_t size, double offset = 0.0) -> std::vector<double>
+    {
+        std::vector<double> signal(size);
+
+        for (size_t i = 0; i < size; ++i)
+            signal[i] = offset + std::sin(2.0 * Pi * frequency * i / SampleRate);
+
+        return signal;
+    }
+
+    // Largest deviation from the offset, after the filter has settled
+    auto amplitude(std::span<const double> signal, size_t skip, double offset = 0.0) -> double
+    {
+        double result = 0.0;
+
+        for (size_t i = skip; i < signal.size() - skip; ++i)
+            result = std::max(result, std::abs(signal[i] - offset));
+
+        return result;
+    }
+
+    auto decibels(double gain) -> double
+    {
+        return 20.0 * std::log10(gain);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testResponse()
+{
+    const BiquadFilter filter = makeMainsFilter();
+
+    // Three notches and a fourth-order low-pass
+    CHECK(filter.size() == 5);
+
+    CHECK_NEAR(decibels(filter.response(0.0)), 0.0, 1e-9);
+    CHECK_NEAR(decibels(filter.response(20.0 / SampleRate)), 0.0, 0.5);
+
+    CHECK(decibels(filter.response(50.0 / SampleRate)) < -100.0);
+    CHECK(decibels(filter.response(100.0 / SampleRate)) < -100.0);
+    CHECK(decibels(filter.response(150.0 / SampleRate)) < -100.0);
+
+    // Butterworth: -3 dB at the cutoff
+    CHECK_NEAR(decibels(BiquadFilter::lowPass(0.1).response(0.1)), -3.01, 0.01);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testMainsRejection()
+{
+    const BiquadFilter filter = makeMainsFilter();
+
+    static constexpr size_t Size = 10000;
+    static constexpr size_t Settling = 2000;
+
+    for (double frequency : { 50.0, 100.0, 150.0 })
+    {
+        const std::vector<double> input = sine(frequency, Size, 1.0);
+        std::vector<double> output(Size);
+
+        BiquadFilter::State state;
+        filter.apply(input, output, &state);
+        CHECK(amplitude(output, Settling, 1.0) < 1e-3);
+
+        filter.apply(input, output);
+        CHECK(amplitude(output, Settling, 1.0) < 1e-3);
+    }
+
+    // The zero-phase mode passes the signal band without delay
+    const std::vector<double> input = sine(10.0, Size);
+    std::vector<double> output(Size);
+
+    filter.apply(input, output);
+
+    for (size_t i = Settling; i < Size - Settling; ++i)
+        CHECK_NEAR(output[i], input[i], 0.01);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testChunks()
+{
+    const BiquadFilter filter = makeMainsFilter();
+
+    std::vector<double> input = sine(50.0, 5000, 2.0);
+
+    for (size_t i = 0; i < input.size(); ++i)
+        input[i] += 0.3 * std::sin(0.37 * i * i);
+
+    std::vector<double> expected(input.size());
+
+    BiquadFilter::State state;
+    filter.apply(input, expected, &state);
+
+    // The state carries over, so the chunks give exactly the one-shot result
+    for (size_t chunkSize : { 1, 3, 64, 1000 })
+    {
+        std::vector<double> output(input.size());
+
+        state.clear();
+
+        for (size_t i = 0; i < input.size(); i += chunkSize)
+        {
+            const size_t size = std::min(chunkSize, input.size() - i);
+
+            filter.apply(std::span(input).subspan(i, size), std::span(output).subspan(i, size),
+                         &state);
+        }
+
+        if (!CHECK(output == expected))
+            std::cerr << "  chunk size " << chunkSize << std::endl;
+    }
+
+    // A new state settles on the first sample, so a constant passes unchanged from the start
+    const std::vector<double> constant(100, 3.0);
+    std::vector<double> output(constant.size());
+
+    state.clear();
+    filter.apply(constant, output, &state);
+
+    for (double value : output)
+        CHECK_NEAR(value, 3.0, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testResponse();
+    testMainsRejection();
+    testChunks();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
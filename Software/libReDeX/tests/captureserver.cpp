@@ -0,0 +1,141 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "captureserver.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------------------------- //
+
+CaptureServer::CaptureServer(const std::string& capture, size_t repeatCount)
+{
+    m_data.reserve(capture.size() * repeatCount);
+
+    for (size_t i = 0; i < repeatCount; ++i)
+        m_data += capture;
+
+    m_server = ::socket(AF_INET, SOCK_STREAM, 0);
+
+    ::sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    ::socklen_t length = sizeof(address);
+
+    if (::bind(m_server, reinterpret_cast<::sockaddr*>(&address), length) < 0 ||
+        ::listen(m_server, 1) < 0 ||
+        ::getsockname(m_server, reinterpret_cast<::sockaddr*>(&address), &length) < 0)
+    {
+        throw std::runtime_error("Unable to start capture server.");
+    }
+
+    m_port = ntohs(address.sin_port);
+    m_thread = std::thread(&CaptureServer::run, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+CaptureServer::~CaptureServer()
+{
+    ::shutdown(m_server, SHUT_RDWR);
+    disconnect();
+
+    m_thread.join();
+
+    ::close(m_server);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CaptureServer::disconnect()
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_client >= 0)
+        ::shutdown(m_client, SHUT_RDWR);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CaptureServer::run()
+{
+    while (true)
+    {
+        const int client = ::accept(m_server, nullptr, nullptr);
+
+        if (client < 0)
+            return;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_client = client;
+        }
+
+        serve(client);
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_client = -1;
+        }
+
+        ::close(client);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CaptureServer::serve(int client)
+{
+    static constexpr std::string_view Preamble = "<WELCOME>\r\n";
+    bool ok = ::send(client, Preamble.data(), Preamble.size(), MSG_NOSIGNAL) > 0;
+
+    std::string request;
+    char buffer[256];
+
+    while (ok && !request.ends_with("\r\n"))
+    {
+        const ssize_t size = ::recv(client, buffer, sizeof(buffer), 0);
+
+        ok = size > 0;
+        request.append(buffer, std::max<ssize_t>(size, 0));
+    }
+
+    ok = ok && request == "<START_MEASUREMENT>\r\n";
+
+    for (size_t offset = 0; ok && offset < m_data.size(); offset += ChunkSize)
+    {
+        const size_t size = std::min(ChunkSize, m_data.size() - offset);
+        ok = ::send(client, m_data.data() + offset, size, MSG_NOSIGNAL) == ssize_t(size);
+    }
+
+    // Further commands are ignored, wait for the client to disconnect
+    while (ok && ::recv(client, buffer, sizeof(buffer), 0) > 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,61 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Sends the capture to each client once it starts a measurement, in chunks smaller than a
+// voltammogram line. Clients are served one after the other.
+class CaptureServer
+{
+public:
+    static constexpr size_t ChunkSize = 1500;
+
+public:
+    CaptureServer(const std::string& capture, size_t repeatCount);
+    ~CaptureServer();
+
+    auto port() const -> uint16_t { return m_port; }
+
+    // Closes the connection to the current client, as if the hub went away
+    void disconnect();
+
+private:
+    void run();
+    void serve(int client);
+
+private:
+    std::string m_data;
+
+    int m_server = -1;
+    uint16_t m_port = 0;
+
+    std::mutex m_mutex;
+    int m_client = -1; // Protected by m_mutex
+
+    std::thread m_thread;
+};
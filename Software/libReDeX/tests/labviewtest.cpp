@@ -0,0 +1,304 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "captureserver.h"
+#include "testing.h"
+
+#include <redex_lv.h>
+
+#include <extcode.h> // LabVIEW stub
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    enum EventRef : redex_lv_event_ref
+    {
+        NodeInfoRef = 1,
+        ConductanceRef,
+        ConductanceBatchRef,
+        OrpRef
+    };
+
+    struct ConductanceEvent
+    {
+        std::string testpointId;
+        double voltage;
+        double current;
+        double admittance;
+    };
+
+    // Copies of the posted data, the handles are reused by the next event
+    std::mutex g_mutex;
+    std::condition_variable g_condition;
+
+    std::vector<std::pair<std::string, std::string>> g_nodeInfo;
+    std::vector<ConductanceEvent> g_conductance;
+    std::vector<size_t> g_conductanceBatchSizes;
+    std::vector<double> g_orpValues;
+
+    auto toString(redex_lv_string_handle handle) -> std::string
+    {
+        return { reinterpret_cast<const char*>((*handle)->bytes),
+                 static_cast<size_t>((*handle)->count) };
+    }
+
+    auto toEvent(const redex_lv_conductance_data& data) -> ConductanceEvent
+    {
+        return { toString(data.testpoint_id), data.voltage, data.current, data.admittance };
+    }
+
+    auto onPost(LVUserEventRef ref, void* data) -> MgErr
+    {
+        std::lock_guard lock(g_mutex);
+
+        switch (ref)
+        {
+        case NodeInfoRef: {
+            const auto infos = static_cast<redex_lv_node_info_data*>(data)->infos;
+
+            for (int32_t i = 0; i < (*infos)->count; ++i)
+            {
+                const redex_lv_node_info& info = (*infos)->entries[i];
+                g_nodeInfo.push_back({ toString(info.id), toString(info.type) });
+            }
+
+            break;
+        }
+
+        case ConductanceRef:
+            g_conductance.push_back(toEvent(*static_cast<redex_lv_conductance_data*>(data)));
+            break;
+
+        case ConductanceBatchRef: {
+            const auto records = static_cast<redex_lv_conductance_batch_data*>(data)->records;
+
+            for (int32_t i = 0; i < (*records)->count; ++i)
+                g_conductance.push_back(toEvent((*records)->entries[i]));
+
+            g_conductanceBatchSizes.push_back((*records)->count);
+            break;
+        }
+
+        case OrpRef:
+            g_orpValues.push_back(static_cast<redex_lv_orp_data*>(data)->value);
+            break;
+        }
+
+        g_condition.notify_all();
+        return mgNoErr;
+    }
+
+    template <typename Predicate>
+    auto waitFor(Predicate predicate) -> bool
+    {
+        std::unique_lock lock(g_mutex);
+        return g_condition.wait_for(lock, 10s, predicate);
+    }
+
+    // The statistics are updated after an event was handled, so they are polled
+    auto waitForPostedEvents(redex_lv_handle handle, uint64_t count) -> redex_lv_statistics
+    {
+        redex_lv_statistics statistics = {};
+        const auto deadline = std::chrono::steady_clock::now() + 10s;
+
+        do {
+            redex_lv_get_statistics(handle, &statistics);
+
+            if (statistics.posted_events >= count)
+                break;
+
+            std::this_thread::sleep_for(1ms);
+        } while (std::chrono::steady_clock::now() < deadline);
+
+        return statistics;
+    }
+
+    void reset()
+    {
+        std::lock_guard lock(g_mutex);
+
+        g_nodeInfo.clear();
+        g_conductance.clear();
+        g_conductanceBatchSizes.clear();
+        g_orpValues.clear();
+    }
+
+    // Conductance values of four testpoints, followed by an ORP value
+    auto makeCapture(size_t conductanceCount) -> std::string
+    {
+        std::string capture = "<NODE_INFO>\x1f" "2\x1fN1;Potentiostat\x1fN2;Conductance\r\n";
+
+        for (size_t i = 0; i < conductanceCount; ++i)
+        {
+            capture += "<CONDUCTANCE>\x1fTP" + std::to_string(i % 4 + 1) + "\x1f" +
+                       std::to_string(i) + ";0.5;0.25\r\n";
+        }
+
+        capture += "<ORP>\x1fTP1\x1f" "0.125\r\n";
+
+        return capture;
+    }
+
+    auto connect(const CaptureServer& server) -> redex_lv_handle
+    {
+        redex_lv_handle handle = nullptr;
+        const std::string host = "127.0.0.1:" + std::to_string(server.port());
+
+        if (redex_lv_connect(host.c_str(), &handle) != REDEX_LV_SUCCESS)
+            throw std::runtime_error("Unable to connect.");
+
+        redex_lv_event_ref nodeInfoRef = NodeInfoRef;
+        redex_lv_event_ref orpRef = OrpRef;
+
+        redex_lv_register_node_info_event(handle, &nodeInfoRef);
+        redex_lv_register_orp_event(handle, &orpRef);
+
+        return handle;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSingleEvents()
+{
+    static constexpr size_t ConductanceCount = 1000;
+
+    reset();
+
+    CaptureServer server(makeCapture(ConductanceCount), 1);
+    redex_lv_handle handle = connect(server);
+
+    redex_lv_event_ref conductanceRef = ConductanceRef;
+    redex_lv_register_conductance_event(handle, &conductanceRef);
+
+    CHECK(redex_lv_start_measurement(handle) == REDEX_LV_SUCCESS);
+    CHECK(waitFor([] { return !g_orpValues.empty(); }));
+
+    {
+        std::lock_guard lock(g_mutex);
+
+        // The node info array is aligned like LabVIEW expects it
+        CHECK(g_nodeInfo.size() == 2);
+        CHECK(g_nodeInfo[0] == std::make_pair(std::string("N1"), std::string("Potentiostat")));
+        CHECK(g_nodeInfo[1] == std::make_pair(std::string("N2"), std::string("Conductance")));
+
+        if (CHECK(g_conductance.size() == ConductanceCount))
+        {
+            for (size_t i = 0; i < ConductanceCount; ++i)
+            {
+                CHECK(g_conductance[i].testpointId == "TP" + std::to_string(i % 4 + 1));
+                CHECK_NEAR(g_conductance[i].voltage, double(i), 1e-12);
+            }
+        }
+    }
+
+    // Handles are reused from event to event instead of being allocated for each of them
+    CHECK(LVStubHandleCount() < 10);
+
+    const redex_lv_statistics statistics = waitForPostedEvents(handle, ConductanceCount + 2);
+
+    CHECK(statistics.posted_events == ConductanceCount + 2);
+    CHECK(statistics.coalesced_records == 0);
+    CHECK(statistics.dropped_records == 0);
+
+    redex_lv_close(handle);
+    CHECK(LVStubHandleCount() == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBatchEvents()
+{
+    static constexpr size_t ConductanceCount = 1000;
+    static constexpr size_t MaximumBatchSize = 100;
+
+    reset();
+
+    CaptureServer server(makeCapture(ConductanceCount), 1);
+    redex_lv_handle handle = connect(server);
+
+    // Records of kinds without a batch event are still posted on their own
+    redex_lv_event_ref conductanceBatchRef = ConductanceBatchRef;
+    redex_lv_register_conductance_batch_event(handle, &conductanceBatchRef);
+
+    CHECK(redex_lv_set_batching(handle, 10, MaximumBatchSize) == REDEX_LV_SUCCESS);
+    CHECK(redex_lv_start_measurement(handle) == REDEX_LV_SUCCESS);
+
+    CHECK(waitFor([] { return g_conductance.size() == ConductanceCount && !g_orpValues.empty(); }));
+
+    size_t batchCount = 0;
+
+    {
+        std::lock_guard lock(g_mutex);
+
+        for (size_t i = 0; i < g_conductance.size(); ++i)
+            CHECK_NEAR(g_conductance[i].voltage, double(i), 1e-12);
+
+        for (size_t size : g_conductanceBatchSizes)
+            CHECK(size > 0 && size <= MaximumBatchSize);
+
+        batchCount = g_conductanceBatchSizes.size();
+        CHECK_NEAR(g_orpValues.front(), 0.125, 1e-12);
+    }
+
+    CHECK(batchCount >= ConductanceCount / MaximumBatchSize);
+
+    const redex_lv_statistics statistics = waitForPostedEvents(handle, batchCount + 2);
+
+    CHECK(statistics.posted_events == batchCount + 2);
+    CHECK(statistics.coalesced_records == ConductanceCount);
+    CHECK(statistics.dropped_records == 0);
+
+    redex_lv_close(handle);
+    CHECK(LVStubHandleCount() == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    LVStubSetPostHandler(onPost);
+
+    try {
+        testSingleEvents();
+        testBatchEvents();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
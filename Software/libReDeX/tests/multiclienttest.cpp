@@ -0,0 +1,249 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+#include "captureserver.h"
+#include "testing.h"
+
+#include <redex.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+using namespace std::chrono_literals;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr size_t ValueCount = 500;
+
+    // The testpoint ID names the hub, the values count up from zero
+    auto makeCapture(size_t hub) -> std::string
+    {
+        std::string capture;
+
+        for (size_t i = 0; i < ValueCount; ++i)
+            capture += "<ORP>\x1fHUB" + std::to_string(hub) + "\x1f" + std::to_string(i) + "\r\n";
+
+        return capture;
+    }
+
+    auto hostOf(const CaptureServer& server) -> std::string
+    {
+        return "127.0.0.1:" + std::to_string(server.port());
+    }
+
+    struct OrpValue
+    {
+        std::string testpointId;
+        double value;
+    };
+
+    // Everything taken from the client so far
+    class Received
+    {
+    public:
+        explicit Received(size_t hubCount)
+            : orpValues(hubCount), errors(hubCount) {}
+
+        void poll(MultiClient& client, std::function<bool()> complete);
+
+    public:
+        std::vector<std::vector<OrpValue>> orpValues; // Per hub
+        std::vector<std::vector<std::string>> errors; // Per hub
+
+        std::vector<MergedRecord> merged;
+        std::vector<OrpValue> mergedOrpValues;
+
+    private:
+        MultiBatch m_batch;
+    };
+
+    void Received::poll(MultiClient& client, std::function<bool()> complete)
+    {
+        const auto end = std::chrono::steady_clock::now() + 5s;
+
+        while (!complete() && std::chrono::steady_clock::now() < end)
+        {
+            if (!client.poll(m_batch, 100ms))
+                continue;
+
+            for (size_t hub = 0; hub < m_batch.hubs.size(); ++hub)
+            {
+                const Batch& batch = m_batch.hubs[hub];
+
+                for (const SensorRecord& record : batch.orpValues)
+                {
+                    const std::string& testpointId = batch.testpointIds[record.testpoint];
+                    orpValues[hub].push_back({ testpointId, record.value });
+                }
+
+                errors[hub].insert(errors[hub].end(), batch.errors.begin(), batch.errors.end());
+            }
+
+            for (const MergedRecord& record : m_batch.merged)
+            {
+                merged.push_back(record);
+
+                if (record.type == RecordType::OrpValue)
+                {
+                    const Batch& batch = m_batch.hubs[record.hub];
+                    const SensorRecord& value = batch.orpValues.at(record.index);
+
+                    mergedOrpValues.push_back({ batch.testpointIds[value.testpoint], value.value });
+                }
+            }
+        }
+    }
+
+    // The values of one hub arrived complete and in order
+    auto checkValues(const std::vector<OrpValue>& values, size_t hub, size_t first = 0) -> bool
+    {
+        bool valid = values.size() == first + ValueCount;
+
+        for (size_t i = first; valid && i < values.size(); ++i)
+        {
+            valid = values[i].testpointId == "HUB" + std::to_string(hub) &&
+                    values[i].value == static_cast<double>(i - first);
+        }
+
+        return CHECK(valid);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTaggedAndMerged()
+{
+    CaptureServer first(makeCapture(0), 1);
+    CaptureServer second(makeCapture(1), 1);
+
+    MultiClient client({ hostOf(first), hostOf(second) }, true);
+
+    CHECK(client.isConnected(0));
+    CHECK(client.isConnected(1));
+
+    client.startMeasurement(0);
+    client.startMeasurement(1);
+
+    Received received(2);
+
+    received.poll(client, [&] {
+        return received.mergedOrpValues.size() >= 2 * ValueCount;
+    });
+
+    // Every value is reported for the hub that sent it
+    checkValues(received.orpValues[0], 0);
+    checkValues(received.orpValues[1], 1);
+
+    CHECK(received.errors[0].empty());
+    CHECK(received.errors[1].empty());
+
+    // The merged list refers to the right hub and keeps the order of each hub
+    std::vector<std::vector<OrpValue>> mergedPerHub(2);
+    bool tagged = true;
+    bool ordered = true;
+
+    for (size_t i = 0; i < received.merged.size(); ++i)
+    {
+        const MergedRecord& record = received.merged[i];
+        const OrpValue& value = received.mergedOrpValues[i];
+
+        tagged = tagged && value.testpointId == "HUB" + std::to_string(record.hub);
+        ordered = ordered && (i == 0 || received.merged[i - 1].time <= record.time);
+
+        mergedPerHub.at(record.hub).push_back(value);
+    }
+
+    CHECK(tagged);
+    CHECK(ordered);
+
+    checkValues(mergedPerHub[0], 0);
+    checkValues(mergedPerHub[1], 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDisconnectAndReconnect()
+{
+    CaptureServer first(makeCapture(0), 1);
+    CaptureServer second(makeCapture(1), 1);
+
+    MultiClient client({ hostOf(first), hostOf(second) });
+
+    Received received(2);
+
+    // The second hub goes away before the first one sends anything
+    second.disconnect();
+
+    received.poll(client, [&] { return !received.errors[1].empty(); });
+
+    CHECK(received.errors[1].size() == 1);
+    CHECK(!client.isConnected(1));
+    CHECK_THROWS(client.startMeasurement(1));
+
+    // The first hub is served regardless
+    CHECK(client.isConnected(0));
+    client.startMeasurement(0);
+
+    received.poll(client, [&] { return received.orpValues[0].size() >= ValueCount; });
+
+    checkValues(received.orpValues[0], 0);
+    CHECK(received.errors[0].empty());
+    CHECK(received.orpValues[1].empty());
+
+    // After reconnecting, the second hub delivers its values again
+    client.reconnect(1);
+
+    if (!CHECK(client.isConnected(1)))
+        return;
+
+    client.startMeasurement(1);
+
+    received.poll(client, [&] { return received.orpValues[1].size() >= ValueCount; });
+
+    checkValues(received.orpValues[1], 1);
+    CHECK(received.errors[1].size() == 1);
+    CHECK(received.orpValues[0].size() == ValueCount);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    try {
+        testTaggedAndMerged();
+        testDisconnectAndReconnect();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
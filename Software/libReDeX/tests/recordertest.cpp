@@ -0,0 +1,546 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+#include "testing.h"
+#include "recorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+using namespace std::chrono_literals;
+
+namespace fs = std::filesystem;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr size_t BinaryHeaderSize = 8 + sizeof(uint32_t);
+    constexpr size_t BinaryRecordHeaderSize = 8 + 2 + 1 + 4;
+
+    // An empty directory, removed again at the end of the test
+    class TemporaryDirectory
+    {
+    public:
+        explicit TemporaryDirectory(const std::string& name)
+            : m_path(fs::temp_directory_path() /
+                     ("redex_" + name + "_" + std::to_string(::getpid())))
+        {
+            fs::remove_all(m_path);
+        }
+
+        ~TemporaryDirectory() { fs::remove_all(m_path); }
+
+        auto path() const -> const fs::path& { return m_path; }
+
+        // Sorted by name, which is the order in which they were written
+        auto files() const -> std::vector<fs::path>
+        {
+            std::vector<fs::path> result;
+
+            for (const auto& entry : fs::directory_iterator(m_path))
+                result.push_back(entry.path());
+
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+    private:
+        fs::path m_path;
+    };
+
+    auto readFile(const fs::path& path) -> std::string
+    {
+        std::ifstream file(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+
+    // Reads the binary format as documented in redex.h
+    class BinaryReader
+    {
+    public:
+        explicit BinaryReader(const std::string& data) : m_data(data) {}
+
+        auto atEnd() const -> bool { return m_offset >= m_data.size(); }
+        auto valid() const -> bool { return m_valid; }
+
+        template <typename T>
+        auto read() -> T
+        {
+            T value = {};
+
+            if (m_offset + sizeof(T) > m_data.size())
+            {
+                m_valid = false;
+                return value;
+            }
+
+            std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+
+            return value;
+        }
+
+        auto string() -> std::string
+        {
+            const auto size = read<uint16_t>();
+
+            if (m_offset + size > m_data.size())
+            {
+                m_valid = false;
+                return {};
+            }
+
+            m_offset += size;
+            return m_data.substr(m_offset - size, size);
+        }
+
+        auto offset() const -> size_t { return m_offset; }
+
+    private:
+        const std::string& m_data;
+        size_t m_offset = 0;
+        bool m_valid = true;
+    };
+
+    struct BinaryRecord
+    {
+        int64_t time;
+        uint16_t hub;
+        RecordType type;
+        uint32_t size;
+    };
+
+    auto readRecord(BinaryReader& reader) -> BinaryRecord
+    {
+        BinaryRecord record;
+
+        record.time = reader.read<int64_t>();
+        record.hub = reader.read<uint16_t>();
+        record.type = static_cast<RecordType>(reader.read<uint8_t>());
+        record.size = reader.read<uint32_t>();
+
+        return record;
+    }
+
+    // One record of each kind that carries values
+    auto makeBatch() -> Batch
+    {
+        Batch batch;
+
+        batch.nodeInfo = { { "N1", "Potentiostat" }, { "N2", "Conductance" } };
+
+        batch.conductance.push_back({ batch.addTestpointId("TP1"), 0.05, 1.25e-4, 2.5e-3 });
+        batch.orpValues.push_back({ batch.addTestpointId("TP2"), 0.2134 });
+
+        batch.voltammogramVoltage = { -0.5, 0.0, 0.5 };
+        batch.voltammogramCurrent = { 1e-6, 2e-6, 3e-6 };
+        batch.voltammograms.push_back({ batch.addTestpointId("TP1"), 0, 3 });
+
+        batch.errors.push_back("Connection lost, \"hub 1\"");
+
+        return batch;
+    }
+
+    void addAll(Recorder& recorder, const Batch& batch, size_t hub)
+    {
+        recorder.add(hub, RecordType::NodeInfo, batch, 0);
+        recorder.add(hub, RecordType::Conductance, batch, 0);
+        recorder.add(hub, RecordType::OrpValue, batch, 0);
+        recorder.add(hub, RecordType::Voltammogram, batch, 0);
+        recorder.add(hub, RecordType::Error, batch, 0);
+    }
+
+    // The writer thread picks up a full buffer right away
+    auto waitForRecords(const Recorder& recorder, uint64_t count) -> bool
+    {
+        const auto end = std::chrono::steady_clock::now() + 5s;
+
+        while (recorder.statistics().records < count && std::chrono::steady_clock::now() < end)
+            std::this_thread::sleep_for(1ms);
+
+        return recorder.statistics().records >= count;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testBinaryRoundTrip()
+{
+    TemporaryDirectory directory("binary");
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.format = RecordFormat::Binary;
+
+    const Batch batch = makeBatch();
+    const auto before = std::chrono::system_clock::now();
+
+    Recorder recorder;
+    recorder.start(settings);
+    CHECK(recorder.isActive());
+
+    addAll(recorder, batch, 3);
+    recorder.stop();
+
+    const auto after = std::chrono::system_clock::now();
+
+    const RecorderStatistics statistics = recorder.statistics();
+
+    CHECK(statistics.records == 5);
+    CHECK(statistics.droppedRecords == 0);
+    CHECK(statistics.files == 1);
+    CHECK(statistics.writeErrors == 0);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (!CHECK(files.size() == 1))
+        return;
+
+    CHECK(files[0].extension() == ".rdx");
+
+    const std::string data = readFile(files[0]);
+    CHECK(data.size() == BinaryHeaderSize + statistics.bytes);
+
+    BinaryReader reader(data);
+
+    CHECK(data.compare(0, 8, "REDEXREC") == 0);
+    reader.read<uint64_t>();
+    CHECK(reader.read<uint32_t>() == 1);
+
+    const std::vector<RecordType> types = {
+        RecordType::NodeInfo, RecordType::Conductance, RecordType::OrpValue,
+        RecordType::Voltammogram, RecordType::Error
+    };
+
+    for (const RecordType type : types)
+    {
+        const BinaryRecord record = readRecord(reader);
+        const size_t payload = reader.offset();
+
+        CHECK(record.type == type);
+        CHECK(record.hub == 3);
+        CHECK(record.time >= std::chrono::nanoseconds(before.time_since_epoch()).count());
+        CHECK(record.time <= std::chrono::nanoseconds(after.time_since_epoch()).count());
+
+        switch (type)
+        {
+        case RecordType::NodeInfo:
+            CHECK(reader.read<uint32_t>() == 2);
+            CHECK(reader.string() == "N1");
+            CHECK(reader.string() == "Potentiostat");
+            CHECK(reader.string() == "N2");
+            CHECK(reader.string() == "Conductance");
+            break;
+
+        case RecordType::Conductance:
+            CHECK(reader.string() == "TP1");
+            CHECK(reader.read<double>() == 0.05);
+            CHECK(reader.read<double>() == 1.25e-4);
+            CHECK(reader.read<double>() == 2.5e-3);
+            break;
+
+        case RecordType::OrpValue:
+            CHECK(reader.string() == "TP2");
+            CHECK(reader.read<double>() == 0.2134);
+            break;
+
+        case RecordType::Voltammogram: {
+            CHECK(reader.string() == "TP1");
+
+            // One length for both the voltage and the current samples
+            const auto size = reader.read<uint32_t>();
+
+            if (!CHECK(size == 3))
+                return;
+
+            for (const double voltage : batch.voltammogramVoltage)
+                CHECK(reader.read<double>() == voltage);
+
+            for (const double current : batch.voltammogramCurrent)
+                CHECK(reader.read<double>() == current);
+
+            break;
+        }
+
+        default:
+            CHECK(reader.string() == "Connection lost, \"hub 1\"");
+            break;
+        }
+
+        CHECK(reader.offset() - payload == record.size);
+    }
+
+    CHECK(reader.valid());
+    CHECK(reader.atEnd());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCsvRoundTrip()
+{
+    TemporaryDirectory directory("csv");
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.prefix = "test";
+    settings.format = RecordFormat::Csv;
+
+    const Batch batch = makeBatch();
+
+    Recorder recorder;
+    recorder.start(settings);
+
+    addAll(recorder, batch, 1);
+    recorder.stop();
+
+    CHECK(recorder.statistics().records == 5);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (!CHECK(files.size() == 1))
+        return;
+
+    CHECK(files[0].extension() == ".csv");
+    CHECK(files[0].filename().string().starts_with("test_"));
+
+    std::istringstream file(readFile(files[0]));
+    std::vector<std::string> lines;
+
+    for (std::string line; std::getline(file, line);)
+        lines.push_back(line);
+
+    if (!CHECK(lines.size() == 6))
+        return;
+
+    CHECK(lines[0] == "time,hub,type,fields");
+
+    // The time is left out, it differs from run to run
+    const auto fields = [](const std::string& line) {
+        const size_t comma = line.find(',');
+        return comma == std::string::npos ? std::string() : line.substr(comma + 1);
+    };
+
+    CHECK(fields(lines[1]) == "1,NodeInfo,2,N1,Potentiostat,N2,Conductance");
+    CHECK(fields(lines[2]) == "1,Conductance,TP1,0.05,0.000125,0.0025");
+    CHECK(fields(lines[3]) == "1,OrpValue,TP2,0.2134");
+    CHECK(fields(lines[4]) == "1,Voltammogram,TP1,3,-0.5,0,0.5,1e-06,2e-06,3e-06");
+    CHECK(fields(lines[5]) == "1,Error,\"Connection lost, \"\"hub 1\"\"\"");
+
+    // Seconds since the epoch with microseconds
+    const std::string time = lines[1].substr(0, lines[1].find(','));
+    const size_t dot = time.find('.');
+
+    CHECK(dot != std::string::npos && time.size() - dot == 7);
+    CHECK(std::abs(std::stod(time) - static_cast<double>(std::time(nullptr))) < 10.0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSizeRotation()
+{
+    TemporaryDirectory directory("size");
+
+    const Batch batch = makeBatch();
+
+    // TP2 and one value
+    const size_t recordSize = BinaryRecordHeaderSize + 2 + 3 + sizeof(double);
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.bufferSize = 1;
+    settings.maxFileSize = BinaryHeaderSize + 2 * recordSize;
+
+    Recorder recorder;
+    recorder.start(settings);
+
+    // Every record is written on its own, so each file takes exactly two
+    for (uint64_t i = 1; i <= 6; ++i)
+    {
+        recorder.add(0, RecordType::OrpValue, batch, 0);
+        CHECK(waitForRecords(recorder, i));
+    }
+
+    recorder.stop();
+
+    CHECK(recorder.statistics().files == 3);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (!CHECK(files.size() == 3))
+        return;
+
+    for (const fs::path& file : files)
+        CHECK(fs::file_size(file) == settings.maxFileSize);
+
+    // The files are numbered in the order they were started
+    for (size_t i = 0; i < files.size(); ++i)
+        CHECK(files[i].stem().string().ends_with("_000" + std::to_string(i)));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTimeRotation()
+{
+    TemporaryDirectory directory("time");
+
+    const Batch batch = makeBatch();
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.bufferSize = 1;
+    settings.maxFileDuration = 1s;
+
+    Recorder recorder;
+    recorder.start(settings);
+
+    recorder.add(0, RecordType::OrpValue, batch, 0);
+    recorder.add(0, RecordType::OrpValue, batch, 0);
+    CHECK(waitForRecords(recorder, 2));
+
+    std::this_thread::sleep_for(1100ms);
+
+    recorder.add(0, RecordType::OrpValue, batch, 0);
+    recorder.stop();
+
+    CHECK(recorder.statistics().records == 3);
+    CHECK(recorder.statistics().files == 2);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (!CHECK(files.size() == 2))
+        return;
+
+    const size_t recordSize = BinaryRecordHeaderSize + 2 + 3 + sizeof(double);
+
+    CHECK(fs::file_size(files[0]) == BinaryHeaderSize + 2 * recordSize);
+    CHECK(fs::file_size(files[1]) == BinaryHeaderSize + recordSize);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTypeFilter()
+{
+    TemporaryDirectory directory("filter");
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.format = RecordFormat::Csv;
+    settings.types = { RecordType::OrpValue, RecordType::Error };
+
+    Recorder recorder;
+    recorder.start(settings);
+
+    addAll(recorder, makeBatch(), 0);
+    recorder.stop();
+
+    CHECK(recorder.statistics().records == 2);
+    CHECK(recorder.statistics().droppedRecords == 0);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (!CHECK(files.size() == 1))
+        return;
+
+    const std::string data = readFile(files[0]);
+
+    CHECK(std::count(data.begin(), data.end(), '\n') == 3);
+    CHECK(data.find(",OrpValue,") != std::string::npos);
+    CHECK(data.find(",Error,") != std::string::npos);
+    CHECK(data.find(",Conductance,") == std::string::npos);
+    CHECK(data.find(",Voltammogram,") == std::string::npos);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDroppedRecords()
+{
+    TemporaryDirectory directory("dropped");
+
+    Batch batch = makeBatch();
+
+    // Larger than all records that may be pending
+    batch.voltammogramVoltage.assign(1000, 0.5);
+    batch.voltammogramCurrent.assign(1000, 1e-6);
+    batch.voltammograms[0].size = 1000;
+
+    RecorderSettings settings;
+    settings.directory = directory.path().string();
+    settings.bufferSize = 1024;
+    settings.maxPending = 1024;
+
+    Recorder recorder;
+    recorder.start(settings);
+
+    recorder.add(0, RecordType::OrpValue, batch, 0);
+    recorder.add(0, RecordType::Voltammogram, batch, 0);
+    recorder.add(0, RecordType::Voltammogram, batch, 0);
+    recorder.add(0, RecordType::Conductance, batch, 0);
+
+    recorder.stop();
+
+    const RecorderStatistics statistics = recorder.statistics();
+
+    CHECK(statistics.droppedRecords == 2);
+    CHECK(statistics.records == 2);
+
+    const std::vector<fs::path> files = directory.files();
+
+    if (CHECK(files.size() == 1))
+        CHECK(fs::file_size(files[0]) == BinaryHeaderSize + statistics.bytes);
+
+    // Starting again resets the statistics
+    recorder.start(settings);
+    CHECK(recorder.statistics().droppedRecords == 0);
+    recorder.stop();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    try {
+        testBinaryRoundTrip();
+        testCsvRoundTrip();
+        testSizeRotation();
+        testTimeRotation();
+        testTypeFilter();
+        testDroppedRecords();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,259 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "rollingstatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+using namespace std::chrono_literals;
+
+using Clock = RollingWindow::Clock;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Statistics of the samples computed from scratch
+static auto expectedStatistics(const std::vector<double>& times, const std::vector<double>& values)
+    -> Statistics
+{
+    const double n = static_cast<double>(values.size());
+
+    double meanTime = 0.0;
+    double meanValue = 0.0;
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        meanTime += times[i] / n;
+        meanValue += values[i] / n;
+    }
+
+    double timeSquares = 0.0;
+    double valueSquares = 0.0;
+    double products = 0.0;
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        timeSquares += (times[i] - meanTime) * (times[i] - meanTime);
+        valueSquares += (values[i] - meanValue) * (values[i] - meanValue);
+        products += (times[i] - meanTime) * (values[i] - meanValue);
+    }
+
+    return { values.size(), meanValue, std::sqrt(valueSquares / (n - 1)),
+             *std::min_element(values.begin(), values.end()),
+             *std::max_element(values.begin(), values.end()), products / timeSquares };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testCountWindow()
+{
+    static constexpr size_t WindowSize = 50;
+
+    RollingWindow window({ WindowSize, 0ms });
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    const Clock::time_point start = Clock::now();
+
+    std::vector<double> times;
+    std::vector<double> values;
+
+    // Long enough for the running sums to be recomputed a few times
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        const double time = 0.01 * i;
+        const double value = 1000.0 + 2.0 * time + distribution(generator);
+
+        window.add(value, start + std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double>(time)));
+
+        times.push_back(time);
+        values.push_back(value);
+
+        if (values.size() > WindowSize)
+        {
+            times.erase(times.begin());
+            values.erase(values.begin());
+        }
+
+        if (i % 97 != 0 && i < 4990)
+            continue;
+
+        const Statistics statistics = window.statistics();
+        const Statistics expected = expectedStatistics(times, values);
+
+        CHECK(statistics.count == expected.count);
+        CHECK_NEAR(statistics.mean, expected.mean, 1e-9);
+        CHECK(statistics.minimum == expected.minimum);
+        CHECK(statistics.maximum == expected.maximum);
+
+        if (values.size() > 1)
+        {
+            CHECK_NEAR(statistics.standardDeviation, expected.standardDeviation, 1e-9);
+            CHECK_NEAR(statistics.slope, expected.slope, 1e-6);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDurationWindow()
+{
+    RollingWindow window({ 0, 100ms });
+
+    const Clock::time_point start = Clock::now();
+
+    window.add(5.0, start);
+    window.add(1.0, start + 50ms);
+    window.add(3.0, start + 100ms);
+
+    Statistics statistics = window.statistics();
+
+    CHECK(statistics.count == 3);
+    CHECK(statistics.minimum == 1.0 && statistics.maximum == 5.0);
+
+    // The oldest sample expires, and with it the maximum
+    window.expire(start + 120ms);
+    statistics = window.statistics();
+
+    CHECK(statistics.count == 2);
+    CHECK_NEAR(statistics.mean, 2.0, 1e-12);
+    CHECK(statistics.minimum == 1.0 && statistics.maximum == 3.0);
+    CHECK_NEAR(statistics.slope, 40.0, 1e-9);
+
+    window.expire(start + 1s);
+    statistics = window.statistics();
+
+    CHECK(statistics.count == 0);
+    CHECK(std::isnan(statistics.mean) && std::isnan(statistics.minimum));
+
+    window.add(7.0, start + 2s);
+    statistics = window.statistics();
+
+    CHECK(statistics.count == 1);
+    CHECK(statistics.mean == 7.0);
+    CHECK(std::isnan(statistics.standardDeviation) && std::isnan(statistics.slope));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testNonFiniteValues()
+{
+    static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+    static constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+    RollingWindow window({ 3, 100ms });
+
+    const Clock::time_point start = Clock::now();
+
+    window.add(1.0, start);
+    window.add(NaN, start + 10ms);
+    window.add(3.0, start + 20ms);
+    window.add(Infinity, start + 30ms);
+    window.add(-Infinity, start + 40ms);
+
+    Statistics statistics = window.statistics();
+
+    CHECK(statistics.count == 2);
+    CHECK_NEAR(statistics.mean, 2.0, 1e-12);
+    CHECK_NEAR(statistics.standardDeviation, std::sqrt(2.0), 1e-12);
+    CHECK(statistics.minimum == 1.0 && statistics.maximum == 3.0);
+    CHECK_NEAR(statistics.slope, 100.0, 1e-9);
+
+    // Skipped values don't take up room in the window
+    window.add(5.0, start + 50ms);
+    statistics = window.statistics();
+
+    CHECK(statistics.count == 3);
+    CHECK_NEAR(statistics.mean, 3.0, 1e-12);
+
+    // But the time of a skipped value still expires old samples
+    window.add(NaN, start + 1s);
+    statistics = window.statistics();
+
+    CHECK(statistics.count == 0);
+    CHECK(std::isnan(statistics.mean));
+
+    window.add(7.0, start + 2s);
+    CHECK(window.statistics().mean == 7.0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testRollingStatistics()
+{
+    RollingStatistics statistics(2);
+
+    CHECK(!statistics.isEnabled());
+    CHECK_THROWS(statistics.setWindows({ StatisticsWindow() }));
+
+    statistics.setWindows({ { 2, 0ms }, { 10, 0ms } });
+    CHECK(statistics.isEnabled());
+
+    const Clock::time_point now = Clock::now();
+
+    for (double value : { 1.0, 2.0, 3.0 })
+        statistics.add(1, "TP1", Channel::Ph, value, now);
+
+    // Values of an unknown hub are dropped instead of written out of bounds
+    statistics.add(2, "TP1", Channel::Ph, 100.0, now);
+
+    CHECK(statistics.statistics(1, "TP1", Channel::Ph, 0).count == 2);
+    CHECK(statistics.statistics(1, "TP1", Channel::Ph, 1).count == 3);
+    CHECK_NEAR(statistics.statistics(1, "TP1", Channel::Ph, 1).mean, 2.0, 1e-12);
+
+    CHECK(statistics.statistics(0, "TP1", Channel::Ph, 0).count == 0);
+    CHECK(statistics.statistics(1, "TP1", Channel::Orp, 0).count == 0);
+    CHECK(statistics.statistics(1, "TP2", Channel::Ph, 0).count == 0);
+
+    CHECK_THROWS(statistics.statistics(1, "TP1", Channel::Ph, 2));
+    CHECK_THROWS(statistics.statistics(2, "TP1", Channel::Ph, 0));
+
+    // New windows start from scratch
+    statistics.setWindows({ { 5, 0ms } });
+    CHECK(statistics.statistics(1, "TP1", Channel::Ph, 0).count == 0);
+
+    statistics.setWindows({});
+    CHECK(!statistics.isEnabled());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testCountWindow();
+    testDurationWindow();
+    testNonFiniteValues();
+    testRollingStatistics();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,240 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "sincfilter.h"
+#include "voltammogramfilter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr size_t VoltammogramFilterSize = 121;
+
+    // Relative to the largest output value
+    constexpr double FftTolerance = 1e-13;
+
+    auto randomSignal(size_t size) -> std::vector<double>
+    {
+        static std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        std::vector<double> signal(size);
+        std::generate(signal.begin(), signal.end(), [&] { return distribution(generator); });
+
+        return signal;
+    }
+
+    // The nested loop the optimized paths are compared against
+    auto convolve(std::span<const double> signal, std::span<const double> kernel)
+        -> std::vector<double>
+    {
+        std::vector<double> out(signal.size() + kernel.size() - 1, 0.0);
+
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            for (size_t j = 0; j < kernel.size(); ++j)
+                out[i + j] += signal[i] * kernel[j];
+        }
+
+        return out;
+    }
+
+    auto maximumDeviation(std::span<const double> values, std::span<const double> expected)
+        -> double
+    {
+        double peak = 0.0;
+        double deviation = 0.0;
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            peak = std::max(peak, std::abs(expected[i]));
+            deviation = std::max(deviation, std::abs(values[i] - expected[i]));
+        }
+
+        return peak > 0.0 ? deviation / peak : deviation;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDirectConvolution()
+{
+    // Kernels below eight taps use the plain loop, the others the vectorized one
+    for (size_t taps : { 3, 7, 9, 31, 33, 121 })
+    {
+        const SincFilter filter = SincFilter::lowPass(taps, 0.2);
+
+        // Signals shorter than a block of outputs and shorter than the kernel included
+        for (size_t size : { 1, 2, 7, 8, 9, 17, 100, 333 })
+        {
+            const std::vector<double> signal = randomSignal(size);
+            const std::vector<double> expected = convolve(signal, filter.coefficients());
+
+            // The output may be longer than the result, the rest is set to zero
+            std::vector<double> output(expected.size() + 5, 1.0);
+            filter.apply(signal, output);
+
+            // The products are added in the same order, so the result is identical
+            const bool identical = std::equal(expected.begin(), expected.end(), output.begin());
+            const bool padded = std::all_of(output.begin() + expected.size(), output.end(),
+                                            [](double value) { return value == 0.0; });
+
+            if (!CHECK(identical && padded))
+                std::cerr << "  " << taps << " taps, signal size " << size << std::endl;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testFftConvolution()
+{
+    const SincFilter filter = SincFilter::lowPass(VoltammogramFilterSize, 0.18);
+
+    // Short signals take the direct path, the longer ones the FFT path
+    for (size_t size : { 100, 483, 484, 1000, 1024, 5000, 20011 })
+    {
+        const std::vector<double> signal = randomSignal(size);
+        const std::vector<double> expected = convolve(signal, filter.coefficients());
+
+        std::vector<double> output(expected.size());
+        filter.apply(signal, output);
+
+        if (!CHECK(maximumDeviation(output, expected) < FftTolerance))
+            std::cerr << "  signal size " << size << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testFftPlans()
+{
+    // The plan of each thread follows the kernel in use
+    const SincFilter lowPass = SincFilter::lowPass(VoltammogramFilterSize, 0.18);
+    const SincFilter highPass = SincFilter::highPass(2 * VoltammogramFilterSize + 1, 0.05);
+
+    const std::vector<double> signal = randomSignal(4000);
+
+    const std::vector<double> expectedLowPass = convolve(signal, lowPass.coefficients());
+    const std::vector<double> expectedHighPass = convolve(signal, highPass.coefficients());
+
+    std::atomic<size_t> failures = 0;
+
+    const auto run = [&] {
+        std::vector<double> output;
+
+        for (size_t i = 0; i < 20; ++i)
+        {
+            const bool odd = i % 2 == 1;
+
+            const SincFilter& filter = odd ? highPass : lowPass;
+            const std::vector<double>& expected = odd ? expectedHighPass : expectedLowPass;
+
+            output.resize(expected.size());
+            filter.apply(signal, output);
+
+            if (maximumDeviation(output, expected) >= FftTolerance)
+                ++failures;
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < 4; ++i)
+        threads.emplace_back(run);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK(failures == 0);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testScale()
+{
+    const SincFilter filter = SincFilter::highPass(31, 0.1);
+    const std::vector<double> signal = randomSignal(500);
+
+    std::vector<double> output(signal.size() + filter.size() - 1);
+    std::vector<double> scaled(output.size());
+
+    filter.apply(signal, output);
+    filter.apply(signal, scaled, -2.5);
+
+    for (size_t i = 0; i < output.size(); ++i)
+        CHECK(scaled[i] == -2.5 * output[i]);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testVoltammogramFilter()
+{
+    const VoltammogramFilter filter;
+
+    // The kernel is private, but the response to a centered impulse reproduces it
+    std::vector<double> impulse(VoltammogramFilterSize, 0.0);
+    impulse[VoltammogramFilterSize / 2] = 1.0;
+
+    std::vector<double> kernel(VoltammogramFilterSize);
+    filter.apply(impulse, kernel);
+
+    for (size_t size : { 200, 1000, 5000, 20000 })
+    {
+        const std::vector<double> signal = randomSignal(size);
+        const std::vector<double> full = convolve(signal, kernel);
+
+        // The output is aligned with the input, without the group delay
+        const std::span<const double> expected(full.data() + VoltammogramFilterSize / 2, size);
+
+        std::vector<double> output(size);
+        filter.apply(signal, output);
+
+        if (!CHECK(maximumDeviation(output, expected) < FftTolerance))
+            std::cerr << "  signal size " << size << std::endl;
+    }
+
+    std::vector<double> output(10);
+    CHECK_THROWS(filter.apply(impulse, output));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    testDirectConvolution();
+    testFftConvolution();
+    testFftPlans();
+    testScale();
+    testVoltammogramFilter();
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,285 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "captureserver.h"
+#include "testing.h"
+#include "tcpclient.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace redex;
+
+// ---------------------------------------------------------------------------------------------- //
+
+class CountingListener : public Listener
+{
+public:
+    void onStatusChanged(Status status) override;
+
+    void onConductanceReceived(const std::string& testpointId,
+                               double voltage, double current, double admittance) override;
+
+    void onOrpValueReceived(const std::string& testpointId, double value) override;
+    void onPhValueReceived(const std::string& testpointId, double value) override;
+    void onTemperatureReceived(const std::string& testpointId, double value) override;
+
+    void onVoltammogramReceived(const std::string& testpointId,
+                                std::span<const double> voltage,
+                                std::span<const double> current) override;
+
+    void onHubStatusReceived(double temperature) override;
+
+    void onNodeStatusReceived(const std::string& nodeId,
+                              double voltage, double current, double temperature) override;
+
+    void onError(const std::string& msg) override;
+
+    auto waitForRecords(size_t count, std::chrono::seconds timeout) -> bool;
+
+public:
+    // Only touched by the client thread until waitForRecords() returns
+    size_t statusCount = 0;
+    size_t conductanceCount = 0;
+    size_t sensorValueCount = 0;
+    size_t voltammogramCount = 0;
+    size_t voltammogramPointCount = 0;
+    size_t powerStatusCount = 0;
+    size_t errorCount = 0;
+
+private:
+    void addRecord();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    size_t m_recordCount = 0;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onStatusChanged(Status status)
+{
+    CHECK(status == Status::MeasurementStarted);
+
+    ++statusCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onConductanceReceived(const std::string& testpointId,
+                                             double voltage, double current, double admittance)
+{
+    if (testpointId == "TP1")
+    {
+        CHECK_NEAR(voltage, 0.05, 1e-12);
+        CHECK_NEAR(current, 1.2345e-4, 1e-12);
+        CHECK_NEAR(admittance, 2.469e-3, 1e-12);
+    }
+
+    ++conductanceCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onOrpValueReceived(const std::string& testpointId, double value)
+{
+    if (testpointId == "TP1")
+        CHECK_NEAR(value, 0.2134, 1e-12);
+
+    ++sensorValueCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onPhValueReceived(const std::string& testpointId, double value)
+{
+    if (testpointId == "TP1")
+        CHECK_NEAR(value, 7.012, 1e-12);
+
+    ++sensorValueCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onTemperatureReceived(const std::string& testpointId, double value)
+{
+    if (testpointId == "TP1")
+        CHECK_NEAR(value, 24.56, 1e-12);
+
+    ++sensorValueCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onVoltammogramReceived(const std::string& /*testpointId*/,
+                                              std::span<const double> voltage,
+                                              std::span<const double> current)
+{
+    // Triangular sweep from -0.5 V to 0.5 V and back
+    if (CHECK(voltage.size() == 1000 && current.size() == 1000))
+    {
+        CHECK_NEAR(voltage[0], -0.5, 1e-12);
+        CHECK_NEAR(voltage[250], 0.0, 1e-12);
+        CHECK_NEAR(voltage[500], 0.5, 1e-12);
+        CHECK_NEAR(voltage[999], -0.498, 1e-12);
+    }
+
+    ++voltammogramCount;
+    voltammogramPointCount += voltage.size();
+
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onHubStatusReceived(double temperature)
+{
+    CHECK_NEAR(temperature, 32.5, 1e-12);
+
+    ++powerStatusCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onNodeStatusReceived(const std::string& nodeId,
+                                            double voltage, double current, double temperature)
+{
+    CHECK(nodeId == "N1");
+    CHECK_NEAR(voltage, 5.02, 1e-12);
+    CHECK_NEAR(current, 0.215, 1e-12);
+    CHECK_NEAR(temperature, 31.5, 1e-12);
+
+    ++powerStatusCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::onError(const std::string& msg)
+{
+    std::cerr << "Error: " << msg << std::endl;
+
+    ++errorCount;
+    addRecord();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto CountingListener::waitForRecords(size_t count, std::chrono::seconds timeout) -> bool
+{
+    std::unique_lock lock(m_mutex);
+    return m_condition.wait_for(lock, timeout, [&] { return m_recordCount >= count; });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void CountingListener::addRecord()
+{
+    std::lock_guard lock(m_mutex);
+
+    ++m_recordCount;
+    m_condition.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static auto readCapture(const std::string& fileName) -> std::string
+{
+    std::ifstream file(fileName, std::ios::binary);
+
+    if (!file)
+        throw std::runtime_error("Unable to open " + fileName + ".");
+
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Usage: TcpClientBenchmark <capture file> [repeat count]
+auto main(int argc, char* argv[]) -> int
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <capture file> [repeat count]" << std::endl;
+        return 2;
+    }
+
+    try {
+        const std::string capture = readCapture(argv[1]);
+        const size_t repeatCount = argc > 2 ? std::stoul(argv[2]) : 200;
+
+        // One measurement cycle of four testpoints, each line is one record
+        const size_t linesPerCapture = std::count(capture.begin(), capture.end(), '\n');
+        CHECK(linesPerCapture == 21);
+
+        CaptureServer server(capture, repeatCount);
+        CountingListener listener;
+
+        TcpClient client("127.0.0.1", &listener, TcpClient::ReadMode::Thread, server.port());
+
+        const auto start = std::chrono::steady_clock::now();
+        client.startMeasurement();
+
+        const bool complete = listener.waitForRecords(linesPerCapture * repeatCount, 60s);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (!CHECK(complete))
+            return Testing::result();
+
+        CHECK(listener.errorCount == 0);
+        CHECK(listener.statusCount == repeatCount);
+        CHECK(listener.conductanceCount == 4 * repeatCount);
+        CHECK(listener.sensorValueCount == 12 * repeatCount);
+        CHECK(listener.voltammogramCount == 2 * repeatCount);
+        CHECK(listener.powerStatusCount == 2 * repeatCount);
+
+        const double megabytes = capture.size() * repeatCount / 1e6;
+
+        std::cout << "Decoded " << megabytes << " MB in " << elapsed.count() << " s: "
+                  << megabytes / elapsed.count() << " MB/s, "
+                  << listener.voltammogramPointCount / elapsed.count() / 1e6
+                  << " M voltammogram points/s" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
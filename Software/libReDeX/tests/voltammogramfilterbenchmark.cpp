@@ -0,0 +1,131 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+#include "voltammogramfilter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    constexpr size_t FilterSize = 121;
+
+    // Relative to the largest output value
+    constexpr double Tolerance = 1e-13;
+
+    // Same as the direct convolution before the FFT path was added
+    void convolve(std::span<const double> signal, std::span<const double> kernel,
+                  std::span<double> out)
+    {
+        std::fill(out.begin(), out.end(), 0.0);
+
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            for (size_t j = 0; j < kernel.size(); ++j)
+                out[i + j] += signal[i] * kernel[j];
+        }
+    }
+
+    // Microseconds per call
+    template <typename Func>
+    auto measure(size_t repeatCount, Func func) -> double
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < repeatCount; ++i)
+            func();
+
+        const std::chrono::duration<double, std::micro> elapsed =
+                std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / repeatCount;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main(int argc, char* argv[]) -> int
+{
+    try {
+        const size_t repeatCount = argc > 1 ? std::stoul(argv[1]) : 50;
+
+        const VoltammogramFilter fir(VoltammogramFilter::Type::Fir);
+        const VoltammogramFilter iir(VoltammogramFilter::Type::Iir);
+
+        // The kernel is private, but the response to a centered impulse reproduces it
+        std::vector<double> impulse(FilterSize, 0.0);
+        impulse[FilterSize / 2] = 1.0;
+
+        std::vector<double> kernel(FilterSize);
+        fir.apply(impulse, kernel);
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+        std::printf("  length    direct       FIR       IIR   deviation\n");
+
+        for (size_t size : { 1024, 5000, 20000, 50000 })
+        {
+            std::vector<double> signal(size);
+            std::generate(signal.begin(), signal.end(), [&] { return distribution(generator); });
+
+            std::vector<double> full(size + FilterSize - 1);
+            std::vector<double> output(size);
+
+            const double direct = measure(repeatCount, [&] { convolve(signal, kernel, full); });
+            const double fft = measure(repeatCount, [&] { fir.apply(signal, output); });
+            const double biquad = measure(repeatCount, [&] { iir.apply(signal, output); });
+
+            fir.apply(signal, output);
+
+            double peak = 0.0;
+            double deviation = 0.0;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                const double expected = full[i + FilterSize / 2];
+
+                peak = std::max(peak, std::abs(expected));
+                deviation = std::max(deviation, std::abs(output[i] - expected));
+            }
+
+            CHECK(deviation / peak < Tolerance);
+
+            std::printf("%8zu %6.0f us %6.0f us %6.0f us %11.1e\n",
+                        size, direct, fft, biquad, deviation / peak);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -30,38 +30,53 @@
 namespace {
     constexpr size_t FilterSize = 121;
     constexpr size_t OffsetSize = (FilterSize - 1) / 2;
+
+    constexpr size_t SampleRate = 1000;
+
+    constexpr double StopBand1Low  = 45.0 / SampleRate;
+    constexpr double StopBand1High = 55.0 / SampleRate;
+
+    constexpr double StopBand2Low  =  95.0 / SampleRate;
+    constexpr double StopBand2High = 105.0 / SampleRate;
+
+    constexpr double StopBand3Low  = 145.0 / SampleRate;
+    constexpr double StopBand3High = 155.0 / SampleRate;
+
+    constexpr double LowPassCutoff = 180.0 / SampleRate;
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-void VoltammogramFilter::apply(std::span<const double> input, std::span<double> output)
+VoltammogramFilter::VoltammogramFilter(Type type)
+    : m_type(type)
 {
-    if (input.size() != output.size())
-        throw Error("Filter output size must match input size.");
-
-    m_data.resize(input.size() + FilterSize - 1);
-    m_filter.apply(input, m_data);
-
-    std::copy_n(std::begin(m_data) + OffsetSize, output.size(),  std::begin(output));
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
-auto VoltammogramFilter::makeFilter() -> SincFilter
+void VoltammogramFilter::apply(std::span<const double> input, std::span<double> output) const
 {
-    constexpr size_t SampleRate = 1000;
+    if (input.size() != output.size())
+        throw Error("Filter output size must match input size.");
 
-    constexpr double StopBand1Low  = 45.0 / SampleRate;
-    constexpr double StopBand1High = 55.0 / SampleRate;
+    if (m_type == Type::Iir)
+    {
+        m_biquadFilter.apply(input, output);
+        return;
+    }
 
-    constexpr double StopBand2Low  =  95.0 / SampleRate;
-    constexpr double StopBand2High = 105.0 / SampleRate;
+    thread_local std::vector<double> data;
 
-    constexpr double StopBand3Low  = 145.0 / SampleRate;
-    constexpr double StopBand3High = 155.0 / SampleRate;
+    data.resize(input.size() + FilterSize - 1);
+    m_sincFilter.apply(input, data);
 
-    constexpr double LowPassCutoff = 180.0 / SampleRate;
+    std::copy_n(std::begin(data) + OffsetSize, output.size(),  std::begin(output));
+}
+
+// ---------------------------------------------------------------------------------------------- //
 
+auto VoltammogramFilter::makeSincFilter() -> SincFilter
+{
     constexpr auto StopBandWindow = SincFilter::WindowType::None;
     constexpr auto LowPassWindow  = SincFilter::WindowType::None;
 
@@ -74,3 +89,13 @@ auto VoltammogramFilter::makeFilter() -> SincFilter
 }
 
 // ---------------------------------------------------------------------------------------------- //
+
+auto VoltammogramFilter::makeBiquadFilter() -> BiquadFilter
+{
+    return BiquadFilter::notch(StopBand1Low, StopBand1High)
+         * BiquadFilter::notch(StopBand2Low, StopBand2High)
+         * BiquadFilter::notch(StopBand3Low, StopBand3High)
+         * BiquadFilter::lowPass(LowPassCutoff);
+}
+
+// ---------------------------------------------------------------------------------------------- //
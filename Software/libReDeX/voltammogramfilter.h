@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "biquadfilter.h"
 #include "sincfilter.h"
 
 #include <stdexcept>
@@ -33,13 +34,25 @@ class VoltammogramFilter
 public:
     using Error = std::runtime_error;
 
+    enum class Type
+    {
+        Fir,
+        Iir
+    };
+
 public:
-    void apply(std::span<const double> input, std::span<double> output);
+    explicit VoltammogramFilter(Type type = Type::Fir);
+
+    // Thread-safe, the scratch buffer is kept per thread
+    void apply(std::span<const double> input, std::span<double> output) const;
 
 private:
-    static auto makeFilter() -> SincFilter;
+    static auto makeSincFilter() -> SincFilter;
+    static auto makeBiquadFilter() -> BiquadFilter;
 
 private:
-    SincFilter m_filter = makeFilter();
-    std::vector<double> m_data;
+    const Type m_type;
+
+    const SincFilter m_sincFilter = makeSincFilter();
+    const BiquadFilter m_biquadFilter = makeBiquadFilter();
 };
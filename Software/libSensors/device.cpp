@@ -22,14 +22,24 @@
 // ============================================================================================== //
 
 #include "device.h"
-#include "serialport.h"
 
+#include <serial/serialport.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <tuple>
 
 // ---------------------------------------------------------------------------------------------- //
 
 using namespace isf::Sensors;
+using isf::Serial::SerialPort;
 
 // ---------------------------------------------------------------------------------------------- //
 
@@ -71,6 +81,65 @@ namespace {
         stream << value;
         return stream.str();
     }
+
+    // The tag the response to a request starts with. <GET_X> is answered with <X>, <GET_ALL_VALUES>
+    // with the <SENSOR_DATA> of the first sensor and a command like <SUBSCRIBE> with <SUBSCRIBED>.
+    auto responseTagOf(const std::string& request) -> std::string
+    {
+        const std::string tag = request.substr(0, request.find_first_of(' '));
+
+        if (tag == "<GET_ALL_VALUES>")
+            return "<SENSOR_DATA>";
+
+        if (tag.starts_with("<GET_"))
+            return "<" + tag.substr(5);
+
+        return tag.substr(0, tag.size() - 1) + "D>";
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+    // Assembles the lines of a response that may be split across several reads
+    class LineAssembler
+    {
+    public:
+        static constexpr size_t MaximumLineLength = 4096;
+
+        void append(std::span<const char> data)
+        {
+            m_buffer.append(data.begin(), data.end());
+        }
+
+        auto takeLine(std::string& line) -> bool
+        {
+            static const std::string lineBreak = "\r\n";
+
+            const size_t pos = m_buffer.find(lineBreak, m_offset);
+
+            if (pos == std::string::npos)
+            {
+                m_buffer.erase(0, m_offset);
+                m_offset = 0;
+
+                // Discard garbage that will never form a valid line
+                if (m_buffer.size() > MaximumLineLength)
+                    m_buffer.clear();
+
+                return false;
+            }
+
+            line.assign(m_buffer, m_offset, pos - m_offset);
+            m_offset = pos + lineBreak.size();
+
+            return true;
+        }
+
+    private:
+        std::string m_buffer;
+        size_t m_offset = 0;
+    };
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -89,12 +158,56 @@ class Device::Private
 public:
     static constexpr std::chrono::milliseconds DefaultTimeout = SerialPort::DefaultTimeout;
 
+    // Pushed values are considered stale after this many missed intervals
+    static constexpr int StallIntervalCount = 3;
+
+    // Requests end with "@<id>", which is echoed on every line of the response
+    static constexpr char RequestIdPrefix = '@';
+
+    struct PendingRequest
+    {
+        unsigned long id;
+        std::string responseTag;
+        size_t lineCount;
+        std::chrono::steady_clock::time_point deadline;
+        std::vector<std::string> lines;
+
+        // Timed out, but still waiting for its response, see waitForResponse()
+        bool abandoned = false;
+    };
+
+    using RequestHandle = std::shared_ptr<PendingRequest>;
+
 public:
     Private(const std::string& port);
+    ~Private();
+
+    auto startRequest(const std::string& request, size_t lineCount = 1,
+                      std::chrono::milliseconds timeout = DefaultTimeout) const -> RequestHandle;
+
+    auto waitForResponse(const RequestHandle& request) const -> std::vector<std::string>;
 
-    auto sendRequest(std::string request,
+    auto sendRequest(const std::string& request,
                      std::chrono::milliseconds timeout = DefaultTimeout) const -> std::string;
 
+    auto sendRequest(const std::string& request, size_t lineCount,
+                     std::chrono::milliseconds timeout = DefaultTimeout) const
+        -> std::vector<std::string>;
+
+    auto getAllValues() const -> Values;
+    auto getAllValuesLegacy() const -> Values;
+
+    auto subscribe(std::chrono::milliseconds interval) -> std::chrono::milliseconds;
+    void unsubscribe();
+    void resetSubscription();
+
+    auto isSubscribed() const -> bool { return m_subscribed; }
+
+    auto getLatestValues() const -> Values;
+    auto getHistory() const -> std::vector<Sample>;
+
+    static void checkIndex(size_t index);
+
     static auto parseString(const std::string& response,
                             const std::string& expectedTag) -> std::string;
 
@@ -109,12 +222,55 @@ public:
 
     static auto parsePowerValues(const std::string& response,
                                  const std::string& expectedTag) -> PowerValues;
+
+    static auto parseSensorData(const std::string& response, const std::string& expectedTag)
+        -> std::tuple<size_t, SensorType, double>;
+
+    static auto toSensorType(const std::string& type) -> SensorType;
+
+public:
+    mutable std::atomic<size_t> requestCount = 0;
+    mutable std::atomic<bool> allValuesSupported = true;
+
 private:
+    void processData(std::span<const char> data);
+    void processError(const std::string& error);
+
+    void processLine(std::string line);
+    void processPushedValues(const std::string& line, const std::string& tag);
+
+    static auto takeRequestId(std::string& line) -> std::optional<unsigned long>;
+    static auto isComplete(const PendingRequest& request) -> bool;
+
     static void checkError(const std::string& response);
     static auto mapError(const std::string& error) -> std::string;
 
 private:
     SerialPort m_port;
+    std::atomic<bool> m_subscribed = false;
+
+    // Only used on the I/O thread of the serial port
+    LineAssembler m_assembler;
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_condition;
+
+    // Protected by m_mutex
+    mutable unsigned long m_nextRequestId = 0;
+    mutable std::deque<RequestHandle> m_pendingRequests;
+    std::string m_portError;
+    bool m_requestIdsEchoed = false;
+
+    bool m_pushEnabled = false;
+    Values m_pendingValues = {};
+    size_t m_pendingSensorCount = 0;
+
+    std::deque<Sample> m_history;
+    std::chrono::milliseconds m_interval = {};
+
+    // Written once by getAllValuesLegacy()
+    mutable std::once_flag m_sensorTypesQueried;
+    mutable std::array<SensorType, SensorCount> m_sensorTypes = {};
 };
 
 // ---------------------------------------------------------------------------------------------- //
@@ -132,6 +288,12 @@ Device::~Device() = default;
 
 auto Device::getSensorType(size_t index) const -> SensorType
 {
+    if (d->isSubscribed())
+    {
+        Private::checkIndex(index);
+        return d->getLatestValues().sensorTypes[index];
+    }
+
     const std::string response = d->sendRequest("<GET_SENSOR_TYPE> " + toString(index));
     return Private::parseSensorType(response, "<SENSOR_TYPE>");
 }
@@ -140,6 +302,12 @@ auto Device::getSensorType(size_t index) const -> SensorType
 
 auto Device::getSensorValue(size_t index) const -> double
 {
+    if (d->isSubscribed())
+    {
+        Private::checkIndex(index);
+        return d->getLatestValues().sensorValues[index];
+    }
+
     const std::string response = d->sendRequest("<GET_SENSOR_VALUE> " + toString(index));
     return Private::parseDouble(response, "<SENSOR_VALUE>");
 }
@@ -148,12 +316,60 @@ auto Device::getSensorValue(size_t index) const -> double
 
 auto Device::getPowerValues() const -> PowerValues
 {
+    if (d->isSubscribed())
+        return d->getLatestValues().powerValues;
+
     const std::string response = d->sendRequest("<GET_POWER_VALUES>");
     return Private::parsePowerValues(response, "<POWER_VALUES>");
 }
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto Device::getAllValues() const -> Values
+{
+    if (d->isSubscribed())
+        return d->getLatestValues();
+
+    return d->allValuesSupported ? d->getAllValues() : d->getAllValuesLegacy();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::getRequestCount() const -> size_t
+{
+    return d->requestCount;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::subscribe(std::chrono::milliseconds interval) -> std::chrono::milliseconds
+{
+    return d->subscribe(interval);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::unsubscribe()
+{
+    d->unsubscribe();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::isSubscribed() const -> bool
+{
+    return d->isSubscribed();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::getHistory() const -> std::vector<Sample>
+{
+    return d->getHistory();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 auto Device::getHardwareVersion() const -> std::string
 {
     const std::string response = d->sendRequest("<GET_HARDWARE_VERSION>");
@@ -195,33 +411,469 @@ auto Device::toPhValue(double voltage, double temperature) -> double
 // ---------------------------------------------------------------------------------------------- //
 
 Device::Private::Private(const std::string& port)
-    : m_port(port) {}
+    : m_port(port)
+{
+    m_port.setReadCallback([this](std::span<const char> data) { processData(data); },
+                           [this](const std::string& error) { processError(error); });
+
+    resetSubscription();
+}
 
 // ---------------------------------------------------------------------------------------------- //
 
-auto Device::Private::sendRequest(std::string request,
-                                  std::chrono::milliseconds timeout) const -> std::string
+Device::Private::~Private()
+{
+    try {
+        unsubscribe();
+    }
+    catch (...) {}
+
+    m_port.setReadCallback({});
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::startRequest(const std::string& request, size_t lineCount,
+                                   std::chrono::milliseconds timeout) const -> RequestHandle
+{
+    std::lock_guard lock(m_mutex);
+
+    const unsigned long id = m_nextRequestId++;
+
+    auto pending = std::make_shared<PendingRequest>();
+    pending->id = id;
+    pending->responseTag = responseTagOf(request);
+    pending->lineCount = lineCount;
+    pending->deadline = std::chrono::steady_clock::now() + timeout;
+
+    // Register before sending, the response may arrive on the I/O thread right away
+    m_pendingRequests.push_back(pending);
+
+    try {
+        m_port.sendData(request + " " + RequestIdPrefix + toString(id) + "\r\n");
+    }
+    catch (...)
+    {
+        m_pendingRequests.pop_back();
+        throw;
+    }
+
+    ++requestCount;
+    return pending;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::waitForResponse(const RequestHandle& request) const
+    -> std::vector<std::string>
 {
-    request += "\r\n";
-    m_port.sendData(request);
+    std::unique_lock lock(m_mutex);
+
+    m_condition.wait_until(lock, request->deadline, [&] {
+        return isComplete(*request) || !m_portError.empty();
+    });
 
-    const bool dataAvailable = m_port.waitForDataAvailable(timeout);
+    // Firmware without request IDs answers strictly in order, so a request that timed out
+    // keeps its place until its response arrives. Otherwise a late response would be taken
+    // for the response to the next request.
+    if (!isComplete(*request) && m_portError.empty() && !m_requestIdsEchoed)
+        request->abandoned = true;
+    else
+        std::erase(m_pendingRequests, request);
+
+    if (!isComplete(*request))
+    {
+        if (!m_portError.empty())
+            throw Error(m_portError);
 
-    if (!dataAvailable)
         throw Error("Request timed out.");
+    }
+
+    const std::vector<std::string> lines = std::move(request->lines);
+    lock.unlock();
+
+    // An error always terminates the response
+    checkError(lines.back());
+
+    return lines;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::sendRequest(const std::string& request,
+                                  std::chrono::milliseconds timeout) const -> std::string
+{
+    return sendRequest(request, 1, timeout).front();
+}
 
-    const std::vector<char> data = m_port.readAllData();
-    std::string response(data.begin(), data.end());
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::sendRequest(const std::string& request, size_t lineCount,
+                                  std::chrono::milliseconds timeout) const
+    -> std::vector<std::string>
+{
+    return waitForResponse(startRequest(request, lineCount, timeout));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::getAllValues() const -> Values
+{
+    std::vector<std::string> lines;
+
+    try {
+        lines = sendRequest("<GET_ALL_VALUES>", SensorCount + 1);
+    }
+    catch (const Error& e)
+    {
+        if (std::string(e.what()) != mapError("UNKNOWN_COMMAND"))
+            throw;
+
+        // Firmware predates the bulk command, so fall back permanently
+        allValuesSupported = false;
+        return getAllValuesLegacy();
+    }
+
+    Values values = {};
+
+    for (size_t i = 0; i < SensorCount; ++i)
+    {
+        const auto [index, type, value] = parseSensorData(lines[i], "<SENSOR_DATA>");
+
+        if (index != i)
+            throw InvalidResponseError(lines[i]);
+
+        values.sensorTypes[i] = type;
+        values.sensorValues[i] = value;
+    }
+
+    values.powerValues = parsePowerValues(lines.back(), "<POWER_VALUES>");
+
+    return values;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::getAllValuesLegacy() const -> Values
+{
+    // The sensor types are read from ID pins when the device boots, so they are queried only
+    // once. Each readout then sends as many commands as before the bulk command existed, as
+    // a longer burst risks overflowing the receive buffer of old firmware.
+    std::call_once(m_sensorTypesQueried, [this] {
+        std::array<RequestHandle, SensorCount> typeRequests;
+
+        for (size_t i = 0; i < SensorCount; ++i)
+            typeRequests[i] = startRequest("<GET_SENSOR_TYPE> " + toString(i));
+
+        for (size_t i = 0; i < SensorCount; ++i)
+        {
+            const std::string type = waitForResponse(typeRequests[i]).front();
+            m_sensorTypes[i] = parseSensorType(type, "<SENSOR_TYPE>");
+        }
+    });
+
+    // All requests are in flight at once, so this still takes a single round trip
+    std::array<RequestHandle, SensorCount> valueRequests;
+
+    for (size_t i = 0; i < SensorCount; ++i)
+        valueRequests[i] = startRequest("<GET_SENSOR_VALUE> " + toString(i));
+
+    const RequestHandle powerRequest = startRequest("<GET_POWER_VALUES>");
+
+    Values values = {};
+    values.sensorTypes = m_sensorTypes;
+
+    for (size_t i = 0; i < SensorCount; ++i)
+    {
+        const std::string value = waitForResponse(valueRequests[i]).front();
+        values.sensorValues[i] = parseDouble(value, "<SENSOR_VALUE>");
+    }
+
+    const std::string power = waitForResponse(powerRequest).front();
+    values.powerValues = parsePowerValues(power, "<POWER_VALUES>");
+
+    return values;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::subscribe(std::chrono::milliseconds interval) -> std::chrono::milliseconds
+{
+    {
+        std::lock_guard lock(m_mutex);
 
-    static const std::string lineBreak = "\r\n";
+        // The device starts pushing values right after its response
+        m_pushEnabled = true;
 
-    if (!response.ends_with(lineBreak))
+        if (!m_subscribed)
+        {
+            m_pendingSensorCount = 0;
+            m_history.clear();
+        }
+    }
+
+    try {
+        const std::string response = sendRequest("<SUBSCRIBE> " + toString(interval.count()));
+        const unsigned long actualInterval = parseULong(response, "<SUBSCRIBED>");
+
+        std::unique_lock lock(m_mutex);
+
+        m_interval = std::chrono::milliseconds(actualInterval);
+        m_subscribed = true;
+
+        // The first values are pushed on the next update of the device
+        m_condition.wait_for(lock, DefaultTimeout, [this] {
+            return !m_history.empty() || !m_portError.empty();
+        });
+    }
+    catch (...)
+    {
+        std::lock_guard lock(m_mutex);
+        m_pushEnabled = m_subscribed;
+
+        throw;
+    }
+
+    return m_interval;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::unsubscribe()
+{
+    if (!m_subscribed)
+        return;
+
+    // Values are requested again from now on, even if the device keeps pushing
+    m_subscribed = false;
+
+    const std::string response = sendRequest("<UNSUBSCRIBE>");
+
+    if (response != "<UNSUBSCRIBED>")
         throw InvalidResponseError(response);
 
-    response.erase(response.size() - lineBreak.size());
+    std::lock_guard lock(m_mutex);
+    m_pushEnabled = false;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::resetSubscription()
+{
+    // A previous session may have left the device subscribed, so treat values without an ID
+    // as pushed until the device has stopped pushing
+    {
+        std::lock_guard lock(m_mutex);
+        m_pushEnabled = true;
+    }
+
+    try {
+        sendRequest("<UNSUBSCRIBE>");
+    }
+    catch (const Error&) {
+        // Firmware without push support doesn't know the command
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    m_pushEnabled = false;
+    m_pendingSensorCount = 0;
+    m_history.clear();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::getLatestValues() const -> Values
+{
+    std::lock_guard lock(m_mutex);
+
+    if (!m_portError.empty())
+        throw Error(m_portError);
+
+    if (m_history.empty())
+        throw Error("No values received from device.");
+
+    const Sample& sample = m_history.back();
+    const auto age = std::chrono::steady_clock::now() - sample.timestamp;
+
+    if (age > StallIntervalCount * m_interval + DefaultTimeout)
+        throw Error("Device stopped pushing values.");
+
+    return sample.values;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::getHistory() const -> std::vector<Sample>
+{
+    std::lock_guard lock(m_mutex);
+    return { m_history.begin(), m_history.end() };
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::checkIndex(size_t index)
+{
+    if (index >= SensorCount)
+        throw Error(mapError("INVALID_ARGUMENT"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::processData(std::span<const char> data)
+{
+    m_assembler.append(data);
+
+    std::string line;
+
+    while (m_assembler.takeLine(line))
+        processLine(std::move(line));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::processError(const std::string& error)
+{
+    std::lock_guard lock(m_mutex);
+
+    m_portError = error;
+    m_condition.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::processLine(std::string line)
+{
+    const std::optional<unsigned long> id = takeRequestId(line);
+    const std::string tag = line.substr(0, line.find_first_of(' '));
+
+    std::lock_guard lock(m_mutex);
+
+    if (id && !m_requestIdsEchoed)
+    {
+        m_requestIdsEchoed = true;
+
+        // Responses are matched by ID from now on, no matter how late they are
+        std::erase_if(m_pendingRequests, [](const RequestHandle& request) {
+            return request->abandoned;
+        });
+    }
+
+    // Firmware that echoes request IDs never sends values without one unless pushing
+    const bool pushed = !id && (m_pushEnabled || m_requestIdsEchoed);
+
+    if (pushed && (tag == "<SENSOR_DATA>" || tag == "<POWER_VALUES>"))
+    {
+        processPushedValues(line, tag);
+        return;
+    }
+
+    // Such firmware tags every response, so any other line without an ID can't be matched
+    if (!id && m_requestIdsEchoed)
+        return;
+
+    // Firmware without request IDs answers strictly in order, so lines without
+    // an ID belong to the oldest incomplete request, including ones that timed out.
+    // Late responses to requests with an ID that already timed out are dropped.
+    const auto matches = [&](const RequestHandle& request) {
+        return id ? request->id == *id : !isComplete(*request);
+    };
+
+    auto it = std::find_if(m_pendingRequests.begin(), m_pendingRequests.end(), matches);
+
+    // A line that can't start the response to a request that timed out means that its
+    // response was lost, as the firmware drops commands when its receive buffer overflows
+    while (!id && it != m_pendingRequests.end() && (*it)->abandoned && (*it)->lines.empty() &&
+           tag != (*it)->responseTag && tag != "<ERROR>")
+    {
+        it = m_pendingRequests.erase(it);
+        it = std::find_if(it, m_pendingRequests.end(), matches);
+    }
+
+    if (it == m_pendingRequests.end() || isComplete(**it))
+        return;
+
+    (*it)->lines.push_back(std::move(line));
+
+    if (!isComplete(**it))
+        return;
+
+    // Nobody waits for the response to a request that timed out
+    if ((*it)->abandoned)
+        m_pendingRequests.erase(it);
+    else
+        m_condition.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void Device::Private::processPushedValues(const std::string& line, const std::string& tag)
+{
+    // Pushed values arrive as one <SENSOR_DATA> line per sensor, in order,
+    // followed by <POWER_VALUES>. Incomplete or garbled frames are dropped.
+    if (tag == "<SENSOR_DATA>")
+    {
+        try {
+            const auto [index, type, value] = parseSensorData(line, tag);
+
+            if (index != m_pendingSensorCount)
+                throw InvalidResponseError(line);
+
+            m_pendingValues.sensorTypes[index] = type;
+            m_pendingValues.sensorValues[index] = value;
+            ++m_pendingSensorCount;
+        }
+        catch (const Error&) {
+            m_pendingSensorCount = 0;
+        }
+    }
+    else
+    {
+        try {
+            m_pendingValues.powerValues = parsePowerValues(line, tag);
+
+            if (m_pendingSensorCount == SensorCount)
+            {
+                m_history.push_back({ std::chrono::steady_clock::now(), m_pendingValues });
+
+                if (m_history.size() > HistorySize)
+                    m_history.pop_front();
+
+                m_condition.notify_all();
+            }
+        }
+        catch (const Error&) {}
+
+        m_pendingSensorCount = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::takeRequestId(std::string& line) -> std::optional<unsigned long>
+{
+    const size_t pos = line.find_last_of(' ');
+
+    if (pos == std::string::npos || line[pos + 1] != RequestIdPrefix)
+        return std::nullopt;
+
+    try {
+        const auto id = to<unsigned long>(line.substr(pos + 2));
+        line.erase(pos);
+
+        return id;
+    }
+    catch (...) {}
 
-    checkError(response);
-    return response;
+    return std::nullopt;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::isComplete(const PendingRequest& request) -> bool
+{
+    return request.lines.size() >= request.lineCount ||
+           (!request.lines.empty() && request.lines.back().starts_with("<ERROR>"));
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -285,21 +937,14 @@ auto Device::Private::parseDouble(const std::string& response,
 auto Device::Private::parseSensorType(const std::string& response,
                                       const std::string& expectedTag) -> SensorType
 {
-    static const std::map<std::string, SensorType> types = {
-        { "Unknown",     SensorType::Unknown     },
-        { "pH/ORP",      SensorType::pH_ORP      },
-        { "Temperature", SensorType::Temperature },
-        { "None",        SensorType::None        }
-    };
-
     const std::string type = parseString(response, expectedTag);
 
-    auto it = types.find(type.c_str());
-
-    if (it == types.end())
-        throw InvalidResponseError(response);
+    try {
+        return toSensorType(type);
+    }
+    catch (...) {}
 
-    return it->second;
+    throw InvalidResponseError(response);
 }
 
 // ---------------------------------------------------------------------------------------------- //
@@ -328,6 +973,49 @@ auto Device::Private::parsePowerValues(const std::string& response,
 
 // ---------------------------------------------------------------------------------------------- //
 
+auto Device::Private::parseSensorData(const std::string& response,
+                                      const std::string& expectedTag)
+    -> std::tuple<size_t, SensorType, double>
+{
+    const std::string data = parseString(response, expectedTag);
+
+    const std::vector<std::string> values = split(data, ';');
+
+    if (values.size() == 3)
+    {
+        try {
+            const auto index = to<size_t>(values.at(0));
+
+            if (index < SensorCount)
+                return { index, toSensorType(values.at(1)), to<double>(values.at(2)) };
+        }
+        catch (...) {}
+    }
+
+    throw InvalidResponseError(response);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto Device::Private::toSensorType(const std::string& type) -> SensorType
+{
+    static const std::map<std::string, SensorType> types = {
+        { "Unknown",     SensorType::Unknown     },
+        { "pH/ORP",      SensorType::pH_ORP      },
+        { "Temperature", SensorType::Temperature },
+        { "None",        SensorType::None        }
+    };
+
+    auto it = types.find(type);
+
+    if (it == types.end())
+        throw std::exception();
+
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 auto Device::Private::mapError(const std::string& error) -> std::string
 {
     // TODO: Create shared header
@@ -33,7 +33,12 @@
   #define ISF_EXPORT __attribute__((visibility("default")))
 #endif
 
+#include <array>
+#include <chrono>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace isf::Sensors {
 
@@ -57,6 +62,21 @@ public:
         double temperature;
     };
 
+    struct Values
+    {
+        std::array<SensorType, SensorCount> sensorTypes;
+        std::array<double, SensorCount> sensorValues;
+        PowerValues powerValues;
+    };
+
+    struct Sample
+    {
+        std::chrono::steady_clock::time_point timestamp;
+        Values values;
+    };
+
+    static constexpr size_t HistorySize = 64;
+
     using Error = std::runtime_error;
 
 public:
@@ -74,6 +94,18 @@ public:
 
     auto getPowerValues() const -> PowerValues;
 
+    auto getAllValues() const -> Values;
+
+    auto getRequestCount() const -> size_t;
+
+    // While subscribed, the device pushes its values at the given interval and all value
+    // getters return the latest pushed values without a request. Returns the actual interval.
+    auto subscribe(std::chrono::milliseconds interval) -> std::chrono::milliseconds;
+    void unsubscribe();
+
+    auto isSubscribed() const -> bool;
+    auto getHistory() const -> std::vector<Sample>;
+
     auto getHardwareVersion() const -> std::string;
     auto getFirmwareVersion() const -> std::string;
     auto getSerialNumber() const -> std::string;
@@ -1 +0,0 @@
-../Common/serialport.h
\ No newline at end of file
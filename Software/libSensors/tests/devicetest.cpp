@@ -0,0 +1,432 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "testing.h"
+
+#include <sensors/device.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using isf::Sensors::Device;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Answers requests on a pseudo terminal like a sensor board would
+class FakeBoard
+{
+public:
+    struct Options
+    {
+        bool echoRequestIds = true;
+        bool supportsAllValues = true;
+        bool supportsPush = true;
+
+        // Left over from a previous session
+        bool subscribed = false;
+
+        // Sent before every response, firmware echoing request IDs never does that
+        std::string untaggedLine;
+
+        // Answered late, once
+        std::string slowRequest;
+        std::chrono::milliseconds slowDelay = {};
+
+        // Never answered, as if lost in a receive buffer overflow
+        std::string lostRequest;
+    };
+
+public:
+    FakeBoard(const Options& options);
+    ~FakeBoard();
+
+    auto port() const -> std::string;
+    auto isSubscribed() const -> bool { return m_subscribed; }
+    auto requestCount() const -> size_t { return m_requestCount; }
+
+private:
+    void run();
+    void processRequest(std::string request);
+
+    void send(const std::string& line, const std::string& requestId = {});
+    void sendValues(const std::string& requestId = {});
+
+private:
+    Options m_options;
+
+    int m_master = -1;
+    int m_slave = -1;
+
+    std::atomic<bool> m_running = true;
+    std::atomic<bool> m_subscribed = false;
+    std::atomic<size_t> m_requestCount = 0;
+
+    std::thread m_thread;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+FakeBoard::FakeBoard(const Options& options)
+    : m_options(options),
+      m_subscribed(options.subscribed)
+{
+    m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (m_master < 0 || ::grantpt(m_master) < 0 || ::unlockpt(m_master) < 0)
+        std::abort();
+
+    // Keeps the terminal raw until the device has configured it and the master readable
+    // when the device closes its end
+    m_slave = ::open(::ptsname(m_master), O_RDWR | O_NOCTTY);
+
+    ::termios termios = {};
+    ::tcgetattr(m_slave, &termios);
+    ::cfmakeraw(&termios);
+    ::tcsetattr(m_slave, TCSANOW, &termios);
+
+    m_thread = std::thread(&FakeBoard::run, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+FakeBoard::~FakeBoard()
+{
+    m_running = false;
+    m_thread.join();
+
+    ::close(m_slave);
+    ::close(m_master);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto FakeBoard::port() const -> std::string
+{
+    // Device expects a name relative to /dev
+    return std::string(::ptsname(m_master)).substr(5);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::run()
+{
+    static constexpr auto PushInterval = 20ms;
+
+    std::string buffer;
+    auto lastPush = std::chrono::steady_clock::now();
+
+    while (m_running)
+    {
+        ::pollfd fd = { m_master, POLLIN, 0 };
+
+        if (::poll(&fd, 1, 5) > 0 && (fd.revents & POLLIN))
+        {
+            char data[256];
+            const ssize_t size = ::read(m_master, data, sizeof(data));
+
+            if (size > 0)
+                buffer.append(data, size);
+        }
+
+        size_t pos = 0;
+
+        while ((pos = buffer.find("\r\n")) != std::string::npos)
+        {
+            processRequest(buffer.substr(0, pos));
+            buffer.erase(0, pos + 2);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+
+        if (m_subscribed && now - lastPush >= PushInterval)
+        {
+            sendValues();
+            lastPush = now;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::processRequest(std::string request)
+{
+    std::string requestId;
+    ++m_requestCount;
+
+    const size_t pos = request.find(" @");
+
+    if (pos != std::string::npos)
+    {
+        if (m_options.echoRequestIds)
+            requestId = request.substr(pos + 1);
+
+        request.erase(pos);
+    }
+
+    if (request == m_options.lostRequest)
+        return;
+
+    if (request == m_options.slowRequest)
+    {
+        std::this_thread::sleep_for(m_options.slowDelay);
+        m_options.slowRequest.clear();
+    }
+
+    if (!m_options.untaggedLine.empty())
+        send(m_options.untaggedLine);
+
+    if (request == "<GET_SENSOR_TYPE> 0")
+        send("<SENSOR_TYPE> pH/ORP", requestId);
+    else if (request == "<GET_SENSOR_TYPE> 1")
+        send("<SENSOR_TYPE> Temperature", requestId);
+    else if (request == "<GET_SENSOR_VALUE> 0")
+        send("<SENSOR_VALUE> 0.125", requestId);
+    else if (request == "<GET_SENSOR_VALUE> 1")
+        send("<SENSOR_VALUE> 25.5", requestId);
+    else if (request == "<GET_POWER_VALUES>")
+        send("<POWER_VALUES> 5;0.25;30", requestId);
+    else if (request == "<GET_HARDWARE_VERSION>")
+        send("<HARDWARE_VERSION> 1.0", requestId);
+    else if (request == "<GET_ALL_VALUES>" && m_options.supportsAllValues)
+        sendValues(requestId);
+    else if (request.starts_with("<SUBSCRIBE>") && m_options.supportsPush)
+    {
+        send("<SUBSCRIBED> 20", requestId);
+        m_subscribed = true;
+    }
+    else if (request == "<UNSUBSCRIBE>" && m_options.supportsPush)
+    {
+        send("<UNSUBSCRIBED>", requestId);
+        m_subscribed = false;
+    }
+    else
+        send("<ERROR> UNKNOWN_COMMAND", requestId);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::send(const std::string& line, const std::string& requestId)
+{
+    const std::string data = requestId.empty() ? line + "\r\n" : line + " " + requestId + "\r\n";
+
+    if (::write(m_master, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+        std::abort();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void FakeBoard::sendValues(const std::string& requestId)
+{
+    send("<SENSOR_DATA> 0;pH/ORP;0.125", requestId);
+    send("<SENSOR_DATA> 1;Temperature;25.5", requestId);
+    send("<POWER_VALUES> 5;0.25;30", requestId);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void checkValues(const Device::Values& values)
+{
+    CHECK(values.sensorTypes[0] == Device::SensorType::pH_ORP);
+    CHECK(values.sensorTypes[1] == Device::SensorType::Temperature);
+    CHECK_NEAR(values.sensorValues[0], 0.125, 1e-9);
+    CHECK_NEAR(values.sensorValues[1], 25.5, 1e-9);
+    CHECK_NEAR(values.powerValues.voltage, 5.0, 1e-9);
+    CHECK_NEAR(values.powerValues.current, 0.25, 1e-9);
+    CHECK_NEAR(values.powerValues.temperature, 30.0, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTaggedResponses()
+{
+    FakeBoard board({});
+    Device device(board.port());
+
+    CHECK(device.getSensorType(0) == Device::SensorType::pH_ORP);
+    CHECK_NEAR(device.getSensorValue(0), 0.125, 1e-9);
+    CHECK(device.getHardwareVersion() == "1.0");
+
+    checkValues(device.getAllValues());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUntaggedResponses()
+{
+    // Firmware predating request IDs and push mode answers strictly in order
+    FakeBoard board({ .echoRequestIds = false, .supportsPush = false });
+    Device device(board.port());
+
+    CHECK(device.getSensorType(0) == Device::SensorType::pH_ORP);
+    CHECK_NEAR(device.getSensorValue(0), 0.125, 1e-9);
+    CHECK(device.getHardwareVersion() == "1.0");
+
+    checkValues(device.getAllValues());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testLegacyValues()
+{
+    // Firmware predating the bulk command, its receive buffer only holds a few commands
+    FakeBoard board({ .echoRequestIds = false, .supportsAllValues = false,
+                      .supportsPush = false });
+    Device device(board.port());
+
+    // Falls back and queries the sensor types once
+    checkValues(device.getAllValues());
+
+    // Then reads the values with as many commands as before the bulk command existed
+    for (int i = 0; i < 10; ++i)
+    {
+        const size_t requestCount = board.requestCount();
+        checkValues(device.getAllValues());
+
+        CHECK(board.requestCount() - requestCount == 3);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testLateUntaggedResponse()
+{
+    // The device gives up on the first request before the board answers it
+    FakeBoard board({ .echoRequestIds = false, .supportsPush = false,
+                      .slowRequest = "<GET_SENSOR_VALUE> 0",
+                      .slowDelay = 700ms }); // Times out after 500 ms
+    Device device(board.port());
+
+    CHECK_THROWS(device.getSensorValue(0));
+
+    // The late response must not be taken for the response to the next request
+    CHECK_NEAR(device.getSensorValue(1), 25.5, 1e-9);
+    CHECK_NEAR(device.getSensorValue(0), 0.125, 1e-9);
+    CHECK(device.getHardwareVersion() == "1.0");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testLostUntaggedResponse()
+{
+    FakeBoard board({ .echoRequestIds = false, .supportsPush = false,
+                      .lostRequest = "<GET_SENSOR_VALUE> 0" });
+    Device device(board.port());
+
+    CHECK_THROWS(device.getSensorValue(0));
+
+    // The next response can't answer the request that timed out, so it's not waited for
+    CHECK(device.getHardwareVersion() == "1.0");
+    CHECK_NEAR(device.getSensorValue(1), 25.5, 1e-9);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUntaggedLinesDropped()
+{
+    // Once IDs are echoed, a line without one must never complete a request
+    FakeBoard board({ .untaggedLine = "<SENSOR_TYPE> None" });
+    Device device(board.port());
+
+    CHECK(device.getSensorType(0) == Device::SensorType::pH_ORP);
+    CHECK(device.getHardwareVersion() == "1.0");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testStaleSubscription()
+{
+    // The board is still pushing for a host that has gone away
+    FakeBoard board({ .subscribed = true });
+    std::this_thread::sleep_for(100ms);
+
+    Device device(board.port());
+
+    CHECK(!board.isSubscribed());
+    CHECK(!device.isSubscribed());
+
+    CHECK(device.getSensorType(0) == Device::SensorType::pH_ORP);
+    CHECK_NEAR(device.getSensorValue(0), 0.125, 1e-9);
+    CHECK(device.getHardwareVersion() == "1.0");
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testPushedValues()
+{
+    FakeBoard board({});
+    Device device(board.port());
+
+    CHECK(device.subscribe(20ms) == 20ms);
+    CHECK(device.isSubscribed());
+
+    // Requests are answered in between pushed values
+    for (int i = 0; i < 20; ++i)
+    {
+        CHECK(device.getHardwareVersion() == "1.0");
+        checkValues(device.getAllValues());
+    }
+
+    std::this_thread::sleep_for(100ms);
+    CHECK(device.getHistory().size() >= 3);
+
+    device.unsubscribe();
+
+    CHECK(!board.isSubscribed());
+    CHECK(!device.isSubscribed());
+
+    CHECK(device.getSensorType(0) == Device::SensorType::pH_ORP);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    try {
+        testTaggedResponses();
+        testUntaggedResponses();
+        testLegacyValues();
+        testLateUntaggedResponse();
+        testLostUntaggedResponse();
+        testUntaggedLinesDropped();
+        testStaleSubscription();
+        testPushedValues();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //
@@ -0,0 +1,37 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#ifdef _WIN32
+  #ifdef ISF_BUILD_SERIAL
+    #define ISF_SERIAL_EXPORT __declspec(dllexport)
+  #else
+    #define ISF_SERIAL_EXPORT __declspec(dllimport)
+  #endif
+#else
+  #define ISF_SERIAL_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define ISF_SERIAL_BEGIN_NAMESPACE() namespace isf::Serial {
+#define ISF_SERIAL_END_NAMESPACE()   } // End of namespace isf::Serial
@@ -23,8 +23,11 @@
 
 #pragma once
 
+#include <serial/global.h>
+
 #include <array>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <span>
 #include <stdexcept>
@@ -33,6 +36,8 @@
 
 using namespace std::chrono_literals;
 
+ISF_SERIAL_BEGIN_NAMESPACE();
+
 // ---------------------------------------------------------------------------------------------- //
 
 struct SerialPortSettings
@@ -42,13 +47,17 @@ struct SerialPortSettings
 
 // ---------------------------------------------------------------------------------------------- //
 
-class SerialPort
+class ISF_SERIAL_EXPORT SerialPort
 {
 public:
     static constexpr std::chrono::milliseconds DefaultTimeout = 500ms;
 
     using Error = std::runtime_error;
 
+    // Called on the I/O thread shared by all ports. The data is only valid during the call.
+    using ReadCallback = std::function<void(std::span<const char> data)>;
+    using ErrorCallback = std::function<void(const std::string& error)>;
+
 public:
     SerialPort(const std::string& port, const SerialPortSettings& settings = {});
 
@@ -69,6 +78,11 @@ public:
 
     auto getNumberOfBytesAvailable() const -> size_t;
 
+    // Lets the shared I/O thread deliver all incoming data to the callback. Blocking reads
+    // must not be used while a callback is set. An empty callback unregisters the port,
+    // after which no callback is running or will be called anymore.
+    void setReadCallback(ReadCallback readCallback, ErrorCallback errorCallback = {});
+
 private:
     void move(SerialPort&& other);
     void close();
@@ -83,3 +97,5 @@ private:
 };
 
 // ---------------------------------------------------------------------------------------------- //
+
+ISF_SERIAL_END_NAMESPACE();
@@ -21,7 +21,9 @@
 //                                                                                                //
 // ============================================================================================== //
 
-#include "serialport.h"
+#include "serialreactor.h"
+
+#include <serial/serialport.h>
 
 #if defined(__linux__)
 #include <fcntl.h>
@@ -43,6 +45,40 @@
 
 // ---------------------------------------------------------------------------------------------- //
 
+using namespace isf::Serial;
+
+// ---------------------------------------------------------------------------------------------- //
+
+#if defined(_WIN32)
+namespace {
+    // The handle is opened for overlapped I/O so that the reactor can wait for events on it,
+    // transfers still complete before returning
+    template<typename Transfer>
+    auto transferData(::HANDLE handle, Transfer transfer, ::DWORD size) -> bool
+    {
+        ::OVERLAPPED overlapped = {};
+        overlapped.hEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+        if (!overlapped.hEvent)
+            return false;
+
+        ::DWORD count = 0;
+
+        const bool success = (transfer(&overlapped) || ::GetLastError() == ERROR_IO_PENDING) &&
+                             ::GetOverlappedResult(handle, &overlapped, &count, TRUE) &&
+                             count == size;
+
+        const ::DWORD error = ::GetLastError();
+        ::CloseHandle(overlapped.hEvent);
+        ::SetLastError(error);
+
+        return success;
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------- //
+
 struct SerialPort::Private
 {
 #if defined(__linux__)
@@ -50,6 +86,8 @@ struct SerialPort::Private
 #elif defined(_WIN32)
     ::HANDLE handle = INVALID_HANDLE_VALUE;
 #endif
+
+    bool registered = false;
 };
 
 // ---------------------------------------------------------------------------------------------- //
@@ -78,14 +116,22 @@ SerialPort::SerialPort(const std::string& port, const SerialPortSettings& settin
     termios.c_ispeed = settings.baudrate;
     termios.c_ospeed = settings.baudrate;
 
-    ::ioctl(d->fd, TCSETS2, &termios);
+    // BOTHER allows arbitrary baud rates, not only the predefined Bxxx constants
+    if (::ioctl(d->fd, TCSETS2, &termios) < 0)
+    {
+        const int code = errno;
+        ::close(d->fd);
+
+        throwSystemError("Unable to configure serial port " + port + ":", code);
+    }
+
     ::ioctl(d->fd, TIOCEXCL);
     ::ioctl(d->fd, TCFLSH, TCIOFLUSH);
 #elif defined(_WIN32)
     const std::string filename = "\\\\.\\" + port;
 
     d->handle = ::CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE,
-                              0, nullptr, OPEN_EXISTING, 0, nullptr);
+                              0, nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
 
     if (d->handle == INVALID_HANDLE_VALUE)
         throwSystemError("Unable to open serial port " + port + ":");
@@ -151,9 +197,9 @@ void SerialPort::sendData(std::span<const char> data) const
     const ssize_t count = ::write(d->fd, data.data(), data.size());
     const bool success = count >= 0 && static_cast<size_t>(count) == data.size();
 #elif defined(_WIN32)
-    ::DWORD count;
-    const bool success = ::WriteFile(d->handle, data.data(), data.size(), &count, nullptr) &&
-                         count == data.size();
+    const bool success = transferData(d->handle, [&](::OVERLAPPED* overlapped) {
+        return ::WriteFile(d->handle, data.data(), data.size(), nullptr, overlapped);
+    }, data.size());
 #endif
 
     if (!success)
@@ -221,9 +267,9 @@ auto SerialPort::readAllData() const -> std::vector<char>
         const ssize_t count = ::read(d->fd, data.data(), data.size());
         const bool success = count >= 0 && static_cast<size_t>(count) == data.size();
 #elif defined(_WIN32)
-        ::DWORD count;
-        const bool success = ::ReadFile(d->handle, data.data(), data.size(), &count, nullptr) &&
-                             count == data.size();
+        const bool success = transferData(d->handle, [&](::OVERLAPPED* overlapped) {
+            return ::ReadFile(d->handle, data.data(), data.size(), nullptr, overlapped);
+        }, data.size());
 #endif
 
         if (!success)
@@ -257,10 +303,38 @@ auto SerialPort::getNumberOfBytesAvailable() const -> size_t
 
 // ---------------------------------------------------------------------------------------------- //
 
+void SerialPort::setReadCallback(ReadCallback readCallback, ErrorCallback errorCallback)
+{
+#if defined(__linux__)
+    const SerialReactor::Handle handle = d->fd;
+#elif defined(_WIN32)
+    const SerialReactor::Handle handle = d->handle;
+#endif
+
+    SerialReactor& reactor = SerialReactor::instance();
+
+    if (d->registered)
+    {
+        reactor.removePort(handle);
+        d->registered = false;
+    }
+
+    if (readCallback)
+    {
+        reactor.addPort(handle, std::move(readCallback), std::move(errorCallback));
+        d->registered = true;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
 void SerialPort::move(SerialPort&& other)
 {
     m_port = std::move(other.m_port);
 
+    d->registered = other.d->registered;
+    other.d->registered = false;
+
 #if defined(__linux__)
     d->fd = other.d->fd;
     other.d->fd = -1;
@@ -274,6 +348,10 @@ void SerialPort::move(SerialPort&& other)
 
 void SerialPort::close()
 {
+    // The port has to be unregistered before its handle can be reused
+    if (d->registered)
+        setReadCallback({});
+
 #if defined(__linux__)
     if (d->fd >= 0)
         ::close(d->fd);
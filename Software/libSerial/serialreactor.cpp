@@ -0,0 +1,465 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#include "serialreactor.h"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+// ---------------------------------------------------------------------------------------------- //
+
+using namespace isf::Serial;
+
+// ---------------------------------------------------------------------------------------------- //
+
+namespace {
+#if defined(__linux__)
+    constexpr size_t MaximumEventCount = 16;
+#elif defined(_WIN32)
+    // WaitForMultipleObjects also waits for the wakeup event
+    constexpr size_t MaximumWaitingPorts = MAXIMUM_WAIT_OBJECTS - 1;
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SerialReactor::instance() -> SerialReactor&
+{
+    static SerialReactor reactor;
+    return reactor;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::addPort(Handle handle, SerialPort::ReadCallback readCallback,
+                            SerialPort::ErrorCallback errorCallback)
+{
+    std::lock_guard lock(m_mutex);
+
+    auto port = std::make_shared<Port>();
+    port->readCallback = std::move(readCallback);
+    port->errorCallback = std::move(errorCallback);
+
+#if defined(__linux__)
+    ::epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = handle;
+
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, handle, &event) < 0)
+        throw SerialPort::Error(systemError("Unable to register serial port:"));
+#elif defined(_WIN32)
+    port->overlapped.hEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+    if (!port->overlapped.hEvent || !::SetCommMask(handle, EV_RXCHAR | EV_ERR))
+        throw SerialPort::Error(systemError("Unable to register serial port:"));
+#endif
+
+    m_ports[handle] = std::move(port);
+
+#if defined(_WIN32)
+    // Lets the I/O thread start waiting for the new port
+    ::SetEvent(m_wakeup);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::removePort(Handle handle)
+{
+    std::unique_lock lock(m_mutex);
+
+    auto it = m_ports.find(handle);
+
+    if (it == m_ports.end())
+        return;
+
+#if defined(__linux__)
+    if (!it->second->failed)
+        ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, nullptr);
+#elif defined(_WIN32)
+    const std::shared_ptr<Port> port = it->second;
+
+    // Completes a pending WaitCommEvent with an empty event mask
+    ::SetCommMask(handle, 0);
+#endif
+
+    m_ports.erase(it);
+
+    // Callbacks may remove their own port, in which case waiting would deadlock
+    if (std::this_thread::get_id() != m_thread.get_id())
+    {
+        m_dispatchFinished.wait(lock, [&] {
+#if defined(_WIN32)
+            // The handle must stay open until the I/O thread has seen the wait complete
+            if (port->waiting)
+                return false;
+#endif
+            return !m_dispatching || m_dispatchHandle != handle;
+        });
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+SerialReactor::SerialReactor()
+    : m_readBuffer(ReadBufferSize)
+{
+#if defined(__linux__)
+    m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+
+    if (m_epoll < 0)
+        throw SerialPort::Error(systemError("Unable to create serial I/O reactor:"));
+
+    m_wakeup = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (m_wakeup < 0)
+    {
+        ::close(m_epoll);
+        throw SerialPort::Error(systemError("Unable to create serial I/O reactor:"));
+    }
+
+    ::epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeup;
+
+    ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+#elif defined(_WIN32)
+    m_wakeup = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    m_readEvent = ::CreateEvent(nullptr, TRUE, FALSE, nullptr);
+
+    if (!m_wakeup || !m_readEvent)
+    {
+        const std::string error = systemError("Unable to create serial I/O reactor:");
+
+        if (m_wakeup)
+            ::CloseHandle(m_wakeup);
+
+        if (m_readEvent)
+            ::CloseHandle(m_readEvent);
+
+        throw SerialPort::Error(error);
+    }
+#endif
+
+    m_thread = std::thread(&SerialReactor::run, this);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+SerialReactor::~SerialReactor()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_running = false;
+    }
+
+#if defined(__linux__)
+    const uint64_t value = 1;
+    [[maybe_unused]] const ssize_t count = ::write(m_wakeup, &value, sizeof(value));
+#elif defined(_WIN32)
+    ::SetEvent(m_wakeup);
+#endif
+
+    m_thread.join();
+
+#if defined(__linux__)
+    ::close(m_wakeup);
+    ::close(m_epoll);
+#elif defined(_WIN32)
+    ::CloseHandle(m_readEvent);
+    ::CloseHandle(m_wakeup);
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::run()
+{
+#if defined(__linux__)
+    std::array<::epoll_event, MaximumEventCount> events;
+
+    while (true)
+    {
+        const int count = ::epoll_wait(m_epoll, events.data(), events.size(), -1);
+
+        if (count < 0 && errno != EINTR)
+            return;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const ::epoll_event& event = events[i];
+
+            if (event.data.fd == m_wakeup)
+            {
+                std::lock_guard lock(m_mutex);
+
+                if (!m_running)
+                    return;
+
+                continue;
+            }
+
+            if (event.events & EPOLLIN)
+                readPort(event.data.fd);
+
+            if (event.events & (EPOLLHUP | EPOLLERR))
+                failPort(event.data.fd, "Serial port disconnected.");
+        }
+    }
+#elif defined(_WIN32)
+    std::vector<std::pair<Handle, std::string>> failedPorts;
+    std::vector<Handle> newPorts;
+    std::vector<::HANDLE> events;
+
+    while (true)
+    {
+        failedPorts.clear();
+        newPorts.clear();
+
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (!m_running)
+                return;
+
+            for (const auto& [handle, port] : m_ports)
+            {
+                if (port->failed || port->waiting || m_waitingPorts.size() >= MaximumWaitingPorts)
+                    continue;
+
+                port->eventMask = 0;
+                ::ResetEvent(port->overlapped.hEvent);
+
+                if (::WaitCommEvent(handle, &port->eventMask, &port->overlapped))
+                {
+                    ::SetEvent(port->overlapped.hEvent);
+                }
+                else if (::GetLastError() != ERROR_IO_PENDING)
+                {
+                    failedPorts.emplace_back(handle,
+                                             systemError("Unable to wait for serial port:"));
+                    continue;
+                }
+
+                port->waiting = true;
+                m_waitingPorts.emplace_back(handle, port);
+
+                // Data received before the event mask was set does not raise an event
+                if (!port->armed)
+                {
+                    port->armed = true;
+                    newPorts.push_back(handle);
+                }
+            }
+        }
+
+        for (const auto& [handle, error] : failedPorts)
+            failPort(handle, error);
+
+        for (Handle handle : newPorts)
+            readPort(handle);
+
+        events.assign(1, m_wakeup);
+
+        for (const auto& [handle, port] : m_waitingPorts)
+            events.push_back(port->overlapped.hEvent);
+
+        // Blocks until data arrives or the ports change, also while no port is registered
+        const ::DWORD result = ::WaitForMultipleObjects(events.size(), events.data(),
+                                                        FALSE, INFINITE);
+
+        if (result == WAIT_FAILED)
+            return;
+
+        // Serves every ready port, not only the first one, so that no port starves
+        for (auto it = m_waitingPorts.begin(); it != m_waitingPorts.end();)
+        {
+            const auto [handle, port] = *it;
+
+            if (::WaitForSingleObject(port->overlapped.hEvent, 0) != WAIT_OBJECT_0)
+            {
+                ++it;
+                continue;
+            }
+
+            it = m_waitingPorts.erase(it);
+
+            ::DWORD unused = 0;
+            const bool success = ::GetOverlappedResult(handle, &port->overlapped, &unused, FALSE);
+            const std::string error = success ? std::string()
+                                              : systemError("Unable to wait for serial port:");
+
+            bool registered = false;
+
+            {
+                std::lock_guard lock(m_mutex);
+
+                port->waiting = false;
+                m_dispatchFinished.notify_all();
+
+                // The handle may have been reused by a port registered in the meantime
+                const auto registeredPort = m_ports.find(handle);
+                registered = registeredPort != m_ports.end() && registeredPort->second == port;
+            }
+
+            if (!registered)
+                continue;
+
+            if (!success)
+                failPort(handle, error);
+            else if (port->eventMask & (EV_RXCHAR | EV_ERR))
+                readPort(handle);
+        }
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::readPort(Handle handle)
+{
+    const std::shared_ptr<Port> port = beginDispatch(handle);
+
+    if (!port)
+        return;
+
+#if defined(__linux__)
+    const ssize_t count = ::read(handle, m_readBuffer.data(), m_readBuffer.size());
+    const bool success = count >= 0 || errno == EAGAIN || errno == EINTR;
+#elif defined(_WIN32)
+    ::DWORD errors = 0;
+    ::COMSTAT stat = {};
+    ::DWORD count = 0;
+
+    bool success = ::ClearCommError(handle, &errors, &stat);
+
+    if (success && stat.cbInQue > 0)
+    {
+        const ::DWORD size = std::min<::DWORD>(stat.cbInQue, m_readBuffer.size());
+
+        // The data is already buffered, so the overlapped read completes right away
+        ::OVERLAPPED overlapped = {};
+        overlapped.hEvent = m_readEvent;
+
+        ::ResetEvent(m_readEvent);
+
+        success = (::ReadFile(handle, m_readBuffer.data(), size, nullptr, &overlapped) ||
+                   ::GetLastError() == ERROR_IO_PENDING) &&
+                  ::GetOverlappedResult(handle, &overlapped, &count, TRUE);
+    }
+#endif
+
+    if (success && count > 0)
+    {
+        try {
+            port->readCallback({ m_readBuffer.data(), static_cast<size_t>(count) });
+        }
+        catch (...) {}
+    }
+
+    endDispatch();
+
+    if (!success)
+        failPort(handle, systemError("Unable to read from serial port:"));
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::failPort(Handle handle, const std::string& error)
+{
+    const std::shared_ptr<Port> port = beginDispatch(handle);
+
+    if (!port)
+        return;
+
+    {
+        std::lock_guard lock(m_mutex);
+        port->failed = true;
+
+#if defined(__linux__)
+        // Stop polling, a disconnected port would otherwise be reported continuously
+        ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, handle, nullptr);
+#endif
+    }
+
+    if (port->errorCallback)
+    {
+        try {
+            port->errorCallback(error);
+        }
+        catch (...) {}
+    }
+
+    endDispatch();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SerialReactor::beginDispatch(Handle handle) -> std::shared_ptr<Port>
+{
+    std::lock_guard lock(m_mutex);
+
+    auto it = m_ports.find(handle);
+
+    if (it == m_ports.end() || it->second->failed)
+        return nullptr;
+
+    m_dispatching = true;
+    m_dispatchHandle = handle;
+
+    // The port may be removed while its callback is running
+    return it->second;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void SerialReactor::endDispatch()
+{
+    std::lock_guard lock(m_mutex);
+
+    m_dispatching = false;
+    m_dispatchFinished.notify_all();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto SerialReactor::systemError(const std::string& error) -> std::string
+{
+#if defined(__linux__)
+    return error + " " + std::string(::strerror(errno)) + ".";
+#elif defined(_WIN32)
+    return error + " Error code " + std::to_string(::GetLastError()) + ".";
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------- //
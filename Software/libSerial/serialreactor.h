@@ -0,0 +1,123 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+
+#pragma once
+
+#include <serial/serialport.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+ISF_SERIAL_BEGIN_NAMESPACE();
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Serves all registered serial ports from a single I/O thread
+class SerialReactor
+{
+public:
+#if defined(__linux__)
+    using Handle = int;
+#elif defined(_WIN32)
+    using Handle = void*;
+#endif
+
+    static constexpr size_t ReadBufferSize = 64 * 1024;
+
+public:
+    static auto instance() -> SerialReactor&;
+
+    void addPort(Handle handle, SerialPort::ReadCallback readCallback,
+                 SerialPort::ErrorCallback errorCallback);
+
+    void removePort(Handle handle);
+
+private:
+    struct Port
+    {
+        SerialPort::ReadCallback readCallback;
+        SerialPort::ErrorCallback errorCallback;
+        bool failed = false;
+
+#if defined(_WIN32)
+        ~Port() { if (overlapped.hEvent) ::CloseHandle(overlapped.hEvent); }
+
+        // The pending WaitCommEvent, owned by the I/O thread as long as waiting is set
+        ::OVERLAPPED overlapped = {};
+        ::DWORD eventMask = 0;
+        bool waiting = false;
+        bool armed = false;
+#endif
+    };
+
+private:
+    SerialReactor();
+    ~SerialReactor();
+
+    void run();
+
+    void readPort(Handle handle);
+    void failPort(Handle handle, const std::string& error);
+
+    auto beginDispatch(Handle handle) -> std::shared_ptr<Port>;
+    void endDispatch();
+
+    static auto systemError(const std::string& error) -> std::string;
+
+private:
+    std::thread m_thread;
+    bool m_running = true;
+
+    std::mutex m_mutex;
+    std::condition_variable m_dispatchFinished;
+
+    // Protected by m_mutex
+    std::map<Handle, std::shared_ptr<Port>> m_ports;
+    Handle m_dispatchHandle = {};
+    bool m_dispatching = false;
+
+    // Only used on the I/O thread
+    std::vector<char> m_readBuffer;
+
+#if defined(__linux__)
+    int m_epoll = -1;
+    int m_wakeup = -1;
+#elif defined(_WIN32)
+    ::HANDLE m_wakeup = nullptr;
+    ::HANDLE m_readEvent = nullptr;
+
+    // Ports with a pending WaitCommEvent, which may outlive their registration
+    std::vector<std::pair<Handle, std::shared_ptr<Port>>> m_waitingPorts;
+#endif
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+ISF_SERIAL_END_NAMESPACE();
@@ -0,0 +1,391 @@
+// ============================================================================================== //
+//                                                                                                //
+//  This file is part of the ISF ReDeX project.                                                   //
+//                                                                                                //
+//  Author:                                                                                       //
+//  Marcel Hasler <mahasler@gmail.com>                                                            //
+//                                                                                                //
+//  Copyright (c) 2021 - 2023                                                                     //
+//  Bonn-Rhein-Sieg University of Applied Sciences                                                //
+//                                                                                                //
+//  This program is free software: you can redistribute it and/or modify it under the terms       //
+//  of the GNU General Public License as published by the Free Software Foundation, either        //
+//  version 3 of the License, or (at your option) any later version.                              //
+//                                                                                                //
+//  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;     //
+//  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.     //
+//  See the GNU General Public License for more details.                                          //
+//                                                                                                //
+//  You should have received a copy of the GNU General Public License along with this program.    //
+//  If not, see <https://www.gnu.org/licenses/>.                                                  //
+//                                                                                                //
+// ============================================================================================== //
+#include "testing.h"
+
+#include <serial/serialport.h>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+using isf::Serial::SerialPort;
+
+// ---------------------------------------------------------------------------------------------- //
+
+// The master end of a pseudo terminal, standing in for a connected board
+class PseudoTerminal
+{
+public:
+    PseudoTerminal();
+    ~PseudoTerminal();
+
+    auto port() const -> std::string;
+
+    void send(const std::string& data);
+    void close();
+
+private:
+    int m_master = -1;
+    int m_slave = -1;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+PseudoTerminal::PseudoTerminal()
+{
+    m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (m_master < 0 || ::grantpt(m_master) < 0 || ::unlockpt(m_master) < 0)
+        std::abort();
+
+    // Keeps the terminal raw until the serial port has configured it
+    m_slave = ::open(::ptsname(m_master), O_RDWR | O_NOCTTY);
+
+    ::termios termios = {};
+    ::tcgetattr(m_slave, &termios);
+    ::cfmakeraw(&termios);
+    ::tcsetattr(m_slave, TCSANOW, &termios);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+PseudoTerminal::~PseudoTerminal()
+{
+    close();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto PseudoTerminal::port() const -> std::string
+{
+    // SerialPort expects a name relative to /dev
+    return std::string(::ptsname(m_master)).substr(5);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PseudoTerminal::send(const std::string& data)
+{
+    if (::write(m_master, data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+        std::abort();
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+void PseudoTerminal::close()
+{
+    if (m_slave >= 0)
+        ::close(m_slave);
+
+    if (m_master >= 0)
+        ::close(m_master);
+
+    m_slave = -1;
+    m_master = -1;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+// Splits the data delivered by the reactor into lines, as the device libraries do
+class LineCollector
+{
+public:
+    void attach(SerialPort& port);
+
+    auto waitForLines(size_t count, std::chrono::milliseconds timeout = 2s) -> bool;
+    auto waitForError(std::chrono::milliseconds timeout = 2s) -> bool;
+
+    auto lines() -> std::vector<std::string>;
+    auto callbackThread() -> std::thread::id;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+
+    std::string m_buffer;
+    std::vector<std::string> m_lines;
+    std::string m_error;
+    std::thread::id m_callbackThread;
+};
+
+// ---------------------------------------------------------------------------------------------- //
+
+void LineCollector::attach(SerialPort& port)
+{
+    port.setReadCallback([this](std::span<const char> data) {
+        std::lock_guard lock(m_mutex);
+
+        m_callbackThread = std::this_thread::get_id();
+        m_buffer.append(data.begin(), data.end());
+
+        size_t end = 0;
+
+        while ((end = m_buffer.find("\r\n")) != std::string::npos)
+        {
+            m_lines.push_back(m_buffer.substr(0, end));
+            m_buffer.erase(0, end + 2);
+        }
+
+        m_changed.notify_all();
+    },
+    [this](const std::string& error) {
+        std::lock_guard lock(m_mutex);
+
+        m_error = error;
+        m_changed.notify_all();
+    });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto LineCollector::waitForLines(size_t count, std::chrono::milliseconds timeout) -> bool
+{
+    std::unique_lock lock(m_mutex);
+    return m_changed.wait_for(lock, timeout, [&] { return m_lines.size() >= count; });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto LineCollector::waitForError(std::chrono::milliseconds timeout) -> bool
+{
+    std::unique_lock lock(m_mutex);
+    return m_changed.wait_for(lock, timeout, [&] { return !m_error.empty(); });
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto LineCollector::lines() -> std::vector<std::string>
+{
+    std::lock_guard lock(m_mutex);
+    return m_lines;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto LineCollector::callbackThread() -> std::thread::id
+{
+    std::lock_guard lock(m_mutex);
+    return m_callbackThread;
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testSplitLines()
+{
+    PseudoTerminal terminal;
+    SerialPort port(terminal.port());
+
+    LineCollector collector;
+    collector.attach(port);
+
+    terminal.send("<SENSOR_VALUE>0.1");
+    std::this_thread::sleep_for(20ms);
+    terminal.send("25\r\n<SENSOR");
+    std::this_thread::sleep_for(20ms);
+    terminal.send("_VALUE>25.5\r\n");
+
+    CHECK(collector.waitForLines(2));
+
+    const std::vector<std::string> lines = collector.lines();
+
+    if (CHECK(lines.size() == 2))
+    {
+        CHECK(lines[0] == "<SENSOR_VALUE>0.125");
+        CHECK(lines[1] == "<SENSOR_VALUE>25.5");
+    }
+
+    CHECK(collector.callbackThread() != std::this_thread::get_id());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testManyLinesInOrder()
+{
+    static constexpr size_t LineCount = 2000;
+
+    PseudoTerminal terminal;
+    SerialPort port(terminal.port());
+
+    LineCollector collector;
+    collector.attach(port);
+
+    std::string data;
+
+    for (size_t i = 0; i < LineCount; ++i)
+        data += "<SENSOR_DATA>" + std::to_string(i) + "\r\n";
+
+    // Larger than the terminal buffer, so the reactor has to read while the writer waits
+    std::thread writer([&] { terminal.send(data); });
+
+    CHECK(collector.waitForLines(LineCount, 5s));
+    writer.join();
+
+    const std::vector<std::string> lines = collector.lines();
+
+    if (CHECK(lines.size() == LineCount))
+    {
+        bool inOrder = true;
+
+        for (size_t i = 0; i < LineCount; ++i)
+            inOrder = inOrder && lines[i] == "<SENSOR_DATA>" + std::to_string(i);
+
+        CHECK(inOrder);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testTwoPorts()
+{
+    PseudoTerminal firstTerminal;
+    PseudoTerminal secondTerminal;
+
+    SerialPort firstPort(firstTerminal.port());
+    SerialPort secondPort(secondTerminal.port());
+
+    LineCollector firstCollector;
+    LineCollector secondCollector;
+
+    firstCollector.attach(firstPort);
+    secondCollector.attach(secondPort);
+
+    firstTerminal.send("FIRST\r\n");
+    secondTerminal.send("SECOND\r\n");
+
+    CHECK(firstCollector.waitForLines(1));
+    CHECK(secondCollector.waitForLines(1));
+
+    CHECK(firstCollector.lines() == std::vector<std::string>{ "FIRST" });
+    CHECK(secondCollector.lines() == std::vector<std::string>{ "SECOND" });
+
+    // A single I/O thread serves all ports
+    CHECK(firstCollector.callbackThread() == secondCollector.callbackThread());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUnregister()
+{
+    PseudoTerminal terminal;
+    SerialPort port(terminal.port());
+
+    LineCollector collector;
+    collector.attach(port);
+
+    terminal.send("BEFORE\r\n");
+    CHECK(collector.waitForLines(1));
+
+    port.setReadCallback({});
+
+    // The data now stays in the port for blocking reads
+    terminal.send("AFTER\r\n");
+
+    CHECK(port.waitForDataAvailable());
+    std::this_thread::sleep_for(20ms);
+
+    const std::vector<char> data = port.readAllData();
+
+    CHECK(std::string(data.begin(), data.end()) == "AFTER\r\n");
+    CHECK(collector.lines().size() == 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testUnregisterFromCallback()
+{
+    PseudoTerminal terminal;
+    SerialPort port(terminal.port());
+
+    std::mutex mutex;
+    std::condition_variable called;
+    size_t callCount = 0;
+
+    port.setReadCallback([&](std::span<const char>) {
+        // Must not wait for its own dispatch to finish
+        port.setReadCallback({});
+
+        std::lock_guard lock(mutex);
+        ++callCount;
+        called.notify_all();
+    });
+
+    terminal.send("FIRST\r\n");
+
+    {
+        std::unique_lock lock(mutex);
+        CHECK(called.wait_for(lock, 2s, [&] { return callCount > 0; }));
+    }
+
+    terminal.send("SECOND\r\n");
+    std::this_thread::sleep_for(50ms);
+
+    std::lock_guard lock(mutex);
+    CHECK(callCount == 1);
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+static void testDisconnect()
+{
+    PseudoTerminal terminal;
+    SerialPort port(terminal.port());
+
+    LineCollector collector;
+    collector.attach(port);
+
+    terminal.send("LAST\r\n");
+    CHECK(collector.waitForLines(1));
+
+    terminal.close();
+    CHECK(collector.waitForError());
+}
+
+// ---------------------------------------------------------------------------------------------- //
+
+auto main() -> int
+{
+    try {
+        testSplitLines();
+        testManyLinesInOrder();
+        testTwoPorts();
+        testUnregister();
+        testUnregisterFromCallback();
+        testDisconnect();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return Testing::result();
+}
+
+// ---------------------------------------------------------------------------------------------- //